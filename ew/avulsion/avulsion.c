@@ -30,7 +30,7 @@ avulsion_data_struct_quark(void)
 }
 
 Avulsion_st*
-avulsion_new(GRand* rand, double std_dev)
+avulsion_new(Eh_rand* rand, double std_dev)
 {
     Avulsion_st* data = eh_new(Avulsion_st, 1);
 
@@ -46,7 +46,7 @@ avulsion_dup(Avulsion_st* s)
     Avulsion_st* d = NULL;
 
     if (s) {
-        d = avulsion_new(g_rand_copy(s->rand), s->std_dev);
+        d = avulsion_new(eh_rand_copy(s->rand), s->std_dev);
     }
 
     return d;
@@ -56,7 +56,7 @@ Avulsion_st*
 avulsion_destroy(Avulsion_st* data)
 {
     if (data) {
-        g_rand_free(data->rand);
+        eh_rand_destroy(data->rand);
         data->std_dev = 0;
         data->rand    = NULL;
         eh_free(data);
@@ -72,7 +72,7 @@ get_std_dev_func(double angle, double std_dev)
 }
 
 double
-avulsion(GRand* rand, double last_angle, double std_dev)
+avulsion(Eh_rand* rand, double last_angle, double std_dev)
 {
     double new_angle;
     //   double d_angle = eh_rand_normal( rand , 0. , std_dev );
@@ -127,7 +127,7 @@ sed_river_impart_avulsion_data(Sed_riv r)
         if (sed_river_avulsion_data(left) == NULL) {
             Avulsion_st* left_data = avulsion_dup(parent_data);
             left_data->std_dev  *= .5;
-            left_data->rand = g_rand_new_with_seed(g_rand_int(parent_data->rand));
+            left_data->rand = eh_rand_new_with_seed(eh_rand_int(parent_data->rand));
             sed_river_set_avulsion_data(left, left_data);
         } else {
             sed_river_impart_avulsion_data(left);
@@ -138,7 +138,7 @@ sed_river_impart_avulsion_data(Sed_riv r)
         if (sed_river_avulsion_data(right) == NULL) {
             Avulsion_st* right_data = avulsion_dup(parent_data);
             right_data->std_dev  *= .5;
-            right_data->rand = g_rand_new_with_seed(g_rand_int(parent_data->rand));
+            right_data->rand = eh_rand_new_with_seed(eh_rand_int(parent_data->rand));
             sed_river_set_avulsion_data(right, right_data);
         } else {
             sed_river_impart_avulsion_data(right);
@@ -190,7 +190,7 @@ sed_river_avulse(Sed_riv r)
         eh_require(data);
 
         if (data && data->std_dev > 0) {
-            GRand* rand       = data->rand;
+            Eh_rand* rand     = data->rand;
             double std_dev    = data->std_dev;
             double min_angle  = sed_river_min_angle(r);
             double max_angle  = sed_river_max_angle(r);
@@ -33,7 +33,7 @@ G_BEGIN_DECLS
 #define AVULSION_MICRO_VERSION (0)
 
 typedef struct {
-    GRand* rand;
+    Eh_rand* rand;
     double std_dev;
 }
 Avulsion_st;
@@ -43,9 +43,9 @@ Avulsion_st;
 GQuark
 avulsion_data_struct_quark(void);
 double
-avulsion(GRand* rand, double last_angle, double std_dev);
+avulsion(Eh_rand* rand, double last_angle, double std_dev);
 Avulsion_st*
-avulsion_new(GRand* rand, double std_dev);
+avulsion_new(Eh_rand* rand, double std_dev);
 Avulsion_st*
 avulsion_dup(Avulsion_st* s);
 Avulsion_st*
@@ -418,7 +418,7 @@ avulsion_set_variance(AvulsionModel* self, double variance)
         Avulsion_st* data;
 
         data = avulsion_new(
-                (self->seed == 0) ? g_rand_new() : g_rand_new_with_seed(self->seed),
+                (self->seed == 0) ? eh_rand_new() : eh_rand_new_with_seed(self->seed),
                 variance);
         eh_require(data);
         sed_river_set_avulsion_data(r, data);
@@ -1919,7 +1919,7 @@ avulsion_init_state(AvulsionModel* s)
         s->time_step = 1.;
 
         s->seed = DEFAULT_SEED;
-        s->rand = g_rand_new_with_seed(s->seed);
+        s->rand = eh_rand_new_with_seed(s->seed);
 
         s->p = NULL;
 
@@ -1941,7 +1941,7 @@ void
 avulsion_free_state(AvulsionModel* s)
 {
     if (s) {
-        g_rand_free(s->rand);
+        eh_rand_destroy(s->rand);
         s->rand = NULL;
 
         if (s->discharge) {
@@ -73,7 +73,7 @@ typedef struct {
     double dx;
     double dy;
 
-    GRand* rand;
+    Eh_rand* rand;
     guint seed;
 } AvulsionModel;
 
@@ -164,7 +164,7 @@ avulsion_lite(void)
     {
         gint n;
         double angle = init_angle;
-        GRand* rand = (seed == 0) ? g_rand_new() : g_rand_new_with_seed(seed);
+        Eh_rand* rand = (seed == 0) ? eh_rand_new() : eh_rand_new_with_seed(seed);
         double m;
 
         m = 2.*G_PI / (max_angle - min_angle);
@@ -176,7 +176,7 @@ avulsion_lite(void)
             fprintf(stdout, "%f\n", (angle / m + .5 * (min_angle + max_angle))*S_DEGREES_PER_RAD);
         }
 
-        g_rand_free(rand);
+        eh_rand_destroy(rand);
     }
 
     return 0;
@@ -289,7 +289,7 @@ avulsion_full()
             max_angle = river_data[i][1] * S_RADS_PER_DEGREE;
             std_dev   = river_data[i][2] * S_RADS_PER_DEGREE;
 
-            data = avulsion_new((seed == 0) ? g_rand_new() : g_rand_new_with_seed(seed), std_dev);
+            data = avulsion_new((seed == 0) ? eh_rand_new() : eh_rand_new_with_seed(seed), std_dev);
 
             new_river = sed_river_new(NULL);
 
@@ -623,7 +623,7 @@ deposit_sediment_helper(Sed_riv this_river, Sed_cube c)
     mouth_pos = sed_river_mouth(this_river);
 
     if (sed_cube_is_in_domain(c, mouth_pos.i, mouth_pos.j)) {
-        double depth = sed_column_water_depth(sed_cube_col_ij(c, mouth_pos.i, mouth_pos.j));
+        double depth = sed_column_water_depth(sed_cube_peek_col_ij(c, mouth_pos.i, mouth_pos.j));
 
         if (depth < sed_cell_size(deposit_cell)) {
             sed_cell_resize(deposit_cell, depth);
@@ -170,7 +170,7 @@ bio_init(Sed_process p, Eh_symbol_table t, GError** error)
         //gchar** err_s   = NULL;
         gchar*  model_s = eh_symbol_table_lookup(t, BIO_KEY_MODEL);
 
-        data->depth = eh_symbol_table_input_value(t, BIO_KEY_DEPTH, &tmp_err);
+        data->depth = sed_process_input_value(p, t, BIO_KEY_DEPTH, &tmp_err);
 
         if (g_ascii_strcasecmp(model_s, "DIFFUSION") == 0) {
             data->method = BIO_METHOD_DIFFUSION;
@@ -183,13 +183,13 @@ bio_init(Sed_process p, Eh_symbol_table t, GError** error)
         if (!tmp_err
             && data->method == BIO_METHOD_DIFFUSION
             && eh_symbol_table_require_labels(t, bio_diff_req_label, &tmp_err)) {
-            data->k = eh_symbol_table_input_value(t, BIO_KEY_K, &tmp_err);
+            data->k = sed_process_input_value(p, t, BIO_KEY_K, &tmp_err);
         }
 
         if (!tmp_err
             && data->method == BIO_METHOD_CONVEYOR
             && eh_symbol_table_require_labels(t, bio_conv_req_label, &tmp_err)) {
-            data->r = eh_symbol_table_input_value(t, BIO_KEY_R, &tmp_err);
+            data->r = sed_process_input_value(p, t, BIO_KEY_R, &tmp_err);
         }
     }
 
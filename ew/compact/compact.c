@@ -45,6 +45,291 @@ compact_error_quark(void)
     return g_quark_from_static_string("compact-error-quark");
 }
 
+/** Sediment properties used by compaction
+
+Fetch the per-type properties that compaction needs once so that they can be
+shared by every column that is compacted with them.
+
+\return A new Compact_props; destroy with compact_props_destroy
+*/
+Compact_props*
+compact_props_new(void)
+{
+    Compact_props* props = eh_new(Compact_props, 1);
+
+    props->n_grains      = sed_sediment_env_n_types();
+    props->c             = sed_sediment_property(NULL, &sed_type_compressibility);
+    props->rho_grain     = sed_sediment_property(NULL, &sed_type_rho_grain);
+    props->rho_max       = sed_sediment_property(NULL, &sed_type_rho_max);
+    props->rho           = sed_sediment_property(NULL, &sed_type_rho_sat);
+    props->rho_sea_water = sed_rho_sea_water();
+    props->e             = eh_new(double, props->n_grains);
+
+    return props;
+}
+
+Compact_props*
+compact_props_destroy(Compact_props* props)
+{
+    if (props) {
+        eh_free(props->c);
+        eh_free(props->rho_grain);
+        eh_free(props->rho_max);
+        eh_free(props->rho);
+        eh_free(props->e);
+        eh_free(props);
+    }
+
+    return NULL;
+}
+
+/** Loads that the cells of a column were last compacted under
+
+Each cell keeps the sediment load of itself and every cell below it, so that
+the load on a cell is the load on the base of the column less the load below
+the cell.  Cells that are buried under new sediment keep these sums and so
+only the loads of cells at the top of the column, which are new or have been
+changed, need to be added up.
+
+Cells are compacted in runs.  Each run of cells was last compacted when the
+base of the column was under the same load, and so the change in load of
+every cell of a run is the same.  A run whose load has changed by no more
+than the tolerance is left alone without looking at its cells.
+
+Entries remember which cell (and its uncompacted thickness, age and pore
+pressure) they were computed for so that cells that have been replaced,
+coalesced or added to are always recompacted.
+*/
+struct _Compact_column_cache {
+    Sed_cell* cell;      ///< Cell that the entry was computed for
+    double*   t_0;       ///< Uncompacted thickness of the cell
+    double*   age;       ///< Age of the cell
+    double*   pressure;  ///< Pore pressure of the cell
+    double*   load;      ///< Sediment load of the cell and all cells below it
+    gint*     run_start; ///< First cell of each run
+    double*   run_load;  ///< Load on the base of the column when a run was compacted
+    gint      n_runs;    ///< Number of runs
+    gint      len;       ///< Number of cells when the column was last compacted
+    gint      size;      ///< Allocated number of entries
+    gint      top;       ///< Cells above this one are new or have changed
+    double    total;     ///< Load on the base of the column now
+};
+
+static void
+_compact_column_cache_init(Compact_column_cache* c)
+{
+    c->cell      = NULL;
+    c->t_0       = NULL;
+    c->age       = NULL;
+    c->pressure  = NULL;
+    c->load      = NULL;
+    c->run_start = NULL;
+    c->run_load  = NULL;
+    c->n_runs    = 0;
+    c->len       = 0;
+    c->size      = 0;
+    c->top       = -1;
+    c->total     = 0.;
+}
+
+static void
+_compact_column_cache_free(Compact_column_cache* c)
+{
+    eh_free(c->cell);
+    eh_free(c->t_0);
+    eh_free(c->age);
+    eh_free(c->pressure);
+    eh_free(c->load);
+    eh_free(c->run_start);
+    eh_free(c->run_load);
+}
+
+static void
+_compact_column_cache_resize(Compact_column_cache* c, gint n)
+{
+    if (c->size < n) {
+        c->cell      = eh_renew(Sed_cell, c->cell, n);
+        c->t_0       = eh_renew(double, c->t_0, n);
+        c->age       = eh_renew(double, c->age, n);
+        c->pressure  = eh_renew(double, c->pressure, n);
+        c->load      = eh_renew(double, c->load, n);
+        c->run_start = eh_renew(gint, c->run_start, n);
+        c->run_load  = eh_renew(double, c->run_load, n);
+        c->size      = n;
+    }
+}
+
+/* Is the i-th entry of a column cache for this cell as it is now? */
+static gboolean
+_compact_column_cache_has(const Compact_column_cache* c, gint i,
+    const Sed_cell cell)
+{
+    return c->cell[i] == cell
+        && c->t_0[i] == sed_cell_size_0(cell)
+        && c->age[i] == sed_cell_age(cell)
+        && c->pressure[i] == sed_cell_pressure(cell);
+}
+
+/* Find the cells of a column that need to be compacted.  Cells from the top
+   of the column down to the first cell that is unchanged since the column
+   was last compacted are taken to be new; the cells below it are taken to be
+   as they were.  Returns TRUE if any cell needs to be compacted.  The column
+   is not changed. */
+static gboolean
+_compact_column_plan(const Sed_column s, Compact_column_cache* c, double tol)
+{
+    const gint len = sed_column_len(s);
+    gint       i, k;
+
+    if (len <= 2) {
+        /* Too short to have any overlying load */
+        c->len    = 0;
+        c->n_runs = 0;
+        return FALSE;
+    }
+
+    _compact_column_cache_resize(c, len);
+
+    for (i = MIN(len, c->len) - 1 ; i >= 0 ; i--)
+        if (_compact_column_cache_has(c, i, sed_column_nth_cell(s, i))) {
+            break;
+        }
+
+    c->top = i;
+
+    for (i = c->top + 1 ; i < len ; i++) {
+        const double below = (i > 0) ? c->load[i - 1] : 0.;
+        c->load[i] = below + sed_cell_sediment_load(sed_column_nth_cell(s, i));
+    }
+
+    c->total = c->load[len - 1];
+
+    if (c->top < len - 1) {
+        return TRUE;
+    }
+
+    for (k = 0 ; k < c->n_runs && c->run_start[k] <= c->top ; k++)
+        if (fabs(c->total - c->run_load[k]) > tol) {
+            return TRUE;
+        }
+
+    return FALSE;
+}
+
+/* Compact cells [i_0,i_1) of a column.  The props scratch space is written
+   to, so each thread needs its own. */
+static void
+_compact_cells(Sed_column s, Compact_props* props, Compact_column_cache* c,
+    gint i_0, gint i_1)
+{
+    const gint     n_grains = props->n_grains;
+    const double*  cc       = props->c;
+    const double*  rho_grain = props->rho_grain;
+    const double*  rho_max  = props->rho_max;
+    const double*  rho      = props->rho;
+    const double   rho_sea_water = props->rho_sea_water;
+    double*        e        = props->e;
+    gint           i, n;
+    Sed_cell       this_cell;
+    double         load_eff, t_0, t_new, rho_new, vol;
+
+    for (i = i_0 ; i < i_1 ; i++) {
+        this_cell = sed_column_nth_cell(s, i);
+
+        /* The effective load of the overlying sediment (including the cell). */
+        load_eff = c->total - ((i > 0) ? c->load[i - 1] : 0.)
+            - sed_cell_pressure(this_cell);
+
+        if (load_eff < 0) {
+            load_eff = 0.;
+        }
+
+        c->cell[i]     = this_cell;
+        c->t_0[i]      = sed_cell_size_0(this_cell);
+        c->age[i]      = sed_cell_age(this_cell);
+        c->pressure[i] = sed_cell_pressure(this_cell);
+
+        /* Kept free of branches so that it can be vectorized.  That needs a
+           vector exp from the math library; glibc only declares one when
+           built with -ffast-math, which isn't used here. */
+        #pragma omp simd
+        for (n = 0 ; n < n_grains ; n++) {
+            e[n] = exp(cc[n] * load_eff);
+        }
+
+        vol = sed_cell_sediment_volume(this_cell);
+
+        for (n = 0, t_new = 0. ; n < n_grains ; n++) {
+            /* Compact each grain type. */
+
+            t_0 = vol * sed_cell_fraction(this_cell, n);
+            rho_new = rho_max[n] + (rho[n] - rho_max[n]) / e[n];
+
+            t_new += t_0 * (rho_grain[n] - rho_sea_water) / (rho_new - rho_sea_water);
+
+            if (t_new < 0) {
+                t_new = 0;
+                eh_require_not_reached();
+            }
+        }
+
+        // If the new thickness is greater than the current thickness, we
+        // don't do anything.  In this case overlying sediment has been eroded.
+        if (t_new < sed_cell_size(this_cell)) {
+            sed_column_compact_cell(s, i, t_new);
+        }
+    }
+}
+
+/* Compact the cells of a column that _compact_column_plan found: the new cells
+   at the top and the runs below them whose load has changed by more than
+   tol. */
+static void
+_compact_column_apply(Sed_column s, Compact_props* props,
+    Compact_column_cache* c, double tol)
+{
+    const gint len = sed_column_len(s);
+    gint       i, k, n_runs;
+
+    /* The column was taken by the cube after it was planned and so its cells
+       may have been copied (see sed_column_unshare) */
+    if (c->top >= 0 && c->cell[c->top] != sed_column_nth_cell(s, c->top)) {
+        for (i = 0 ; i <= c->top ; i++) {
+            c->cell[i] = sed_column_nth_cell(s, i);
+        }
+    }
+
+    for (k = 0 ; k < c->n_runs && c->run_start[k] <= c->top ; k++) {
+        if (fabs(c->total - c->run_load[k]) > tol) {
+            const gint end = (k + 1 < c->n_runs && c->run_start[k + 1] <= c->top)
+                ? c->run_start[k + 1] : c->top + 1;
+
+            _compact_cells(s, props, c, c->run_start[k], end);
+            c->run_load[k] = c->total;
+        }
+    }
+
+    n_runs = k;
+
+    if (c->top + 1 < len) {
+        _compact_cells(s, props, c, c->top + 1, len);
+
+        c->run_start[n_runs] = c->top + 1;
+        c->run_load[n_runs]  = c->total;
+        n_runs++;
+    }
+
+    /* Join neighbouring runs that were compacted under the same load */
+    for (k = 1, c->n_runs = (n_runs > 0) ? 1 : 0 ; k < n_runs ; k++)
+        if (c->run_load[k] != c->run_load[c->n_runs - 1]) {
+            c->run_start[c->n_runs] = c->run_start[k];
+            c->run_load[c->n_runs]  = c->run_load[k];
+            c->n_runs++;
+        }
+
+    c->len = len;
+}
+
 /** Compact a column of sediment
 
 Compact a column of sediment.  The amount that a cell of sediment
@@ -75,115 +360,153 @@ compact(Sed_column s)
 {
     eh_require(s);
 
-    //if ( s || sed_column_len(s)<2 )
-    if (s && sed_column_len(s) > 2) {
-        /* There is a column with overlying load; compact it! */
-        //const double hydro_static = sed_column_water_pressure( s );
-        const gint n_grains = sed_sediment_env_n_types();
-        const gint col_len  = sed_column_len(s);
-        double*    load_eff = eh_new0(double, col_len);
-
-        eh_require(load_eff);
-
-        { /* Calculate the effective load of the overlying sediment. */
-            gint  i;
-            double* load = sed_column_load(s, 0, -1, NULL);
-            double* p    = sed_column_pressure(s, 0, -1, NULL);
+    if (s) {
+        Compact_column_cache c;
 
-            for (i = 0; i < col_len; i++) {
-                load_eff[i] = load[i] - p[i];
+        _compact_column_cache_init(&c);
 
-                if (load_eff[i] < 0) {
-                    load_eff[i] = 0.;
-                }
-            }
+        if (_compact_column_plan(s, &c, 0.)) {
+            /* There is a column with overlying load; compact it! */
+            Compact_props* props = compact_props_new();
 
-            /*
-                     for (i=sed_column_len(s)-1; i>=0; --i)
-                     {
-                        p = sed_cell_pressure( sed_column_nth_cell( s , i ) );
+            _compact_column_apply(s, props, &c, 0.);
 
-                        load_eff[i] = load[i] - p;
-
-                        if ( load_eff[i] < 0 )
-                           load_eff[i] = 0.;
-                     }
-            */
-            eh_free(p);
-            eh_free(load);
+            compact_props_destroy(props);
         }
 
-        { /* Calculate the densities that the sediment should be. */
-            gint i, n;
-            Sed_cell this_cell;
-            double t_new;
-            double* c         = sed_sediment_property(NULL,
-                    &sed_type_compressibility);
-            double* rho_grain = sed_sediment_property(NULL, &sed_type_rho_grain);
-            double* rho_max   = sed_sediment_property(NULL, &sed_type_rho_max);
-            double* rho       = sed_sediment_property(NULL, &sed_type_rho_sat);
-            double rho_new;
-            double t_0;
-            const double rho_sea_water = sed_rho_sea_water();
-
-            for (i = sed_column_len(s) - 1; i >= 0 ; i--) {
-                /* From the top of the column to the bottom. */
+        _compact_column_cache_free(&c);
+    }
 
-                this_cell = sed_column_nth_cell(s, i);
+    return 0;
+}
 
-                for (n = 0, t_new = 0. ; n < n_grains ; n++) {
-                    /* Compact each grain type. */
+gboolean
+compact_cube(Sed_cube p)
+{
+    return compact_cube_incremental(p, NULL, 0.);
+}
 
-                    t_0 = sed_cell_sediment_volume(this_cell)
-                        * sed_cell_fraction(this_cell, n);
-                    rho_new = rho_max[n] + (rho[n] - rho_max[n]) / exp(c[n] * load_eff[i]);
+/** Cached effective loads for every column of a cube
 
-                    t_new += t_0 * (rho_grain[n] - rho_sea_water) / (rho_new - rho_sea_water);
+\return A new Compact_cache; destroy with compact_cache_destroy
+*/
+Compact_cache*
+compact_cache_new(void)
+{
+    Compact_cache* cache = eh_new(Compact_cache, 1);
 
-                    if (t_new < 0) {
-                        t_new = 0;
-                        eh_require_not_reached();
-                    }
+    cache->col = NULL;
+    cache->len = 0;
 
-                }
+    return cache;
+}
 
-                // If the new thickness is greater than the current thickness, we
-                // don't do anything.  In this case overlying sediment has been eroded.
-                if (t_new < sed_cell_size(this_cell)) {
-                    sed_column_compact_cell(s, i, t_new);
-                }
-            }
+Compact_cache*
+compact_cache_destroy(Compact_cache* cache)
+{
+    if (cache) {
+        gint i;
 
-            eh_free(c);
-            eh_free(rho_max);
-            eh_free(rho_grain);
-            eh_free(rho);
+        for (i = 0 ; i < cache->len ; i++) {
+            _compact_column_cache_free(&cache->col[i]);
         }
 
-        eh_free(load_eff);
+        eh_free(cache->col);
+        eh_free(cache);
     }
 
-    return 0;
+    return NULL;
 }
 
+/** Compact only those cells of a cube whose load has changed
+
+Compact each column of a cube as compact does but remember the load that
+each cell was compacted under.  On later calls, only the cells at the top of
+a column that are new, or have changed, have their loads added up; the cells
+below them are taken to be as they were and are compacted only if the load
+on them has changed by more than tol.  The cost of compaction so follows
+the new sediment rather than the total thickness of the columns.
+
+Buried cells are assumed to change only if the cells above them do.  A
+process that changes buried cells directly (their pore pressure, say) while
+leaving the cells above them alone should be followed by compaction with a
+new cache.  Columns whose cells were copied since they were last compacted
+(see sed_column_unshare) are compacted in full.
+
+Columns are looked at with sed_cube_peek_col and only those with cells to
+compact are taken by the cube (see sed_cube_col), so columns that are shared
+with a snapshot are copied only if they change.
+
+\param p     A Sed_cube
+\param cache Loads from previous calls, or NULL to compact every cell
+\param tol   Change in load (Pa) below which a cell is not compacted
+
+\return TRUE on success
+*/
 gboolean
-compact_cube(Sed_cube p)
+compact_cube_incremental(Sed_cube p, Compact_cache* cache, double tol)
 {
     gboolean success = FALSE;
 
     eh_require(p);
+    eh_require(tol >= 0.);
 
     if (p) {
-        gint i;
-        const gint len = sed_cube_size(p);
+        gint           i;
+        const gint     len     = sed_cube_size(p);
+        Compact_cache* scratch = NULL;
+        Sed_column*    cols    = eh_new(Sed_column, len);
+
+        if (!cache) {
+            cache = scratch = compact_cache_new();
+        }
+
+        if (cache->len != len) {
+            gint n;
+
+            for (n = len ; n < cache->len ; n++) {
+                _compact_column_cache_free(&cache->col[n]);
+            }
+
+            cache->col = eh_renew(Compact_column_cache, cache->col, len);
+
+            for (n = cache->len ; n < len ; n++) {
+                _compact_column_cache_init(&cache->col[n]);
+            }
+
+            cache->len = len;
+        }
 
         #pragma omp parallel for num_threads(4)
 
         for (i = 0 ; i < len ; i++) {
-            Sed_column s = sed_cube_col(p, i);
-            compact(s);
+            Sed_column s = sed_cube_peek_col(p, i);
+            cols[i] = _compact_column_plan(s, &cache->col[i], tol) ? s : NULL;
+        }
+
+        for (i = 0 ; i < len ; i++)
+            if (cols[i]) {
+                cols[i] = sed_cube_col(p, i);
+            }
+
+        #pragma omp parallel num_threads(4)
+
+        {
+            Compact_props* props = compact_props_new();
+
+            #pragma omp for
+
+            for (i = 0 ; i < len ; i++)
+                if (cols[i]) {
+                    _compact_column_apply(cols[i], props, &cache->col[i], tol);
+                }
+
+            compact_props_destroy(props);
         }
 
+        eh_free(cols);
+        compact_cache_destroy(scratch);
+
         success = TRUE;
     }
 
@@ -15,10 +15,42 @@ Compact_error;
 #define COMPACT_ERROR compact_error_quark()
 GQuark
 compact_error_quark(void);
+/** Per-type sediment properties used by compaction */
+typedef struct {
+    gint    n_grains;      ///< Number of sediment types
+    double* c;             ///< Compressibility of each type
+    double* rho_grain;     ///< Grain density of each type
+    double* rho_max;       ///< Maximum bulk density of each type
+    double* rho;           ///< Saturated bulk density of each type
+    double  rho_sea_water; ///< Density of sea water
+    double* e;             ///< Scratch space of n_grains values
+}
+Compact_props;
+
+typedef struct _Compact_column_cache Compact_column_cache;
+
+/** Effective loads that the cells of a cube were last compacted under */
+typedef struct {
+    Compact_column_cache* col; ///< Cache for each column of the cube
+    gint                  len; ///< Number of columns
+}
+Compact_cache;
+
 int
 compact(Sed_column col);
 gboolean
 compact_cube(Sed_cube cube);
+gboolean
+compact_cube_incremental(Sed_cube cube, Compact_cache* cache, double tol);
+
+Compact_props*
+compact_props_new(void);
+Compact_props*
+compact_props_destroy(Compact_props* props);
+Compact_cache*
+compact_cache_new(void);
+Compact_cache*
+compact_cache_destroy(Compact_cache* cache);
 
 #define COMPACTION_PROGRAM_NAME     "compact"
 #define COMPACTION_MAJOR_VERSION    1
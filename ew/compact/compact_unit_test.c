@@ -2,8 +2,7 @@
 #include <sed/sed_sedflux.h>
 #include <check.h>
 
-int
-compact(Sed_column);
+#include "compact.h"
 
 START_TEST(test_compact_0)
 {
@@ -273,6 +272,275 @@ START_TEST(test_compact_mixed)
 }
 END_TEST
 
+/* A cube of two columns, each a stack of five cells of mixed sediment. */
+static Sed_cube
+_new_test_cube(void)
+{
+    Sed_cube p = sed_cube_new(1, 2);
+    double*  f = eh_new0(double, sed_sediment_env_n_types());
+    Sed_cell cell;
+    gint     i, n;
+
+    for (n = 0 ; n < sed_sediment_env_n_types() ; n++) {
+        f[n] = 1. / (double)sed_sediment_env_n_types();
+    }
+
+    cell = sed_cell_new_sized(sed_sediment_env_n_types(), 1000, f);
+
+    for (i = 0 ; i < sed_cube_size(p) ; i++) {
+        Sed_column s = sed_cube_col(p, i);
+
+        sed_column_set_sea_level(s, 10);
+        sed_column_set_base_height(s, -40000);
+
+        for (n = 0 ; n < 5 ; n++) {
+            sed_column_stack_cell(s, cell);
+        }
+    }
+
+    sed_cell_destroy(cell);
+    eh_free(f);
+
+    return p;
+}
+
+/* Stack another cell on top of each column of a cube. */
+static void
+_stack_test_cell(Sed_cube p, double t)
+{
+    double*  f = eh_new0(double, sed_sediment_env_n_types());
+    Sed_cell cell;
+    gint     i;
+
+    f[0] = 1.;
+    cell = sed_cell_new_sized(sed_sediment_env_n_types(), t, f);
+
+    for (i = 0 ; i < sed_cube_size(p) ; i++) {
+        sed_column_stack_cell(sed_cube_col(p, i), cell);
+    }
+
+    sed_cell_destroy(cell);
+    eh_free(f);
+}
+
+/* Undo the compaction of a cell. */
+static Sed_cell
+_uncompact_cell(Sed_cube p, gint i, gint n)
+{
+    Sed_column s = sed_cube_col(p, i);
+
+    sed_column_compact_cell(s, n, sed_cell_size_0(sed_column_nth_cell(s, n)));
+
+    return sed_column_nth_cell(s, n);
+}
+
+static gboolean
+_cubes_are_equal(Sed_cube a, Sed_cube b)
+{
+    gint i, n;
+
+    for (i = 0 ; i < sed_cube_size(a) ; i++) {
+        Sed_column s_a = sed_cube_col(a, i);
+        Sed_column s_b = sed_cube_col(b, i);
+
+        if (sed_column_len(s_a) != sed_column_len(s_b)
+            || sed_column_thickness(s_a) != sed_column_thickness(s_b)) {
+            return FALSE;
+        }
+
+        for (n = 0 ; n < sed_column_len(s_a) ; n++)
+            if (sed_cell_size(sed_column_nth_cell(s_a, n))
+                != sed_cell_size(sed_column_nth_cell(s_b, n))) {
+                return FALSE;
+            }
+    }
+
+    return TRUE;
+}
+
+START_TEST(test_compact_cube_incremental)
+{
+    Sed_cube      a     = _new_test_cube();
+    Sed_cube      b     = _new_test_cube();
+    Compact_cache* cache = compact_cache_new();
+    gint          n;
+
+    for (n = 0 ; n < 5 ; n++) {
+        _stack_test_cell(a, 100. * (n + 1));
+        _stack_test_cell(b, 100. * (n + 1));
+
+        compact_cube_incremental(a, cache, 0.);
+        compact_cube(b);
+
+        fail_unless(_cubes_are_equal(a, b),
+            "Incremental compaction differs from full compaction");
+    }
+
+    {
+        Sed_cell cell_0 = sed_column_nth_cell(sed_cube_col(a, 0), 0);
+        fail_unless(sed_cell_size(cell_0) < sed_cell_size_0(cell_0),
+            "Cell was not compacted");
+    }
+
+    compact_cache_destroy(cache);
+    sed_cube_destroy(a);
+    sed_cube_destroy(b);
+}
+END_TEST
+
+START_TEST(test_compact_cache_hit)
+{
+    Sed_cube      p     = _new_test_cube();
+    Compact_cache* cache = compact_cache_new();
+    Sed_cell      cell;
+
+    compact_cube_incremental(p, cache, 0.);
+
+    // Nothing has changed, so the cell is left as it is.
+    cell = _uncompact_cell(p, 0, 0);
+    compact_cube_incremental(p, cache, 0.);
+
+    fail_unless(sed_cell_size(cell) == sed_cell_size_0(cell),
+        "Cached cell was recompacted");
+
+    // Without the cache it is compacted.
+    compact_cube(p);
+
+    fail_unless(sed_cell_size(cell) < sed_cell_size_0(cell),
+        "Cell was not compacted");
+
+    compact_cache_destroy(cache);
+    sed_cube_destroy(p);
+}
+END_TEST
+
+START_TEST(test_compact_cache_miss_cell)
+{
+    Sed_cube      a     = _new_test_cube();
+    Sed_cube      b     = _new_test_cube();
+    Sed_cube      c     = _new_test_cube();
+    Compact_cache* cache = compact_cache_new();
+
+    // The cells of another cube are never found in the cache.
+    compact_cube_incremental(a, cache, G_MAXDOUBLE);
+    compact_cube_incremental(b, cache, G_MAXDOUBLE);
+    compact_cube(c);
+
+    fail_unless(_cubes_are_equal(b, c),
+        "Cells of a new cube were found in the cache");
+
+    compact_cache_destroy(cache);
+    sed_cube_destroy(a);
+    sed_cube_destroy(b);
+    sed_cube_destroy(c);
+}
+END_TEST
+
+START_TEST(test_compact_cache_miss_size)
+{
+    Sed_cube      a     = _new_test_cube();
+    Sed_cube      b     = _new_test_cube();
+    Compact_cache* cache = compact_cache_new();
+    Sed_cell      cell_0, cell_top;
+    gint          top;
+    double        t;
+
+    compact_cube_incremental(a, cache, 0.);
+    compact_cube(b);
+
+    // Adding sediment to a cell changes its uncompacted thickness and
+    // so it is recompacted, regardless of the change in load.
+    top = sed_column_len(sed_cube_col(a, 0)) - 1;
+    t = 2. * sed_cell_size(sed_column_nth_cell(sed_cube_col(a, 0), top));
+    sed_column_resize_cell(sed_cube_col(a, 0), top, t);
+    sed_column_resize_cell(sed_cube_col(b, 0), top, t);
+
+    cell_top = sed_column_nth_cell(sed_cube_col(a, 0), top);
+    cell_0   = _uncompact_cell(a, 0, 0);
+
+    compact_cube_incremental(a, cache, G_MAXDOUBLE);
+    compact_cube(b);
+
+    fail_unless(sed_cell_size(cell_top)
+        == sed_cell_size(sed_column_nth_cell(sed_cube_col(b, 0), top)),
+        "Resized cell was not recompacted");
+    fail_unless(sed_cell_size(cell_0) == sed_cell_size_0(cell_0),
+        "Cached cell was recompacted");
+
+    compact_cache_destroy(cache);
+    sed_cube_destroy(a);
+    sed_cube_destroy(b);
+}
+END_TEST
+
+START_TEST(test_compact_cache_shared)
+{
+    Sed_cube      p     = _new_test_cube();
+    Compact_cache* cache = compact_cache_new();
+    Sed_cube      snap;
+
+    compact_cube_incremental(p, cache, 0.);
+    snap = sed_cube_snapshot(p);
+
+    // Columns with nothing to compact are not taken from the snapshot ...
+    compact_cube_incremental(p, cache, 0.);
+
+    fail_unless(sed_column_is_shared(sed_cube_peek_col(p, 0)),
+        "Column was copied without being compacted");
+    fail_unless(sed_column_is_shared(sed_cube_peek_col(p, 1)),
+        "Column was copied without being compacted");
+
+    // ... but those with new sediment are.
+    sed_column_stack_cell(sed_cube_col(p, 0),
+        sed_column_top_cell(sed_cube_peek_col(p, 0)));
+    compact_cube_incremental(p, cache, 0.);
+
+    fail_if(sed_column_is_shared(sed_cube_peek_col(p, 0)),
+        "Compacted column is shared");
+    fail_unless(sed_column_is_shared(sed_cube_peek_col(p, 1)),
+        "Column was copied without being compacted");
+    fail_unless(sed_column_len(sed_cube_peek_col(snap, 0))
+        == sed_column_len(sed_cube_peek_col(p, 0)) - 1,
+        "Snapshot was changed");
+
+    sed_cube_destroy(snap);
+    compact_cache_destroy(cache);
+    sed_cube_destroy(p);
+}
+END_TEST
+
+START_TEST(test_compact_cache_miss_load)
+{
+    Sed_cube      p     = _new_test_cube();
+    Compact_cache* cache = compact_cache_new();
+    Sed_cell      cell;
+    double        d_load;
+
+    compact_cube_incremental(p, cache, 0.);
+
+    _stack_test_cell(p, 10.);
+    d_load = sed_cell_sediment_load(
+            sed_column_top_cell(sed_cube_col(p, 0)));
+
+    // A change in load within the tolerance is ignored ...
+    cell = _uncompact_cell(p, 0, 0);
+    compact_cube_incremental(p, cache, 2. * d_load);
+
+    fail_unless(sed_cell_size(cell) == sed_cell_size_0(cell),
+        "Cell was recompacted for a load change within tolerance");
+
+    // ... but one greater than it is not.
+    _stack_test_cell(p, 10.);
+    compact_cube_incremental(p, cache, .5 * d_load);
+
+    fail_unless(sed_cell_size(cell) < sed_cell_size_0(cell),
+        "Cell was not recompacted for a load change beyond tolerance");
+
+    compact_cache_destroy(cache);
+    sed_cube_destroy(p);
+}
+END_TEST
+
 Suite*
 sed_compact_suite(void)
 {
@@ -287,6 +555,12 @@ sed_compact_suite(void)
     tcase_add_test(test_case_core, test_compact_3);
     tcase_add_test(test_case_core, test_compact_4);
     tcase_add_test(test_case_core, test_compact_mixed);
+    tcase_add_test(test_case_core, test_compact_cube_incremental);
+    tcase_add_test(test_case_core, test_compact_cache_hit);
+    tcase_add_test(test_case_core, test_compact_cache_miss_cell);
+    tcase_add_test(test_case_core, test_compact_cache_miss_size);
+    tcase_add_test(test_case_core, test_compact_cache_miss_load);
+    tcase_add_test(test_case_core, test_compact_cache_shared);
 
     return s;
 }
@@ -858,7 +858,7 @@ diffuse_sediment_2(Sed_cube prof, double k_long_max,
                             add_cell);
                     //               else if ( is_in_domain( prof->n_x , prof->n_y , i , add_index ) )
                     else
-                        sed_column_top(sed_cube_col_ij(prof, i, remove_index),
+                        sed_column_top(sed_cube_peek_col_ij(prof, i, remove_index),
                             fabs(qy[i][j]),
                             add_cell);
 
@@ -900,7 +900,7 @@ diffuse_sediment_2(Sed_cube prof, double k_long_max,
                             add_cell);
                     //               else if ( is_in_domain( prof->n_x , prof->n_y , add_index , j ) )
                     else
-                        sed_column_top(sed_cube_col_ij(prof, remove_index, j),
+                        sed_column_top(sed_cube_peek_col_ij(prof, remove_index, j),
                             fabs(qx[i][j]),
                             add_cell);
 
@@ -63,7 +63,7 @@ decider(const Sed_cube p, double threshold)
         Sed_cell c    = sed_cell_new(n_grains);
 
         for (i = 0 ; i < sed_cube_n_y(p) ; i++) {
-            sed_column_top(sed_cube_col(p, i), sed_cube_thickness(p, 0, i), c);
+            sed_column_top(sed_cube_peek_col(p, i), sed_cube_thickness(p, 0, i), c);
             sed_cell_add(fail, c);
         }
 
@@ -130,7 +130,7 @@ get_janbu_parameters(const Sed_cube p,
 
     for (i = 0, volume = 0.; i < len; i++) {
 
-        this_col = sed_cube_col(p, i);
+        this_col = sed_cube_peek_col(p, i);
 
         if (sed_column_len(this_col) > 0) {
             hydro_static = sed_column_water_pressure(this_col);
@@ -52,7 +52,7 @@ get_failure_surface(const Sed_cube p, int start, int len)
     */
 
     // if there is no sediment in the first column, return null.
-    if (sed_column_thickness(sed_cube_col(p, start)) < 1e-5) {
+    if (sed_column_thickness(sed_cube_peek_col(p, start)) < 1e-5) {
         return NULL;
     }
 
@@ -592,7 +592,7 @@ init_column(gpointer data, gpointer user_data)
     Fail_column** slice  = ((Init_failure_t*)user_data)->slice;
 
     slice[i] = fail_reinit_fail_column(slice[i],
-            sed_cube_col(p, i),
+            sed_cube_peek_col(p, i),
             failure_line[i],
             fail_const);
 
@@ -772,7 +772,7 @@ fail_update_fail_profile(Fail_profile* p)
     for (i = 0 ; i < p->size ; i++) {
 
         f_col = p->col[i];
-        s_col = sed_cube_col(p->p, i);
+        s_col = sed_cube_peek_col(p->p, i);
 
         if (f_col->size > 0) {
             fail_col_h = f_col->height[f_col->size - 1];
@@ -253,7 +253,7 @@ muddy(Sed_cube prof, Sed_cell* in_suspension_cell, double* wave, double duration
             else if (u_wave[i] > u_wave_critical && extra < 0 && EROSION_IS_ON) {
                 extra *= -1.;
 
-                max_erode_depth = sed_column_depth_age(sed_cube_col(prof, i),
+                max_erode_depth = sed_column_depth_age(sed_cube_peek_col(prof, i),
                         sed_cube_age(prof)
                         - ERODE_DEPTH_IN_YEARS);
                 //            max_erode_depth = .25;
@@ -227,7 +227,7 @@ main(int argc, char* argv[])
     for (i = 0; i < sed_cube_n_y(prof); i++)
         fprintf(stdout, "%f , %f\n",
             sed_cube_col_y(prof, i),
-            sed_column_thickness(sed_cube_col(prof, i)));
+            sed_column_thickness(sed_cube_peek_col(prof, i)));
 
     // write out the cube
     sed_fp = sed_property_file_new("output.grain", grain_size, NULL);
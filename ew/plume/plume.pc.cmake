@@ -1,7 +1,7 @@
 Name: LibPlume
 Description: Plume BMI library
 Version: ${PLUME_VERSION}
-Requires: glib-2.0 >= 2.25, utils, sed
+Requires: glib-2.0 >= 2.32, utils, sed
 Libs: -L${CMAKE_INSTALL_PREFIX}/lib -lbmi_plume
 Cflags: -I${CMAKE_INSTALL_PREFIX}/include/ew-2.0 -I${CMAKE_INSTALL_PREFIX}/include
 
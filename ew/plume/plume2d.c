@@ -34,29 +34,56 @@ plume3d(Plume_inputs* plume_const, Plume_river river,
     int n_grains, Plume_sediment* sedload,
     Eh_dbl_grid* deposit, Plume_data* data);
 
+//---
+// A Plume_data holds the plume grids along with a workspace.  The grids and
+// the workspace only ever grow, and are reused from one call to the next, so
+// that once the plume has been run for its largest domain it no longer needs
+// to allocate memory.  A Plume_data should be kept for as long as the plume
+// is run (by the plume process, say) rather than created for each call.
+//---
 Plume_data*
 plume_data_init(Plume_data* data)
 {
+    int n;
+
     data->x_len = 0;
     data->y_len = 0;
+    data->z_len = 0;
+    data->pc_len = 0;
     data->ccnc  = NULL;
     data->ncnc  = NULL;
     data->deps  = NULL;
     data->dist  = NULL;
     data->ualb  = NULL;
     data->pcent = NULL;
+    data->sln   = NULL;
     data->xval  = NULL;
     data->yval  = NULL;
+    data->xwid  = NULL;
+    data->x_ratio = 1.;
+    data->dx_max  = 0.;
+    data->work  = NULL;
+    data->work_len = 0;
+    data->out_grid = NULL;
+
+    for (n = 0 ; n < 4 ; n++) {
+        data->pct[n]     = NULL;
+        data->pct_len[n] = 0;
+    }
 
     return data;
 }
 
+/* Free the grids and workspace of a Plume_data but not the Plume_data itself. */
 void
-destroy_plume_data(Plume_data* grid)
+plume_data_free(Plume_data* grid)
 {
     if (grid) {
+        int n;
+
         eh_free(grid->xval);
         eh_free(grid->yval);
+        eh_free(grid->xwid);
 
         free_d3tensor(grid->ccnc);
         free_d3tensor(grid->ncnc);
@@ -64,11 +91,60 @@ destroy_plume_data(Plume_data* grid)
         free_d3tensor(grid->dist);
         free_dmatrix(grid->ualb);
         free_dmatrix(grid->pcent);
+        free_dmatrix(grid->sln);
+
+        for (n = 0 ; n < 4 ; n++) {
+            free_dmatrix(grid->pct[n]);
+        }
+
+        eh_free(grid->work);
 
+        if (grid->out_grid) {
+            eh_grid_destroy((Eh_dbl_grid)grid->out_grid, TRUE);
+        }
+
+        plume_data_init(grid);
+    }
+}
+
+void
+destroy_plume_data(Plume_data* grid)
+{
+    if (grid) {
+        plume_data_free(grid);
         eh_free(grid);
     }
 }
 
+/* Scratch space of at least len doubles.  Its contents are not preserved
+   between calls. */
+double*
+plume_data_work(Plume_data* grid, long len)
+{
+    if (len > grid->work_len) {
+        eh_free(grid->work);
+        grid->work     = eh_new(double, len);
+        grid->work_len = len;
+    }
+
+    return grid->work;
+}
+
+/* The n-th centerline scratch matrix, with at least n_rows rows of 2. */
+double**
+plume_data_pct(Plume_data* grid, int n, long n_rows)
+{
+    eh_require(n >= 0 && n < 4);
+
+    if (n_rows > grid->pct_len[n]) {
+        free_dmatrix(grid->pct[n]);
+        grid->pct[n]     = new_dmatrix(n_rows, 2);
+        grid->pct_len[n] = n_rows;
+    }
+
+    return grid->pct[n];
+}
+
 gboolean
 plume2d(Plume_inputs* plume_const, Plume_river river,
     int n_grains, Plume_sediment* sedload,
@@ -217,6 +293,11 @@ plume3d(Plume_inputs* plume_const, Plume_river river,
     grid->max_len = eh_grid_y(deposit[0])[eh_grid_n_y(deposit[0]) - 1]
         - eh_grid_y(deposit[0])[0];
 
+    // The plume is not resolved more coarsely than the deposit grid.
+    if (eh_grid_n_y(deposit[0]) > 1) {
+        grid->dx_max = fabs(eh_grid_y(deposit[0])[1] - eh_grid_y(deposit[0])[0]);
+    }
+
     opt.fjrd = 0;
     opt.strt = 0;
     opt.kwf  = 1;
@@ -197,13 +197,12 @@ plume_wrapper(Sed_hydro r, Plume_param_st* p, gint* len, gint* n_grains)
 
         eh_message("Set plume grid");
         { /* Set Plume_grid structure */
+            plume_data_init(&grid);
             grid.ndy   =  p->river_mouth_nodes;
             grid.ndx   =  p->aspect_ratio;
             grid.ymin  = -p->basin_width * .5;
             grid.ymax  =  p->basin_width * .5;
             grid.max_len = p->basin_len;
-            grid.x_len = 0;
-            grid.y_len = 0;
         }
 
         eh_message("Set plume options");
@@ -229,6 +228,8 @@ plume_wrapper(Sed_hydro r, Plume_param_st* p, gint* len, gint* n_grains)
 
         plume_output_3(&env, &grid, g, p->rotate);
 
+        plume_data_free(&grid);
+
     }
 
     return g;
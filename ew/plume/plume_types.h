@@ -118,6 +118,21 @@ typedef struct {
     int x_len;
     int ndy;
     int ndx;
+
+    // cross-shore grid spacing grows by x_ratio from one row to the next
+    // beyond the near field, up to dx_max (straight plumes only)
+    double x_ratio;
+    double dx_max;
+    double* xwid;      // cross-shore width of each row of cells
+
+    // workspace that is kept between calls (see plume_data_init)
+    int z_len;         // number of grains allocated for ccnc, ncnc, deps
+    int pc_len;        // number of rows allocated for pcent
+    double* work;      // scratch space
+    long work_len;     // length of the scratch space
+    double** pct[4];   // centerline scratch matrices (n by 2)
+    long pct_len[4];   // number of rows allocated for each of pct
+    void* out_grid;    // Eh_dbl_grid used to remap the deposit
 }
 Plume_grid;
 
@@ -89,6 +89,59 @@
 //    ocean.v0
 //---
 
+//---
+// Cross-shore positions of the rows of a stretched grid.  Rows are dx apart
+// out to x_near, beyond which the spacing grows by a factor of x_ratio from
+// one row to the next until it reaches dx_max.  The last row is the first
+// one beyond x_end.  If xval is non-NULL, the positions and widths of the
+// rows are stored in xval and xwid.
+//
+// Returns the number of rows.
+//---
+static int
+_plume_array_stretched_x(const Plume_grid* grid, double x_near, double x_end,
+    double* xval, double* xwid)
+{
+    int n;
+    double x = grid->xmin;
+    double h = grid->dx;
+
+    for (n = 0 ; ; n++) {
+        if (xval) {
+            xval[n] = x;
+        }
+
+        if (x > x_end) {
+            break;
+        }
+
+        if (x >= x_near) {
+            h = mn(h * grid->x_ratio, grid->dx_max);
+        }
+
+        x += h;
+    }
+
+    n++;
+
+    if (xwid) {
+        int ii;
+
+        if (n == 1) {
+            xwid[0] = grid->dx;
+        } else {
+            xwid[0]     = xval[1] - xval[0];
+            xwid[n - 1] = xval[n - 1] - xval[n - 2];
+
+            for (ii = 1 ; ii < n - 1 ; ii++) {
+                xwid[ii] = .5 * (xval[ii + 1] - xval[ii - 1]);
+            }
+        }
+    }
+
+    return n;
+}
+
 //---
 // Start of PlumeArray
 //---
@@ -98,7 +151,10 @@ plumearray(Plume_grid* grid, Plume_enviro* env, Plume_options* opt)
     static int reuse_count = 0;
     static int new_count = 0;
     int  ii, jj, kk, l1, endi;
-    int x_size, y_size;
+    gboolean is_stretched;
+    double x_near = 0;
+    double x_end = 0;
+    int x_size, y_size, z_size;
     double aa, AA, avo, mxcs, mnlm, Li, nv, tst, xend, yend, zend;
     double* dcl, *xcl, *ycl;
     int n_grains = env->n_grains;
@@ -167,13 +223,9 @@ plumearray(Plume_grid* grid, Plume_enviro* env, Plume_options* opt)
         // Allocate centerline arrays
         l1    = (int)rnd(1.1 * zend / grid->dy);
 
-        if ((xcl = (double*) calloc(l1, sizeof(double))) == NULL ||
-            (ycl = (double*) calloc(l1, sizeof(double))) == NULL ||
-            (dcl = (double*) calloc(l1, sizeof(double))) == NULL) {
-            fprintf(stderr, " PlumeArray ERROR: memory allocation failed \n");
-            fprintf(stderr, "                failed on xcl, ycl, dcl \n");
-            return 1;
-        }
+        xcl   = plume_data_work(grid, 3 * l1);
+        ycl   = xcl + l1;
+        dcl   = ycl + l1;
 
         // Find the jet position and distance along the jet
         xcl[0] = ycl[0] = dcl[0] = 0.0;
@@ -200,11 +252,6 @@ plumearray(Plume_grid* grid, Plume_enviro* env, Plume_options* opt)
         xend = xcl[endi];
         yend = ycl[endi];
 
-        // free up local allocated memory
-        free(xcl);
-        free(ycl);
-        free(dcl);
-
         if (yend > 1.5 * xend) {
             /* (3) Ocean plume, with upwelling, strong vo indicated by vo~=0, kwf=0, yend>1.5*xend */
             grid->xmax = rnd(xend + Li);
@@ -241,8 +288,6 @@ plumearray(Plume_grid* grid, Plume_enviro* env, Plume_options* opt)
         } // end 3)
     } // end of Upwelling Conditons
 
-    eh_info("Increased grid size!");
-
     if (fabs(grid->ymin) > grid->ymax) {
         grid->ymax =  fabs(grid->ymin);
     }
@@ -258,6 +303,31 @@ plumearray(Plume_grid* grid, Plume_enviro* env, Plume_options* opt)
     grid->ymin = rnd(floor(grid->ymin / (int)(grid->dy)) * (int)(grid->dy));
     grid->lx = (int)(((grid->xmax - grid->xmin) / (int)(grid->dx)) + 2);
     grid->ly = (int)(((grid->ymax - grid->ymin) / (int)(grid->dy)) + 2);
+
+    //---
+    // Straight plumes can be coarsened in the far field.  The near field
+    // extends past the zone of flow establishment to where the inventory
+    // of the most rapidly removed grain has fallen by a factor of e (as for
+    // zend, but with the largest lambda).  Beyond that the deposit varies
+    // slowly and the grid spacing is allowed to grow.
+    //---
+    is_stretched = (opt->fjrd || opt->strt)
+        && grid->x_ratio > 1.
+        && grid->dx_max > grid->dx;
+
+    if (is_stretched) {
+        double mxlm = sedload[0].lambda;
+
+        for (ii = 0; ii < n_grains; ii++) {
+            mxlm = mx(mxlm, sedload[ii].lambda);
+        }
+
+        x_near = pow((river->u0 / mxlm) * sqrt(river->b0 / (sqpi * C1)), (2.0 / 3.0));
+        x_near = mx(x_near, plg * river->b0);
+
+        x_end    = grid->xmax;
+        grid->lx = _plume_array_stretched_x(grid, x_near, x_end, NULL, NULL);
+    }
     grid->lz = n_grains;
     /*
        if( (xval = (double *) calloc(grid->lx,sizeof(double))) == NULL ||
@@ -285,52 +355,38 @@ plumearray(Plume_grid* grid, Plume_enviro* env, Plume_options* opt)
     // Increase lpc.  Sometimes it is not large enough to store the entrie grid.
     grid->lpc *= 10;
 
-    if (grid->lx > grid->x_len || grid->ly > grid->y_len || TRUE) {
+    x_size = mx(grid->lx, grid->x_len);
+    y_size = mx(grid->ly, grid->y_len);
+    z_size = mx(n_grains, grid->z_len);
 
-        new_count++;
-
-        if (grid->x_len != 0 || grid->y_len != 0) {
-            eh_free(grid->xval);
-            eh_free(grid->yval);
-
-            free_d3tensor(grid->ccnc);
-            free_d3tensor(grid->ncnc);
-            free_d3tensor(grid->deps);
-            free_d3tensor(grid->dist);
-            free_dmatrix(grid->ualb);
-            free_dmatrix(grid->pcent);
-        }
-
-        if (grid->lx > grid->x_len) {
-            grid->x_len = grid->lx;
-        }
-
-        if (grid->ly > grid->y_len) {
-            grid->y_len = grid->ly;
-        }
+    //---
+    // The grids are only reallocated if they are too small.  Otherwise the
+    // grids from the previous call are reused.
+    //---
+    if (x_size > grid->x_len || y_size > grid->y_len || z_size > grid->z_len) {
 
-        grid->xval = eh_new(double, grid->lx);
-        grid->yval = eh_new(double, grid->ly);
+        new_count++;
 
-        for (ii = 0 ; ii < grid->lx ; ii++) {
-            grid->xval[ii] = grid->xmin + ii * grid->dx;
-        }
+        eh_info("Increased grid size!");
 
-        for (ii = 0 ; ii < grid->ly ; ii++) {
-            grid->yval[ii] = grid->ymin + ii * grid->dy;
-        }
+        eh_free(grid->xval);
+        eh_free(grid->yval);
+        eh_free(grid->xwid);
 
-        y_size = grid->ly;
+        free_d3tensor(grid->ccnc);
+        free_d3tensor(grid->ncnc);
+        free_d3tensor(grid->deps);
+        free_d3tensor(grid->dist);
+        free_dmatrix(grid->ualb);
+        free_dmatrix(grid->sln);
 
-        if (y_size < grid->y_len) {
-            y_size = grid->y_len;
-        }
+        grid->x_len = x_size;
+        grid->y_len = y_size;
+        grid->z_len = z_size;
 
-        x_size = grid->lx;
-
-        if (x_size < grid->x_len) {
-            x_size = grid->x_len;
-        }
+        grid->xval = eh_new(double, x_size);
+        grid->yval = eh_new(double, y_size);
+        grid->xwid = eh_new(double, x_size);
 
         // Create remaining arrays (i,j = cross-shore, along-shore)
         // ccnc  : Conservative Cs (kg/m^3)
@@ -338,24 +394,45 @@ plumearray(Plume_grid* grid, Plume_enviro* env, Plume_options* opt)
         // deps  : Deposit thickness (kg/m^3)
         // dist  : Information relating to closest centerline point
         // ualb  : Albertson velocities (m/s)
-        // pcent : Deflected centerline information
-        grid->ccnc  = new_d3tensor(x_size, y_size, n_grains);
-        grid->ncnc  = new_d3tensor(x_size, y_size, n_grains);
-        grid->deps  = new_d3tensor(x_size, y_size, n_grains);
+        grid->ccnc  = new_d3tensor(x_size, y_size, z_size);
+        grid->ncnc  = new_d3tensor(x_size, y_size, z_size);
+        grid->deps  = new_d3tensor(x_size, y_size, z_size);
         grid->dist  = new_d3tensor(x_size, y_size, 5);
         grid->ualb  = new_dmatrix(x_size, y_size);
-        grid->pcent = new_dmatrix(grid->lpc, 4);
-
-        if (opt->o1) {
-            // sln  : Conservative tracer concentration
-            grid->sln = new_dmatrix(x_size, y_size);
-        }
+        grid->sln   = NULL;
     } else {
         reuse_count++;
     }
 
-    for (ii = 0 ; ii < grid->x_len ; ii++)
-        for (jj = 0 ; jj < grid->y_len ; jj++) {
+    // sln  : Conservative tracer concentration
+    if (opt->o1 && !grid->sln) {
+        grid->sln = new_dmatrix(grid->x_len, grid->y_len);
+    }
+
+    // pcent : Deflected centerline information
+    if (grid->lpc > grid->pc_len) {
+        free_dmatrix(grid->pcent);
+
+        grid->pcent  = new_dmatrix(grid->lpc, 4);
+        grid->pc_len = grid->lpc;
+    }
+
+    if (is_stretched) {
+        _plume_array_stretched_x(grid, x_near, x_end, grid->xval, grid->xwid);
+        grid->xmax = grid->xval[grid->lx - 1];
+    } else {
+        for (ii = 0 ; ii < grid->lx ; ii++) {
+            grid->xval[ii] = grid->xmin + ii * grid->dx;
+            grid->xwid[ii] = grid->dx;
+        }
+    }
+
+    for (ii = 0 ; ii < grid->ly ; ii++) {
+        grid->yval[ii] = grid->ymin + ii * grid->dy;
+    }
+
+    for (ii = 0 ; ii < grid->lx ; ii++)
+        for (jj = 0 ; jj < grid->ly ; jj++) {
             for (kk = 0 ; kk < n_grains ; kk++) {
                 grid->ccnc[ii][jj][kk] = 0.;
                 grid->ncnc[ii][jj][kk] = 0.;
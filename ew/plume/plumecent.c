@@ -114,10 +114,10 @@ plumecent(Plume_enviro* env, Plume_grid* grid, Plume_options* opt)
 #ifdef DBG
         fprintf(stderr, "  PlumeCent: Allocating pct matrices \n");
 #endif
-        pct0 = new_dmatrix(ll, 2);
-        pct1 = new_dmatrix(ll, 2);
-        pct2 = new_dmatrix(ll, 2);
-        pct3 = new_dmatrix(grid->lpc, 2);
+        pct0 = plume_data_pct(grid, 0, ll);
+        pct1 = plume_data_pct(grid, 1, ll);
+        pct2 = plume_data_pct(grid, 2, ll);
+        pct3 = plume_data_pct(grid, 3, grid->lpc);
 #ifdef DBG
         fprintf(stderr, "          finished Allocation \n");
 #endif
@@ -441,12 +441,6 @@ plumecent(Plume_enviro* env, Plume_grid* grid, Plume_options* opt)
             }
         }
 
-        // Free up allocated memory
-        free_dmatrix(pct0);
-        free_dmatrix(pct1);
-        free_dmatrix(pct2);
-        free_dmatrix(pct3);
-
     } // end ifelse( fjrd || strt )
 
 #ifdef DBG
@@ -31,138 +31,247 @@
 #include <math.h>
 #include <utils/utils.h>
 
-int
-plumeconc(Plume_enviro* env, Plume_grid* grid, Plume_options* opt)
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//---
+// The Albertson solution is separated into a part that depends only on the
+// position of a cell and a part that depends on the grain.  For a cell, the
+// velocity and the conservative concentration of every grain share the
+// same shape,
+//
+//   ualb = u0 * shape_a * shape_b + ucor
+//   ccnc = Cs * shape_a * shape_b + ccor
+//
+// so the transcendental functions of the shape are evaluated once per cell
+// rather than once per cell and grain.  The shape of a row of cells is held
+// in contiguous arrays so that the per-grain loops run over unit-stride,
+// branch-free data.  The operations, and their order, are those of the
+// cell-by-cell evaluation so that the results are identical to it.
+//---
+typedef struct {
+    double* shape_a; // sqrt(b0/(sqrt(pi)*C1*x)) or exp of the plug edge
+    double* shape_b; // exp(-(y/(sqrt(2)*C1*x))^2), or 1
+    double* ualb; // Albertson velocity
+    double* xx; // Distance from the river mouth
+    double* uu; // Velocity used to scale time
+    double* ccnc; // Conservative concentration of one grain
+    double* ncnc; // Non-conservative concentration of one grain
+    double* deps; // Deposit thickness of one grain
+}
+Plume_conc_row;
+
+#define PLUME_CONC_ROW_N_ARRAYS (8)
+
+// Divide PLUME_CONC_ROW_N_ARRAYS*ly doubles of work space among the arrays.
+static void
+_plume_conc_row_init(Plume_conc_row* row, double* work, int ly)
+{
+    row->shape_a = work;
+    row->shape_b = work + ly;
+    row->ualb    = work + 2 * ly;
+    row->xx      = work + 3 * ly;
+    row->uu      = work + 4 * ly;
+    row->ccnc    = work + 5 * ly;
+    row->ncnc    = work + 6 * ly;
+    row->deps    = work + 7 * ly;
+}
+
+//---
+// Calculate the concentrations and deposit thicknesses of row ii for all
+// grains.
+//---
+static void
+_plume_conc_row(Plume_conc_row* row, int ii, Plume_enviro* env,
+    Plume_grid* grid, Plume_options* opt)
 {
-    int ii, jj, nn;
-    double aa, bb, ucor, *ccor, plugwidth;
-    double dl, utest, uu, XX, v1, v2;
-    Plume_river river = *(env->river);
-    Plume_ocean ocean = *(env->ocean);
-    Plume_sediment* sedload = env->sed;
-    //   double erfc(double);
+    int jj, nn;
+    double aa, bb, ucor, ccor;
+    const Plume_river river = *(env->river);
+    const Plume_ocean ocean = *(env->ocean);
+    const Plume_sediment* sedload = env->sed;
+    const int ly = grid->ly;
+    const double utest = 0.05 * river.u0;
+    const double dl = 0.5 * (double)(grid->xwid[ii] + grid->dy); // Average grid length
+    double** dist = grid->dist[ii];
+    double* restrict shape_a = row->shape_a;
+    double* restrict shape_b = row->shape_b;
+    double* restrict ualb = row->ualb;
+    double* restrict xx = row->xx;
+    double* restrict uu = row->uu;
+    double* restrict ccnc = row->ccnc;
+    double* restrict ncnc = row->ncnc;
+    double* restrict deps = row->deps;
 
     //---
-    // Set the minimum velocity cutoff used in the following calculations
-    // The value chosen reduces mass balance errors at the edges of the plume
+    // Mass and Velocity Corrections for flow out of the edges of a Fjord
     //---
-    utest  = 0.05 * river.u0;
-    dl     = 0.5 * (double)(grid->dx + grid->dy); // Average grid length
-
-    // Allocate memory for the concentration correction
-    if ((ccor = (double*) calloc(env->n_grains, sizeof(double))) == NULL) {
-        fprintf(stderr, " PlumeArray ERROR: memory allocation failed \n");
-        fprintf(stderr, "                failed on xcl, ycl, dcl \n");
-        eh_exit(1);
+    if (opt->fjrd && grid->xval[ii] > 0) {
+        aa = sqrt(river.b0 / (sqpi * C1 * grid->xval[ii]));
+        bb = 1 / (sqtwo * C1 * grid->xval[ii]);
+
+        ucor = 2.*river.u0 * aa * aa * erfc(bb * 0.5 * (grid->ymax - grid->ymin)) / ((
+                    grid->ymax - grid->ymin) * bb);
+    } else {
+        aa   = 0;
+        bb   = 0;
+        ucor = 0;
     }
 
-    for (nn = 0 ; nn < env->n_grains ; nn++) {
+    // Shape of the solution, common to all grains
+    for (jj = 0 ; jj < ly ; jj++) {
+        const double x = dist[jj][2];
+        const double y = dist[jj][3];
+        double v1, v2;
+
+        if (x < plg * river.b0) { // 'zone of flow establishment'
+            const double plugwidth = -x / (2.*plg) + river.b0 / 2.;
 
+            if (y < plugwidth) {
+                shape_a[jj] = 1.;
+            } else {
+                v1 = y + 0.5 * sqpi * C1 * x - river.b0 / 2.;
+                v2 = mx((sqtwo * C1 * x), 0.01);
+
+                shape_a[jj] = exp(-sq(v1 / v2));
+            }
+
+            shape_b[jj] = 1.;
+        } else { // 'zone of established flow'
+            v1 = river.b0 / (sqpi * C1 * x);
+            v2 = y / (sqtwo * C1 * x);
+
+            shape_a[jj] = sqrt(v1);
+            shape_b[jj] = exp(-sq(v2));
+        }
+    }
+
+    for (jj = 0 ; jj < ly ; jj++) {
+        ualb[jj] = river.u0 * shape_a[jj] * shape_b[jj] + ucor;
+    }
+
+    // scale surface concentration by: t = x/u
+    if (opt->fjrd) {
+        for (jj = 0 ; jj < ly ; jj++) {
+            uu[jj] = (river.u0 + dist[jj][4] + 7.*ualb[jj]) / 9.;
+        }
+    } else {
+        for (jj = 0 ; jj < ly ; jj++) {
+            uu[jj] = (river.u0 + dist[jj][4] + 3.*ualb[jj]) / 5.;
+        }
+    }
+
+    for (jj = 0 ; jj < ly ; jj++) {
+        xx[jj] = sqrt(sq(dist[jj][2]) + sq(dist[jj][3]));
+    }
+
+    for (jj = 0 ; jj < ly ; jj++) {
+        grid->ualb[ii][jj] = ualb[jj];
+    }
+
+    for (nn = 0 ; nn < env->n_grains ; nn++) {
         if (river.Cs[nn] > .001) {
+            const double cs = river.Cs[nn];
+            const double lambda = sedload[nn].lambda;
+            const double rho = sedload[nn].rho;
 
-            for (ii = 0 ; ii < grid->lx ; ii++) {
+            if (opt->fjrd && grid->xval[ii] > 0) {
+                ccor = 2.*cs * aa * aa * erfc(bb * 0.5 * (grid->ymax - grid->ymin)) / ((
+                            grid->ymax - grid->ymin) * bb);
+            } else {
+                ccor = 0;
+            }
 
-#ifdef DBG
-                fprintf(stderr,
-                    "\r  PlumeConc  ii = %d, lx = %d, ly = %d, nn = %d, ngrains = %d    ",
-                    ii + 1, grid->lx, grid->ly, nn + 1, env->n_grains);
-#endif
+            for (jj = 0 ; jj < ly ; jj++) {
+                ccnc[jj] = cs * shape_a[jj] * shape_b[jj] + ccor;
+            }
+
+            // Calculate Non-conservative Concentration
+            for (jj = 0 ; jj < ly ; jj++) {
+                ncnc[jj] = (ualb[jj] > utest) ?
+                    ccnc[jj] * exp(-lambda * xx[jj] / uu[jj]) + ocean.Cw :
+                    ocean.Cw;
+            }
 
-                //---
-                // Mass and Velocity Corrections for flow out of the edges
-                // of a Fjord
-                //---
-                if (opt->fjrd && grid->xval[ii] > 0) {
-                    aa = sqrt(river.b0 / (sqpi * C1 * grid->xval[ii]));
-                    bb = 1 / (sqtwo * C1 * grid->xval[ii]);
-
-                    ucor = 2.*river.u0 * aa * aa * erfc(bb * 0.5 * (grid->ymax - grid->ymin)) / ((
-                                grid->ymax - grid->ymin) * bb);
-                    ccor[nn] = 2.*river.Cs[nn] * aa * aa * erfc(bb * 0.5 * (grid->ymax - grid->ymin)) / ((
-                                grid->ymax - grid->ymin) * bb);
-                } else {
-                    ucor     = 0;
-                    ccor[nn] = 0;
-                }
-
-                for (jj = 0 ; jj < grid->ly ; jj++) {
-                    // 'zone of flow establishment'
-                    if (grid->dist[ii][jj][2] < plg * river.b0) {
-
-                        plugwidth  = -grid->dist[ii][jj][2] / (2.*plg) + river.b0 / 2.;
-
-                        if (grid->dist[ii][jj][3] < plugwidth) {
-                            grid->ccnc[ii][jj][nn] = river.Cs[nn] + ccor[nn];
-                            grid->ualb[ii][jj]     = river.u0 + ucor;
-                        } else {
-                            v1 = grid->dist[ii][jj][3]
-                                + 0.5 * sqpi * C1 * grid->dist[ii][jj][2]
-                                - river.b0 / 2.;
-                            v2 = mx((sqtwo * C1 * grid->dist[ii][jj][2]), 0.01);
-
-                            grid->ccnc[ii][jj][nn] = river.Cs[nn] * exp(-sq(v1 / v2)) + ccor[nn];
-                            grid->ualb[ii][jj]     = river.u0 * exp(-sq(v1 / v2)) + ucor;
-                        }
-                    } else { // 'zone of established flow'
-                        v1 = river.b0 / (sqpi * C1 * grid->dist[ii][jj][2]);
-                        v2 = grid->dist[ii][jj][3] / (sqtwo * C1 * grid->dist[ii][jj][2]);
-
-                        grid->ccnc[ii][jj][nn] = river.Cs[nn] * sqrt(v1) * exp(-sq(v2))
-                            + ccor[nn];
-                        grid->ualb[ii][jj] = river.u0 * sqrt(v1) * exp(-sq(v2)) + ucor;
-                    }
-
-                    // scale surface concentration by: t = x/u
-                    if (opt->fjrd) {
-                        uu = (river.u0 + grid->dist[ii][jj][4] + 7.*grid->ualb[ii][jj]) / 9.;
-                    } else {
-                        uu = (river.u0 + grid->dist[ii][jj][4] + 3.*grid->ualb[ii][jj]) / 5.;
-                    }
-
-                    XX = sqrt(sq(grid->dist[ii][jj][2]) + sq(grid->dist[ii][jj][3]));
-
-                    // Calculate Non-conservative Concentration
-                    if (grid->ualb[ii][jj] > utest)
-                        grid->ncnc[ii][jj][nn] = grid->ccnc[ii][jj][nn]
-                            * exp(-sedload[nn].lambda * XX / uu)
-                            + ocean.Cw;
-                    else {
-                        grid->ncnc[ii][jj][nn] = ocean.Cw;
-                    }
-
-                    //---
-                    // Calculate Deposit Thickness, scale time by local u and local x
-                    //  C do 1/rho => kg/m^3 m m^3/kg => m (~/dt)
-                    //  Vol/Area = do
-                    //  dt/day => dTOs*u/l  => (#ofs/day)*1/(#ofs/dt) => dt/day
-                    //  m/dt * dt/day => m (~/day)
-                    //---
-                    if (grid->ncnc[ii][jj][nn] > ocean.Cw
-                        && grid->ualb[ii][jj] > utest) {
-                        grid->deps[ii][jj][nn] = grid->ncnc[ii][jj][nn]
-                            * (exp(sedload[nn].lambda * dl / grid->ualb[ii][jj]) - 1.)
-                            * (river.d0 * dTOs * grid->ualb[ii][jj])
-                            / (sedload[nn].rho * dl);
-                    } else {
-                        grid->deps[ii][jj][nn] = 0.0;
-                    }
-
-                    // Calculate the concentration of a conservative tracer (like Salinity)
-                    if (opt->o1)
-                        grid->sln[ii][jj] = (ocean.Sw - ocean.So)
-                            * (1 - grid->ccnc[ii][jj][0] / (river.Cs[0] - ocean.Cw))
-                            + ocean.So;
-                }
+            //---
+            // Calculate Deposit Thickness, scale time by local u and local x
+            //  C do 1/rho => kg/m^3 m m^3/kg => m (~/dt)
+            //  Vol/Area = do
+            //  dt/day => dTOs*u/l  => (#ofs/day)*1/(#ofs/dt) => dt/day
+            //  m/dt * dt/day => m (~/day)
+            //---
+            for (jj = 0 ; jj < ly ; jj++) {
+                deps[jj] = (ncnc[jj] > ocean.Cw && ualb[jj] > utest) ?
+                    ncnc[jj] * (exp(lambda * dl / ualb[jj]) - 1.)
+                    * (river.d0 * dTOs * ualb[jj]) / (rho * dl) :
+                    0.0;
             }
+
+            for (jj = 0 ; jj < ly ; jj++) {
+                grid->ccnc[ii][jj][nn] = ccnc[jj];
+                grid->ncnc[ii][jj][nn] = ncnc[jj];
+                grid->deps[ii][jj][nn] = deps[jj];
+            }
+        }
+    }
+
+    // Calculate the concentration of a conservative tracer (like Salinity)
+    if (opt->o1)
+        for (jj = 0 ; jj < ly ; jj++)
+            grid->sln[ii][jj] = (ocean.Sw - ocean.So)
+                * (1 - grid->ccnc[ii][jj][0] / (river.Cs[0] - ocean.Cw))
+                + ocean.So;
+}
+
+int
+plumeconc(Plume_enviro* env, Plume_grid* grid, Plume_options* opt)
+{
+    int nn;
+    int n_active = 0;
+
+    for (nn = 0 ; nn < env->n_grains ; nn++) {
+        if (env->river->Cs[nn] > .001) {
+            n_active++;
         }
     }
 
-    free(ccor);
+    //---
+    // Rows are independent of one another and so are divided among threads.
+    // Each thread has its own part of the plume workspace for its rows.
+    //---
+    if (n_active > 0) {
+        int n_threads = 1;
+        double* work;
+
+#ifdef _OPENMP
+        n_threads = omp_get_max_threads();
+#endif
+
+        work = plume_data_work(grid,
+                (long)n_threads * PLUME_CONC_ROW_N_ARRAYS * grid->ly);
 
-#ifdef DBG
-    fprintf(stderr, "\n");
+        #pragma omp parallel num_threads(n_threads)
+        {
+            int ii;
+            int thread = 0;
+            Plume_conc_row row;
+
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
 #endif
 
+            _plume_conc_row_init(&row,
+                work + (long)thread * PLUME_CONC_ROW_N_ARRAYS * grid->ly, grid->ly);
+
+            #pragma omp for schedule(static)
+
+            for (ii = 0 ; ii < grid->lx ; ii++) {
+                _plume_conc_row(&row, ii, env, grid, opt);
+            }
+        }
+    }
+
     return 0;
 
 } // end of PlumeConc
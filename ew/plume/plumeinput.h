@@ -134,7 +134,10 @@ gint plumeout3(Plume_enviro* env, Plume_grid* grid, Eh_dbl_grid* deposit_grid);
 int plumelog(Plume_enviro*, Plume_grid*, Plume_options*, Plume_mass_bal*);
 
 Plume_data* plume_data_init(Plume_data*);
+void plume_data_free(Plume_data*);
 void destroy_plume_data(Plume_data*);
+double* plume_data_work(Plume_data*, long len);
+double** plume_data_pct(Plume_data*, int n, long n_rows);
 
 Eh_dbl_grid* plume_grid_to_dbl_grid(Plume_grid* g, const gint n_grains);
 
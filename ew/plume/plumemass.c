@@ -53,8 +53,12 @@ plumemass(Plume_enviro* env, Plume_grid* grid, Plume_mass_bal* mb)
     Plume_river river = *(env->river);
     Plume_sediment* sedload = env->sed;
 
-    mass_in  = eh_new0(double, env->n_grains);
-    mass_out = eh_new0(double, env->n_grains);
+    mass_in  = plume_data_work(grid, 2 * env->n_grains);
+    mass_out = mass_in + env->n_grains;
+
+    for (nn = 0 ; nn < 2 * env->n_grains ; nn++) {
+        mass_in[nn] = 0.;
+    }
 
     err = 0;
     mb->Qsr = 0.0;
@@ -130,7 +134,7 @@ plumemass(Plume_enviro* env, Plume_grid* grid, Plume_mass_bal* mb)
             for (nn = 0 ; nn < env->n_grains ; nn++)
                 mass_out[nn] += grid->deps[ii][jj][nn]
                     * sedload[nn].rho
-                    * grid->dx
+                    * grid->xwid[ii]
                     * grid->dy;
 
 #ifdef MASS_CHECK
@@ -223,9 +227,6 @@ plumemass(Plume_enviro* env, Plume_grid* grid, Plume_mass_bal* mb)
         mass_out[nn] = 0;
     }
 
-    eh_free(mass_in);
-    eh_free(mass_out);
-
     return (err);
 
 } // end of PlumeMass
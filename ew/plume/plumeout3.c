@@ -94,8 +94,18 @@ plumeout3(Plume_enviro* env, Plume_grid* grid, Eh_dbl_grid* deposit_grid)
     //   1. along-shore
     //   2. cross-shore
     // Also, the interpolation function requires an Eh_dbl_grid as input.
+    //
+    // The grid is kept with the rest of the plume workspace and is resized
+    // to the current plume domain.
     //---
-    plume_grid = eh_grid_new(double, grid->ly, grid->lx);
+    if (!grid->out_grid) {
+        grid->out_grid = eh_grid_new(double, grid->ly, grid->lx);
+    } else if (eh_grid_n_x((Eh_dbl_grid)grid->out_grid) != grid->ly
+        || eh_grid_n_y((Eh_dbl_grid)grid->out_grid) != grid->lx) {
+        eh_grid_resize((Eh_dbl_grid)grid->out_grid, grid->ly, grid->lx);
+    }
+
+    plume_grid = (Eh_dbl_grid)grid->out_grid;
     memcpy(eh_grid_x(plume_grid), grid->yval, eh_grid_n_x(plume_grid)*sizeof(double));
     memcpy(eh_grid_y(plume_grid), grid->xval, eh_grid_n_y(plume_grid)*sizeof(double));
 
@@ -128,7 +138,11 @@ plumeout3(Plume_enviro* env, Plume_grid* grid, Eh_dbl_grid* deposit_grid)
 
             //      interpolate_2_bad_val( plume_grid , deposit_grid[nn] , 0 );
 
-            eh_dbl_grid_rebin_bad_val(plume_grid, deposit_grid[nn], 0);
+            // The scratch space comes from the plume workspace so that it
+            // isn't allocated for every grain of every river.
+            eh_dbl_grid_rebin_bad_val_work(plume_grid, deposit_grid[nn], 0,
+                plume_data_work(grid,
+                    eh_dbl_grid_rebin_work_len(plume_grid, deposit_grid[nn])));
             /*
             eh_watch_dbl( eh_grid_x(deposit_grid[nn])[0] );
             eh_watch_dbl( eh_grid_x(deposit_grid[nn])[1] );
@@ -177,6 +191,9 @@ plumeout3(Plume_enviro* env, Plume_grid* grid, Eh_dbl_grid* deposit_grid)
                 eh_require_not_reached();
             }
 
+        } else {
+            // The deposit grids may be reused from a previous call.
+            eh_dbl_grid_set(deposit_grid[nn], 0.);
         }
 
     }
@@ -191,8 +208,6 @@ plumeout3(Plume_enviro* env, Plume_grid* grid, Eh_dbl_grid* deposit_grid)
         }
     }
 
-    eh_grid_destroy(plume_grid, TRUE);
-
     return 0;
 }   // end of PlumeOut3
 
@@ -115,8 +115,7 @@ plumeread(FILE* fpin, Plume_enviro* env, Plume_grid* grid, Plume_options* opt)
     fgets(chs, 120, fpin);
     fscanf(fpin, "%lf", &grid->ymax);
     fgets(chs, 120, fpin);
-    grid->x_len = 0;
-    grid->y_len = 0;
+    plume_data_init(grid);
 
     /*
      *   debug and output option flags
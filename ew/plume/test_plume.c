@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <glib.h>
+
+#include <utils/utils.h>
+#include <sed/sed_sedflux.h>
+
+#include "plume_types.h"
+#include "plumeinput.h"
+
+gboolean
+plume3d(Plume_inputs* plume_const, Plume_river river,
+    int n_grains, Plume_sediment* sedload,
+    Eh_dbl_grid* deposit, Plume_data* data);
+
+#define N_GRAINS (4)
+#define N_X      (40)
+#define N_Y      (200)
+#define DX       (250.)
+
+static const double grain_lambda[N_GRAINS] = { 16.8, 9., 2.4, 3.2 };
+static const double grain_rho[N_GRAINS]    = { 1800., 1750., 1650., 1600. };
+
+/* Run a straight plume onto a grid of DX by DX cells and return the deposit
+   of each grain.  The plume grid is coarsened in the far field by x_ratio. */
+static Eh_dbl_grid*
+run_plume(double x_ratio, int* lx)
+{
+    Plume_inputs   plume_const;
+    Plume_river    river;
+    Plume_sediment sedload[N_GRAINS];
+    Plume_data     plume_data;
+    Eh_dbl_grid*   deposit = eh_new(Eh_dbl_grid, N_GRAINS);
+    gint           n;
+
+    plume_const.current_velocity    = 0.;
+    plume_const.ocean_concentration = 0.;
+    plume_const.plume_width         = 3000.;
+    plume_const.ndx                 = 1;
+    plume_const.ndy                 = 3;
+
+    river.Cs         = eh_new(double, N_GRAINS);
+    river.Cs[0]      = .071;
+    river.Cs[1]      = .071;
+    river.Cs[2]      = .089;
+    river.Cs[3]      = .124;
+    river.rdirection = G_PI_2;
+    river.u0         = 1.06;
+    river.b0         = 263.;
+    river.d0         = 8.3;
+    river.Q          = river.u0 * river.b0 * river.d0;
+    river.rma        = 0;
+
+    for (n = 0 ; n < N_GRAINS ; n++) {
+        sedload[n].lambda = grain_lambda[n] / S_SECONDS_PER_DAY;
+        sedload[n].rho    = grain_rho[n];
+
+        deposit[n] = eh_grid_new(double, N_X, N_Y);
+
+        eh_grid_set_x_lin(deposit[n], -.5 * N_X * DX, DX);
+        eh_grid_set_y_lin(deposit[n], 0, DX);
+    }
+
+    plume_data_init(&plume_data);
+    plume_data.x_ratio = x_ratio;
+
+    plume3d(&plume_const, river, N_GRAINS, sedload, deposit, &plume_data);
+
+    *lx = plume_data.lx;
+
+    plume_data_free(&plume_data);
+    eh_free(river.Cs);
+
+    return deposit;
+}
+
+static double
+deposit_mass(Eh_dbl_grid* deposit)
+{
+    double mass = 0;
+    gint   n;
+
+    for (n = 0 ; n < N_GRAINS ; n++) {
+        mass += eh_dbl_grid_sum(deposit[n]) * grain_rho[n] * DX * DX;
+    }
+
+    return mass;
+}
+
+static void
+deposit_destroy(Eh_dbl_grid* deposit)
+{
+    gint n;
+
+    for (n = 0 ; n < N_GRAINS ; n++) {
+        eh_grid_destroy(deposit[n], TRUE);
+    }
+
+    eh_free(deposit);
+}
+
+void
+test_far_field_coarsening(void)
+{
+    int          lx_fine, lx_coarse;
+    Eh_dbl_grid* fine   = run_plume(1., &lx_fine);
+    Eh_dbl_grid* coarse = run_plume(1.5, &lx_coarse);
+
+    // The far field of the plume is solved on fewer rows
+    g_assert_cmpint(lx_coarse, <, lx_fine);
+
+    // The same mass is deposited
+    g_assert(eh_compare_dbl(deposit_mass(coarse), deposit_mass(fine), 1e-6));
+
+    // Within the near field (the first two kilometers from the river mouth)
+    // the grids are the same, and the deposits agree along the plume axis
+    // and in total
+    {
+        const gint i_mid = N_X / 2;
+        gint       n, i, j;
+
+        for (n = 0 ; n < N_GRAINS ; n++) {
+            double near_fine   = 0;
+            double near_coarse = 0;
+
+            for (j = 0 ; j < 8 ; j++) {
+                const double d_fine   = eh_dbl_grid_val(fine[n], i_mid, j);
+                const double d_coarse = eh_dbl_grid_val(coarse[n], i_mid, j);
+
+                g_assert_cmpfloat(d_fine, >, 0.);
+                g_assert_cmpfloat(fabs(d_coarse - d_fine) / d_fine, <, .01);
+
+                for (i = 0 ; i < N_X ; i++) {
+                    near_fine   += eh_dbl_grid_val(fine[n], i, j);
+                    near_coarse += eh_dbl_grid_val(coarse[n], i, j);
+                }
+            }
+
+            g_assert_cmpfloat(fabs(near_coarse - near_fine) / near_fine, <, .01);
+        }
+    }
+
+    deposit_destroy(coarse);
+    deposit_destroy(fine);
+}
+
+int
+main(int argc, char* argv[])
+{
+    eh_init_glib();
+
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/plume/far_field_coarsening", &test_far_field_coarsening);
+
+    g_test_run();
+}
@@ -1,7 +1,7 @@
 Name: LibSed
 Description: Sedflux utility library
 Version: ${SEDFLUX_VERSION}
-Requires: glib-2.0 >= 2.25, utils
+Requires: glib-2.0 >= 2.32, utils
 Libs: -L${CMAKE_INSTALL_PREFIX}/lib -lsedflux
 Cflags: -I${CMAKE_INSTALL_PREFIX}/include/ew-2.0
 
@@ -625,6 +625,46 @@ sed_cell_add(Sed_cell a, const Sed_cell b)
     return a;
 }
 
+/** Merge one Sed_cell into another.
+
+As sed_cell_add but the new grain fractions, age and pressure of a are
+averages weighted by the uncompacted thicknesses of a and b rather than
+their thicknesses.  Fractions are of the uncompacted sediment of a cell so,
+unlike sed_cell_add, this keeps the mass of each grain type when a and b
+have been compacted by different amounts.
+
+\param[out] a    The destination cell.
+\param[in]  b    The source cell.
+
+\see sed_cell_add.
+*/
+Sed_cell
+sed_cell_merge(Sed_cell a, const Sed_cell b)
+{
+    eh_require(a);
+
+    if (b && !sed_cell_is_empty(b)) {
+        gssize n;
+        gssize len = sed_cell_n_types(b);
+        double ratio = a->t_0 / b->t_0;
+
+        eh_require_critical(sed_cell_is_valid(b));
+        eh_require(sed_cell_is_compatible(a, b));
+
+        for (n = 0 ; n < len ; n++) {
+            a->f[n] = (a->f[n] * ratio + b->f[n]) / (ratio + 1.);
+        }
+
+        a->t        = a->t   + b->t;
+        a->t_0      = a->t_0 + b->t_0;
+        a->age      = (a->age * ratio + b->age) / (ratio + 1.);
+        a->pressure = (a->pressure * ratio + b->pressure) / (ratio + 1.);
+        a->facies   = a->facies | b->facies;
+    }
+
+    return a;
+}
+
 /** Test if a Sed_cell is empty
 
 A Sed_cell is determined to be empty if its size is less than some tolerance.
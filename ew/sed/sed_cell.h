@@ -119,6 +119,8 @@ Sed_cell
 sed_cell_set_equal_fraction(Sed_cell c);
 Sed_cell
 sed_cell_add(Sed_cell c_1, const Sed_cell c_2);
+Sed_cell
+sed_cell_merge(Sed_cell c_1, const Sed_cell c_2);
 
 gboolean
 sed_cell_is_empty(Sed_cell a);
@@ -39,6 +39,8 @@ CLASS(Sed_column)
     double y;          ///< y-position of this column
     double age;        ///< age of this column
     double sl;         ///< sea level
+    guint64 stamp;     ///< Incremented each time the column is changed
+    gint* cell_refs;   ///< Number of columns that share cell
 };
 
 //@Include: sed_column.h
@@ -73,6 +75,10 @@ sed_column_new(gssize n_bins)
         s->y   = 0.;
         s->age = 0.;
         s->sl  = 0.;
+
+        s->stamp = 0;
+        s->cell_refs = eh_new(gint, 1);
+        *s->cell_refs = 1;
     }
 
     return s;
@@ -93,6 +99,10 @@ sed_column_new_filled(double t, Sed_size_class size)
 
 /** Destroy a column of sediment.
 
+If the column's cells are shared (see sed_column_share), only the reference
+to them is dropped.  The cells are freed once the last column that holds them
+is destroyed.
+
 @param s        The Sed_column to be destroyed.
 
 @see sed_column_new
@@ -101,13 +111,18 @@ Sed_column
 sed_column_destroy(Sed_column s)
 {
     if (s) {
-        gssize i;
+        if (*s->cell_refs > 1) {
+            *s->cell_refs -= 1;
+        } else {
+            gssize i;
 
-        for (i = 0; i < s->size; i++) {
-            sed_cell_destroy(s->cell[i]);
-        }
+            for (i = 0; i < s->size; i++) {
+                sed_cell_destroy(s->cell[i]);
+            }
 
-        eh_free(s->cell);
+            eh_free(s->cell);
+            eh_free(s->cell_refs);
+        }
 
         eh_free(s);
     }
@@ -131,6 +146,8 @@ sed_column_clear(Sed_column s)
 
         s->len = 0;
         s->t   = 0.;
+
+        sed_column_touch(s);
     }
 
     return s;
@@ -176,6 +193,8 @@ sed_column_copy(Sed_column dest, const Sed_column src)
         for (i = 0 ; i < src->size ; i++) {
             sed_cell_copy(dest->cell[i], src->cell[i]);
         }
+
+        sed_column_touch(dest);
     } else {
         dest = NULL;
     }
@@ -236,6 +255,8 @@ sed_column_copy_data(Sed_column dest, const Sed_column src)
         dest->y    = src->y;
         dest->age  = src->age;
         dest->sl   = src->sl;
+
+        sed_column_touch(dest);
     }
 
     return dest;
@@ -251,6 +272,8 @@ sed_column_copy_public_data(Sed_column dest, const Sed_column src)
         dest->y    = src->y;
         dest->age  = src->age;
         dest->sl   = src->sl;
+
+        sed_column_touch(dest);
     }
 
     return dest;
@@ -440,6 +463,7 @@ Sed_column
 sed_column_set_sea_level(Sed_column c, double sl)
 {
     c->sl = sl;
+    sed_column_touch(c);
     return c;
 }
 
@@ -447,6 +471,7 @@ Sed_column
 sed_column_set_base_height(Sed_column c, double z)
 {
     c->z = z;
+    sed_column_touch(c);
     return c;
 }
 
@@ -454,6 +479,7 @@ Sed_column
 sed_column_adjust_base_height(Sed_column c, double dz)
 {
     c->z += dz;
+    sed_column_touch(c);
     return c;
 }
 
@@ -1406,6 +1432,183 @@ sed_column_resize(Sed_column col, gssize n)
     return col;
 }
 
+/** Free the unused cells of a column.
+
+sed_column_resize never gives memory back.  Free the cells above the top of
+a column, keeping a block of S_ADDBINS cells for sediment yet to be added.
+
+@param col A pointer to a Sed_column.
+
+@return A pointer to the input Sed_column.
+*/
+Sed_column
+sed_column_shrink(Sed_column col)
+{
+    eh_require(col);
+
+    {
+        const gssize new_size = (col->len / S_ADDBINS + 1) * S_ADDBINS;
+
+        if (new_size < col->size) {
+            gssize i;
+
+            for (i = new_size ; i < col->size ; i++) {
+                col->cell[i] = sed_cell_destroy(col->cell[i]);
+            }
+
+            col->cell = eh_renew(Sed_cell, col->cell, new_size);
+            col->size = new_size;
+        }
+    }
+
+    return col;
+}
+
+static gboolean
+sed_cell_is_similar(const Sed_cell a, const Sed_cell b, double f_tol,
+    double age_tol)
+{
+    if (sed_cell_facies(a) != sed_cell_facies(b)
+        || fabs(sed_cell_age(a) - sed_cell_age(b)) > age_tol) {
+        return FALSE;
+    } else {
+        const gssize len = sed_cell_n_types(a);
+        gssize n;
+
+        for (n = 0 ; n < len ; n++) {
+            if (fabs(sed_cell_fraction(a, n) - sed_cell_fraction(b, n)) > f_tol) {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+/* The thickest a merged cell may be if its top is at \a depth below the top
+   of the column.  Zero if the cell is not buried deeply enough to merge. */
+static double
+sed_coalesce_profile_thickness(const Sed_coalesce_profile* p, double depth)
+{
+    double t = 0.;
+    gint   i;
+
+    for (i = 0 ; i < p->len && depth >= p->depth[i] ; i++) {
+        t = p->thickness[i];
+    }
+
+    return t;
+}
+
+/** Test if any cells of a column would be coalesced.
+
+The column is only read, so this can be used to decide whether a column that
+is shared with another cube needs to be copied before it is coalesced.
+
+@param col A pointer to a Sed_column.
+@param p   Depths, resolutions and tolerances that control the merging.
+
+@return TRUE if sed_column_coalesce would merge at least one cell.
+*/
+gboolean
+sed_column_can_coalesce(const Sed_column col, const Sed_coalesce_profile* p)
+{
+    eh_require(col);
+    eh_require(p);
+
+    if (col->len > 1 && p->len > 0) {
+        const double top   = sed_column_thickness(col);
+        double       below = sed_cell_size(col->cell[0]);
+        gssize       r;
+
+        // Until the first merge, each cell is tested against the one below it.
+        for (r = 1 ; r < col->len ; r++) {
+            const Sed_cell c     = col->cell[r];
+            const double   t     = sed_cell_size(c);
+            const double   max_t = sed_coalesce_profile_thickness(p,
+                    top - (below + t));
+
+            if (sed_cell_size(col->cell[r - 1]) + t <= max_t
+                && sed_cell_is_similar(col->cell[r - 1], c, p->f_tol, p->age_tol)) {
+                return TRUE;
+            }
+
+            below += t;
+        }
+    }
+
+    return FALSE;
+}
+
+/** Merge similar buried cells of a column.
+
+Walk up a column and merge each cell with the cell below it if it is buried
+deeply enough and the two are alike (see Sed_coalesce_profile).  Cells are
+merged with sed_cell_merge so that the thickness, original thickness and mass
+of the column are unchanged, even for cells that have been compacted by
+different amounts.  Cells that are freed up are released with
+sed_column_shrink.
+
+This takes a single pass over the column.
+
+@param col A pointer to a Sed_column.
+@param p   Depths, resolutions and tolerances that control the merging.
+
+@return The number of cells that were merged away.
+*/
+gssize
+sed_column_coalesce(Sed_column col, const Sed_coalesce_profile* p)
+{
+    gssize n_merged = 0;
+
+    eh_require(col);
+    eh_require(p);
+
+    if (col->len > 1 && p->len > 0) {
+        const double top   = sed_column_thickness(col);
+        double       below = 0.;
+        gssize       w     = 0;
+        gssize       r;
+
+        for (r = 0 ; r < col->len ; r++) {
+            Sed_cell     c     = col->cell[r];
+            const double t     = sed_cell_size(c);
+            const double depth = top - (below + t);
+
+            below += t;
+
+            if (w > 0) {
+                Sed_cell     dest  = col->cell[w - 1];
+                const double max_t = sed_coalesce_profile_thickness(p, depth);
+
+                if (sed_cell_size(dest) + t <= max_t
+                    && sed_cell_is_similar(dest, c, p->f_tol, p->age_tol)) {
+                    sed_cell_merge(dest, c);
+                    sed_cell_clear(c);
+                    n_merged++;
+                    continue;
+                }
+            }
+
+            // Move this cell down onto the cleared cell that was merged away.
+            if (w != r) {
+                col->cell[r] = col->cell[w];
+                col->cell[w] = c;
+            }
+
+            w++;
+        }
+
+        if (n_merged > 0) {
+            col->len = w;
+            sed_column_touch(col);
+            sed_column_shrink(col);
+        }
+    }
+
+    return n_merged;
+}
+
 /** Remove part of the top cell of a column and save the sediment.
 
 The top fraction (given by f) is removed from the cell at the top of a sediment
@@ -1570,6 +1773,7 @@ sed_column_extract_top_fill(Sed_column col,
                 sed_cell_resize(fill, dh);
                 sed_column_adjust_base_height(col, -dh);
                 col->z -= dh;
+                sed_column_touch(col);
                 sed_cell_add(dest, fill);
             }
         }
@@ -1638,6 +1842,7 @@ sed_column_remove_top_erode(Sed_column col, double t)
 
         if (erode > 0) {
             col->z -= erode;
+            sed_column_touch(col);
         }
     }
 
@@ -2061,6 +2266,10 @@ sed_column_read(FILE* fp)
         s->len  = len;
         s->size = size;
 
+        s->stamp = 0;
+        s->cell_refs = eh_new(gint, 1);
+        *s->cell_refs = 1;
+
         s->cell = eh_new(Sed_cell, s->size);
 
         for (i = 0 ; i < s->size ; i++) {
@@ -2304,9 +2513,115 @@ Sed_column
 sed_column_set_thickness(Sed_column col, double new_t)
 {
     col->t = new_t;
+    sed_column_touch(col);
+    return col;
+}
+
+/** Mark a Sed_column as changed.
+
+Every function that changes the height, thickness, sea level, or cells of a
+Sed_column increments the column's stamp.  Code that changes the cells of
+a column directly (through sed_column_nth_cell, for instance) should call
+this function so that cached surface values (see sed_cube_elevation_data)
+are recomputed.
+
+@param col A pointer to a Sed_column.
+
+@return A pointer to the input Sed_column.
+*/
+Sed_column
+sed_column_touch(Sed_column col)
+{
+    col->stamp++;
+    return col;
+}
+
+/** Get the stamp of a Sed_column.
+
+The stamp changes each time the column is changed.  Two calls that return
+the same stamp, for the same column, are guaranteed to see the same column.
+
+@param col A pointer to a Sed_column.
+
+@return The current stamp of the Sed_column.
+*/
+guint64
+sed_column_stamp(const Sed_column col)
+{
+    return col->stamp;
+}
+
+/** Create a Sed_column that shares the cells of another.
+
+The new column gets its own copy of the values that describe the column as a
+whole (its base height, sea level, position and so on), but its cells are
+shared with \p col rather than copied (cube snapshots, for instance).  Either
+column can have those values changed without affecting the other.  The
+shared cells must not be changed; a column that wants to change them first
+takes a private copy with sed_column_unshare.
+
+@param col A pointer to a Sed_column.
+
+@return A new Sed_column.  Destroy it with sed_column_destroy.
+*/
+Sed_column
+sed_column_share(const Sed_column col)
+{
+    Sed_column s;
+
+    eh_require(col);
+
+    NEW_OBJECT(Sed_column, s);
+
+    *s = *col;
+    *s->cell_refs += 1;
+
+    return s;
+}
+
+/** Give a Sed_column its own copy of shared cells.
+
+@param col A pointer to a Sed_column.
+
+@return The input Sed_column.
+
+@see sed_column_share
+*/
+Sed_column
+sed_column_unshare(Sed_column col)
+{
+    eh_require(col);
+
+    if (*col->cell_refs > 1) {
+        Sed_cell* cell = eh_new(Sed_cell, col->size);
+        gssize i;
+
+        for (i = 0 ; i < col->size ; i++) {
+            cell[i] = sed_cell_dup(col->cell[i]);
+        }
+
+        *col->cell_refs -= 1;
+
+        col->cell = cell;
+        col->cell_refs = eh_new(gint, 1);
+        *col->cell_refs = 1;
+    }
+
     return col;
 }
 
+/** Are the cells of a Sed_column shared with another column?
+
+@param col A pointer to a Sed_column.
+
+@return TRUE if the column's cells are held by more than one column.
+*/
+gboolean
+sed_column_is_shared(const Sed_column col)
+{
+    return *col->cell_refs > 1;
+}
+
 gboolean
 sed_column_size_is(const Sed_column col, double t)
 
@@ -82,6 +82,24 @@ we'll need another coordinate.
 */
 new_handle(Sed_column);
 
+/** Parameters that control how buried cells of a Sed_column are coalesced.
+
+Cells whose tops lie deeper than \a depth[i] (measured down from the top of
+the column) may be merged with the cell below them as long as the merged
+cell is no thicker than \a thickness[i].  The values of \a depth must
+increase.  Only cells of the same facies whose ages differ by no more than
+\a age_tol, and whose grain fractions differ by no more than \a f_tol, are
+merged.
+*/
+typedef struct {
+    const double* depth;     ///< Depths at which each resolution begins
+    const double* thickness; ///< Largest thickness of a merged cell below each depth
+    gint          len;       ///< Number of depths
+    double        f_tol;     ///< Largest difference in any grain fraction
+    double        age_tol;   ///< Largest difference in age
+}
+Sed_coalesce_profile;
+
 Sed_column
 sed_column_new(gssize n);
 Sed_column
@@ -156,6 +174,12 @@ sed_column_add_vec(Sed_column, const double*);
 Sed_column
 sed_column_resize(Sed_column c, gssize n);
 Sed_column
+sed_column_shrink(Sed_column c);
+gboolean
+sed_column_can_coalesce(const Sed_column c, const Sed_coalesce_profile* p);
+gssize
+sed_column_coalesce(Sed_column c, const Sed_coalesce_profile* p);
+Sed_column
 sed_column_resize_cell(Sed_column c, gssize i, double t);
 Sed_column
 sed_column_compact_cell(Sed_column c, gssize i, double t);
@@ -249,6 +273,16 @@ sed_column_is_above(Sed_column c, double z);
 
 Sed_column
 sed_column_set_thickness(Sed_column c, double t) G_GNUC_INTERNAL;
+Sed_column
+sed_column_touch(Sed_column c);
+guint64
+sed_column_stamp(const Sed_column c);
+Sed_column
+sed_column_share(const Sed_column c);
+Sed_column
+sed_column_unshare(Sed_column c);
+gboolean
+sed_column_is_shared(const Sed_column c);
 
 double
 sed_column_depth_age(const Sed_column, double);
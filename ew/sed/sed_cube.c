@@ -23,6 +23,46 @@
 #include "utils/utils.h"
 #include "sed_cube.h"
 
+/** Cached surface fields of a Sed_cube
+
+Values for a column are recomputed only when the column's stamp (see
+sed_column_stamp) no longer matches the stamp that was recorded when they
+were cached, or when a different column has been placed at that position.
+The load is expensive to compute and so is cached only once it is asked for.
+*/
+typedef struct {
+    Sed_column* col; //< Column that the cached values were computed from
+    guint64* stamp; //< Stamp of the column when the values were computed
+    double* elevation; //< Elevation to the top of each column
+    double* water_depth; //< Water depth above each column
+    double* thickness; //< Sediment thickness of each column
+    double* load; //< Load at the base of each column (NaN if not cached)
+    double* x_slope; //< Slope in the x-direction
+    double* y_slope; //< Slope in the y-direction
+    gboolean slopes_are_stale; //< Slopes must be recomputed
+}
+Sed_cube_surface;
+
+/** Cached shoreline of a Sed_cube
+
+Whether a column is below sea level is cached along with the column's stamp.
+When a column changes, only it and its four neighbours need to have their
+shore status re-evaluated, and then only if the column crossed sea level.
+*/
+typedef struct {
+    Sed_column* col; //< Column that the cached values were computed from
+    guint64* stamp; //< Stamp of the column when the values were computed
+    gchar* is_wet; //< Column is below sea level
+    gchar* is_shore; //< Column is a shore column (see is_shore_cell)
+    gint* dirty; //< Scratch space for ids of columns that crossed sea level
+    gint* ids; //< Ids of shore columns in increasing order (-1 terminated)
+    gint n_ids; //< Number of shore columns
+    double sea_level; //< Sea level when the values were computed
+    gboolean is_primed; //< Values have been computed at least once
+    gboolean ids_are_stale; //< The shore ids must be rebuilt from is_shore
+}
+Sed_cube_shore;
+
 CLASS(Sed_cube)
 {
     gchar* name; //< The name of the Sed_cube.
@@ -52,6 +92,9 @@ CLASS(Sed_cube)
     double** discharge; //< Water discharge at each column
     double** bed_load_flux; //< Bed load flux at each column
     Sed_hydro external_river; //< River to be set by an external source
+
+    Sed_cube_surface surface; //< Cached surface fields of each column
+    Sed_cube_shore shore_cache; //< Cached shore columns
 };
 
 GQuark
@@ -77,6 +120,8 @@ double
 _shore_normal(const gchar shore_edge, const double aspect_ratio);
 int
 sed_cube_find_shore_edge(Sed_cube s, gssize i, gssize j);
+static void
+_sed_cube_free_shore_list(Sed_cube s);
 
 void
 sed_mode_set(Sedflux_mode mode)
@@ -179,6 +224,32 @@ sed_cube_new_empty(gssize n_x, gssize n_y)
     s->bed_load_flux = eh_new_2(double, n_x, n_y);
     s->external_river = NULL;
 
+    { /* Surface values are computed the first time that they are needed */
+        const gint len = n_x * n_y;
+
+        s->surface.col         = eh_new0(Sed_column, len);
+        s->surface.stamp       = eh_new0(guint64, len);
+        s->surface.elevation   = eh_new(double, len);
+        s->surface.water_depth = eh_new(double, len);
+        s->surface.thickness   = eh_new(double, len);
+        s->surface.load        = eh_new(double, len);
+        s->surface.x_slope     = eh_new(double, len);
+        s->surface.y_slope     = eh_new(double, len);
+        s->surface.slopes_are_stale = TRUE;
+
+        s->shore_cache.col      = eh_new0(Sed_column, len);
+        s->shore_cache.stamp    = eh_new0(guint64, len);
+        s->shore_cache.is_wet   = eh_new0(gchar, len);
+        s->shore_cache.is_shore = eh_new0(gchar, len);
+        s->shore_cache.dirty    = eh_new(gint, len);
+        s->shore_cache.ids      = eh_new(gint, len + 1);
+        s->shore_cache.ids[0]   = -1;
+        s->shore_cache.n_ids    = 0;
+        s->shore_cache.sea_level = 0.;
+        s->shore_cache.is_primed = FALSE;
+        s->shore_cache.ids_are_stale = FALSE;
+    }
+
     return s;
 }
 
@@ -343,6 +414,22 @@ sed_cube_free(Sed_cube s, gboolean free_data)
         eh_free_2(s->bed_load_flux);
         sed_hydro_destroy(s->external_river);
 
+        eh_free(s->surface.col);
+        eh_free(s->surface.stamp);
+        eh_free(s->surface.elevation);
+        eh_free(s->surface.water_depth);
+        eh_free(s->surface.thickness);
+        eh_free(s->surface.load);
+        eh_free(s->surface.x_slope);
+        eh_free(s->surface.y_slope);
+
+        eh_free(s->shore_cache.col);
+        eh_free(s->shore_cache.stamp);
+        eh_free(s->shore_cache.is_wet);
+        eh_free(s->shore_cache.is_shore);
+        eh_free(s->shore_cache.dirty);
+        eh_free(s->shore_cache.ids);
+
         sed_cube_remove_all_trunks(s);
 
         sed_cell_destroy(s->erode);
@@ -350,7 +437,7 @@ sed_cube_free(Sed_cube s, gboolean free_data)
 
         sed_cube_destroy_storm_list(s);
 
-        g_list_free(s->shore);
+        _sed_cube_free_shore_list(s);
 
         g_free(s->name);
         eh_free(s);
@@ -529,7 +616,7 @@ sed_cube_set_bathy_data(Sed_cube c, double* z)
         int i;
 
         for (i = 0; i < len; i++) {
-            sed_column_set_base_height(c->col[0][i], z[i]);
+            sed_column_set_base_height(sed_cube_peek_col(c, i), z[i]);
         }
     }
 
@@ -546,7 +633,7 @@ sed_cube_set_dz(Sed_cube p, double new_dz)
         p->cell_height = new_dz;
 
         for (i = 0 ; i < len ; i++) {
-            sed_column_set_z_res(sed_cube_col(p, i), new_dz);
+            sed_column_set_z_res(sed_cube_peek_col(p, i), new_dz);
         }
     }
 
@@ -567,6 +654,31 @@ sed_cube_size(const Sed_cube s)
     return s->n_x * s->n_y;
 }
 
+/** The number of cells in all of the columns of a cube
+
+\param s  A Sed_cube
+
+\return The sum of the lengths of the columns of \a s
+*/
+gint64
+sed_cube_n_cells(const Sed_cube s)
+{
+    gint64 n = 0;
+
+    eh_return_val_if_fail(s != NULL, 0);
+
+    {
+        const gint len = s->n_x * s->n_y;
+        gint       id;
+
+        for (id = 0 ; id < len ; id++) {
+            n += sed_column_len(s->col[0][id]);
+        }
+    }
+
+    return n;
+}
+
 gint
 sed_cube_n_x(const Sed_cube s)
 {
@@ -581,6 +693,19 @@ sed_cube_n_y(const Sed_cube s)
     return s->n_y;
 }
 
+/* Make sure that the cells of a column are held only by this cube.
+
+The cells of a column that are shared with a snapshot (see sed_cube_snapshot)
+are copied the first time that the column is handed out for possible change.
+The snapshot keeps the originals.  The column itself always belongs to the
+cube, so its pointer, and anything cached against it, is unchanged.
+*/
+static Sed_column
+_sed_cube_own_col(Sed_cube s, gssize id)
+{
+    return sed_column_unshare(s->col[0][id]);
+}
+
 Sed_column
 sed_cube_col(const Sed_cube s, gssize ind)
 {
@@ -589,7 +714,7 @@ sed_cube_col(const Sed_cube s, gssize ind)
     eh_require(ind >= 0);
     eh_require(ind < sed_cube_size(s));
 
-    return s->col[0][ind];
+    return _sed_cube_own_col(s, ind);
 }
 
 Sed_column
@@ -602,7 +727,43 @@ sed_cube_col_ij(const Sed_cube s, gssize i, gssize j)
     eh_require(i < sed_cube_n_x(s));
     eh_require(sed_cube_id(s, i, j) < sed_cube_size(s));
 
-    return s->col[i][j];
+    return _sed_cube_own_col(s, sed_cube_id(s, i, j));
+}
+
+/** Look at a column of a cube without taking ownership of it
+
+Unlike sed_cube_col, cells that are shared with a snapshot are not copied,
+and so the cells of the column that is returned must not be changed.  Values
+that each cube holds for itself, such as the base height and sea level of the
+column, are not shared and can be set.
+
+\param s    A Sed_cube
+\param ind  Index of the column
+
+\return The column at \a ind
+*/
+Sed_column
+sed_cube_peek_col(const Sed_cube s, gssize ind)
+{
+    eh_return_val_if_fail(s != NULL, NULL);
+
+    eh_require(ind >= 0);
+    eh_require(ind < sed_cube_size(s));
+
+    return s->col[0][ind];
+}
+
+Sed_column
+sed_cube_peek_col_ij(const Sed_cube s, gssize i, gssize j)
+{
+    eh_return_val_if_fail(s != NULL, NULL);
+
+    eh_require(i >= 0);
+    eh_require(j >= 0);
+    eh_require(i < sed_cube_n_x(s));
+    eh_require(sed_cube_id(s, i, j) < sed_cube_size(s));
+
+    return s->col[0][sed_cube_id(s, i, j)];
 }
 
 Sed_column
@@ -642,7 +803,7 @@ sed_cube_x(const Sed_cube s, gint* id)
             x = eh_new(double, s->n_x);
 
             for (i = 0 ; i < s->n_x ; i++) {
-                x[i] = sed_column_x_position(sed_cube_col(s, i * s->n_y));
+                x[i] = sed_column_x_position(sed_cube_peek_col(s, i * s->n_y));
             }
         } else {
             for (n_x = 0 ; id[n_x] >= 0 ; n_x++);
@@ -650,7 +811,7 @@ sed_cube_x(const Sed_cube s, gint* id)
             x = eh_new(double, n_x);
 
             for (i = 0 ; i < n_x ; i++) {
-                x[i] = sed_column_x_position(sed_cube_col(s, id[i]));
+                x[i] = sed_column_x_position(sed_cube_peek_col(s, id[i]));
             }
         }
     }
@@ -672,7 +833,7 @@ sed_cube_y(const Sed_cube s, gint* id)
             y = eh_new(double, s->n_y);
 
             for (i = 0 ; i < s->n_y ; i++) {
-                y[i] = sed_column_y_position(sed_cube_col(s, i));
+                y[i] = sed_column_y_position(sed_cube_peek_col(s, i));
             }
         } else {
             for (n_y = 0 ; id[n_y] >= 0 ; n_y++);
@@ -680,7 +841,7 @@ sed_cube_y(const Sed_cube s, gint* id)
             y = eh_new(double, n_y);
 
             for (i = 0 ; i < n_y ; i++) {
-                y[i] = sed_column_y_position(sed_cube_col(s, id[i]));
+                y[i] = sed_column_y_position(sed_cube_peek_col(s, id[i]));
             }
         }
     }
@@ -694,13 +855,13 @@ sed_cube_col_x(const Sed_cube s, gssize id)
     eh_require(id >= 0);
     eh_require(id < sed_cube_size(s));
 
-    return sed_column_x_position(sed_cube_col(s, id));
+    return sed_column_x_position(sed_cube_peek_col(s, id));
 }
 
 double
 sed_cube_col_x_ij(const Sed_cube s, gint i, gint j)
 {
-    return sed_column_x_position(sed_cube_col_ij(s, i, j));
+    return sed_column_x_position(sed_cube_peek_col_ij(s, i, j));
 }
 
 double
@@ -709,13 +870,13 @@ sed_cube_col_y(const Sed_cube s, gssize id)
     eh_require(id >= 0);
     eh_require(id < sed_cube_size(s));
 
-    return sed_column_y_position(sed_cube_col(s, id));
+    return sed_column_y_position(sed_cube_peek_col(s, id));
 }
 
 double
 sed_cube_col_y_ij(const Sed_cube s, gint i, gint j)
 {
-    return sed_column_y_position(sed_cube_col_ij(s, i, j));
+    return sed_column_y_position(sed_cube_peek_col_ij(s, i, j));
 }
 
 double
@@ -815,7 +976,7 @@ sed_cube_slope_vector(const Sed_cube s, gssize i, gssize j)
 double
 sed_cube_top_height(const Sed_cube p, gssize i, gssize j)
 {
-    return sed_column_top_height(sed_cube_col_ij(p, i, j));
+    return sed_cube_elevation(p, i, j);
 }
 
 Eh_ind_2
@@ -829,6 +990,178 @@ sed_ind2sub(gssize ind, gssize n_y)
     return sub;
 }
 
+/* Bring the cached surface values of column id up to date. */
+static inline void
+_sed_cube_surface_sync_col(const Sed_cube s, gint id)
+{
+    Sed_column c = s->col[0][id];
+    Sed_cube_surface* surf = &s->surface;
+
+    if (surf->col[id] != c || surf->stamp[id] != sed_column_stamp(c)) {
+        surf->elevation[id]   = sed_column_top_height(c);
+        surf->water_depth[id] = sed_column_water_depth(c);
+        surf->thickness[id]   = sed_column_thickness(c);
+        surf->load[id]        = eh_nan();
+
+        surf->col[id]   = c;
+        surf->stamp[id] = sed_column_stamp(c);
+
+        surf->slopes_are_stale = TRUE;
+    }
+}
+
+static void
+_sed_cube_surface_sync(const Sed_cube s)
+{
+    gint id;
+    const gint len = sed_cube_size(s);
+
+    for (id = 0; id < len; id++) {
+        _sed_cube_surface_sync_col(s, id);
+    }
+}
+
+static void
+_sed_cube_surface_sync_slopes(const Sed_cube s)
+{
+    _sed_cube_surface_sync(s);
+
+    if (s->surface.slopes_are_stale) {
+        gint i, j, id;
+        const gint n_x = s->n_x;
+        const gint n_y = s->n_y;
+        const double* z = s->surface.water_depth;
+        double* dx = s->surface.x_slope;
+        double* dy = s->surface.y_slope;
+
+        for (i = 0, id = 0; i < n_x; i++)
+            for (j = 0; j < n_y; j++, id++) {
+                if (n_x < 2) {
+                    dx[id] = 0;
+                } else if (i == n_x - 1) {
+                    dx[id] = (z[id] - z[id - n_y]) / s->dx;
+                } else {
+                    dx[id] = (z[id + n_y] - z[id]) / s->dx;
+                }
+
+                if (n_y < 2) {
+                    dy[id] = 0;
+                } else if (j == n_y - 1) {
+                    dy[id] = (z[id] - z[id - 1]) / s->dy;
+                } else {
+                    dy[id] = (z[id + 1] - z[id]) / s->dy;
+                }
+            }
+
+        s->surface.slopes_are_stale = FALSE;
+    }
+}
+
+/** Get the elevation of every column of a Sed_cube.
+
+Values are cached by the cube and only recomputed for columns that have
+changed since the last call.  The returned array is owned by the cube and
+remains valid until the cube is destroyed.  Its contents are only guaranteed
+to be current until the cube is next changed.
+
+@param s A Sed_cube
+
+@return The elevation to the top of each column, indexed by column id
+*/
+const double*
+sed_cube_elevation_data(const Sed_cube s)
+{
+    eh_return_val_if_fail(s, NULL);
+    _sed_cube_surface_sync(s);
+    return s->surface.elevation;
+}
+
+/** Get the water depth above every column of a Sed_cube.
+
+@see sed_cube_elevation_data
+*/
+const double*
+sed_cube_water_depth_data(const Sed_cube s)
+{
+    eh_return_val_if_fail(s, NULL);
+    _sed_cube_surface_sync(s);
+    return s->surface.water_depth;
+}
+
+/** Get the sediment thickness of every column of a Sed_cube.
+
+@see sed_cube_elevation_data
+*/
+const double*
+sed_cube_thickness_data(const Sed_cube s)
+{
+    eh_return_val_if_fail(s, NULL);
+    _sed_cube_surface_sync(s);
+    return s->surface.thickness;
+}
+
+/** Get the load at the base of every column of a Sed_cube.
+
+@see sed_cube_elevation_data
+*/
+const double*
+sed_cube_load_data(const Sed_cube s)
+{
+    gint id;
+    const gint len = sed_cube_size(s);
+
+    eh_return_val_if_fail(s, NULL);
+
+    for (id = 0; id < len; id++) {
+        sed_cube_load(s, 0, id);
+    }
+
+    return s->surface.load;
+}
+
+/** Get the x-slope of the water depth of every column of a Sed_cube.
+
+@see sed_cube_elevation_data
+*/
+const double*
+sed_cube_x_slope_data(const Sed_cube s)
+{
+    eh_return_val_if_fail(s, NULL);
+    _sed_cube_surface_sync_slopes(s);
+    return s->surface.x_slope;
+}
+
+/** Get the y-slope of the water depth of every column of a Sed_cube.
+
+@see sed_cube_elevation_data
+*/
+const double*
+sed_cube_y_slope_data(const Sed_cube s)
+{
+    eh_return_val_if_fail(s, NULL);
+    _sed_cube_surface_sync_slopes(s);
+    return s->surface.y_slope;
+}
+
+static Eh_dbl_grid
+_sed_cube_surface_grid(const Sed_cube s, const double* data, gint* index)
+{
+    Eh_dbl_grid g = eh_grid_new(double, s->n_x, s->n_y);
+    double* dest = eh_dbl_grid_data_start(g);
+
+    if (index) {
+        gint i;
+
+        for (i = 0 ; index[i] >= 0 ; i++) {
+            dest[index[i]] = data[index[i]];
+        }
+    } else {
+        memcpy(dest, data, sizeof(double) * sed_cube_size(s));
+    }
+
+    return g;
+}
+
 Eh_dbl_grid
 sed_cube_grid(const Sed_cube s,
     Sed_grid_func func,
@@ -867,37 +1200,171 @@ sed_cube_slope_dir_grid(const Sed_cube s, gint* index)
 Eh_dbl_grid
 sed_cube_x_slope_grid(const Sed_cube s, gint* index)
 {
-    return sed_cube_grid(s, S_X_SLOPE_FUNC, index);
+    return _sed_cube_surface_grid(s, sed_cube_x_slope_data(s), index);
 }
 
 Eh_dbl_grid
 sed_cube_y_slope_grid(const Sed_cube s, gint* index)
 {
-    return sed_cube_grid(s, S_Y_SLOPE_FUNC, index);
+    return _sed_cube_surface_grid(s, sed_cube_y_slope_data(s), index);
 }
 
 Eh_dbl_grid
 sed_cube_water_depth_grid(const Sed_cube s, gint* index)
 {
-    return sed_cube_grid(s, S_WATER_DEPTH_FUNC, index);
+    return _sed_cube_surface_grid(s, sed_cube_water_depth_data(s), index);
 }
 
 Eh_dbl_grid
 sed_cube_elevation_grid(const Sed_cube s, gint* index)
 {
-    return sed_cube_grid(s, S_ELEVATION_FUNC, index);
+    return _sed_cube_surface_grid(s, sed_cube_elevation_data(s), index);
 }
 
 Eh_dbl_grid
 sed_cube_thickness_grid(const Sed_cube s, gint* index)
 {
-    return sed_cube_grid(s, S_THICKNESS_FUNC, index);
+    return _sed_cube_surface_grid(s, sed_cube_thickness_data(s), index);
 }
 
 Eh_dbl_grid
 sed_cube_load_grid(const Sed_cube s, gint* index)
 {
-    return sed_cube_grid(s, S_LOAD_FUNC, index);
+    if (index) {
+        return sed_cube_grid(s, S_LOAD_FUNC, index);
+    } else {
+        return _sed_cube_surface_grid(s, sed_cube_load_data(s), NULL);
+    }
+}
+
+/* Shore status of column (i,j) from the cached sea-level crossings. */
+static inline gchar
+_sed_cube_shore_from_wet(const Sed_cube s, gint i, gint j)
+{
+    const gchar* wet = s->shore_cache.is_wet;
+    const gint id = i * s->n_y + j;
+
+    if (wet[id]) {
+        return FALSE;
+    } else {
+        return (j > 0 && wet[id - 1])
+            || (j < s->n_y - 1 && wet[id + 1])
+            || (i > 0 && wet[id - s->n_y])
+            || (i < s->n_x - 1 && wet[id + s->n_y]);
+    }
+}
+
+/* Bring the cached shore columns up to date.  Only columns that have crossed
+   sea level since the last call, along with their neighbours, are
+   re-evaluated. */
+static void
+_sed_cube_shore_sync(const Sed_cube s)
+{
+    Sed_cube_shore* sc = &s->shore_cache;
+    const gint n_x = s->n_x;
+    const gint n_y = s->n_y;
+    const gint len = n_x * n_y;
+    gint id;
+
+    if (!sc->is_primed || sc->sea_level != s->sea_level) {
+        gint i, j;
+
+        for (id = 0; id < len; id++) {
+            Sed_column c = s->col[0][id];
+            sc->col[id]    = c;
+            sc->stamp[id]  = sed_column_stamp(c);
+            sc->is_wet[id] = sed_column_is_below(c, s->sea_level);
+        }
+
+        for (i = 0, id = 0; i < n_x; i++)
+            for (j = 0; j < n_y; j++, id++) {
+                sc->is_shore[id] = _sed_cube_shore_from_wet(s, i, j);
+            }
+
+        sc->sea_level     = s->sea_level;
+        sc->is_primed     = TRUE;
+        sc->ids_are_stale = TRUE;
+    } else {
+        gint n_dirty = 0;
+        gint n;
+
+        for (id = 0; id < len; id++) {
+            Sed_column c = s->col[0][id];
+
+            if (sc->col[id] != c || sc->stamp[id] != sed_column_stamp(c)) {
+                const gchar is_wet = sed_column_is_below(c, s->sea_level);
+
+                sc->col[id]   = c;
+                sc->stamp[id] = sed_column_stamp(c);
+
+                if (is_wet != sc->is_wet[id]) {
+                    sc->is_wet[id] = is_wet;
+                    sc->dirty[n_dirty++] = id;
+                }
+            }
+        }
+
+        for (n = 0; n < n_dirty; n++) {
+            const gint i = sc->dirty[n] / n_y;
+            const gint j = sc->dirty[n] % n_y;
+            gint k;
+            const gint shift[5][2] = { {0, 0}, {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+            for (k = 0; k < 5; k++) {
+                const gint ii = i + shift[k][0];
+                const gint jj = j + shift[k][1];
+
+                if (ii >= 0 && ii < n_x && jj >= 0 && jj < n_y) {
+                    const gchar is_shore = _sed_cube_shore_from_wet(s, ii, jj);
+
+                    if (is_shore != sc->is_shore[ii * n_y + jj]) {
+                        sc->is_shore[ii * n_y + jj] = is_shore;
+                        sc->ids_are_stale = TRUE;
+                    }
+                }
+            }
+        }
+    }
+
+    if (sc->ids_are_stale) {
+        gint n = 0;
+
+        for (id = 0; id < len; id++)
+            if (sc->is_shore[id]) {
+                sc->ids[n++] = id;
+            }
+
+        sc->ids[n] = -1;
+        sc->n_ids  = n;
+        sc->ids_are_stale = FALSE;
+    }
+}
+
+/** Get the ids of the shore columns of a Sed_cube.
+
+Shore columns are those identified by is_shore_cell.  The shore is cached by
+the cube and is only re-evaluated near columns that have crossed sea level
+since the last call.  The returned array is owned by the cube and remains
+valid until the cube is destroyed.  Its contents are only guaranteed to be
+current until the cube is next changed.
+
+@param s A Sed_cube
+@param n Location to put the number of shore columns (or NULL)
+
+@return Ids of the shore columns in increasing order, terminated by -1
+*/
+const gint*
+sed_cube_shore_data(const Sed_cube s, gint* n)
+{
+    eh_return_val_if_fail(s, NULL);
+
+    _sed_cube_shore_sync(s);
+
+    if (n) {
+        *n = s->shore_cache.n_ids;
+    }
+
+    return s->shore_cache.ids;
 }
 
 gboolean*
@@ -908,16 +1375,18 @@ sed_cube_shore_mask(const Sed_cube s)
     eh_require(s);
 
     {
-        gint i, j, id;
-        const gint nx = sed_cube_n_x(s);
-        const gint ny = sed_cube_n_y(s);
+        gint id;
+        const gint len = sed_cube_size(s);
+        const gchar* is_shore;
 
-        mask = eh_new(gboolean, s->n_x * s->n_y);
+        _sed_cube_shore_sync(s);
 
-        for (i = 0, id = 0 ; i < nx ; i++)
-            for (j = 0 ; j < ny ; j++, id++) {
-                mask[id] = is_shore_cell(s, i, j);
-            }
+        is_shore = s->shore_cache.is_shore;
+        mask = eh_new(gboolean, len);
+
+        for (id = 0 ; id < len ; id++) {
+            mask[id] = is_shore[id];
+        }
     }
 
     return mask;
@@ -926,29 +1395,152 @@ sed_cube_shore_mask(const Sed_cube s)
 gint*
 sed_cube_shore_ids(const Sed_cube s)
 {
-    gboolean* ids = NULL;
+    gint* ids = NULL;
 
     eh_require(s);
 
     {
-        gint i, j;
-        gint shore_count = 0;
-        const gint nx = sed_cube_n_x(s);
-        const gint ny = sed_cube_n_y(s);
+        gint n;
+        const gint* shore = sed_cube_shore_data(s, &n);
 
-        ids = eh_new(gint, sed_cube_size(s) + 1);
+        ids = eh_new(gint, n + 1);
+        memcpy(ids, shore, sizeof(gint) * (n + 1));
+    }
 
-        for (i = 0 ; i < nx; i++)
-            for (j = 0 ; j < ny; j++)
-                if (is_shore_cell(s, i, j)) {
-                    ids[shore_count] = sed_cube_id(s, i, j);
-                    shore_count++;
-                }
+    return ids;
+}
+
+/* An unvisited shore column that neighbours id, or -1 if there is none.
+   Columns that share an edge with id are preferred to those that share only
+   a corner so that a walk follows each step of a staircase shoreline. */
+static gint
+_sed_cube_next_shore(const Sed_cube s, gint id, const gchar* visited)
+{
+    static const gint di[8] = { 0, 1,  0, -1, 1,  1, -1, -1 };
+    static const gint dj[8] = { 1, 0, -1,  0, 1, -1, -1,  1 };
+    const gint n_x = s->n_x;
+    const gint n_y = s->n_y;
+    const gchar* is_shore = s->shore_cache.is_shore;
+    const gint i = id / n_y;
+    const gint j = id % n_y;
+    gint k;
+
+    for (k = 0 ; k < 8 ; k++) {
+        const gint ii = i + di[k];
+        const gint jj = j + dj[k];
+
+        if (ii >= 0 && ii < n_x && jj >= 0 && jj < n_y) {
+            const gint next = ii * n_y + jj;
 
-        ids[shore_count] = -1;
+            if (is_shore[next] && !visited[next]) {
+                return next;
+            }
+        }
     }
 
-    return ids;
+    return -1;
+}
+
+/* Walk away from id along unvisited shore columns, appending each step to
+   line.  Returns the new length of line. */
+static gint
+_sed_cube_walk_shore(const Sed_cube s, gint id, gchar* visited, gint* line,
+    gint n)
+{
+    while ((id = _sed_cube_next_shore(s, id, visited)) >= 0) {
+        visited[id] = TRUE;
+        line[n++]   = id;
+    }
+
+    return n;
+}
+
+/* Append to line the piece of shoreline that passes through id.  The two
+   walks that leave id are joined end to end, the first reversed, so that the
+   piece runs from one of its ends to the other.  Returns the new length of
+   line. */
+static gint
+_sed_cube_trace_shore_piece(const Sed_cube s, gint id, gchar* visited,
+    gint* line, gint n)
+{
+    const gint first = n;
+    gint a, b;
+
+    visited[id] = TRUE;
+
+    n = _sed_cube_walk_shore(s, id, visited, line, n);
+
+    for (a = first, b = n - 1 ; a < b ; a++, b--) {
+        const gint swap = line[a];
+        line[a] = line[b];
+        line[b] = swap;
+    }
+
+    line[n++] = id;
+
+    return _sed_cube_walk_shore(s, id, visited, line, n);
+}
+
+/* Append to line the shore columns that are 8-connected to id.  Columns of
+   a piece of shoreline are neighbours in line; columns that branch off a
+   piece start pieces of their own.  Returns the new length of line. */
+static gint
+_sed_cube_trace_shore(const Sed_cube s, gint id, gchar* visited, gint* line,
+    gint n)
+{
+    gint k;
+
+    k = n;
+    n = _sed_cube_trace_shore_piece(s, id, visited, line, n);
+
+    for (; k < n ; k++) {
+        gint next;
+
+        while ((next = _sed_cube_next_shore(s, line[k], visited)) >= 0) {
+            n = _sed_cube_trace_shore_piece(s, next, visited, line, n);
+        }
+    }
+
+    return n;
+}
+
+/** Get the shore columns of a Sed_cube ordered along the shoreline.
+
+Shore columns are traced through their eight neighbours so that columns of
+the same piece of shoreline are adjacent in the returned array, from one end
+of the piece to the other.  Separate pieces of shoreline, and columns that
+branch off of them, follow one another.
+
+@param s A Sed_cube
+
+@return A newly-allocated array of column ids, terminated by -1
+*/
+gint*
+sed_cube_shore_line_ids(const Sed_cube s)
+{
+    gint* line = NULL;
+
+    eh_require(s);
+
+    {
+        gint n_shore, k;
+        gint n = 0;
+        const gint* ids = sed_cube_shore_data(s, &n_shore);
+        gchar* visited = eh_new0(gchar, sed_cube_size(s));
+
+        line = eh_new(gint, n_shore + 1);
+
+        for (k = 0; k < n_shore; k++)
+            if (!visited[ids[k]]) {
+                n = _sed_cube_trace_shore(s, ids[k], visited, line, n);
+            }
+
+        line[n] = -1;
+
+        eh_free(visited);
+    }
+
+    return line;
 }
 
 Sed_riv
@@ -1321,13 +1913,14 @@ sed_cube_set_tidal_range(Sed_cube s, double new_val)
 double
 sed_cube_water_depth(const Sed_cube p, gint i, gint j)
 {
-    double depth;
+    const gint id = i * p->n_y + j;
 
     eh_require(p);
+    eh_require(id >= 0 && id < sed_cube_size(p));
 
-    depth = sed_column_water_depth(sed_cube_col_ij(p, i, j));
+    _sed_cube_surface_sync_col(p, id);
 
-    return depth;
+    return p->surface.water_depth[id];
 }
 
 /** Get the elevation to the top of a Sed_cube column
@@ -1341,13 +1934,14 @@ sed_cube_water_depth(const Sed_cube p, gint i, gint j)
 double
 sed_cube_elevation(const Sed_cube p, gint i, gint j)
 {
-    double elevation;
+    const gint id = i * p->n_y + j;
 
     eh_require(p);
+    eh_require(id >= 0 && id < sed_cube_size(p));
 
-    elevation = sed_column_top_height(sed_cube_col_ij(p, i, j));
+    _sed_cube_surface_sync_col(p, id);
 
-    return elevation;
+    return p->surface.elevation[id];
 }
 
 double
@@ -1371,24 +1965,31 @@ sed_cube_water_pressure(const Sed_cube p, gssize i, gssize j)
 double
 sed_cube_load(const Sed_cube p, gint i, gint j)
 {
-    double load;
+    const gint id = i * p->n_y + j;
 
     eh_require(p);
+    eh_require(id >= 0 && id < sed_cube_size(p));
 
-    {
-        double sediment_load = sed_column_load_at(sed_cube_col_ij(p, i, j), 0);
+    _sed_cube_surface_sync_col(p, id);
+
+    if (eh_isnan(p->surface.load[id])) {
+        double sediment_load = sed_column_load_at(p->col[0][id], 0);
         double  water_load   = sed_cube_water_pressure(p, i, j);
 
-        load = water_load + sediment_load;
+        p->surface.load[id] = water_load + sediment_load;
     }
 
-    return load;
+    return p->surface.load[id];
 }
 
 double
 sed_cube_thickness(const Sed_cube p, gint i, gint j)
 {
-    return sed_column_thickness(p->col[i][j]);
+    const gint id = i * p->n_y + j;
+
+    _sed_cube_surface_sync_col(p, id);
+
+    return p->surface.thickness[id];
 }
 
 gboolean
@@ -1400,7 +2001,7 @@ sed_cube_col_is_empty(const Sed_cube p, gssize i, gssize j)
 double
 sed_cube_base_height(const Sed_cube p, gssize i, gssize j)
 {
-    return sed_column_base_height(sed_cube_col_ij(p, i, j));
+    return sed_column_base_height(sed_cube_peek_col_ij(p, i, j));
 }
 
 /** Duplicate a sediment cube.
@@ -1443,6 +2044,92 @@ sed_cube_copy(Sed_cube dest, const Sed_cube src)
     return dest;
 }
 
+/** Take a snapshot of a sediment cube.
+
+The snapshot shares the cells of its columns with the original cube, so
+taking one costs little more than a copy of each column's base height, sea
+level and the like.  The cells of a column are copied only when either cube
+hands the column out for change (see sed_cube_col); changing sea level or
+base height copies nothing.  A snapshot is an
+ordinary Sed_cube: it can be run forward as a what-if branch or used to
+restore the original (see sed_cube_branch).  Destroy it with sed_cube_destroy.
+
+\param c The cube to take a snapshot of.
+
+\return A newly created cube.
+*/
+Sed_cube
+sed_cube_snapshot(const Sed_cube c)
+{
+    return sed_cube_branch(NULL, c);
+}
+
+/** Branch a sediment cube from another.
+
+Set \p dest to the state of \p src.  The cells of the columns are shared
+between the two cubes rather than copied (see sed_cube_snapshot).  Rivers are duplicated.
+
+\param dest A cube with the same dimensions as \p src (or NULL to create a cube)
+\param src  The cube to branch from.
+
+\return The branched cube.
+*/
+Sed_cube
+sed_cube_branch(Sed_cube dest, const Sed_cube src)
+{
+    eh_require(src);
+
+    if (dest == NULL) {
+        dest = sed_cube_new_empty(src->n_x, src->n_y);
+    } else {
+        gssize id;
+
+        eh_require(dest->n_x == src->n_x && dest->n_y == src->n_y);
+
+        /* The new columns may be given the addresses of the old ones, so
+           forget what was cached for them */
+        for (id = 0 ; id < sed_cube_size(dest) ; id++) {
+            sed_column_destroy(dest->col[0][id]);
+            dest->surface.col[id]     = NULL;
+            dest->shore_cache.col[id] = NULL;
+        }
+
+        sed_cube_remove_all_trunks(dest);
+    }
+
+    sed_cube_copy_scalar_data(dest, src);
+
+    dest->basinWidth = src->basinWidth;
+    dest->constants  = src->constants;
+
+    sed_cell_copy(dest->erode, src->erode);
+    sed_cell_copy(dest->remove, src->remove);
+
+    {
+        const gssize len = sed_cube_size(src);
+        gssize id;
+
+        for (id = 0 ; id < len ; id++) {
+            dest->col[0][id] = sed_column_share(src->col[0][id]);
+        }
+
+        if (len > 0) {
+            memcpy(dest->discharge[0], src->discharge[0], len * sizeof(double));
+            memcpy(dest->bed_load_flux[0], src->bed_load_flux[0], len * sizeof(double));
+        }
+    }
+
+    {
+        GList* r;
+
+        for (r = g_list_last(src->river) ; r ; r = r->prev) {
+            sed_cube_add_trunk(dest, (Sed_riv)r->data);
+        }
+    }
+
+    return dest;
+}
+
 /** Place columns from a Sed_cube into a new 1D Sed_cube
 
 Create a new 1D Sed_cube out of Sed_columns of an existing Sed_cube.  Columns
@@ -1554,10 +2241,10 @@ sed_cube_cols(Sed_cube src, gint* path)
 
         if (path)
             for (j = 0 ; j < len ; j++) {
-                new_cube->col[0][j] = src->col[0][path[j]];
+                new_cube->col[0][j] = sed_cube_col(src, path[j]);
             } else
             for (j = 0 ; j < len ; j++) {
-                new_cube->col[0][j] = src->col[0][j];
+                new_cube->col[0][j] = sed_cube_col(src, j);
             }
     }
 
@@ -1608,7 +2295,7 @@ sed_cube_remove(Sed_cube dest, Sed_cube src)
 
     for (i = 0 ; i < dest_size ; i++)
         if (src_id[i] >= 0)
-            sed_column_remove(dest->col[0][i],
+            sed_column_remove(sed_cube_col(dest, i),
                 src->col[0][src_id[i]]);
 
     eh_free(src_id);
@@ -1623,19 +2310,51 @@ sed_cube_add(Sed_cube dest, const Sed_cube src)
     gssize src_size  = sed_cube_size(src);
     gssize* dest_id = eh_new(gssize, src_size);
 
-    for (i = 0 ; i < src_size ; i++)
-        dest_id[i] = sed_cube_column_id(dest,
-                sed_column_x_position(src->col[0][i]),
-                sed_column_y_position(src->col[0][i]));
+    for (i = 0 ; i < src_size ; i++)
+        dest_id[i] = sed_cube_column_id(dest,
+                sed_column_x_position(src->col[0][i]),
+                sed_column_y_position(src->col[0][i]));
+
+    for (i = 0 ; i < src_size ; i++)
+        if (dest_id[i] >= 0)
+            sed_column_add(sed_cube_col(dest, dest_id[i]),
+                src->col[0][i]);
+
+    eh_free(dest_id);
+
+    return dest;
+}
+
+/** Merge similar buried cells in every column of a cube.
+
+@param p       A Sed_cube
+@param profile Depths, resolutions and tolerances that control the merging
+
+@return The number of cells that were merged away.
+
+@see sed_column_coalesce
+*/
+gssize
+sed_cube_coalesce(Sed_cube p, const Sed_coalesce_profile* profile)
+{
+    gssize n_merged = 0;
+
+    eh_require(p);
+    eh_require(profile);
 
-    for (i = 0 ; i < src_size ; i++)
-        if (dest_id[i] >= 0)
-            sed_column_add(dest->col[0][dest_id[i]],
-                src->col[0][i]);
+    {
+        gssize i;
+        const gssize len = sed_cube_size(p);
 
-    eh_free(dest_id);
+        /* Only columns with cells to merge are taken by the cube, so that a
+           column shared with a snapshot is not copied just to be looked at */
+        for (i = 0 ; i < len ; i++)
+            if (sed_column_can_coalesce(sed_cube_peek_col(p, i), profile)) {
+                n_merged += sed_column_coalesce(sed_cube_col(p, i), profile);
+            }
+    }
 
-    return dest;
+    return n_merged;
 }
 
 double
@@ -1647,8 +2366,10 @@ sed_cube_mass(const Sed_cube p)
         gssize i;
         gssize len = sed_cube_size(p);
 
+        /* Read the columns in place, so that a column shared with a
+           snapshot is not copied just to be weighed */
         for (i = 0 ; i < len ; i++) {
-            mass += sed_column_mass(sed_cube_col(p, i));
+            mass += sed_column_mass(p->col[0][i]);
         }
 
         mass *= sed_cube_x_res(p) * sed_cube_y_res(p);
@@ -1668,7 +2389,7 @@ sed_cube_sediment_mass(const Sed_cube p)
         gint len = sed_cube_size(p);
 
         for (i = 0 ; i < len ; i++) {
-            mass += sed_column_sediment_mass(sed_cube_col(p, i));
+            mass += sed_column_sediment_mass(sed_cube_peek_col(p, i));
         }
 
         mass *= sed_cube_x_res(p) * sed_cube_y_res(p);
@@ -1710,8 +2431,12 @@ sed_cube_set_sea_level(Sed_cube s, double new_sea_level)
         gssize i, len = sed_cube_size(s);
         s->sea_level = new_sea_level;
 
+        /* Sea level isn't part of the cells that a column may share with a
+           snapshot, so setting it never copies them */
         for (i = 0 ; i < len ; i++) {
-            sed_column_set_sea_level(sed_cube_col(s, i), new_sea_level);
+            if (sed_column_sea_level(s->col[0][i]) != new_sea_level) {
+                sed_column_set_sea_level(sed_cube_peek_col(s, i), new_sea_level);
+            }
         }
     }
 
@@ -1727,14 +2452,14 @@ sed_cube_adjust_sea_level(Sed_cube s, double dz)
 Sed_cube
 sed_cube_set_base_height(Sed_cube s, gssize i, gssize j, double height)
 {
-    sed_column_set_base_height(sed_cube_col_ij(s, i, j), height);
+    sed_column_set_base_height(sed_cube_peek_col_ij(s, i, j), height);
     return s;
 }
 
 Sed_cube
 sed_cube_adjust_base_height(Sed_cube s, gssize i, gssize j, double dz)
 {
-    Sed_column this_col = sed_cube_col_ij(s, i, j);
+    Sed_column this_col = sed_cube_peek_col_ij(s, i, j);
     sed_column_set_base_height(this_col,
         sed_column_base_height(this_col) + dz);
     return s;
@@ -2339,7 +3064,7 @@ sed_cube_set_z_res(Sed_cube s, double new_z_res)
         gssize i, len = sed_cube_size(s);
 
         for (i = 0 ; i < len ; i++) {
-            sed_column_set_z_res(sed_cube_col(s, i), new_z_res);
+            sed_column_set_z_res(sed_cube_peek_col(s, i), new_z_res);
         }
 
         s->cell_height = new_z_res;
@@ -2429,102 +3154,86 @@ Sed_cube sed_cube_add_river( Sed_cube s , Sed_river *river )
 }
 */
 
-void
-sed_cube_set_shore(Sed_cube s)
+static void
+_sed_cube_free_shore_list(Sed_cube s)
 {
-    int i;
-    Eh_ind_2* pos;
-    GList* shore_list = NULL;
     GList* list;
 
+    for (list = s->shore ; list ; list = list->next) {
+        eh_free(list->data);
+    }
+
     g_list_free(s->shore);
     s->shore = NULL;
+}
 
-    //---
-    // Look for the shoreline along the first and last rows, then along the
-    // first and last columns.  If there are no shore cells along the boundaries
-    // then look in the interior.
-    //---
-    if ((pos = sed_cube_find_shore(s, 0, VARY_COLS))
-        || (pos = sed_cube_find_shore(s, s->n_x - 1, VARY_COLS))
-        || (pos = sed_cube_find_shore(s, 0, VARY_ROWS))
-        || (pos = sed_cube_find_shore(s, s->n_y - 1, VARY_ROWS))) {
-        shore_list = sed_cube_find_shore_line(s, pos);
-    } else {
-        for (i = 1 ; pos == NULL && i < s->n_x - 1 ; i++) {
-            pos = sed_cube_find_shore(s, i, VARY_COLS);
-        }
+/** Set the shore line of a Sed_cube.
 
-        if (!pos) {
-            eh_message("There are no shore cells in the domain");
-        } else {
-            shore_list = sed_cube_find_shore_line(s, pos);
-        }
-    }
+The shore is stored as a list of Eh_ind_2 ordered along the shoreline (see
+sed_cube_shore_line_ids).
+
+\param s A pointer to a Sed_cube.
+*/
+void
+sed_cube_set_shore(Sed_cube s)
+{
+    gint* line = sed_cube_shore_line_ids(s);
+    GList* shore_list = NULL;
+    gint n;
+
+    _sed_cube_free_shore_list(s);
 
-    g_free(pos);
+    for (n = 0 ; line[n] >= 0 ; n++) {
+        Eh_ind_2 ind = sed_cube_sub(s, line[n]);
+        shore_list = g_list_prepend(shore_list, eh_ind_2_dup(&ind, NULL));
+    }
 
-    for (list = shore_list ; list ; list = list->next) {
-        fprintf(stderr, "shore : %d , %d\n",
-            ((Eh_ind_2*)(list->data))->i,
-            ((Eh_ind_2*)(list->data))->j);
+    if (!shore_list) {
+        eh_message("There are no shore cells in the domain");
     }
 
-    s->shore = shore_list;
+    s->shore = g_list_reverse(shore_list);
+
+    eh_free(line);
 }
 
+/** Trace the shore line that passes through a shore column.
+
+\param s A pointer to a Sed_cube.
+\param pos Indices to a shore column.
+
+\return A newly-allocated list of Eh_ind_2 for each shore column connected
+        to pos, or NULL if pos is not a shore column.
+*/
 GList*
 sed_cube_find_shore_line(Sed_cube s, Eh_ind_2* pos)
 {
-    return sed_find_next_shore(NULL, s, pos, g_list_prepend(NULL, pos));
-}
+    GList* shore_list = NULL;
 
-int
-eh_compare_ind_2(Eh_ind_2* a, Eh_ind_2* b);
+    eh_require(s);
+    eh_require(pos);
 
-GList*
-sed_find_next_shore(GList* shore_list,
-    Sed_cube s,
-    Eh_ind_2* pos,
-    GList* ignore_list)
-{
-    int i;
-    Eh_ind_2 shift[8] = { {-1, -1}, {0, -1}, {1, -1},
-        {-1, 0},          {1, 0},
-        {-1, 1}, {0, 1}, {1, 1}
-    };
-    GList* child_list = NULL;
-    GList* list;
-    Eh_ind_2 shift_pos;
-    Eh_ind_2* next_pos;
-
-    for (i = 0 ; i < 8 ; i++) {
-        shift_pos = eh_ind_2_create(pos->i + shift[i].i, pos->j + shift[i].j);
-
-        if (g_list_find_custom(ignore_list,
-                &shift_pos,
-                (GCompareFunc)&eh_compare_ind_2)
-            == NULL
-            && is_shore_cell(s, shift_pos.i, shift_pos.j)) {
-            next_pos = eh_ind_2_dup(&shift_pos, NULL);
-            child_list = g_list_prepend(child_list, next_pos);
-        }
-    }
+    if (sed_cube_is_in_domain(s, pos->i, pos->j)) {
+        const gint id = sed_cube_id(s, pos->i, pos->j);
+        gint n_shore;
 
+        sed_cube_shore_data(s, &n_shore);
 
-    if (child_list) {
-        for (list = child_list ; list ; list = list->next)
-            ignore_list = g_list_prepend(ignore_list,
-                    eh_ind_2_dup((Eh_ind_2*)list->data,
-                        NULL));
+        if (s->shore_cache.is_shore[id]) {
+            gint k, n;
+            gchar* visited = eh_new0(gchar, sed_cube_size(s));
+            gint* line = eh_new(gint, n_shore + 1);
 
-        for (list = child_list ; list ; list = list->next)
-            shore_list = sed_find_next_shore(shore_list, s,
-                    (Eh_ind_2*)list->data, ignore_list);
+            n = _sed_cube_trace_shore(s, id, visited, line, 0);
 
-        shore_list = g_list_prepend(shore_list, pos);
-    } else {
-        return g_list_prepend(shore_list, pos);
+            for (k = n - 1 ; k >= 0 ; k--) {
+                Eh_ind_2 ind = sed_cube_sub(s, line[k]);
+                shore_list = g_list_prepend(shore_list, eh_ind_2_dup(&ind, NULL));
+            }
+
+            eh_free(line);
+            eh_free(visited);
+        }
     }
 
     return shore_list;
@@ -2969,6 +3678,8 @@ sed_shift_index_over_edge(gssize i, gssize j, int edge)
     return new_index;
 }
 
+/* The columns of the list that is returned are not taken from any snapshots
+   that share them.  Use sed_cube_col to get a column that is to be changed. */
 GList*
 sed_cube_find_columns_custom(Sed_cube s,
     gssize i,
@@ -2999,7 +3710,7 @@ sed_cube_find_columns_custom(Sed_cube s,
         return column_list;
     }
 
-    column_list = g_list_prepend(column_list, s->col[i][j]);
+    column_list = g_list_prepend(column_list, sed_cube_peek_col_ij(s, i, j));
 
     //---
     // Trace the path while within the domain while the stop criterion is not
@@ -3034,8 +3745,8 @@ sed_cube_find_columns_custom(Sed_cube s,
         // columns.  To avoid a infinite loop, stop the search if this cell is
         // already in the list.
         if (eh_is_in_domain(s->n_x, s->n_y, i, j)) {
-            if (column_list->data != s->col[i][j]) {
-                column_list = g_list_prepend(column_list, s->col[i][j]);
+            if (column_list->data != sed_cube_peek_col_ij(s, i, j)) {
+                column_list = g_list_prepend(column_list, sed_cube_peek_col_ij(s, i, j));
             } else {
                 break;
             }
@@ -3055,7 +3766,7 @@ sed_cube_find_cross_shore_columns(Sed_cube s, gssize i, gssize j)
     double max_depth = 20;
 
     if (sed_cube_water_depth(s, i, j) > max_depth) {
-        return g_list_prepend(column_list, s->col[i][j]);
+        return g_list_prepend(column_list, sed_cube_peek_col_ij(s, i, j));
     }
 
     u = sed_cube_slope_vector(s, i, j);
@@ -3071,7 +3782,7 @@ sed_cube_find_cross_shore_columns(Sed_cube s, gssize i, gssize j)
         column_list = sed_cube_find_cross_shore_columns(s, i, j + shift_j);
     }
 
-    column_list = g_list_prepend(column_list, s->col[i][j]);
+    column_list = g_list_prepend(column_list, sed_cube_peek_col_ij(s, i, j));
 
     return column_list;
 }
@@ -3140,27 +3851,105 @@ sed_create_shore_tree(GList* shore)
     return tree;
 }
 
-Sed_riv
-sed_cube_find_river_mouth(Sed_cube c, Sed_riv this_river)
+/* Walk a ray from the center of the hinge cell to the edge of the grid,
+   writing the id of each cell it crosses into id.  The walk is the same
+   cell-to-cell stepping that the river path has always used; it ignores
+   topography so that the result can be cached by the river. */
+static gint
+_sed_cube_trace_ray(const Sed_cube c, const Eh_ind_2* hinge, double angle,
+    gint* id, gint max_len)
+{
+    gint     n = 0;
+    gint     i, j;
+    Eh_ind_2 shift;
+    Eh_pt_2  pos_in_cell;
+
+    eh_require(eh_is_in_domain(c->n_x, c->n_y, hinge->i, hinge->j));
+
+    angle = eh_reduce_angle(angle);
+
+    pos_in_cell.x = .5 * c->dx;
+    pos_in_cell.y = .5 * c->dy;
+
+    i = hinge->i;
+    j = hinge->j;
+
+    id[n++] = eh_grid_sub_to_id(c->n_y, i, j);
+
+    for (; n < max_len ; n++) {
+        pos_in_cell = get_path_exit_pos(pos_in_cell, angle, c->dx, c->dy);
+
+        shift       = get_shift_from_exit_pos(pos_in_cell, c->dx, c->dy);
+        pos_in_cell = get_path_entrance_pos(pos_in_cell, c->dx, c->dy);
+
+        i += shift.i;
+        j += shift.j;
+
+        if (!eh_is_in_domain(c->n_x, c->n_y, i, j)) {
+            break;
+        }
+
+        id[n] = eh_grid_sub_to_id(c->n_y, i, j);
+    }
+
+    eh_require(n < max_len || !eh_is_in_domain(c->n_x, c->n_y, i, j));
+
+    return n;
+}
+
+/* The ray from a river's hinge point, traced only if the river has
+   avulsed or the grid has changed shape since it was last traced. */
+static const gint*
+_sed_cube_river_ray(const Sed_cube c, Sed_riv river, gint* len)
+{
+    const gint* ray = sed_river_path(river, c->n_x, c->n_y, c->dx, c->dy,
+            len);
+
+    if (!ray) {
+        const gint max_len = c->n_x + c->n_y;
+        Eh_ind_2   hinge   = sed_river_hinge(river);
+        gint*      id      = sed_river_path_reserve(river, c->n_x, c->n_y,
+                c->dx, c->dy, max_len);
+
+        *len = _sed_cube_trace_ray(c, &hinge, sed_river_angle(river), id,
+                max_len);
+
+        sed_river_set_path_len(river, *len);
+
+        ray = id;
+    }
+
+    return ray;
+}
+
+/* Number of cells of a ray that make up the river: the ray up to and
+   including the first cell that is under water. */
+static gint
+_sed_cube_river_path_len(const Sed_cube c, const gint* ray, gint len)
 {
-    Eh_ind_2 hinge_pos;
-    Eh_ind_2* new_pos;
-    double hinge_angle;
+    Sed_column* col = c->col[0];
+    gint        n;
+
+    if (sed_column_is_below(col[ray[0]], c->sea_level)) {
+        return 1;
+    }
 
-    hinge_pos     = sed_river_hinge(this_river);
-    hinge_angle   = sed_river_angle(this_river);
+    for (n = 0 ; n < len && sed_column_is_above(col[ray[n]], c->sea_level - 1e-3) ;
+        n++);
 
-    //eh_watch_dbl (hinge_angle);
-    //eh_watch_int (hinge_pos.i);
-    //eh_watch_int (hinge_pos.j);
-    new_pos       = sed_find_river_mouth(c, &hinge_pos, hinge_angle);
-    //eh_watch_ptr (new_pos);
-    //eh_watch_int (new_pos->i);
-    //eh_watch_int (new_pos->j);
+    return (n < len) ? n + 1 : len;
+}
+
+Sed_riv
+sed_cube_find_river_mouth(Sed_cube c, Sed_riv this_river)
+{
+    gint        len;
+    const gint* ray = _sed_cube_river_ray(c, this_river, &len);
 
-    sed_river_set_mouth(this_river, new_pos->i, new_pos->j);
+    len = _sed_cube_river_path_len(c, ray, len);
 
-    eh_free(new_pos);
+    sed_river_set_mouth(this_river, ray[len - 1] / c->n_y,
+        ray[len - 1] % c->n_y);
 
     return this_river;
 }
@@ -3361,36 +4150,23 @@ sed_cube_river_path_id(Sed_cube c,
     eh_require(river);
 
     if (c && river) {
-        Eh_ind_2 hinge = sed_river_hinge(river);
-        double   angle = sed_river_angle(river);
-        GList*   path;
-
-        path = sed_cube_find_line_path(c, &hinge, angle);
-
-        eh_require(path);
-
-        if (path) {
-            gint   i;
-            gint   n_y = g_list_length(path);
-            GList* this_link;
+        gint        i, len;
+        const gint* ray = _sed_cube_river_ray(c, river, &len);
 
-            path_id = eh_new(gint, n_y + 1);
+        len     = _sed_cube_river_path_len(c, ray, len);
+        path_id = eh_new(gint, len + 1);
 
-            if (down_stream) {
-                path = g_list_reverse(path);
+        if (down_stream) {
+            for (i = 0 ; i < len ; i++) {
+                path_id[i] = ray[i];
             }
-
-            for (i = 0, this_link = path ; this_link ; this_link = this_link->next, i++) {
-                path_id[i] = eh_grid_sub_to_id(c->n_y,
-                        ((Eh_ind_2*)(this_link->data))->i,
-                        ((Eh_ind_2*)(this_link->data))->j);
-                eh_free(this_link->data);
+        } else {
+            for (i = 0 ; i < len ; i++) {
+                path_id[i] = ray[len - 1 - i];
             }
-
-            path_id[n_y] = -1;
-
-            g_list_free(path);
         }
+
+        path_id[len] = -1;
     }
 
     return path_id;
@@ -3399,10 +4175,18 @@ sed_cube_river_path_id(Sed_cube c,
 GList*
 sed_cube_river_path(Sed_cube c, Sed_riv river)
 {
-    Eh_ind_2 hinge = sed_river_hinge(river);
-    double   angle = sed_river_angle(river);
+    gint        n, len;
+    const gint* ray  = _sed_cube_river_ray(c, river, &len);
+    GList*      path = NULL;
+
+    len = _sed_cube_river_path_len(c, ray, len);
+
+    for (n = 0 ; n < len ; n++) {
+        Eh_ind_2 pos = eh_ind_2_create(ray[n] / c->n_y, ray[n] % c->n_y);
+        path = g_list_prepend(path, eh_ind_2_dup(&pos, NULL));
+    }
 
-    return sed_cube_find_line_path(c, &hinge, angle);
+    return path;
 }
 
 GList*
@@ -3411,55 +4195,23 @@ sed_cube_find_line_path(Sed_cube c,
     double angle)
 {
     GList* river_path = NULL;
-    int n, i, j;
-    int max_iter;
-    Eh_ind_2 river_pos;
-    Eh_ind_2 shift;
-    Eh_pt_2 pos_in_cell;
-
-    angle = eh_reduce_angle(angle);
-
-    pos_in_cell.x = .5 * c->dx;
-    pos_in_cell.y = .5 * c->dy;
 
     eh_require(c);
     eh_require(hinge_pos);
-    eh_require(eh_is_in_domain(c->n_x, c->n_y, hinge_pos->i, hinge_pos->j));
-
-    i = hinge_pos->i;
-    j = hinge_pos->j;
-
-    river_path = g_list_prepend(river_path, eh_ind_2_dup(hinge_pos, NULL));
-
-    if (sed_column_is_below(c->col[i][j], c->sea_level)) {
-        return river_path;
-    }
-
-    max_iter = c->n_x * c->n_y + 1;
 
-    for (n = 0 ;
-        eh_is_in_domain(c->n_x, c->n_y, i, j)
-        && sed_column_is_above(c->col[i][j], c->sea_level - 1e-3)
-        && n < max_iter ;
-        n++) {
-        pos_in_cell = get_path_exit_pos(pos_in_cell, angle, c->dx, c->dy);
-
-        shift       = get_shift_from_exit_pos(pos_in_cell, c->dx, c->dy);
-        pos_in_cell = get_path_entrance_pos(pos_in_cell, c->dx, c->dy);
-
-        i += shift.i;
-        j += shift.j;
+    {
+        gint  n, len;
+        gint* ray = eh_new(gint, c->n_x + c->n_y);
 
-        if (eh_is_in_domain(c->n_x, c->n_y, i, j)) {
-            river_pos = eh_ind_2_create(i, j);
+        len = _sed_cube_trace_ray(c, hinge_pos, angle, ray, c->n_x + c->n_y);
+        len = _sed_cube_river_path_len(c, ray, len);
 
-            river_path = g_list_prepend(river_path,
-                    eh_ind_2_dup(&river_pos, NULL));
+        for (n = 0 ; n < len ; n++) {
+            Eh_ind_2 pos = eh_ind_2_create(ray[n] / c->n_y, ray[n] % c->n_y);
+            river_path = g_list_prepend(river_path, eh_ind_2_dup(&pos, NULL));
         }
-    }
 
-    if (n == max_iter) {
-        eh_require_not_reached();
+        eh_free(ray);
     }
 
     return river_path;
@@ -3839,23 +4591,20 @@ sed_get_floor_sequence_2(const char* file,
     return grid_seq;
 }
 
-Eh_sequence*
-sed_get_floor_sequence_3(const char* file,
-    double dx,
-    double dy,
-    GError** error)
+/* Open a 3D grid sequence file and read its header.
+
+The number of columns and rows are listed first as two (32 bit) ints.  Each
+frame that follows is a time (a double) and a grid of doubles.  On success,
+the returned file is positioned at the start of the first frame.
+*/
+static FILE*
+_sed_floor_sequence_open_3(const char* file, gint* n_x, gint* n_y, gint* n_t,
+    gboolean* is_wrong_byte_order, GError** error)
 {
-    Eh_dbl_grid  grid     = NULL;
-    Eh_sequence* grid_seq = NULL;
     FILE* fp;
-    int i, n, n_elem;
-    size_t start, end;
-    gint n_x, n_y, n_t;
-    double t;
     GError* tmp_err = NULL;
-    gboolean is_wrong_byte_order = FALSE;
 
-    eh_return_val_if_fail(error == NULL || *error == NULL, NULL);
+    *is_wrong_byte_order = FALSE;
 
     //---
     // Open the sequence file.
@@ -3867,30 +4616,33 @@ sed_get_floor_sequence_3(const char* file,
         //---
         // The number of columns and rows are listed first as an int (32).
         //---
-        fread(&n_y, sizeof(gint32), 1, fp);
-        fread(&n_x, sizeof(gint32), 1, fp);
+        fread(n_y, sizeof(gint32), 1, fp);
+        fread(n_x, sizeof(gint32), 1, fp);
 
         //---
         // A simple check for the wrong byte order
         //---
-        if (n_x <= 0 || n_y <= 0 || n_x > 10000000 || n_y > 10000000) {
+        if (*n_x <= 0 || *n_y <= 0 || *n_x > 10000000 || *n_y > 10000000) {
             rewind(fp);
 
-            eh_fread_int32_swap(&n_y, sizeof(gint32), 1, fp);
-            eh_fread_int32_swap(&n_x, sizeof(gint32), 1, fp);
+            eh_fread_int32_swap(n_y, sizeof(gint32), 1, fp);
+            eh_fread_int32_swap(n_x, sizeof(gint32), 1, fp);
 
-            is_wrong_byte_order = TRUE;
+            *is_wrong_byte_order = TRUE;
         }
 
-        if (n_x <= 0 || n_y <= 0) {
+        if (*n_x <= 0 || *n_y <= 0) {
             g_set_error(&tmp_err,
                 SED_CUBE_ERROR,
                 SED_CUBE_ERROR_BAD_GRID_DIMENSION,
-                "Bad grid dimension (n_x=%d, n_y=%d)", n_x, n_y);
+                "Bad grid dimension (n_x=%d, n_y=%d)", *n_x, *n_y);
         }
     }
 
     if (!tmp_err) {
+        size_t start, end;
+        int n_elem;
+
         //---
         // Calculate the number of rows in the file based on the number of columns
         // and the file size.  If this is not a whole number, something is wrong.
@@ -3901,16 +4653,49 @@ sed_get_floor_sequence_3(const char* file,
         fseek(fp, start, SEEK_SET);
 
         n_elem = (end - start) / sizeof(double);
-        n_t    = n_elem / (n_x * n_y + 1);
+        *n_t   = n_elem / (*n_x * *n_y + 1);
 
-        if ((n_x * n_y + 1)*n_t != n_elem) {
+        if ((*n_x * *n_y + 1) * *n_t != n_elem) {
             g_set_error(&tmp_err,
                 SED_CUBE_ERROR,
                 SED_CUBE_ERROR_TRUNCATED_FILE,
-                "Sequence file is truncated (%d complete records found)", n_t);
+                "Sequence file is truncated (%d complete records found)", *n_t);
+        }
+    }
+
+    if (tmp_err) {
+        if (fp) {
+            fclose(fp);
         }
+
+        fp = NULL;
+
+        g_propagate_error(error, tmp_err);
     }
 
+    return fp;
+}
+
+Eh_sequence*
+sed_get_floor_sequence_3(const char* file,
+    double dx,
+    double dy,
+    GError** error)
+{
+    Eh_dbl_grid  grid     = NULL;
+    Eh_sequence* grid_seq = NULL;
+    FILE* fp;
+    int i, n;
+    gint n_x, n_y, n_t;
+    double t;
+    GError* tmp_err = NULL;
+    gboolean is_wrong_byte_order = FALSE;
+
+    eh_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+    fp = _sed_floor_sequence_open_3(file, &n_x, &n_y, &n_t, &is_wrong_byte_order,
+            &tmp_err);
+
     if (!tmp_err) {
         //---
         // Read the sequence of grids.  A frame of a sequence consists of a key
@@ -3958,6 +4743,8 @@ sed_get_floor_sequence_3(const char* file,
                     n - 1, grid_seq->t[n - 1], n, grid_seq->t[n]);
             }
         }
+
+        fclose(fp);
     }
 
     if (tmp_err) {
@@ -3973,11 +4760,131 @@ sed_get_floor_sequence_3(const char* file,
         g_propagate_error(error, tmp_err);
     }
 
-    fclose(fp);
-
     return grid_seq;
 }
 
+/** Read the times of a 3D grid sequence
+
+Only the time of each frame is read; the grids are left on disk so that they
+can be read one at a time with sed_get_floor_sequence_frame_3.
+
+@param file  Name of a grid sequence file (see sed_get_floor_sequence_3)
+@param n_x   Location to put the number of rows of each grid
+@param n_y   Location to put the number of columns of each grid
+@param n_t   Location to put the number of frames
+@param error Location of a GError (or NULL)
+
+@return A newly-allocated array of the times of each frame, or NULL on error.
+*/
+double*
+sed_get_floor_sequence_times_3(const char* file, gint* n_x, gint* n_y,
+    gint* n_t, GError** error)
+{
+    double* t = NULL;
+    GError* tmp_err = NULL;
+    gboolean is_wrong_byte_order;
+    FILE* fp;
+
+    eh_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+    fp = _sed_floor_sequence_open_3(file, n_x, n_y, n_t, &is_wrong_byte_order,
+            &tmp_err);
+
+    if (!tmp_err) {
+        const long frame_size = (long)(*n_x) * (*n_y) * sizeof(double);
+        gint n;
+
+        t = eh_new(double, *n_t);
+
+        for (n = 0 ; n < *n_t ; n++) {
+            if (is_wrong_byte_order) {
+                eh_fread_dbl_swap(t + n, sizeof(double), 1, fp);
+            } else {
+                fread(t + n, sizeof(double), 1, fp);
+            }
+
+            fseek(fp, frame_size, SEEK_CUR);
+        }
+
+        fclose(fp);
+
+        if (!eh_dbl_array_is_monotonic_up(t, *n_t)) {
+            g_set_error(&tmp_err,
+                SED_CUBE_ERROR,
+                SED_CUBE_ERROR_TIME_NOT_MONOTONIC,
+                "%s: The grid sequence must be monotonically increasing.\n",
+                file);
+        }
+    }
+
+    if (tmp_err) {
+        eh_free(t);
+        t = NULL;
+
+        g_propagate_error(error, tmp_err);
+    }
+
+    return t;
+}
+
+/** Read one frame of a 3D grid sequence
+
+@param file  Name of a grid sequence file (see sed_get_floor_sequence_3)
+@param n     Index of the frame to read
+@param dest  Location to put the grid data (or NULL)
+@param error Location of a GError (or NULL)
+
+@return The grid data of the frame (row-major), or NULL on error.  If \p dest
+        is NULL, a newly-allocated array is returned.
+*/
+double*
+sed_get_floor_sequence_frame_3(const char* file, gint n, double* dest,
+    GError** error)
+{
+    GError* tmp_err = NULL;
+    gboolean is_wrong_byte_order;
+    gint n_x, n_y, n_t;
+    FILE* fp;
+
+    eh_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+    fp = _sed_floor_sequence_open_3(file, &n_x, &n_y, &n_t, &is_wrong_byte_order,
+            &tmp_err);
+
+    if (!tmp_err && (n < 0 || n >= n_t)) {
+        g_set_error(&tmp_err,
+            SED_CUBE_ERROR,
+            SED_CUBE_ERROR_TRUNCATED_FILE,
+            "%s: Frame %d not found (%d frames)", file, n, n_t);
+        fclose(fp);
+    }
+
+    if (!tmp_err) {
+        const gint len = n_x * n_y;
+
+        if (!dest) {
+            dest = eh_new(double, len);
+        }
+
+        fseek(fp, ((long)n * (len + 1) + 1) * sizeof(double), SEEK_CUR);
+
+        if (is_wrong_byte_order) {
+            eh_fread_dbl_swap(dest, sizeof(double), len, fp);
+        } else {
+            fread(dest, sizeof(double), len, fp);
+        }
+
+        fclose(fp);
+    }
+
+    if (tmp_err) {
+        dest = NULL;
+        g_propagate_error(error, tmp_err);
+    }
+
+    return dest;
+}
+
 Eh_dbl_grid
 sed_bathy_grid_scan(const char* file, double dx, double dy, GError** error)
 {
@@ -4772,7 +5679,7 @@ sed_cube_to_cell(Sed_cube c, Sed_cell d)
         sed_cell_clear(d);
 
         for (i = 0 ; i < len ; i++) {
-            sed_column_top(sed_cube_col(c, i), sed_cube_thickness(c, 0, i), top);
+            sed_column_top(sed_cube_peek_col(c, i), sed_cube_thickness(c, 0, i), top);
             sed_cell_add(d, top);
         }
 
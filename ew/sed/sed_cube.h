@@ -159,6 +159,8 @@ Sed_cube
 sed_cube_set_dz(Sed_cube p, double new_dz);
 gint
 sed_cube_size(const Sed_cube s);
+gint64
+sed_cube_n_cells(const Sed_cube s);
 gint
 sed_cube_n_x(const Sed_cube s);
 gint
@@ -169,6 +171,10 @@ sed_cube_col(const Sed_cube s, gssize ind);
 Sed_column
 sed_cube_col_ij(const Sed_cube s, gssize i, gssize j);
 Sed_column
+sed_cube_peek_col(const Sed_cube s, gssize ind);
+Sed_column
+sed_cube_peek_col_ij(const Sed_cube s, gssize i, gssize j);
+Sed_column
 sed_cube_col_pos(const Sed_cube s, double x, double y);
 
 double
@@ -271,6 +277,10 @@ sed_cube_dup(Sed_cube c);
 Sed_cube
 sed_cube_copy(Sed_cube dest, const Sed_cube src);
 Sed_cube
+sed_cube_snapshot(const Sed_cube c);
+Sed_cube
+sed_cube_branch(Sed_cube dest, const Sed_cube src);
+Sed_cube
 sed_cube_copy_cols(const Sed_cube src, gssize* x, gssize* y, double* z, gssize len);
 Sed_cube
 sed_cube_copy_line(const Sed_cube src, double* x, double* y, double* z, gssize len);
@@ -284,6 +294,8 @@ Sed_cube
 sed_cube_add(Sed_cube dest, const Sed_cube src);
 
 //Sed_profile *sed_get_profile_from_cube( Sed_cube c , GList *path );
+gssize
+sed_cube_coalesce(Sed_cube p, const Sed_coalesce_profile* profile);
 double
 sed_cube_mass(const Sed_cube p);
 double
@@ -386,6 +398,19 @@ sed_cube_adjust_age(Sed_cube s, double dt);
 Sed_cube
 sed_cube_increment_age(Sed_cube s);
 
+const double*
+sed_cube_elevation_data(const Sed_cube s);
+const double*
+sed_cube_water_depth_data(const Sed_cube s);
+const double*
+sed_cube_thickness_data(const Sed_cube s);
+const double*
+sed_cube_load_data(const Sed_cube s);
+const double*
+sed_cube_x_slope_data(const Sed_cube s);
+const double*
+sed_cube_y_slope_data(const Sed_cube s);
+
 Eh_dbl_grid
 sed_cube_water_depth_grid(const Sed_cube s, gint* index);
 Eh_dbl_grid
@@ -399,6 +424,10 @@ gboolean*
 sed_cube_shore_mask(const Sed_cube s);
 gint*
 sed_cube_shore_ids(const Sed_cube s);
+const gint*
+sed_cube_shore_data(const Sed_cube s, gint* n);
+gint*
+sed_cube_shore_line_ids(const Sed_cube s);
 
 Sed_riv
 sed_cube_river_by_name(Sed_cube s, const char* name);
@@ -441,18 +470,13 @@ sed_load_cube(FILE* fp);
 gssize
 sed_cube_column_id(const Sed_cube c, double x, double y);
 void
-sed_set_shore(Sed_cube s);
+sed_cube_set_shore(Sed_cube s);
 GList*
 sed_cube_find_shore_line(Sed_cube s, Eh_ind_2* pos);
 
 Sed_riv
 sed_cube_find_river_mouth(Sed_cube c, Sed_riv this_river);
 
-GList*
-sed_find_next_shore(GList* shore_list,
-    Sed_cube s,
-    Eh_ind_2* pos,
-    GList* ignore_list);
 gint*
 sed_cube_shore_normal_shift(Sed_cube s, gint i, gint j);
 double
@@ -580,6 +604,12 @@ sed_get_floor_sequence_3(const char* file,
     double dx,
     double dy,
     GError** error);
+double*
+sed_get_floor_sequence_times_3(const char* file, gint* n_x, gint* n_y,
+    gint* n_t, GError** error);
+double*
+sed_get_floor_sequence_frame_3(const char* file, gint n, double* dest,
+    GError** error);
 
 Sed_cube
 sed_cube_foreach_river(Sed_cube c, GFunc func, gpointer user_data);
@@ -20,6 +20,7 @@
 
 #include "sed_process.h"
 #include "sed_signal.h"
+#include "sed_telemetry.h"
 
 typedef struct {
     // Public
@@ -95,6 +96,13 @@ static const gchar* sed_process_req_labels[] = {
 #define SED_PROCESS( ptr )      ( (Sed_process)(ptr) )
 #define SED_PROCESS_LINK( ptr ) ( (__Sed_process_link*)(ptr) )
 
+/* Values that replace those given in process files, as
+   "process name:key=value" strings */
+static gchar** _sed_process_key_overrides = NULL;
+
+/* Added to the seeds that processes read from their files */
+static guint32 _sed_process_seed_offset = 0;
+
 CLASS(Sed_process_queue)
 {
     GList* l; //< A list of processes
@@ -261,6 +269,115 @@ sed_process_queue_names(Sed_process_init_t p_list[])
     return str;
 }
 
+/** Override the values of keys in process files
+
+Each override is a string of the form "process name:key=value".  Whenever a
+process file is read, any of its groups named "process name" that contain
+"key" have that key's value replaced.  Keys that are not already in the
+file are not added.  The overrides apply to every process file read after
+this call, for the life of the program (or until they are set again).
+
+\param overrides A NULL-terminated list of overrides, or NULL to clear them
+*/
+void
+sed_process_set_key_overrides(const gchar** overrides)
+{
+    g_strfreev(_sed_process_key_overrides);
+    _sed_process_key_overrides = g_strdupv((gchar**)overrides);
+}
+
+/** Offset the random number seeds given in process files
+
+Processes that read a positive seed from their file use the seed plus this
+offset.  This lets each member of an ensemble draw its own random numbers,
+while each of its processes still has its own reproducible stream.
+
+\param offset Value to add to each positive seed
+*/
+void
+sed_process_set_seed_offset(guint32 offset)
+{
+    _sed_process_seed_offset = offset;
+}
+
+/** Create the random number stream of a process
+
+\param seed The seed read from a process file.  If not positive, the stream
+            is seeded from glib's global random number generator.
+
+\return A new Eh_rand.  Use eh_rand_destroy to free.
+*/
+Eh_rand*
+sed_process_rand_new(gint seed)
+{
+    if (seed > 0) {
+        return eh_rand_new_with_seed((guint64)seed + _sed_process_seed_offset);
+    } else {
+        return eh_rand_new();
+    }
+}
+
+/** Read a process's input value from its symbol table
+
+Values that are drawn from a distribution are seeded with the run seed (the
+offset set with sed_process_set_seed_offset), from a stream of their own
+that is named by the process and the key.  If there is no run seed, they
+are seeded from glib's global random number generator.
+
+\param p     A Sed_process
+\param tab   The symbol table of the process
+\param label The key to read
+\param error Location of a GError to indicate an error (or NULL)
+
+\return A new Eh_input_val, or NULL if an error occured
+*/
+Eh_input_val
+sed_process_input_value(Sed_process p, Eh_symbol_table tab,
+    const gchar* label, GError** error)
+{
+    Eh_input_val val = eh_symbol_table_input_value(tab, label, error);
+
+    if (val && p && _sed_process_seed_offset > 0) {
+        eh_input_val_set_seed(val, _sed_process_seed_offset, g_str_hash(p->name),
+            g_str_hash(label));
+    }
+
+    return val;
+}
+
+/** Apply the overrides set with sed_process_set_key_overrides to a key-file
+
+sed_process_queue_init applies them to every process file that it reads.
+
+\param key_file A key-file of process descriptions
+*/
+void
+sed_process_apply_key_overrides(Eh_key_file key_file)
+{
+    gchar** o;
+
+    for (o = _sed_process_key_overrides ; o && *o ; o++) {
+        gchar* colon = strchr(*o, ':');
+        gchar* equal = colon ? strchr(colon, '=') : NULL;
+
+        if (colon && equal) {
+            gchar* group = g_strstrip(g_strndup(*o, colon - *o));
+            gchar* key   = g_strstrip(g_strndup(colon + 1, equal - colon - 1));
+            gchar* value = g_strstrip(g_strdup(equal + 1));
+
+            if (eh_key_file_has_key(key_file, group, key)) {
+                eh_key_file_reset_value(key_file, group, key, value);
+            }
+
+            g_free(value);
+            g_free(key);
+            g_free(group);
+        } else {
+            eh_warning("Badly formed process key override: %s", *o);
+        }
+    }
+}
+
 Sed_process_queue
 sed_process_queue_init(const gchar* file,
     const gchar* prefix,
@@ -285,6 +402,7 @@ sed_process_queue_init(const gchar* file,
             gssize i;
 
             eh_key_file_reset_value(key_file, NULL, SED_KEY_PREFIX, prefix);
+            sed_process_apply_key_overrides(key_file);
 
             q = sed_process_queue_new();
 
@@ -645,6 +763,7 @@ sed_process_queue_run_until(Sed_process_queue q, Sed_cube p, double t_total)
         double t = sed_cube_age_in_years(p);
         const double dt = sed_cube_time_step(p);
         int last_iteration = FALSE;
+        Sed_telemetry telemetry = sed_telemetry_default();
 
         if (t >= t_total) {
             return q;
@@ -674,8 +793,12 @@ sed_process_queue_run_until(Sed_process_queue q, Sed_cube p, double t_total)
             sed_cube_increment_age(p);
             t = sed_cube_age_in_years(p);
 
+            sed_telemetry_update(telemetry, q, p);
+
         } while (t < t_total && !last_iteration);
 
+        sed_telemetry_publish(telemetry, q, p);
+
         sed_cube_set_time_step(p, dt);
 
         if (fabs(sed_cube_age_in_years(p) - t_total) <= 1e-6) {
@@ -1299,6 +1422,20 @@ sed_process_queue_fprint(FILE* fp, Sed_process_queue q)
     return n;
 }
 
+/* Call a function for every process object of a queue, in the order that
+   they are run. */
+void
+sed_process_queue_foreach(Sed_process_queue q, GFunc func, gpointer user_data)
+{
+    if (q && func) {
+        GList* link;
+
+        for (link = q->l ; link ; link = link->next) {
+            g_list_foreach(SED_PROCESS_LINK(link->data)->obj_list, func, user_data);
+        }
+    }
+}
+
 gssize
 sed_process_queue_size(Sed_process_queue q)
 {
@@ -1450,6 +1587,28 @@ sed_process_run_count(Sed_process p)
     return p->run_count;
 }
 
+/* Wall time (in seconds) spent in the run function of a process */
+double
+sed_process_run_time(Sed_process p)
+{
+    eh_return_val_if_fail(p, 0.);
+    return p->info->secs + p->info->u_secs / 1.e6;
+}
+
+double
+sed_process_mass_total_added(Sed_process p)
+{
+    eh_return_val_if_fail(p, 0.);
+    return p->info->mass_total_added;
+}
+
+double
+sed_process_mass_total_lost(Sed_process p)
+{
+    eh_return_val_if_fail(p, 0.);
+    return p->info->mass_total_lost;
+}
+
 gboolean
 sed_process_is_set(Sed_process p)
 {
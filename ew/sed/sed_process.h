@@ -154,6 +154,8 @@ gssize
 sed_process_queue_fprint(FILE* fp, Sed_process_queue q);
 gssize
 sed_process_queue_summary(FILE* fp, Sed_process_queue q);
+void
+sed_process_queue_foreach(Sed_process_queue q, GFunc func, gpointer user_data);
 gssize
 sed_process_queue_size(Sed_process_queue q);
 gssize
@@ -192,6 +194,12 @@ gchar*
 sed_process_prefix(Sed_process p);
 gint
 sed_process_run_count(Sed_process p);
+double
+sed_process_run_time(Sed_process p);
+double
+sed_process_mass_total_added(Sed_process p);
+double
+sed_process_mass_total_lost(Sed_process p);
 gboolean
 sed_process_is_set(Sed_process p);
 gpointer
@@ -231,6 +239,17 @@ Sed_process_queue
 sed_process_queue_destroy(Sed_process_queue);
 char*
 sed_process_queue_names(Sed_process_init_t p_list[]);
+void
+sed_process_set_key_overrides(const gchar** overrides);
+void
+sed_process_apply_key_overrides(Eh_key_file key_file);
+void
+sed_process_set_seed_offset(guint32 offset);
+Eh_rand*
+sed_process_rand_new(gint seed);
+Eh_input_val
+sed_process_input_value(Sed_process p, Eh_symbol_table tab,
+    const gchar* label, GError** error);
 Sed_process_queue
 sed_process_queue_init(const gchar* file,
     const gchar* prefix,
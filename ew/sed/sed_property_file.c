@@ -411,13 +411,13 @@ sed_cube_property_subgrid(Sed_cube p,
     eh_dbl_array_grid(eh_ndgrid_x(g_3, 1), eh_ndgrid_n(g_3, 1), lower_left_y, dy);
     eh_dbl_array_grid(eh_ndgrid_x(g_3, 2), eh_ndgrid_n(g_3, 2), lower_left_z, dz);
 
-    col_temp = sed_column_dup(sed_cube_col(p, cols[0]));
+    col_temp = sed_column_dup(sed_cube_peek_col(p, cols[0]));
 
     top    = lower_left_z + n_rows * dz;
     bottom = lower_left_z;
 
     for (i = 0, id = cols[0], n = 0 ; cols[n] >= 0 ; i++, id = cols[++n]) {
-        sed_column_copy(col_temp, sed_cube_col(p, id));
+        sed_column_copy(col_temp, sed_cube_peek_col(p, id));
 
         sed_column_set_z_res(col_temp, dz);
         sed_column_rebin(col_temp);
@@ -645,7 +645,7 @@ sed_cube_n_rows_between(Sed_cube p, double dz, double lower, double upper,
 
         for (id = col_id[0], n = 0 ; col_id[n] >= 0 ; id = col_id[++n]) {
             row_0 = (long)(sed_cube_base_height(p, 0, id) / dz);
-            row_1 = row_0 +    sed_column_len(sed_cube_col(p, id))
+            row_1 = row_0 +    sed_column_len(sed_cube_peek_col(p, id))
                 * (rows_per_cell) + 1;
             eh_set_min(bottom_row, row_0);
             eh_set_max(top_row, row_1);
@@ -685,7 +685,7 @@ sed_cube_n_rows(Sed_cube p)
 
         for (id = 0; id < len; id++) {
             row_0 = (long)(sed_cube_base_height(p, 0, id) / dz);
-            row_1 = row_0 + sed_column_len(sed_cube_col(p, id)) + 1;
+            row_1 = row_0 + sed_column_len(sed_cube_peek_col(p, id)) + 1;
 
             eh_set_min(bottom_row, row_0);
             eh_set_max(top_row, row_1);
@@ -14,6 +14,26 @@ typedef struct {
 }
 Sed_riv_hinge;
 
+/**
+   The cells crossed by a ray leaving the hinge point, along with the
+   geometry it was traced for.  The ray runs to the edge of the grid
+   regardless of topography so it only goes stale when the river avulses
+   or the grid changes shape.
+*/
+typedef struct {
+    gint*  id;     ///< Cube ids of the cells along the ray, hinge first
+    gint   len;    ///< Number of cells in the ray
+    gint   size;   ///< Allocated length of id
+    gint   i;      ///< x-index of the hinge the ray was traced from
+    gint   j;      ///< y-index of the hinge the ray was traced from
+    double angle;  ///< Angle the ray was traced at
+    gint   n_x;    ///< Number of rows in the traced grid
+    gint   n_y;    ///< Number of columns in the traced grid
+    double dx;     ///< Row spacing of the traced grid
+    double dy;     ///< Column spacing of the traced grid
+}
+Sed_riv_path;
+
 /**
    Describe a river.
 */
@@ -26,6 +46,7 @@ CLASS(Sed_riv)
     gchar*         name;    ///< The name of the river
     Sed_riv        l;
     Sed_riv        r;
+    Sed_riv_path   path;    ///< Cached ray from the hinge point
 };
 
 Sed_riv_hinge*
@@ -94,6 +115,10 @@ sed_river_new(const gchar* name)
     r->l     = NULL;
     r->r     = NULL;
 
+    r->path.id   = NULL;
+    r->path.len  = 0;
+    r->path.size = 0;
+
     return r;
 }
 
@@ -257,6 +282,92 @@ sed_river_set_hinge(Sed_riv r, gint i, gint j)
     return r;
 }
 
+/** Get the cached ray from the hinge point of a river
+
+The cache is valid if it was traced from the river's current hinge point
+and angle on a grid of the given shape.
+
+\param r   A Sed_riv
+\param n_x Number of rows in the grid
+\param n_y Number of columns in the grid
+\param dx  Row spacing of the grid
+\param dy  Column spacing of the grid
+\param len Location to put the number of cells in the ray
+
+\return The cube ids along the ray (owned by the river), or NULL if the
+        cache is stale
+*/
+const gint*
+sed_river_path(Sed_riv r, gint n_x, gint n_y, double dx, double dy,
+    gint* len)
+{
+    const gint* id = NULL;
+
+    if (r && r->path.len > 0
+        && r->path.i == r->hinge->i && r->path.j == r->hinge->j
+        && r->path.angle == r->hinge->angle
+        && r->path.n_x == n_x && r->path.n_y == n_y
+        && r->path.dx == dx && r->path.dy == dy) {
+        id = r->path.id;
+
+        if (len) {
+            *len = r->path.len;
+        }
+    }
+
+    return id;
+}
+
+/** Make room to trace a new ray from the hinge point of a river
+
+The cache is keyed to the river's current hinge point and angle, and the
+given grid.  Once the ray is written, set its length with
+sed_river_set_path_len.
+
+\param r   A Sed_riv
+\param n_x Number of rows in the grid
+\param n_y Number of columns in the grid
+\param dx  Row spacing of the grid
+\param dy  Column spacing of the grid
+\param n   Maximum number of cells in the ray
+
+\return A buffer for at least n cube ids (owned by the river)
+*/
+gint*
+sed_river_path_reserve(Sed_riv r, gint n_x, gint n_y, double dx, double dy,
+    gint n)
+{
+    eh_require(r);
+    eh_require(n > 0);
+
+    if (n > r->path.size) {
+        r->path.id   = eh_renew(gint, r->path.id, n);
+        r->path.size = n;
+    }
+
+    r->path.len   = 0;
+    r->path.i     = r->hinge->i;
+    r->path.j     = r->hinge->j;
+    r->path.angle = r->hinge->angle;
+    r->path.n_x   = n_x;
+    r->path.n_y   = n_y;
+    r->path.dx    = dx;
+    r->path.dy    = dy;
+
+    return r->path.id;
+}
+
+Sed_riv
+sed_river_set_path_len(Sed_riv r, gint len)
+{
+    if (r) {
+        eh_require(len <= r->path.size);
+        r->path.len = len;
+    }
+
+    return r;
+}
+
 Sed_riv
 sed_river_set_mouth(Sed_riv r, gint i, gint j)
 {
@@ -623,6 +734,7 @@ sed_river_destroy(Sed_riv s)
         sed_river_destroy(s->l);
         sed_river_destroy(s->r);
 
+        eh_free(s->path.id);
         eh_free(s);
     }
 
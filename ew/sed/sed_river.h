@@ -36,6 +36,14 @@ Sed_riv
 sed_river_set_hinge(Sed_riv r, gint i, gint j);
 Sed_riv
 sed_river_set_mouth(Sed_riv r, gint i, gint j);
+const gint*
+sed_river_path(Sed_riv r, gint n_x, gint n_y, double dx, double dy,
+    gint* len);
+gint*
+sed_river_path_reserve(Sed_riv r, gint n_x, gint n_y, double dx, double dy,
+    gint n);
+Sed_riv
+sed_river_set_path_len(Sed_riv r, gint len);
 
 Sed_riv
 sed_river_adjust_mass(Sed_riv s, double f);
@@ -41,5 +41,6 @@
 #include "sed_river.h"
 #include "sed_signal.h"
 #include "sed_diag.h"
+#include "sed_telemetry.h"
 
 #endif
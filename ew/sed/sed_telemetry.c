@@ -0,0 +1,510 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <glib.h>
+#include <sed/sed_telemetry.h>
+
+/* Default number of seconds between snapshots */
+#define SED_TELEMETRY_INTERVAL (10.)
+
+typedef struct {
+    gchar* name;
+    double secs;
+    gint   run_count;
+    double mass_added;
+    double mass_lost;
+}
+Sed_telemetry_process;
+
+typedef struct {
+    double  wall;               //< Wall time (s) when the values were collected
+    double  model_time;         //< Age of the cube (years)
+    gint64  n_steps;            //< Number of time steps taken
+    gint    n_x;                //< Number of rows of columns
+    gint    n_y;                //< Number of columns of columns
+    gint64  n_cells;            //< Number of cells in all the columns
+    double  mass;               //< Mass of sediment in the cube (kg)
+    double  mass_in_suspension; //< Mass of sediment in suspension (kg)
+    GArray* procs;              //< Sed_telemetry_process for each process
+}
+Sed_telemetry_state;
+
+/** A live snapshot of a running model
+
+A background thread wakes every few seconds and asks for fresh values.  The
+model thread notices the request at the end of its next time step, collects
+the values and hands them over.  The thread then renders them into a
+key-file and writes it with an atomic rename, so that a reader never sees a
+partial file.
+
+If the model stops stepping, the file is still rewritten, and the time since
+the last update keeps growing.  That, along with the simulated years per
+wall second, is what a farm monitor should look at.
+*/
+CLASS(Sed_telemetry)
+{
+    gchar*        file;       //< Name of the snapshot file
+    double        interval;   //< Seconds between snapshots
+    pid_t         pid;        //< Process that owns the writer thread
+    GTimer*       timer;      //< Wall time since the telemetry was created
+    GThread*      thread;     //< Writer thread
+    GMutex        lock;       //< Guards the members below
+    GCond         cond;
+    gboolean      done;       //< Set to stop the writer thread
+    volatile gint wanted;     //< Set when the writer wants fresh values
+    gint          n_failed;   //< Number of failed writes
+    gboolean      has_state;  //< Have any values been collected?
+    Sed_telemetry_state now;  //< The last values collected
+    Sed_telemetry_state first;//< Times of the first values collected
+    Sed_telemetry_state last; //< Times of the values of the last write
+    gint64        n_steps;    //< Time steps taken (used by the model thread only)
+};
+
+static Sed_telemetry _sed_telemetry = NULL;
+
+static void
+_sed_telemetry_state_clear(Sed_telemetry_state* s)
+{
+    if (s->procs) {
+        guint i;
+
+        for (i = 0 ; i < s->procs->len ; i++) {
+            g_free(g_array_index(s->procs, Sed_telemetry_process, i).name);
+        }
+
+        g_array_free(s->procs, TRUE);
+        s->procs = NULL;
+    }
+}
+
+static void
+_sed_telemetry_add_process(Sed_process p, GArray* procs)
+{
+    Sed_telemetry_process info;
+
+    info.name       = sed_process_name(p);
+    info.secs       = sed_process_run_time(p);
+    info.run_count  = sed_process_run_count(p);
+    info.mass_added = sed_process_mass_total_added(p);
+    info.mass_lost  = sed_process_mass_total_lost(p);
+
+    g_array_append_val(procs, info);
+}
+
+static void
+_sed_telemetry_collect(Sed_telemetry t, Sed_process_queue q, Sed_cube p,
+    Sed_telemetry_state* s)
+{
+    s->wall               = g_timer_elapsed(t->timer, NULL);
+    s->model_time         = sed_cube_age_in_years(p);
+    s->n_steps            = t->n_steps;
+    s->n_x                = sed_cube_n_x(p);
+    s->n_y                = sed_cube_n_y(p);
+    s->n_cells            = sed_cube_n_cells(p);
+    s->mass               = sed_cube_mass(p);
+    s->mass_in_suspension = sed_cube_mass_in_suspension(p);
+    s->procs              = g_array_new(FALSE, FALSE, sizeof(Sed_telemetry_process));
+
+    sed_process_queue_foreach(q, (GFunc)&_sed_telemetry_add_process, s->procs);
+}
+
+/* Resident set size of this process, in bytes.  Where /proc is not
+   available, use the peak resident size instead. */
+static gint64
+_sed_telemetry_resident_memory(void)
+{
+    gint64 rss = -1;
+    gchar* statm;
+
+    if (g_file_get_contents("/proc/self/statm", &statm, NULL, NULL)) {
+        gint64 size, resident;
+
+        if (sscanf(statm, "%" G_GINT64_FORMAT " %" G_GINT64_FORMAT,
+                &size, &resident) == 2) {
+            rss = resident * sysconf(_SC_PAGESIZE);
+        }
+
+        g_free(statm);
+    }
+
+    if (rss < 0) {
+        struct rusage usage;
+
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            rss = (gint64)usage.ru_maxrss * 1024;
+        }
+    }
+
+    return rss;
+}
+
+/* Render the snapshot as a key-file.  Called with the lock held. */
+static GString*
+_sed_telemetry_render(Sed_telemetry t, const gchar* status)
+{
+    GString*                   text = g_string_new(NULL);
+    const Sed_telemetry_state* now  = &t->now;
+    const double               wall = g_timer_elapsed(t->timer, NULL);
+
+    g_string_append_printf(text, "[ 'telemetry' ]\n");
+    g_string_append_printf(text, "status: %s\n", status);
+    g_string_append_printf(text, "pid: %d\n", (gint)t->pid);
+    g_string_append_printf(text, "wall clock: %ld\n", (glong)time(NULL));
+    g_string_append_printf(text, "elapsed wall time: %.3f\n", wall);
+    g_string_append_printf(text, "resident memory: %" G_GINT64_FORMAT "\n",
+        _sed_telemetry_resident_memory());
+
+    if (t->has_state) {
+        double rate      = 0.;
+        double mean_rate = 0.;
+        double added     = 0.;
+        double lost      = 0.;
+        guint  i;
+
+        if (now->wall > t->last.wall) {
+            rate = (now->model_time - t->last.model_time)
+                / (now->wall - t->last.wall);
+        }
+
+        if (now->wall > t->first.wall) {
+            mean_rate = (now->model_time - t->first.model_time)
+                / (now->wall - t->first.wall);
+        }
+
+        for (i = 0 ; i < now->procs->len ; i++) {
+            added += g_array_index(now->procs, Sed_telemetry_process, i).mass_added;
+            lost  += g_array_index(now->procs, Sed_telemetry_process, i).mass_lost;
+        }
+
+        g_string_append_printf(text, "seconds since update: %.3f\n",
+            wall - now->wall);
+        g_string_append_printf(text, "model time: %.17g\n", now->model_time);
+        g_string_append_printf(text, "time steps: %" G_GINT64_FORMAT "\n",
+            now->n_steps);
+        g_string_append_printf(text, "years per second: %g\n", rate);
+        g_string_append_printf(text, "mean years per second: %g\n", mean_rate);
+
+        g_string_append_printf(text, "\n[ 'cube' ]\n");
+        g_string_append_printf(text, "rows: %d\n", now->n_x);
+        g_string_append_printf(text, "columns per row: %d\n", now->n_y);
+        g_string_append_printf(text, "columns: %d\n", now->n_x * now->n_y);
+        g_string_append_printf(text, "cells: %" G_GINT64_FORMAT "\n",
+            now->n_cells);
+
+        g_string_append_printf(text, "\n[ 'mass balance' ]\n");
+        g_string_append_printf(text, "mass: %.17g\n", now->mass);
+        g_string_append_printf(text, "mass in suspension: %.17g\n",
+            now->mass_in_suspension);
+        g_string_append_printf(text, "mass added: %.17g\n", added);
+        g_string_append_printf(text, "mass lost: %.17g\n", lost);
+
+        for (i = 0 ; i < now->procs->len ; i++) {
+            const Sed_telemetry_process* proc =
+                &g_array_index(now->procs, Sed_telemetry_process, i);
+
+            g_string_append_printf(text, "\n[ 'process %s' ]\n", proc->name);
+            g_string_append_printf(text, "run time: %.6f\n", proc->secs);
+            g_string_append_printf(text, "run count: %d\n", proc->run_count);
+            g_string_append_printf(text, "mass added: %.17g\n", proc->mass_added);
+            g_string_append_printf(text, "mass lost: %.17g\n", proc->mass_lost);
+        }
+
+        t->last.wall       = now->wall;
+        t->last.model_time = now->model_time;
+    }
+
+    return text;
+}
+
+/* Write the snapshot file.  Called with the lock held, which is released
+   while the file is written so that the model thread never waits on the
+   file system. */
+static gboolean
+_sed_telemetry_write(Sed_telemetry t, const gchar* status, GError** error)
+{
+    GString* text = _sed_telemetry_render(t, status);
+    gboolean ok;
+
+    g_mutex_unlock(&t->lock);
+    ok = g_file_set_contents(t->file, text->str, text->len, error);
+    g_mutex_lock(&t->lock);
+
+    g_string_free(text, TRUE);
+
+    return ok;
+}
+
+static gpointer
+_sed_telemetry_run(gpointer data)
+{
+    Sed_telemetry t = (Sed_telemetry)data;
+
+    g_mutex_lock(&t->lock);
+
+    while (!t->done) {
+        const gint64 end = g_get_monotonic_time()
+            + (gint64)(t->interval * G_TIME_SPAN_SECOND);
+
+        g_atomic_int_set(&t->wanted, TRUE);
+
+        while (!t->done && g_cond_wait_until(&t->cond, &t->lock, end))
+            ;
+
+        if (!t->done) {
+            GError* error = NULL;
+
+            if (!_sed_telemetry_write(t, "running", &error)) {
+                if (t->n_failed++ == 0) {
+                    eh_warning("Unable to write telemetry file: %s", error->message);
+                }
+
+                g_error_free(error);
+            }
+        }
+    }
+
+    g_mutex_unlock(&t->lock);
+
+    return NULL;
+}
+
+/** Create a telemetry file that is updated in the background
+
+\param file      Name of the snapshot file.  A relative name is taken to be
+                 relative to the current directory.
+\param interval  Seconds between snapshots.  If not positive, a default of
+                 ten seconds is used.
+
+\return A new Sed_telemetry.  Should be destroyed with sed_telemetry_destroy.
+*/
+Sed_telemetry
+sed_telemetry_new(const gchar* file, double interval)
+{
+    Sed_telemetry t = NULL;
+
+    eh_return_val_if_fail(file, NULL);
+
+    NEW_OBJECT(Sed_telemetry, t);
+
+    if (g_path_is_absolute(file)) {
+        t->file = g_strdup(file);
+    } else {
+        gchar* dir = g_get_current_dir();
+        t->file = g_build_filename(dir, file, NULL);
+        g_free(dir);
+    }
+
+    t->interval  = interval > 0. ? interval : SED_TELEMETRY_INTERVAL;
+    t->pid       = getpid();
+    t->timer     = g_timer_new();
+    t->done      = FALSE;
+    t->wanted    = FALSE;
+    t->n_failed  = 0;
+    t->has_state = FALSE;
+    t->n_steps   = 0;
+
+    memset(&t->now, 0, sizeof(Sed_telemetry_state));
+    memset(&t->first, 0, sizeof(Sed_telemetry_state));
+    memset(&t->last, 0, sizeof(Sed_telemetry_state));
+
+    g_mutex_init(&t->lock);
+    g_cond_init(&t->cond);
+
+    t->thread = g_thread_new("sed-telemetry", &_sed_telemetry_run, t);
+
+    return t;
+}
+
+/** Stop the writer thread and write a final snapshot
+
+The final snapshot is written with a status of "finished".
+
+In the child of a forked process, the writer thread and the lock belong to
+the parent.  The child's copy is then freed without touching either, and the
+parent's file is left alone.
+*/
+Sed_telemetry
+sed_telemetry_destroy(Sed_telemetry t)
+{
+    if (t && t->pid != getpid()) {
+        // The lock may have been held when we were forked, so the collected
+        // values may be half swapped.  Leave them be.
+        g_timer_destroy(t->timer);
+        g_free(t->file);
+        eh_free(t);
+    } else if (t) {
+        g_mutex_lock(&t->lock);
+        t->done = TRUE;
+        g_cond_signal(&t->cond);
+        g_mutex_unlock(&t->lock);
+
+        g_thread_join(t->thread);
+
+        g_mutex_lock(&t->lock);
+        _sed_telemetry_write(t, "finished", NULL);
+        g_mutex_unlock(&t->lock);
+
+        _sed_telemetry_state_clear(&t->now);
+
+        g_mutex_clear(&t->lock);
+        g_cond_clear(&t->cond);
+        g_timer_destroy(t->timer);
+        g_free(t->file);
+        eh_free(t);
+    }
+
+    return NULL;
+}
+
+/** Hand the state of the model to the telemetry, when it is wanted
+
+Call this at the end of every time step.  Nothing is collected unless the
+writer thread has asked for fresh values since they were last handed over,
+so the cost of a call is a single atomic read.
+
+\param t  A Sed_telemetry (or NULL, in which case nothing is done)
+\param q  The process queue that is being run
+\param p  The cube that is being run
+*/
+void
+sed_telemetry_update(Sed_telemetry t, Sed_process_queue q, Sed_cube p)
+{
+    if (t && p) {
+        t->n_steps++;
+
+        if (g_atomic_int_get(&t->wanted)) {
+            sed_telemetry_publish(t, q, p);
+        }
+    }
+}
+
+/** Hand the state of the model to the telemetry
+
+Unlike sed_telemetry_update, the values are always collected.  Use this when
+a run is about to stop.
+
+A child of a forked process does not have the writer thread, and so it
+is ignored.
+*/
+void
+sed_telemetry_publish(Sed_telemetry t, Sed_process_queue q, Sed_cube p)
+{
+    if (t && p && t->pid == getpid()) {
+        Sed_telemetry_state s;
+        Sed_telemetry_state old;
+
+        _sed_telemetry_collect(t, q, p, &s);
+
+        g_mutex_lock(&t->lock);
+
+        if (!t->has_state) {
+            t->first.wall       = s.wall;
+            t->first.model_time = s.model_time;
+            t->last.wall        = s.wall;
+            t->last.model_time  = s.model_time;
+            t->has_state        = TRUE;
+        }
+
+        old    = t->now;
+        t->now = s;
+
+        g_atomic_int_set(&t->wanted, FALSE);
+
+        g_mutex_unlock(&t->lock);
+
+        _sed_telemetry_state_clear(&old);
+    }
+}
+
+/** Write the snapshot file now
+
+\param t      A Sed_telemetry
+\param error  Location of a GError, or NULL
+
+\return TRUE if the file was written
+*/
+gboolean
+sed_telemetry_write(Sed_telemetry t, GError** error)
+{
+    gboolean ok;
+
+    eh_return_val_if_fail(t, FALSE);
+    eh_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    g_mutex_lock(&t->lock);
+    ok = _sed_telemetry_write(t, "running", error);
+    g_mutex_unlock(&t->lock);
+
+    return ok;
+}
+
+/** Start the telemetry that is used by sed_process_queue_run_until
+
+sedflux starts it when the SED_TELEMETRY environment variable names a file.
+SED_TELEMETRY_INTERVAL, if set, gives the seconds between snapshots.  When
+running an ensemble, the parent does not step a cube; each member writes
+its own file (see sed_telemetry_start_member).
+
+\param file      Name of the snapshot file
+\param interval  Seconds between snapshots
+
+\return TRUE if the telemetry was started
+*/
+gboolean
+sed_telemetry_start(const gchar* file, double interval)
+{
+    eh_return_val_if_fail(file, FALSE);
+
+    if (!_sed_telemetry) {
+        _sed_telemetry = sed_telemetry_new(file, interval);
+    }
+
+    return _sed_telemetry != NULL;
+}
+
+/** Start the telemetry of an ensemble member
+
+A member runs in a forked child, where the telemetry inherited from its
+parent has no writer thread.  The member gets its own telemetry instead,
+with the same interval, that writes to the parent's file name followed by a
+dot and the member name.  If the parent has no telemetry, neither does the
+member.
+
+\param name  Name of the ensemble member
+
+\return TRUE if the member's telemetry was started
+*/
+gboolean
+sed_telemetry_start_member(const gchar* name)
+{
+    Sed_telemetry parent = _sed_telemetry;
+
+    eh_return_val_if_fail(name, FALSE);
+
+    if (parent && parent->pid != getpid()) {
+        gchar* file = g_strconcat(parent->file, ".", name, NULL);
+
+        _sed_telemetry = sed_telemetry_new(file, parent->interval);
+
+        sed_telemetry_destroy(parent);
+        g_free(file);
+    }
+
+    return _sed_telemetry != NULL && _sed_telemetry->pid == getpid();
+}
+
+void
+sed_telemetry_stop(void)
+{
+    _sed_telemetry = sed_telemetry_destroy(_sed_telemetry);
+}
+
+/* The telemetry started with sed_telemetry_start, or NULL */
+Sed_telemetry
+sed_telemetry_default(void)
+{
+    return _sed_telemetry;
+}
@@ -0,0 +1,35 @@
+#ifndef __SED_TELEMETRY_H__
+#define __SED_TELEMETRY_H__
+
+
+#include <utils/eh_utils.h>
+#include <sed/sed_sedflux.h>
+
+G_BEGIN_DECLS
+
+new_handle(Sed_telemetry);
+
+Sed_telemetry
+sed_telemetry_new(const gchar* file, double interval);
+Sed_telemetry
+sed_telemetry_destroy(Sed_telemetry t);
+
+void
+sed_telemetry_update(Sed_telemetry t, Sed_process_queue q, Sed_cube p);
+void
+sed_telemetry_publish(Sed_telemetry t, Sed_process_queue q, Sed_cube p);
+gboolean
+sed_telemetry_write(Sed_telemetry t, GError** error);
+
+gboolean
+sed_telemetry_start(const gchar* file, double interval);
+gboolean
+sed_telemetry_start_member(const gchar* name);
+void
+sed_telemetry_stop(void);
+Sed_telemetry
+sed_telemetry_default(void);
+
+G_END_DECLS
+
+#endif
@@ -9,12 +9,14 @@ CLASS(Sed_measurement)
     char* name;
     char* unit;
     Sed_tripod_func f;
+    Sed_tripod_batch_func batch;
 };
 
 typedef struct {
     const char* name;
     const char* unit;
     Sed_tripod_func f;
+    Sed_tripod_batch_func batch;
 } Sed_measurement_static;
 
 
@@ -50,26 +52,51 @@ CLASS(Sed_tripod)
     Sed_tripod_attr attr;
 };
 
+CLASS(Sed_tripod_group)
+{
+    FILE* fp;
+    Sed_measurement* x;    ///< Measurements to make (NULL-terminated)
+    gint n_vars;           ///< Number of measurements
+    gint len;              ///< Number of locations
+    Eh_pt_2* pos;          ///< Location of each station
+    gint* id;              ///< Cube id of each station (-1 if out of domain)
+    gint* i;               ///< x-index of each station
+    gint* j;               ///< y-index of each station
+    double* data;          ///< One record of measurements, variable-major
+    gint64 n_records;      ///< Number of records written
+};
+
+static void
+_sed_tripod_batch_elevation(Sed_cube c, const gint* id, gssize len, double* data);
+static void
+_sed_tripod_batch_water_depth(Sed_cube c, const gint* id, gssize len, double* data);
+static void
+_sed_tripod_batch_thickness(Sed_cube c, const gint* id, gssize len, double* data);
+static void
+_sed_tripod_batch_slope(Sed_cube c, const gint* id, gssize len, double* data);
+static void
+_sed_tripod_batch_y_slope(Sed_cube c, const gint* id, gssize len, double* data);
+
 static Sed_measurement_static all_measurements[] = {
-    {"SLOPE", "meter/meter", &sed_measure_cube_slope},
-    {"DEPTH", "meter", &sed_measure_cube_water_depth},
-    {"ELEVATION", "meter", &sed_measure_cube_elevation},
-    {"THICKNESS", "meter", &sed_measure_cube_thickness},
-    {"GRAIN", "micrometer", &sed_measure_cube_grain_size},
-    {"AGE", "year", &sed_measure_cube_age},
-    {"SAND", "1", &sed_measure_cube_sand_fraction},
-    {"SILT", "1", &sed_measure_cube_silt_fraction},
-    {"CLAY", "1", &sed_measure_cube_clay_fraction},
-    {"MUD", "1", &sed_measure_cube_mud_fraction},
-    {"FACIES", "1", &sed_measure_cube_facies},
-    {"DENSITY", "kilogram/meter^3", &sed_measure_cube_density},
-    {"POROSITY", "1", &sed_measure_cube_porosity},
-    {"PERMEABILITY", "meter^2", &sed_measure_cube_permeability},
-    {"BASEMENT", "meter", &sed_measure_cube_basement},
-    {"RIVER_MOUTH", "meter", &sed_measure_cube_river_mouth},
-    {"YSLOPE", "meter/meter", &sed_measure_cube_y_slope},
-    {"XSLOPE", "meter/meter", &sed_measure_cube_x_slope},
-    {NULL, NULL, NULL}
+    {"SLOPE", "meter/meter", &sed_measure_cube_slope, &_sed_tripod_batch_slope},
+    {"DEPTH", "meter", &sed_measure_cube_water_depth, &_sed_tripod_batch_water_depth},
+    {"ELEVATION", "meter", &sed_measure_cube_elevation, &_sed_tripod_batch_elevation},
+    {"THICKNESS", "meter", &sed_measure_cube_thickness, &_sed_tripod_batch_thickness},
+    {"GRAIN", "micrometer", &sed_measure_cube_grain_size, NULL},
+    {"AGE", "year", &sed_measure_cube_age, NULL},
+    {"SAND", "1", &sed_measure_cube_sand_fraction, NULL},
+    {"SILT", "1", &sed_measure_cube_silt_fraction, NULL},
+    {"CLAY", "1", &sed_measure_cube_clay_fraction, NULL},
+    {"MUD", "1", &sed_measure_cube_mud_fraction, NULL},
+    {"FACIES", "1", &sed_measure_cube_facies, NULL},
+    {"DENSITY", "kilogram/meter^3", &sed_measure_cube_density, NULL},
+    {"POROSITY", "1", &sed_measure_cube_porosity, NULL},
+    {"PERMEABILITY", "meter^2", &sed_measure_cube_permeability, NULL},
+    {"BASEMENT", "meter", &sed_measure_cube_basement, NULL},
+    {"RIVER_MOUTH", "meter", &sed_measure_cube_river_mouth, NULL},
+    {"YSLOPE", "meter/meter", &sed_measure_cube_y_slope, &_sed_tripod_batch_y_slope},
+    {"XSLOPE", "meter/meter", &sed_measure_cube_x_slope, NULL},
+    {NULL, NULL, NULL, NULL}
 };
 
 Sed_tripod
@@ -220,12 +247,14 @@ sed_measurement_new(const char* name)
 
         NEW_OBJECT(Sed_measurement, m);
 
-        m->name = g_strdup(name);
-        m->f    = NULL;
+        m->name  = g_strdup(name);
+        m->f     = NULL;
+        m->batch = NULL;
 
         for (i = 0 ; !found && all_measurements[i].name ; i++)
             if (g_ascii_strcasecmp(all_measurements[i].name, name) == 0) {
-                m->f = all_measurements[i].f;
+                m->f     = all_measurements[i].f;
+                m->batch = all_measurements[i].batch;
                 found = TRUE;
             }
 
@@ -251,8 +280,9 @@ sed_measurement_copy(Sed_measurement dest, Sed_measurement src)
 
         eh_free(dest->name);
 
-        dest->name = g_strdup(src->name);
-        dest->f    = src->f;
+        dest->name  = g_strdup(src->name);
+        dest->f     = src->f;
+        dest->batch = src->batch;
     } else {
         dest = NULL;
     }
@@ -448,7 +478,7 @@ double
 sed_measure_cube_grain_size(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col   = sed_cube_col_ij(p, i, j);
+        Sed_column col   = sed_cube_peek_col_ij(p, i, j);
         gssize     i_top = sed_column_top_index(col);
 
         return sed_cell_grain_size_in_phi(sed_column_nth_cell(col, i_top));
@@ -462,7 +492,7 @@ double
 sed_measure_cube_age(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col = sed_cube_col_ij(p, i, j);
+        Sed_column col = sed_cube_peek_col_ij(p, i, j);
         gssize i_top   = sed_column_top_index(col);
 
         return sed_cell_age(sed_column_nth_cell(col, i_top));
@@ -475,7 +505,7 @@ double
 sed_measure_cube_sand_fraction(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col = sed_cube_col_ij(p, i, j);
+        Sed_column col = sed_cube_peek_col_ij(p, i, j);
         gssize i_top   = sed_column_top_index(col);
         return sed_cell_size_class_percent(sed_column_nth_cell(col, i_top), S_SED_TYPE_SAND);
     } else {
@@ -487,7 +517,7 @@ double
 sed_measure_cube_silt_fraction(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col = sed_cube_col_ij(p, i, j);
+        Sed_column col = sed_cube_peek_col_ij(p, i, j);
         gssize i_top   = sed_column_top_index(col);
         return sed_cell_size_class_percent(sed_column_nth_cell(col, i_top), S_SED_TYPE_SILT);
     } else {
@@ -499,7 +529,7 @@ double
 sed_measure_cube_clay_fraction(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col = sed_cube_col_ij(p, i, j);
+        Sed_column col = sed_cube_peek_col_ij(p, i, j);
         gssize i_top   = sed_column_top_index(col);
         return sed_cell_size_class_percent(sed_column_nth_cell(col, i_top), S_SED_TYPE_CLAY);
     } else {
@@ -511,7 +541,7 @@ double
 sed_measure_cube_mud_fraction(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col = sed_cube_col_ij(p, i, j);
+        Sed_column col = sed_cube_peek_col_ij(p, i, j);
         gssize i_top   = sed_column_top_index(col);
         return   sed_cell_size_class_percent(sed_column_nth_cell(col, i_top), S_SED_TYPE_SILT)
             + sed_cell_size_class_percent(sed_column_nth_cell(col, i_top), S_SED_TYPE_CLAY);
@@ -524,7 +554,7 @@ double
 sed_measure_cube_density(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col = sed_cube_col_ij(p, i, j);
+        Sed_column col = sed_cube_peek_col_ij(p, i, j);
         gssize i_top   = sed_column_top_index(col);
         return sed_cell_density(sed_column_nth_cell(col, i_top));
     } else {
@@ -536,7 +566,7 @@ double
 sed_measure_cube_porosity(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col = sed_cube_col_ij(p, i, j);
+        Sed_column col = sed_cube_peek_col_ij(p, i, j);
         gssize i_top   = sed_column_top_index(col);
         return sed_cell_porosity(sed_column_nth_cell(col, i_top));
     } else {
@@ -548,7 +578,7 @@ double
 sed_measure_cube_permeability(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col = sed_cube_col_ij(p, i, j);
+        Sed_column col = sed_cube_peek_col_ij(p, i, j);
         gssize i_top   = sed_column_top_index(col);
         return sed_cell_permeability(sed_column_nth_cell(col, i_top));
     } else {
@@ -560,7 +590,7 @@ double
 sed_measure_cube_facies(Sed_cube p, gssize i, gssize j)
 {
     if (sed_cube_is_in_domain(p, i, j) && !sed_cube_col_is_empty(p, i, j)) {
-        Sed_column col = sed_cube_col_ij(p, i, j);
+        Sed_column col = sed_cube_peek_col_ij(p, i, j);
         gssize i_top   = sed_column_top_index(col);
         return (double)sed_cell_facies(sed_column_nth_cell(col, i_top));
     } else {
@@ -798,3 +828,340 @@ sed_tripod_set_n_y(Sed_tripod t, gssize n_y)
 }
 
 
+static void
+_sed_tripod_batch_gather(const double* src, const gint* id, gssize len,
+    double* data)
+{
+    gssize n;
+
+    for (n = 0 ; n < len ; n++) {
+        data[n] = (id[n] >= 0) ? src[id[n]] : eh_nan();
+    }
+}
+
+static void
+_sed_tripod_batch_elevation(Sed_cube c, const gint* id, gssize len, double* data)
+{
+    _sed_tripod_batch_gather(sed_cube_elevation_data(c), id, len, data);
+}
+
+static void
+_sed_tripod_batch_water_depth(Sed_cube c, const gint* id, gssize len, double* data)
+{
+    _sed_tripod_batch_gather(sed_cube_water_depth_data(c), id, len, data);
+}
+
+static void
+_sed_tripod_batch_thickness(Sed_cube c, const gint* id, gssize len, double* data)
+{
+    _sed_tripod_batch_gather(sed_cube_thickness_data(c), id, len, data);
+}
+
+static void
+_sed_tripod_batch_y_slope(Sed_cube c, const gint* id, gssize len, double* data)
+{
+    _sed_tripod_batch_gather(sed_cube_y_slope_data(c), id, len, data);
+}
+
+static void
+_sed_tripod_batch_slope(Sed_cube c, const gint* id, gssize len, double* data)
+{
+    const double* dx = sed_cube_x_slope_data(c);
+    const double* dy = sed_cube_y_slope_data(c);
+    gssize n;
+
+    for (n = 0 ; n < len ; n++) {
+        if (id[n] >= 0) {
+            data[n] = sqrt(dx[id[n]] * dx[id[n]] + dy[id[n]] * dy[id[n]]);
+        } else {
+            data[n] = eh_nan();
+        }
+    }
+}
+
+#define SED_TRIPOD_GROUP_MAGIC   "SEDSTATN"
+#define SED_TRIPOD_GROUP_VERSION (1)
+
+/* Offset of the record count within the file header */
+#define SED_TRIPOD_GROUP_COUNT_OFFSET (8 + 4 * sizeof(gint32))
+
+static void
+_sed_tripod_group_write_str(FILE* fp, const gchar* str)
+{
+    const gint32 len = strlen(str) + 1;
+
+    fwrite(&len, sizeof(gint32), 1, fp);
+    fwrite(str, sizeof(gchar), len, fp);
+}
+
+/* The header doubles as the file's index.  Every record has the same size
+   so record k starts at data_offset + k*(1 + n_vars*len)*sizeof(double).
+
+      char[8]  magic
+      gint32   version, byte order, number of variables, number of locations
+      gint64   number of records
+      gint64   offset to the first record
+      per variable: gint32 length, name; gint32 length, unit
+      per location: double x, double y, gint32 id
+
+   Each record is the time in years followed by, for each variable, its
+   value at every location. */
+static void
+_sed_tripod_group_write_header(Sed_tripod_group g)
+{
+    const gint32 version    = SED_TRIPOD_GROUP_VERSION;
+    const gint32 byte_order = G_BYTE_ORDER;
+    const gint32 n_vars     = g->n_vars;
+    const gint32 len        = g->len;
+    gint64 data_offset      = 0;
+    gint n;
+
+    fwrite(SED_TRIPOD_GROUP_MAGIC, sizeof(gchar), 8, g->fp);
+    fwrite(&version, sizeof(gint32), 1, g->fp);
+    fwrite(&byte_order, sizeof(gint32), 1, g->fp);
+    fwrite(&n_vars, sizeof(gint32), 1, g->fp);
+    fwrite(&len, sizeof(gint32), 1, g->fp);
+    fwrite(&g->n_records, sizeof(gint64), 1, g->fp);
+    fwrite(&data_offset, sizeof(gint64), 1, g->fp);
+
+    for (n = 0 ; n < g->n_vars ; n++) {
+        gchar* unit = sed_measurement_unit(g->x[n]->name);
+
+        _sed_tripod_group_write_str(g->fp, g->x[n]->name);
+        _sed_tripod_group_write_str(g->fp, unit ? unit : "");
+
+        eh_free(unit);
+    }
+
+    for (n = 0 ; n < g->len ; n++) {
+        const gint32 id = g->id[n];
+
+        fwrite(&g->pos[n].x, sizeof(double), 1, g->fp);
+        fwrite(&g->pos[n].y, sizeof(double), 1, g->fp);
+        fwrite(&id, sizeof(gint32), 1, g->fp);
+    }
+
+    data_offset = ftell(g->fp);
+
+    fseek(g->fp, SED_TRIPOD_GROUP_COUNT_OFFSET + sizeof(gint64), SEEK_SET);
+    fwrite(&data_offset, sizeof(gint64), 1, g->fp);
+    fseek(g->fp, 0, SEEK_END);
+}
+
+/** Create a group of measuring stations that share an output file
+
+The cube indices of the stations are found once, here, rather than each
+time a measurement is made.  Stations that lie outside of the cube record
+NaN.  All of the measurements are written to a single binary file, one
+record per call to sed_tripod_group_write.
+
+\param file Name of the output file
+\param x    NULL-terminated list of measurements to make at each station
+\param c    The Sed_cube that will be measured
+\param pos  Location of each station, or NULL for every column of the cube
+\param len  Number of stations (ignored if pos is NULL)
+
+\return A new Sed_tripod_group
+*/
+Sed_tripod_group
+sed_tripod_group_new(const char* file, Sed_measurement* x, Sed_cube c,
+    const Eh_pt_2* pos, gssize len)
+{
+    Sed_tripod_group g;
+
+    eh_require(file);
+    eh_require(x && x[0]);
+    eh_require(c);
+
+    NEW_OBJECT(Sed_tripod_group, g);
+
+    g->fp = fopen(file, "w+b");
+
+    if (!g->fp) {
+        eh_error("Could not open tripod file");
+    }
+
+    for (g->n_vars = 0 ; x[g->n_vars] ; g->n_vars++);
+
+    g->x = eh_new(Sed_measurement, g->n_vars + 1);
+
+    {
+        gint n;
+
+        for (n = 0 ; n < g->n_vars ; n++) {
+            g->x[n] = sed_measurement_dup(x[n]);
+        }
+
+        g->x[n] = NULL;
+    }
+
+    if (!pos) {
+        len = sed_cube_size(c);
+    }
+
+    g->len       = len;
+    g->pos       = eh_new(Eh_pt_2, len);
+    g->id        = eh_new(gint, len);
+    g->i         = eh_new(gint, len);
+    g->j         = eh_new(gint, len);
+    g->data      = eh_new(double, g->n_vars * len);
+    g->n_records = 0;
+
+    {
+        const double x_0 = sed_cube_col_x(c, 0);
+        const double y_0 = sed_cube_col_y(c, 0);
+        const gint   n_y = sed_cube_n_y(c);
+        gint n;
+
+        for (n = 0 ; n < len ; n++) {
+            if (pos) {
+                g->pos[n] = pos[n];
+                g->i[n]   = (gint)((pos[n].x - x_0) / sed_cube_x_res(c));
+                g->j[n]   = (gint)((pos[n].y - y_0) / sed_cube_y_res(c));
+
+                if (sed_cube_is_in_domain(c, g->i[n], g->j[n])) {
+                    g->id[n] = eh_grid_sub_to_id(n_y, g->i[n], g->j[n]);
+                } else {
+                    g->id[n] = -1;
+                }
+            } else {
+                g->id[n]    = n;
+                g->i[n]     = n / n_y;
+                g->j[n]     = n % n_y;
+                g->pos[n].x = sed_cube_col_x(c, n);
+                g->pos[n].y = sed_cube_col_y(c, n);
+            }
+        }
+    }
+
+    _sed_tripod_group_write_header(g);
+
+    return g;
+}
+
+Sed_tripod_group
+sed_tripod_group_destroy(Sed_tripod_group g)
+{
+    if (g) {
+        Sed_measurement* x;
+
+        for (x = g->x ; *x ; x++) {
+            sed_measurement_destroy(*x);
+        }
+
+        fclose(g->fp);
+
+        eh_free(g->x);
+        eh_free(g->pos);
+        eh_free(g->id);
+        eh_free(g->i);
+        eh_free(g->j);
+        eh_free(g->data);
+        eh_free(g);
+    }
+
+    return NULL;
+}
+
+/** Make every measurement of a group at each of its stations
+
+Measurements that are cached by the cube (elevation, water depth,
+thickness and slopes) are gathered straight from the cube's surface
+arrays; the rest are made column by column.
+
+\param g    A Sed_tripod_group
+\param c    The Sed_cube to measure
+\param data Location to put the measurements (variable-major), or NULL to
+            use the group's own record buffer
+
+\return The measurements
+*/
+double*
+sed_tripod_group_measure(Sed_tripod_group g, Sed_cube c, double* data)
+{
+    eh_require(g);
+    eh_require(c);
+
+    if (!data) {
+        data = g->data;
+    }
+
+    {
+        gint k, n;
+
+        for (k = 0 ; k < g->n_vars ; k++) {
+            Sed_measurement m   = g->x[k];
+            double*         val = data + k * g->len;
+
+            if (m->batch) {
+                (m->batch)(c, g->id, g->len, val);
+            } else {
+                for (n = 0 ; n < g->len ; n++) {
+                    if (g->id[n] >= 0) {
+                        val[n] = (m->f)(c, g->i[n], g->j[n]);
+                    } else {
+                        val[n] = eh_nan();
+                    }
+                }
+            }
+        }
+    }
+
+    return data;
+}
+
+/** Append a record of measurements to a group's output file
+
+\param g A Sed_tripod_group
+\param c The Sed_cube to measure
+
+\return The number of items written
+*/
+gssize
+sed_tripod_group_write(Sed_tripod_group g, Sed_cube c)
+{
+    gssize n = 0;
+
+    eh_require(g);
+    eh_require(c);
+
+    if (g && c) {
+        const double time = sed_cube_age_in_years(c);
+
+        sed_tripod_group_measure(g, c, g->data);
+
+        n += fwrite(&time, sizeof(double), 1, g->fp);
+        n += fwrite(g->data, sizeof(double), g->n_vars * g->len, g->fp);
+
+        g->n_records += 1;
+
+        fseek(g->fp, SED_TRIPOD_GROUP_COUNT_OFFSET, SEEK_SET);
+        fwrite(&g->n_records, sizeof(gint64), 1, g->fp);
+        fseek(g->fp, 0, SEEK_END);
+
+        fflush(g->fp);
+    }
+
+    return n;
+}
+
+gint
+sed_tripod_group_n_vars(Sed_tripod_group g)
+{
+    eh_return_val_if_fail(g, 0);
+    return g->n_vars;
+}
+
+gint
+sed_tripod_group_len(Sed_tripod_group g)
+{
+    eh_return_val_if_fail(g, 0);
+    return g->len;
+}
+
+gint64
+sed_tripod_group_n_records(Sed_tripod_group g)
+{
+    eh_return_val_if_fail(g, 0);
+    return g->n_records;
+}
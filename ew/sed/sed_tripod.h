@@ -11,11 +11,13 @@ new_handle(Sed_tripod);
 new_handle(Sed_tripod_header);
 new_handle(Sed_tripod_attr);
 new_handle(Sed_measurement);
+new_handle(Sed_tripod_group);
 
 #include "sed_cube.h"
 #include "sed_property_file.h"
 
 typedef double (*Sed_tripod_func)(Sed_cube, gssize, gssize);
+typedef void (*Sed_tripod_batch_func)(Sed_cube, const gint*, gssize, double*);
 
 Sed_tripod
 sed_tripod_new(const char* file, Sed_measurement x, Sed_tripod_attr attr);
@@ -105,6 +107,22 @@ sed_tripod_set_n_x(Sed_tripod t, gssize n_x);
 Sed_tripod
 sed_tripod_set_n_y(Sed_tripod t, gssize n_y);
 
+Sed_tripod_group
+sed_tripod_group_new(const char* file, Sed_measurement* x, Sed_cube c,
+    const Eh_pt_2* pos, gssize len);
+Sed_tripod_group
+sed_tripod_group_destroy(Sed_tripod_group g);
+double*
+sed_tripod_group_measure(Sed_tripod_group g, Sed_cube c, double* data);
+gssize
+sed_tripod_group_write(Sed_tripod_group g, Sed_cube c);
+gint
+sed_tripod_group_n_vars(Sed_tripod_group g);
+gint
+sed_tripod_group_len(Sed_tripod_group g);
+gint64
+sed_tripod_group_n_records(Sed_tripod_group g);
+
 G_END_DECLS
 
 #endif
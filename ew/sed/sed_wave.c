@@ -188,6 +188,34 @@ sed_gravity_wave_new(Sed_wave w_infinity, double h, Sed_wave new_wave)
     return new_wave;
 }
 
+/** Transform a deep-water wave to a given water depth with a known wave number
+
+This is sed_gravity_wave_new for a wave number that has already been found,
+for instance with sed_dispersion_relation_wave_number_profile.
+
+\param w_infinity The deep-water wave
+\param h          Water depth in meters
+\param k          Wave number of the wave at this depth in 1/m
+\param new_wave   Location for the new wave (or NULL)
+
+\return The wave at depth \p h
+*/
+Sed_wave
+sed_gravity_wave_new_with_number(Sed_wave w_infinity, double h, double k,
+    Sed_wave new_wave)
+{
+    if (!new_wave) {
+        new_wave = sed_wave_new(0, 0, 0);
+    }
+
+    new_wave->w = w_infinity->w;
+    new_wave->k = k;
+
+    sed_gravity_wave_set_height(new_wave, w_infinity, h);
+
+    return new_wave;
+}
+
 gboolean
 sed_wave_is_breaking(Sed_wave w, double h)
 {
@@ -284,6 +312,39 @@ sed_dispersion_relation_frequency(double water_depth, double wave_number)
     return w;
 }
 
+/* Solve x tanh(x) = y for x >= 0.
+
+In terms of the dispersion relation, x is kh and y is the deep-water value,
+omega^2 h / g.  The Pade approximation of Hunt (1979),
+
+   x^2 = y^2 + y / (1 + d_1 y + d_2 y^2 + ... + d_6 y^6),
+
+is within 0.2% of the root and needs only a square root.  Two Newton
+corrections bring the relative error below 2e-14 (checked for y from 1e-6
+to 1e4).  Only one tanh is evaluated per correction.
+*/
+static double
+_sed_dispersion_kh(double y)
+{
+    double x = 0.;
+
+    if (y > 0.) {
+        double t;
+        gint n;
+
+        x = sqrt(y * y + y / (1. + y * (.6666666666 + y * (.3555555555
+                            + y * (.1608465608 + y * (.0632098765
+                                    + y * (.0217540484 + y * .0065407983)))))));
+
+        for (n = 0 ; n < 2 ; n++) {
+            t  = tanh(x);
+            x -= (x * t - y) / (t + x * (1. - t * t));
+        }
+    }
+
+    return x;
+}
+
 /** Solve the dispersion relation for wave number
 
 The dispersion relation for gravity waves is
@@ -295,6 +356,11 @@ The dispersion relation for gravity waves is
 where \f$ \omega \f$ is wave frequency, \f$ f \f$ is acceleration due
 to gravity, \f$ \kappa \f$ is wave number, and \f$ z \f$ is water depth.
 
+The relation is solved with an explicit approximation followed by two Newton
+corrections.  The relative error in wave number is less than 2e-14.  (The
+Newton-bisection solver that was used before stopped at an absolute error of
+0.01 1/m.)
+
 \param water_depth Water depth in meters
 \param frequency   Wave frequencey in 1/s
 
@@ -304,40 +370,59 @@ double
 sed_dispersion_relation_wave_number(double water_depth,
     double frequency)
 {
-    void sed_dispersion_relation_wave_number_helper(double k,
-        double * y,
-        double * dydx,
-        double * data);
     double wave_number = eh_nan();
 
     eh_require(water_depth > 0) {
-        double data[2];
+        // Grouped as in sed_dispersion_relation_wave_number_profile so that
+        // the two agree to the bit.
+        const double y = frequency * frequency / sed_gravity() * water_depth;
 
-        data[0] = water_depth;
-        data[1] = frequency;
-
-        wave_number = rtsafe(&sed_dispersion_relation_wave_number_helper,
-                0,
-                100,
-                .01,
-                data);
+        wave_number = _sed_dispersion_kh(y) / water_depth;
     }
 
     return wave_number;
 }
 
-void
-sed_dispersion_relation_wave_number_helper(double k,
-    double* y,
-    double* dydx,
-    double* data)
+/** Solve the dispersion relation for a profile of water depths
+
+This is sed_dispersion_relation_wave_number for each depth of a profile and
+for a single frequency.
+
+\param water_depth Water depths in meters
+\param len         Number of water depths
+\param frequency   Wave frequencey in 1/s
+\param wave_number Location for the wave numbers (or NULL)
+
+\return Wave number in 1/m for each depth.  The wave number is NaN where the
+        water depth is not positive.  If \p wave_number is NULL, a
+        newly-allocated array is returned.
+*/
+double*
+sed_dispersion_relation_wave_number_profile(const double* water_depth, gint len,
+    double frequency, double* wave_number)
 {
-    double g = sed_gravity();
-    double h = data[0]; // water depth
-    double w = data[1]; // frequency
+    eh_require(water_depth);
+
+    if (!wave_number) {
+        wave_number = eh_new(double, len);
+    }
 
-    *y    = g * k * tanh(k * h) - w * w;
-    *dydx = g * (k * h * pow(1. / cosh(k * h), 2.) + tanh(k * h));
+    {
+        const double w2_over_g = frequency * frequency / sed_gravity();
+        gint i;
+
+        for (i = 0 ; i < len ; i++) {
+            const double h = water_depth[i];
+
+            if (h > 0) {
+                wave_number[i] = _sed_dispersion_kh(w2_over_g * h) / h;
+            } else {
+                wave_number[i] = eh_nan();
+            }
+        }
+    }
+
+    return wave_number;
 }
 
 Sed_ocean_storm
@@ -39,6 +39,9 @@ sed_wave_is_bad(Sed_wave w);
 Sed_wave
 sed_gravity_wave_new(Sed_wave w_infinity, double h, Sed_wave new_wave);
 Sed_wave
+sed_gravity_wave_new_with_number(Sed_wave w_infinity, double h, double k,
+    Sed_wave new_wave);
+Sed_wave
 sed_gravity_wave_set_frequency(Sed_wave a, double w, double h);
 Sed_wave
 sed_gravity_wave_set_number(Sed_wave w, double k, double h);
@@ -59,6 +62,9 @@ double
 sed_dispersion_relation_frequency(double water_depth, double wave_number);
 double
 sed_dispersion_relation_wave_number(double water_depth, double frequency);
+double*
+sed_dispersion_relation_wave_number_profile(const double* water_depth, gint len,
+    double frequency, double* wave_number);
 
 Sed_ocean_storm
 sed_ocean_storm_new(void);
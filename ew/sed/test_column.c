@@ -330,6 +330,113 @@ test_sed_column_add_cell(void)
 }
 
 
+void
+test_sed_column_coalesce(void)
+{
+    Sed_column c = sed_column_new(5);
+    Sed_cell s = sed_cell_new_classed(NULL, 100., S_SED_TYPE_SAND);
+    double depth[1] = { 10. };
+    double thickness[1] = { 5. };
+    Sed_coalesce_profile p = { depth, thickness, 1, .01, 1. };
+    double mass_in;
+    gssize n;
+
+    sed_column_add_cell(c, s);
+    mass_in = sed_column_mass(c);
+
+    g_assert_cmpint(sed_column_len(c), ==, 100);
+
+    n = sed_column_coalesce(c, &p);
+
+    // The top 10 cells are too shallow.  The other 90 are merged into 5 m cells.
+    g_assert_cmpint(n, ==, 72);
+    g_assert_cmpint(sed_column_len(c), ==, 28);
+    g_assert(fabs(sed_column_thickness(c) - 100.) < 1e-12);
+    g_assert(fabs(sed_column_mass(c) - mass_in) < 1e-9);
+    g_assert(fabs(sed_cell_size(sed_column_nth_cell(c, 0)) - 5.) < 1e-12);
+    g_assert(fabs(sed_cell_size(sed_column_top_cell(c)) - 1.) < 1e-12);
+
+    n = sed_column_coalesce(c, &p);
+    g_assert_cmpint(n, ==, 0);
+
+    sed_cell_destroy(s);
+    sed_column_destroy(c);
+}
+
+
+void
+test_sed_column_coalesce_facies(void)
+{
+    Sed_column c = sed_column_new(5);
+    Sed_cell s = sed_cell_new_classed(NULL, 1., S_SED_TYPE_SAND);
+    double depth[1] = { 0. };
+    double thickness[1] = { 100. };
+    Sed_coalesce_profile p = { depth, thickness, 1, .01, 1. };
+    gint i;
+
+    for (i = 0 ; i < 20 ; i++) {
+        sed_cell_set_facies(s, (i % 2) ? S_FACIES_PLUME : S_FACIES_BEDLOAD);
+        sed_column_add_cell(c, s);
+    }
+
+    g_assert_cmpint(sed_column_coalesce(c, &p), ==, 0);
+    g_assert_cmpint(sed_column_len(c), ==, 20);
+
+    sed_cell_destroy(s);
+    sed_column_destroy(c);
+}
+
+void
+test_sed_column_coalesce_compacted(void)
+{
+    const gint n_types = sed_sediment_env_n_types();
+    Sed_column c = sed_column_new(5);
+    double* f = eh_new0(double, n_types);
+    double depth[1] = { 0. };
+    double thickness[1] = { 100. };
+    Sed_coalesce_profile p = { depth, thickness, 1, 1., 1. };
+    double mass_in, t_0_in;
+    gint i;
+
+    g_assert_cmpint(n_types, >, 1);
+
+    // Cells of different grain sizes, each compacted by a different amount
+    for (i = 0 ; i < 4 ; i++) {
+        Sed_cell s;
+
+        f[0] = .2 + .2 * i;
+        f[n_types - 1] = 1. - f[0];
+
+        s = sed_cell_new_sized(n_types, 2., f);
+        sed_column_stack_cell(c, s);
+        sed_column_compact_cell(c, i, 2. * (1. - .2 * i));
+        sed_cell_destroy(s);
+    }
+
+    mass_in = sed_column_mass(c);
+
+    for (i = 0, t_0_in = 0. ; i < sed_column_len(c) ; i++) {
+        t_0_in += sed_cell_size_0(sed_column_nth_cell(c, i));
+    }
+
+    g_assert(sed_column_can_coalesce(c, &p));
+    g_assert_cmpint(sed_column_coalesce(c, &p), ==, 3);
+    g_assert_cmpint(sed_column_len(c), ==, 1);
+
+    g_assert(eh_compare_dbl(sed_column_mass(c), mass_in, 1e-12));
+    g_assert(eh_compare_dbl(sed_cell_size_0(sed_column_nth_cell(c, 0)), t_0_in,
+            1e-12));
+
+    // The merged cell holds as much of each grain size as the cells did
+    g_assert(eh_compare_dbl(sed_cell_fraction(sed_column_nth_cell(c, 0), 0),
+            (.2 + .4 + .6 + .8) / 4., 1e-12));
+
+    g_assert(!sed_column_can_coalesce(c, &p));
+
+    eh_free(f);
+    sed_column_destroy(c);
+}
+
 void
 test_sed_column_add_cell_empty(void)
 {
@@ -1969,6 +2076,11 @@ main(int argc, char* argv[])
     g_test_add_func("/libsed/sed_column/clear", &test_sed_column_clear);
     g_test_add_func("/libsed/sed_column/stack_cell_loc", &test_sed_column_stack_cells_loc);
     g_test_add_func("/libsed/sed_column/add_cell", &test_sed_column_add_cell);
+    g_test_add_func("/libsed/sed_column/coalesce", &test_sed_column_coalesce);
+    g_test_add_func("/libsed/sed_column/coalesce_facies",
+        &test_sed_column_coalesce_facies);
+    g_test_add_func("/libsed/sed_column/coalesce_compacted",
+        &test_sed_column_coalesce_compacted);
     g_test_add_func("/libsed/sed_column/add_cell_small", &test_sed_column_add_cell_small);
     g_test_add_func("/libsed/sed_column/add_cell_large", &test_sed_column_add_cell_large);
     g_test_add_func("/libsed/sed_column/stack_cell", &test_sed_column_stack_cell);
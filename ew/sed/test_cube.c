@@ -2,6 +2,10 @@
 #include <sed_sedflux.h>
 #include <sed_cube.h>
 
+#include <string.h>
+#include <unistd.h>
+#include <glib/gstdio.h>
+
 #include "test_sed.h"
 
 Sed_cube
@@ -737,6 +741,154 @@ test_shore_ids()
     sed_cube_destroy(p);
 }
 
+void
+test_shore_incremental()
+{
+    Sed_cube p = NULL;
+
+    p = new_land_ocean_cube(0., 1., 0., .25);
+    g_assert(p);
+
+    {
+        gint i, j, n;
+        const gint nx = sed_cube_n_x(p);
+        const gint ny = sed_cube_n_y(p);
+        const gint nland = ny * .25;
+        const gint* ids = NULL;
+        gint* line = NULL;
+
+        ids = sed_cube_shore_data(p, &n);
+        g_assert_cmpint(n, ==, nx);
+
+        // Raise a column just offshore so that it becomes the shore.
+        sed_cube_set_base_height(p, nx / 2, nland, 1);
+
+        ids = sed_cube_shore_data(p, &n);
+        g_assert_cmpint(n, ==, nx);
+        g_assert(!is_shore_cell(p, nx / 2, nland - 1));
+        g_assert(is_shore_cell(p, nx / 2, nland));
+
+        for (i = 0, n = 0; i < nx; i++)
+            for (j = 0; j < ny; j++)
+                if (is_shore_cell(p, i, j)) {
+                    g_assert_cmpint(ids[n], ==, sed_cube_id(p, i, j));
+                    n++;
+                }
+
+        g_assert_cmpint(ids[n], ==, -1);
+
+        // Consecutive columns along a shore line are neighbours.
+        line = sed_cube_shore_line_ids(p);
+
+        for (n = 1; line[n] >= 0; n++) {
+            Eh_ind_2 a = sed_cube_sub(p, line[n - 1]);
+            Eh_ind_2 b = sed_cube_sub(p, line[n]);
+            g_assert_cmpint(ABS(a.i - b.i), <=, 1);
+            g_assert_cmpint(ABS(a.j - b.j), <=, 1);
+        }
+
+        g_assert_cmpint(n, ==, nx);
+
+        eh_free(line);
+
+        // Lowering it again restores the straight shore.
+        sed_cube_set_base_height(p, nx / 2, nland, -1);
+
+        ids = sed_cube_shore_data(p, &n);
+        g_assert_cmpint(n, ==, nx);
+
+        for (i = 0; ids[i] >= 0; i++) {
+            g_assert((ids[i] - (nland - 1)) % ny == 0);
+        }
+
+        // A change in sea level re-evaluates every column.
+        sed_cube_set_sea_level(p, 2.);
+
+        sed_cube_shore_data(p, &n);
+        g_assert_cmpint(n, ==, 0);
+    }
+
+    sed_cube_destroy(p);
+}
+
+/* Consecutive columns of a shore line are neighbours, and every shore
+   column is on it. */
+static void
+_assert_shore_line(Sed_cube p, const gint* line, gint len)
+{
+    gint n;
+
+    for (n = 1; n < len; n++) {
+        Eh_ind_2 a = sed_cube_sub(p, line[n - 1]);
+        Eh_ind_2 b = sed_cube_sub(p, line[n]);
+        g_assert_cmpint(ABS(a.i - b.i), <=, 1);
+        g_assert_cmpint(ABS(a.j - b.j), <=, 1);
+        g_assert_cmpint(line[n - 1], !=, line[n]);
+    }
+
+    sed_cube_shore_data(p, &n);
+    g_assert_cmpint(len, ==, n);
+}
+
+void
+test_shore_line_from_middle()
+{
+    Sed_cube p = new_test_cube();
+
+    g_assert(p);
+
+    {
+        const gint nx = sed_cube_n_x(p);
+        const gint ny = sed_cube_n_y(p);
+        const gint c = ny / 2;
+        gint i, j, n;
+        gint* line = NULL;
+
+        // A peninsula that points to i=0.  Its tip is the first shore column
+        // but is in the middle of the shore line.
+        for (i = 0; i < nx; i++)
+            for (j = 0; j < ny; j++)
+                sed_cube_set_base_height(p, i, j, i >= ABS(j - c) ? 1 : -1);
+
+        g_assert(is_shore_cell(p, 0, c));
+        g_assert(is_shore_cell(p, 1, c - 1));
+        g_assert(is_shore_cell(p, 1, c + 1));
+
+        line = sed_cube_shore_line_ids(p);
+
+        for (n = 0; line[n] >= 0; n++);
+
+        _assert_shore_line(p, line, n);
+        g_assert_cmpint(line[0], !=, sed_cube_id(p, 0, c));
+        g_assert_cmpint(line[n - 1], !=, sed_cube_id(p, 0, c));
+
+        eh_free(line);
+
+        { /* Trace the shore line that passes through its tip */
+            Eh_ind_2 tip = { 0, c };
+            GList* shore = sed_cube_find_shore_line(p, &tip);
+            GList* link;
+
+            n = g_list_length(shore);
+            line = eh_new(gint, n);
+
+            for (link = shore, n = 0; link; link = link->next, n++) {
+                Eh_ind_2* ind = (Eh_ind_2*)link->data;
+                line[n] = sed_cube_id(p, ind->i, ind->j);
+                eh_free(ind);
+            }
+
+            g_list_free(shore);
+
+            _assert_shore_line(p, line, n);
+
+            eh_free(line);
+        }
+    }
+
+    sed_cube_destroy(p);
+}
+
 void
 test_cube_river_north(void)
 {
@@ -850,6 +1002,360 @@ test_cube_river_path_ends(void)
     sed_cube_destroy(p);
 }
 
+void
+test_cube_river_path_cache(void)
+{
+    Sed_cube p = new_land_ocean_cube(0., .25, 0., 1.);
+    Sed_riv r = sed_river_new("North");
+
+    g_assert(p);
+    g_assert(r);
+
+    {
+        const int nx = sed_cube_n_x(p);
+        const int ny = sed_cube_n_y(p);
+        const int nland = nx * .25;
+        const gint hinge[2] = {0, ny / 2};
+        const gint* ray;
+        gint* path;
+        gint len, n;
+
+        sed_cube_set_river_path_ray(r, p, hinge, 0.);
+
+        ray = sed_river_path(r, nx, ny, sed_cube_x_res(p), sed_cube_y_res(p),
+                &len);
+        g_assert(ray);
+        g_assert_cmpint(len, ==, nx);
+
+        /* The ray is kept but the path still ends at the shore */
+        path = sed_cube_river_path_id(p, r, TRUE);
+        for (n = 0; path[n] >= 0; n++) {
+            g_assert_cmpint(path[n], ==, eh_grid_sub_to_id(ny, n, ny / 2));
+        }
+        g_assert_cmpint(n, ==, nland + 1);
+        eh_free(path);
+
+        /* Flood the land; the same ray gives a shorter path */
+        sed_cube_set_sea_level(p, 2.);
+        path = sed_cube_river_path_id(p, r, FALSE);
+        g_assert(sed_river_path(r, nx, ny, sed_cube_x_res(p), sed_cube_y_res(p),
+                NULL) == ray);
+        g_assert_cmpint(path[0], ==, eh_grid_sub_to_id(ny, 0, ny / 2));
+        g_assert_cmpint(path[1], ==, -1);
+        eh_free(path);
+
+        /* An avulsion invalidates the ray */
+        sed_river_set_angle(r, G_PI_2);
+        g_assert(sed_river_path(r, nx, ny, sed_cube_x_res(p), sed_cube_y_res(p),
+                NULL) == NULL);
+
+        sed_cube_set_sea_level(p, 0.);
+        path = sed_cube_river_path_id(p, r, TRUE);
+        for (n = 0; path[n] >= 0; n++) {
+            g_assert_cmpint(path[n], ==, eh_grid_sub_to_id(ny, 0, ny / 2 + n));
+        }
+        g_assert_cmpint(n, ==, ny - ny / 2);
+        eh_free(path);
+    }
+
+    r = sed_river_destroy(r);
+    sed_cube_destroy(p);
+}
+
+void
+test_cube_snapshot(void)
+{
+    Sed_cube p = new_land_ocean_cube(0., .25, 0., 1.);
+    Sed_cube snap;
+
+    g_assert(p);
+
+    {
+        const gint len = sed_cube_size(p);
+        const double* z;
+        Sed_cell c = sed_cell_new_env();
+
+        sed_cell_set_equal_fraction(c);
+        sed_cell_resize(c, 1.);
+
+        snap = sed_cube_snapshot(p);
+
+        g_assert(snap);
+        g_assert_cmpint(sed_cube_size(snap), ==, len);
+        g_assert(sed_cube_sea_level(snap) == sed_cube_sea_level(p));
+
+        /* Changing the cube leaves the snapshot alone */
+        sed_column_add_cell(sed_cube_col(p, 0), c);
+        sed_cube_set_base_height(p, 0, 1, 5.);
+
+        z = sed_cube_elevation_data(snap);
+        g_assert_cmpfloat(z[0], ==, 1.);
+        g_assert_cmpfloat(z[1], ==, 1.);
+        g_assert_cmpfloat(sed_cube_elevation(p, 0, 0), ==, 2.);
+        g_assert_cmpfloat(sed_cube_elevation(p, 0, 1), ==, 5.);
+
+        /* Branching from the snapshot returns the cube to its state */
+        sed_cube_set_sea_level(p, 3.);
+        sed_cube_branch(p, snap);
+
+        g_assert_cmpfloat(sed_cube_sea_level(p), ==, sed_cube_sea_level(snap));
+        g_assert_cmpfloat(sed_cube_elevation(p, 0, 0), ==, 1.);
+        g_assert_cmpfloat(sed_cube_elevation(p, 0, 1), ==, 1.);
+
+        /* and the branch can be run forward without changing the snapshot */
+        sed_column_add_cell(sed_cube_col(p, 0), c);
+        g_assert_cmpfloat(sed_cube_elevation(p, 0, 0), ==, 2.);
+        g_assert_cmpfloat(sed_cube_elevation(snap, 0, 0), ==, 1.);
+
+        sed_cell_destroy(c);
+    }
+
+    sed_cube_destroy(snap);
+    sed_cube_destroy(p);
+}
+
+void
+test_cube_snapshot_reads(void)
+{
+    Sed_cube p = new_land_ocean_cube(0., .25, 0., 1.);
+    Sed_cube snap = sed_cube_snapshot(p);
+    const gint len = sed_cube_size(p);
+    gint i;
+
+    /* Reading the cube leaves its columns shared with the snapshot */
+    for (i = 0 ; i < len ; i++) {
+        sed_cube_col_x(p, i);
+        sed_cube_col_y(p, i);
+    }
+
+    eh_free(sed_cube_x(p, NULL));
+    eh_free(sed_cube_y(p, NULL));
+    sed_cube_base_height(p, 0, 0);
+    sed_cube_sediment_mass(p);
+    sed_cell_destroy(sed_cube_to_cell(p, NULL));
+    sed_cube_set_sea_level(p, sed_cube_sea_level(p));
+
+    for (i = 0 ; i < len ; i++) {
+        g_assert(sed_column_is_shared(sed_cube_peek_col(p, i)));
+        g_assert(sed_column_is_shared(sed_cube_peek_col(snap, i)));
+    }
+
+    /* Changing the sea level or base height copies no cells */
+    sed_cube_set_sea_level(p, sed_cube_sea_level(p) + 1.);
+    sed_cube_adjust_base_height(p, 0, 0, 2.);
+
+    for (i = 0 ; i < len ; i++) {
+        g_assert(sed_column_is_shared(sed_cube_peek_col(p, i)));
+        g_assert(sed_column_is_shared(sed_cube_peek_col(snap, i)));
+        g_assert_cmpfloat(sed_column_sea_level(sed_cube_peek_col(p, i)), ==,
+            sed_cube_sea_level(p));
+        g_assert_cmpfloat(sed_column_sea_level(sed_cube_peek_col(snap, i)), ==,
+            sed_cube_sea_level(snap));
+    }
+
+    g_assert_cmpfloat(sed_cube_base_height(p, 0, 0), ==,
+        sed_cube_base_height(snap, 0, 0) + 2.);
+
+    sed_cube_destroy(snap);
+    sed_cube_destroy(p);
+}
+
+void
+test_cube_branch_sea_level(void)
+{
+    Sed_cube p = new_land_ocean_cube(0., .25, 0., 1.);
+    Sed_cube snap;
+    Sed_cube branch;
+    const gint len = sed_cube_size(p);
+    gint i;
+
+    {
+        Sed_cell c = sed_cell_new_env();
+
+        sed_cell_set_equal_fraction(c);
+        sed_cell_resize(c, 1.);
+
+        for (i = 0 ; i < len ; i++) {
+            sed_column_add_cell(sed_cube_col(p, i), c);
+        }
+
+        snap = sed_cube_snapshot(p);
+        branch = sed_cube_branch(NULL, snap);
+
+        /* Run the branch forward: sea level rises, and one column gets more
+           sediment */
+        sed_cube_set_sea_level(branch, sed_cube_sea_level(snap) + 3.);
+        sed_column_add_cell(sed_cube_col(branch, 0), c);
+
+        sed_cell_destroy(c);
+    }
+
+    /* Only the column that was given sediment has its own cells */
+    g_assert(!sed_column_is_shared(sed_cube_peek_col(branch, 0)));
+
+    for (i = 1 ; i < len ; i++) {
+        g_assert(sed_column_is_shared(sed_cube_peek_col(branch, i)));
+        g_assert(sed_column_nth_cell(sed_cube_peek_col(branch, i), 0)
+            == sed_column_nth_cell(sed_cube_peek_col(snap, i), 0));
+        g_assert(sed_column_nth_cell(sed_cube_peek_col(branch, i), 0)
+            == sed_column_nth_cell(sed_cube_peek_col(p, i), 0));
+    }
+
+    {
+        const double* d_branch = sed_cube_water_depth_data(branch);
+        const double* d_snap = sed_cube_water_depth_data(snap);
+        const double* d_p = sed_cube_water_depth_data(p);
+
+        for (i = 0 ; i < len ; i++) {
+            g_assert(eh_compare_dbl(d_branch[i],
+                    d_snap[i] + 3. - (i == 0 ? 1. : 0.), 1e-12));
+            g_assert_cmpfloat(d_p[i], ==, d_snap[i]);
+        }
+    }
+
+    sed_cube_destroy(branch);
+
+    /* Dropping the branch leaves the cells to the other two */
+    for (i = 1 ; i < len ; i++) {
+        g_assert(sed_column_is_shared(sed_cube_peek_col(snap, i)));
+    }
+
+    sed_cube_destroy(p);
+
+    for (i = 0 ; i < len ; i++) {
+        g_assert(!sed_column_is_shared(sed_cube_peek_col(snap, i)));
+        g_assert_cmpfloat(sed_column_thickness(sed_cube_peek_col(snap, i)), ==, 1.);
+    }
+
+    sed_cube_destroy(snap);
+}
+
+void
+test_cube_coalesce_shared(void)
+{
+    Sed_cube p = new_land_ocean_cube(0., .25, 0., 1.);
+    Sed_cube snap;
+    const gint len = sed_cube_size(p);
+    double depth[1] = { 0. };
+    double thickness[1] = { 100. };
+    Sed_coalesce_profile profile = { depth, thickness, 1, .01, 1. };
+    gint i, n;
+
+    {
+        Sed_cell c = sed_cell_new_env();
+
+        sed_cell_set_equal_fraction(c);
+        sed_cell_resize(c, 1.);
+
+        /* Only the cells of the first column are alike */
+        for (i = 0 ; i < len ; i++)
+            for (n = 0 ; n < 4 ; n++) {
+                sed_cell_set_facies(c,
+                    (i > 0 && n % 2) ? S_FACIES_PLUME : S_FACIES_BEDLOAD);
+                sed_column_add_cell(sed_cube_col(p, i), c);
+            }
+
+        sed_cell_destroy(c);
+    }
+
+    snap = sed_cube_snapshot(p);
+
+    g_assert(sed_column_can_coalesce(sed_cube_peek_col(p, 0), &profile));
+
+    for (i = 1 ; i < len ; i++) {
+        g_assert(!sed_column_can_coalesce(sed_cube_peek_col(p, i), &profile));
+    }
+
+    g_assert_cmpint(sed_cube_coalesce(p, &profile), ==, 3);
+
+    /* Only the column that was merged is copied */
+    g_assert(!sed_column_is_shared(sed_cube_peek_col(p, 0)));
+    g_assert_cmpint(sed_column_len(sed_cube_peek_col(p, 0)), ==, 1);
+    g_assert_cmpint(sed_column_len(sed_cube_peek_col(snap, 0)), ==, 4);
+
+    for (i = 1 ; i < len ; i++) {
+        g_assert(sed_column_is_shared(sed_cube_peek_col(p, i)));
+        g_assert_cmpint(sed_column_len(sed_cube_peek_col(p, i)), ==, 4);
+    }
+
+    sed_cube_destroy(snap);
+    sed_cube_destroy(p);
+}
+
+void
+test_cube_tripod_group(void)
+{
+    Sed_cube p = new_land_ocean_cube(0., .25, 0., 1.);
+    gchar* name_used;
+    FILE* fp = eh_open_temp_file("sed_tripod_group.binXXXXXX", &name_used);
+    Sed_measurement x[4];
+    Sed_tripod_group g;
+
+    fclose(fp);
+
+    x[0] = sed_measurement_new("ELEVATION");
+    x[1] = sed_measurement_new("SLOPE");
+    x[2] = sed_measurement_new("BASEMENT");
+    x[3] = NULL;
+
+    g = sed_tripod_group_new(name_used, x, p, NULL, 0);
+    g_assert(g);
+    g_assert_cmpint(sed_tripod_group_n_vars(g), ==, 3);
+    g_assert_cmpint(sed_tripod_group_len(g), ==, sed_cube_size(p));
+
+    { /* Batched values match those measured one column at a time */
+        const gint len = sed_cube_size(p);
+        const gint n_y = sed_cube_n_y(p);
+        double* data = sed_tripod_group_measure(g, p, NULL);
+        gint id, k;
+
+        for (k = 0; k < 3; k++)
+            for (id = 0; id < len; id++) {
+                g_assert_cmpfloat(data[k * len + id], ==,
+                    sed_measurement_make(x[k], p, id / n_y, id % n_y));
+            }
+    }
+
+    sed_tripod_group_write(g, p);
+    sed_tripod_group_write(g, p);
+    g_assert_cmpint(sed_tripod_group_n_records(g), ==, 2);
+
+    g = sed_tripod_group_destroy(g);
+
+    { /* The header records the number of records and where they start */
+        FILE* fp_in = fopen(name_used, "rb");
+        gchar magic[8];
+        gint32 hdr[4];
+        gint64 n_records, offset;
+        long n_bytes;
+
+        fread(magic, sizeof(gchar), 8, fp_in);
+        fread(hdr, sizeof(gint32), 4, fp_in);
+        fread(&n_records, sizeof(gint64), 1, fp_in);
+        fread(&offset, sizeof(gint64), 1, fp_in);
+
+        fseek(fp_in, 0, SEEK_END);
+        n_bytes = ftell(fp_in);
+
+        g_assert(strncmp(magic, "SEDSTATN", 8) == 0);
+        g_assert_cmpint(hdr[2], ==, 3);
+        g_assert_cmpint(hdr[3], ==, sed_cube_size(p));
+        g_assert_cmpint(n_records, ==, 2);
+        g_assert_cmpint(n_bytes - offset, ==,
+            2 * (1 + 3 * sed_cube_size(p)) * sizeof(double));
+
+        fclose(fp_in);
+    }
+
+    g_remove(name_used);
+    eh_free(name_used);
+
+    sed_measurement_destroy(x[0]);
+    sed_measurement_destroy(x[1]);
+    sed_measurement_destroy(x[2]);
+    sed_cube_destroy(p);
+}
+
 void
 test_river_new(void)
 {
@@ -1126,6 +1632,153 @@ test_cube_grid_elevation_some(void)
     sed_cube_destroy(p);
 }
 
+void
+test_cube_surface_cache(void)
+{
+    Sed_cube p = new_test_cube();
+
+    {
+        gint i;
+        const gint len = sed_cube_size(p);
+        const double* z = NULL;
+        const double* d = NULL;
+
+        for (i = 0; i < len; i++) {
+            sed_cube_set_base_height(p, 0, i, -i);
+        }
+
+        z = sed_cube_elevation_data(p);
+        d = sed_cube_water_depth_data(p);
+        g_assert(z != NULL);
+        g_assert(d != NULL);
+
+        for (i = 0; i < len; i++) {
+            g_assert(eh_compare_dbl(z[i], -i, 1e-12));
+            g_assert(eh_compare_dbl(d[i], i, 1e-12));
+        }
+
+        { /* Changing one column only changes its cached values */
+            const gint id = g_test_rand_int_range(0, len);
+            Sed_cell c = sed_cell_new_classed(NULL, 2., S_SED_TYPE_SAND);
+
+            sed_column_add_cell(sed_cube_col(p, id), c);
+
+            g_assert(sed_cube_elevation_data(p) == z);
+            g_assert(eh_compare_dbl(z[id], -id + 2., 1e-12));
+            g_assert(eh_compare_dbl(sed_cube_thickness(p, 0, id), 2., 1e-12));
+            g_assert(eh_compare_dbl(sed_cube_water_depth(p, 0, id), id - 2., 1e-12));
+
+            for (i = 0; i < len; i++)
+                if (i != id) {
+                    g_assert(eh_compare_dbl(z[i], -i, 1e-12));
+                }
+
+            sed_cell_destroy(c);
+        }
+
+        { /* Changing sea level changes every water depth */
+            sed_cube_set_sea_level(p, 10.);
+
+            d = sed_cube_water_depth_data(p);
+
+            for (i = 0; i < len; i++) {
+                g_assert(eh_compare_dbl(d[i], 10. - z[i], 1e-12));
+            }
+        }
+    }
+
+    sed_cube_destroy(p);
+}
+
+void
+test_cube_telemetry(void)
+{
+    Sed_cube          p = sed_cube_new(3, 4);
+    Sed_process_queue q = sed_process_queue_new();
+    Sed_cube          snap;
+    GError*           error = NULL;
+    gchar*            name_used = NULL;
+    gint              fd;
+
+    fd = g_file_open_tmp("sed_cube_telemetry_XXXXXX", &name_used, &error);
+    g_assert(fd != -1);
+    close(fd);
+
+    sed_cube_set_x_res(p, 1.);
+    sed_cube_set_y_res(p, 1.);
+    sed_cube_set_z_res(p, 1.);
+    sed_cube_set_age(p, 25.);
+
+    {
+        Sed_cell c = sed_cell_new_env();
+
+        sed_cell_set_equal_fraction(c);
+        sed_cell_resize(c, 1.);
+
+        sed_column_add_cell(sed_cube_col(p, 0), c);
+        sed_column_add_cell(sed_cube_col(p, 5), c);
+        sed_column_add_cell(sed_cube_col(p, 5), c);
+
+        sed_cell_destroy(c);
+    }
+
+    snap = sed_cube_snapshot(p);
+
+    {
+        Sed_telemetry t = sed_telemetry_new(name_used, 3600.);
+        Eh_key_file   f;
+        gchar*        status;
+
+        sed_telemetry_publish(t, q, p);
+
+        /* Collecting the values does not copy the shared columns */
+        g_assert(sed_column_is_shared(sed_cube_peek_col(snap, 5)));
+
+        g_assert(sed_telemetry_write(t, &error));
+        g_assert(error == NULL);
+
+        f = eh_key_file_scan(name_used, &error);
+        g_assert(f);
+
+        status = eh_key_file_get_value(f, "telemetry", "status");
+        g_assert_cmpstr(status, ==, "running");
+        eh_free(status);
+
+        g_assert_cmpfloat(eh_key_file_get_dbl_value(f, "telemetry", "model time"),
+            ==, 25.);
+        g_assert_cmpint(eh_key_file_get_int_value(f, "telemetry",
+                "resident memory"), !=, 0);
+        g_assert_cmpint(eh_key_file_get_int_value(f, "cube", "columns"), ==, 12);
+        g_assert_cmpint(eh_key_file_get_int_value(f, "cube", "cells"), ==,
+            sed_cube_n_cells(p));
+        g_assert(eh_compare_dbl(eh_key_file_get_dbl_value(f, "mass balance", "mass"),
+                sed_cube_mass(p), 1e-12));
+
+        eh_key_file_destroy(f);
+
+        t = sed_telemetry_destroy(t);
+        g_assert(t == NULL);
+
+        f = eh_key_file_scan(name_used, &error);
+        g_assert(f);
+
+        status = eh_key_file_get_value(f, "telemetry", "status");
+        g_assert_cmpstr(status, ==, "finished");
+        eh_free(status);
+
+        eh_key_file_destroy(f);
+    }
+
+    g_assert_cmpint(sed_cube_n_cells(p), ==, 3);
+
+    g_remove(name_used);
+    eh_free(name_used);
+
+    sed_process_queue_destroy(q);
+    sed_cube_destroy(snap);
+    sed_cube_destroy(p);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -1159,11 +1812,27 @@ main(int argc, char* argv[])
         &test_is_boundary_cell);
     g_test_add_func("/libsed/sed_cube/shore_mask", &test_shore_mask);
     g_test_add_func("/libsed/sed_cube/shore_ids", &test_shore_ids);
+    g_test_add_func("/libsed/sed_cube/shore_incremental",
+        &test_shore_incremental);
+    g_test_add_func("/libsed/sed_cube/shore_line_from_middle",
+        &test_shore_line_from_middle);
 
     g_test_add_func("/libsed/sed_cube/river_path/ray",
         &test_cube_river_path_ray);
     g_test_add_func("/libsed/sed_cube/river_path/ends",
         &test_cube_river_path_ends);
+    g_test_add_func("/libsed/sed_cube/river_path/cache",
+        &test_cube_river_path_cache);
+    g_test_add_func("/libsed/sed_cube/snapshot", &test_cube_snapshot);
+    g_test_add_func("/libsed/sed_cube/snapshot_reads",
+        &test_cube_snapshot_reads);
+    g_test_add_func("/libsed/sed_cube/branch_sea_level",
+        &test_cube_branch_sea_level);
+    g_test_add_func("/libsed/sed_cube/coalesce_shared",
+        &test_cube_coalesce_shared);
+    g_test_add_func("/libsed/sed_cube/tripod_group",
+        &test_cube_tripod_group);
+    g_test_add_func("/libsed/sed_cube/telemetry", &test_cube_telemetry);
 
     g_test_add_func("/libsed/sed_river/new", &test_river_new);
     g_test_add_func("/libsed/sed_river/dup", &test_river_dup);
@@ -1176,6 +1845,8 @@ main(int argc, char* argv[])
         &test_cube_grid_elevation_all);
     g_test_add_func("/libsed/sed_cube/grid/elevation_some",
         &test_cube_grid_elevation_some);
+    g_test_add_func("/libsed/sed_cube/grid/surface_cache",
+        &test_cube_surface_cache);
 
     g_test_run();
 }
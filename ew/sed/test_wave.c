@@ -1,6 +1,7 @@
 #include "utils/utils.h"
 #include <glib.h>
 
+#include "sed_sediment.h"
 #include "sed_wave.h"
 
 void
@@ -53,6 +54,43 @@ test_sed_wave_copy(void)
     }
 }
 
+void
+test_sed_wave_dispersion(void)
+{
+    const double g = sed_gravity();
+    double h[] = {.01, .1, 1., 5., 20., 100., 1000., -1.};
+    const gint len = sizeof(h) / sizeof(double);
+    const double w[] = {.05, .5, 1., 2.};
+    double k[8];
+    gint i, n;
+
+    for (n = 0 ; n < 4 ; n++) {
+        sed_dispersion_relation_wave_number_profile(h, len, w[n], k);
+
+        for (i = 0 ; i < len - 1 ; i++) {
+            const double residual = g * k[i] * tanh(k[i] * h[i]) / (w[n] * w[n]);
+
+            g_assert(eh_compare_dbl(residual, 1., 1e-8));
+            g_assert_cmpfloat(k[i], ==, sed_dispersion_relation_wave_number(h[i], w[n]));
+        }
+
+        g_assert(eh_isnan(k[len - 1]));
+    }
+
+    {
+        Sed_wave deep = sed_wave_new(1., .25 / sed_gravity(), .5);
+        Sed_wave a = sed_gravity_wave_new(deep, 5., NULL);
+        Sed_wave b = sed_gravity_wave_new_with_number(deep, 5.,
+                sed_dispersion_relation_wave_number(5., .5), NULL);
+
+        g_assert(sed_wave_is_same(a, b));
+
+        sed_wave_destroy(a);
+        sed_wave_destroy(b);
+        sed_wave_destroy(deep);
+    }
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -60,6 +98,7 @@ main(int argc, char* argv[])
 
     g_test_add_func("/libsed/sed_wave/new", &test_sed_wave_new);
     g_test_add_func("/libsed/sed_wave/copy", &test_sed_wave_copy);
+    g_test_add_func("/libsed/sed_wave/dispersion", &test_sed_wave_dispersion);
 
     g_test_run();
 }
@@ -414,101 +414,99 @@ get_grid_origin(BMI_Model* self, int id, double* origin)
 }
 
 
+/* Static metadata for each exchange item.  Surface grids (grid 0) are read
+ * from the sedflux measurement named by sedflux_name, with land cells
+ * masked out if mask_land is set.
+ * Sediment grids (grid 1) are read from the sedflux property of that name.
+ * Scalars (grid 2) are read with get_scalar. Items without a sedflux_name or
+ * get_scalar are input-only. */
+typedef struct {
+    const char* name;
+    const char* sedflux_name;
+    int grid;
+    const char* units;
+    gboolean mask_land;
+    double (*get_scalar)(Sedflux_state*);
+}
+BMI_Var;
+
+
+static const BMI_Var bmi_vars[] = {
+    { "land-or-seabed_sediment_grain__mean_diameter", "GRAIN", 0, "meter", FALSE, NULL },
+    { "sea_water__depth", "DEPTH", 0, "meter", FALSE, NULL },
+    { "sea_bottom_sediment__bulk_mass-per-volume_density", "DENSITY", 0, "kg / m^3", TRUE, NULL },
+    { "land-or-seabed_sediment__bulk_mass-per-volume_density", "DENSITY", 0, "kg / m^3", FALSE, NULL },
+    { "sea_bottom_surface__elevation", "ELEVATION", 0, "meter", TRUE, NULL },
+    { "sea_bottom_sediment_grain__mean_diameter", "GRAIN", 0, "meter", TRUE, NULL },
+    { "bedrock_surface__elevation", "BASEMENT", 0, "meter", FALSE, NULL },
+    { "land-or-seabed_sediment__permeability", "PERMEABILITY", 0, "m^2", FALSE, NULL },
+    { "land-or-seabed_sediment_surface__y_derivative_of_elevation", "YSLOPE", 0, "meter", FALSE, NULL },
+    { "sea_bottom_sediment__porosity", "POROSITY", 0, "", TRUE, NULL },
+    { "land-or-seabed_sediment_silt__volume_fraction", "SILT", 0, "", FALSE, NULL },
+    { "channel_water_sediment~bedload__mass_flow_rate", NULL, 0, "kg / s", FALSE, NULL },
+    { "land-or-seabed_sediment_surface__elevation", "ELEVATION", 0, "meter", FALSE, NULL },
+    { "land-or-seabed_sediment_clay__volume_fraction", "CLAY", 0, "", FALSE, NULL },
+    { "sea_bottom_sediment_mud__volume_fraction", "MUD", 0, "", TRUE, NULL },
+    { "land-or-seabed_sediment_sand__volume_fraction", "SAND", 0, "", FALSE, NULL },
+    { "land-or-seabed_sediment__mean_of_deposition_age", "AGE", 0, "d", FALSE, NULL },
+    { "sea_bottom_surface__y_derivative_of_elevation", "YSLOPE", 0, "meter", TRUE, NULL },
+    { "sea_bottom_sediment_clay__volume_fraction", "CLAY", 0, "", TRUE, NULL },
+    { "land-or-seabed_sediment__porosity", "POROSITY", 0, "", FALSE, NULL },
+    { "land-or-seabed_sediment__bulk_density", NULL, 0, "kg / m^3", FALSE, NULL },
+    { "land-or-seabed_sediment_mud__volume_fraction", "MUD", 0, "", FALSE, NULL },
+    { "land-or-seabed_sediment_surface__x_derivative_of_elevation", "XSLOPE", 0, "meter", FALSE, NULL },
+    { "sea_bottom_sediment__increment_of_thickness", NULL, 0, "meter", FALSE, NULL },
+    { "bedrock_surface__increment_of_elevation", NULL, 0, "meter", FALSE, NULL },
+    { "channel_exit_water__volume_flow_rate", NULL, 0, "m^3 / s", FALSE, NULL },
+    { "sea_bottom_sediment__permeability", "PERMEABILITY", 0, "m^2", TRUE, NULL },
+    { "sea_bottom_surface__x_derivative_of_elevation", "XSLOPE", 0, "meter", TRUE, NULL },
+    { "sea_bottom_sediment_sand__volume_fraction", "SAND", 0, "", TRUE, NULL },
+    { "sea_bottom_sediment__mean_of_deposition_age", "AGE", 0, "d", TRUE, NULL },
+    { "sea_bottom_sediment_silt__volume_fraction", "SILT", 0, "", TRUE, NULL },
+    { "sediment_grain__mean_diameter", "GRAIN", 1, "meter", FALSE, NULL },
+    { "sediment__mean_of_deposition_age", "AGE", 1, "d", FALSE, NULL },
+    { "sediment__porosity", "POROSITY", 1, "", FALSE, NULL },
+    { "sediment__bulk_mass-per-volume_density", "DENSITY", 1, "kg / m^3", FALSE, NULL },
+    { "sediment__permeability", "PERMEABILITY", 1, "m^2", FALSE, NULL },
+    { "channel_exit_water_flow__speed", NULL, 2, "m/s", FALSE, sedflux_get_channel_velocity },
+    { "channel_exit_x-section__mean_of_width", NULL, 2, "m", FALSE, sedflux_get_channel_width },
+    { "channel_exit_x-section__mean_of_depth", NULL, 2, "m", FALSE, sedflux_get_channel_depth },
+    { "channel_exit_water_sediment~suspended__mass_concentration", NULL, 2, "kg/m^3", FALSE, sedflux_get_channel_suspended_load },
+    { NULL, NULL, -1, NULL, FALSE, NULL }
+};
+
+
+static const BMI_Var*
+lookup_var(const char* name)
+{
+    static GHashTable* vars = NULL;
+
+    if (!vars) {
+        const BMI_Var* v;
+
+        vars = g_hash_table_new(g_str_hash, g_str_equal);
+
+        for (v = bmi_vars; v->name; v++) {
+            g_hash_table_insert(vars, (gpointer)v->name, (gpointer)v);
+        }
+    }
+
+    return (const BMI_Var*)g_hash_table_lookup(vars, name);
+}
+
+
 static int
 get_var_grid(BMI_Model* self, const char* name, int* grid)
 {
-    if (strcmp(name, "land-or-seabed_sediment_grain__mean_diameter") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_water__depth") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_sediment__bulk_mass-per-volume_density") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment__bulk_mass-per-volume_density") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_surface__elevation") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_sediment_grain__mean_diameter") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "bedrock_surface__elevation") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment__permeability") == 0) {
-        *grid = 0;
-        // } else if (strcmp(name, "sediment_grain__mean_diameter") == 0) {
-        //     *grid = 1;
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__y_derivative_of_elevation") ==
-        0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_sediment__porosity") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment_silt__volume_fraction") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "channel_water_sediment~bedload__mass_flow_rate") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__elevation") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment_clay__volume_fraction") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_sediment_mud__volume_fraction") == 0) {
-        *grid = 0;
-        // } else if (strcmp(name, "surface_sediment_model_grain_class_0__volume_fraction") == 0) {
-        //     *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment_sand__volume_fraction") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment__mean_of_deposition_age") == 0) {
-        *grid = 0;
-        // } else if (strcmp(name, "sediment__mean_of_deposition_age") == 0) {
-        //     *grid = 1;
-        // } else if (strcmp(name, "sea_bottom_sediment_model_grain_class_0__volume_fraction") == 0) {
-        //     *grid = 0;
-    } else if (strcmp(name, "sea_bottom_surface__y_derivative_of_elevation") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_sediment_clay__volume_fraction") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment__porosity") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment__bulk_density") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment_mud__volume_fraction") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__x_derivative_of_elevation") ==
-        0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_sediment__increment_of_thickness") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "bedrock_surface__increment_of_elevation") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "channel_exit_water__volume_flow_rate") == 0) {
-        *grid = 0;
-        // } else if (strcmp(name, "sediment__porosity") == 0) {
-        //     *grid = 1;
-        // } else if (strcmp(name, "sediment__bulk_mass-per-volume_density") == 0) {
-        //     *grid = 1;
-    } else if (strcmp(name, "sea_bottom_sediment__permeability") == 0) {
-        *grid = 0;
-        // } else if (strcmp(name, "sediment__permeability") == 0) {
-        //     *grid = 1;
-    } else if (strcmp(name, "sea_bottom_surface__x_derivative_of_elevation") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_sediment_sand__volume_fraction") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_sediment__mean_of_deposition_age") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "sea_bottom_sediment_silt__volume_fraction") == 0) {
-        *grid = 0;
-    } else if (strcmp(name, "channel_exit_water_flow__speed") == 0) {
-        *grid = 2;
-    } else if (strcmp(name, "channel_exit_x-section__mean_of_width") == 0) {
-        *grid = 2;
-    } else if (strcmp(name, "channel_exit_x-section__mean_of_depth") == 0) {
-        *grid = 2;
-    } else if (strcmp(name, "channel_exit_water_sediment~suspended__mass_concentration") ==
-        0) {
-        *grid = 2;
-    } else {
+    const BMI_Var* v = lookup_var(name);
+
+    if (!v) {
         *grid = -1;
         return BMI_FAILURE;
     }
 
+    *grid = v->grid;
+
     return BMI_SUCCESS;
 }
 
@@ -516,98 +514,13 @@ get_var_grid(BMI_Model* self, const char* name, int* grid)
 static int
 get_var_type(BMI_Model* self, const char* name, char* type)
 {
-    if (strcmp(name, "land-or-seabed_sediment_grain__mean_diameter") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_water__depth") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment__bulk_mass-per-volume_density") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment__bulk_mass-per-volume_density") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_surface__elevation") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment_grain__mean_diameter") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "bedrock_surface__elevation") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment__permeability") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sediment_grain__mean_diameter") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__y_derivative_of_elevation") ==
-        0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment__porosity") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment_silt__volume_fraction") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "channel_water_sediment~bedload__mass_flow_rate") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__elevation") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment_clay__volume_fraction") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment_mud__volume_fraction") == 0) {
-        strncpy(type, "double", 7);
-        // } else if (strcmp(name, "surface_sediment_model_grain_class_0__volume_fraction") == 0) {
-        //     strncpy(type, "double", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment_sand__volume_fraction") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment__mean_of_deposition_age") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sediment__mean_of_deposition_age") == 0) {
-        strncpy(type, "double", 7);
-        // } else if (strcmp(name, "sea_bottom_sediment_model_grain_class_0__volume_fraction") == 0) {
-        //     strncpy(type, "double", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_surface__y_derivative_of_elevation") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment_clay__volume_fraction") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment__porosity") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment__bulk_density") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment_mud__volume_fraction") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__x_derivative_of_elevation") ==
-        0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment__increment_of_thickness") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "bedrock_surface__increment_of_elevation") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "channel_exit_water__volume_flow_rate") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sediment__porosity") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sediment__bulk_mass-per-volume_density") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment__permeability") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sediment__permeability") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_surface__x_derivative_of_elevation") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment_sand__volume_fraction") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment__mean_of_deposition_age") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "sea_bottom_sediment_silt__volume_fraction") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "channel_exit_water_flow__speed") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "channel_exit_x-section__mean_of_width") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "channel_exit_x-section__mean_of_depth") == 0) {
-        strncpy(type, "double", 7);
-    } else if (strcmp(name, "channel_exit_water_sediment~suspended__mass_concentration") ==
-        0) {
-        strncpy(type, "double", 7);
-    } else {
+    if (!lookup_var(name)) {
         type[0] = '\0';
         return BMI_FAILURE;
     }
 
+    strncpy(type, "double", 7);
+
     return BMI_SUCCESS;
 }
 
@@ -615,98 +528,15 @@ get_var_type(BMI_Model* self, const char* name, char* type)
 static int
 get_var_units(BMI_Model* self, const char* name, char* units)
 {
-    if (strcmp(name, "land-or-seabed_sediment_grain__mean_diameter") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_water__depth") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment__bulk_mass-per-volume_density") == 0) {
-        strncpy(units, "kg / m^3", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment__bulk_mass-per-volume_density") == 0) {
-        strncpy(units, "kg / m^3", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_surface__elevation") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment_grain__mean_diameter") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "bedrock_surface__elevation") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment__permeability") == 0) {
-        strncpy(units, "m^2", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sediment_grain__mean_diameter") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__y_derivative_of_elevation") ==
-        0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment__porosity") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment_silt__volume_fraction") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "channel_water_sediment~bedload__mass_flow_rate") == 0) {
-        strncpy(units, "kg / s", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__elevation") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment_clay__volume_fraction") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment_mud__volume_fraction") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-        // } else if (strcmp(name, "surface_sediment_model_grain_class_0__volume_fraction") == 0) {
-        //     strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment_sand__volume_fraction") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment__mean_of_deposition_age") == 0) {
-        strncpy(units, "d", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sediment__mean_of_deposition_age") == 0) {
-        strncpy(units, "d", BMI_MAX_UNITS_NAME);
-        // } else if (strcmp(name, "sea_bottom_sediment_model_grain_class_0__volume_fraction") == 0) {
-        //     strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_surface__y_derivative_of_elevation") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment_clay__volume_fraction") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment__porosity") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment__bulk_density") == 0) {
-        strncpy(units, "kg / m^3", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment_mud__volume_fraction") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__x_derivative_of_elevation") ==
-        0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment__increment_of_thickness") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "bedrock_surface__increment_of_elevation") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "channel_exit_water__volume_flow_rate") == 0) {
-        strncpy(units, "m^3 / s", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sediment__porosity") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sediment__bulk_mass-per-volume_density") == 0) {
-        strncpy(units, "kg / m^3", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment__permeability") == 0) {
-        strncpy(units, "m^2", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sediment__permeability") == 0) {
-        strncpy(units, "m^2", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_surface__x_derivative_of_elevation") == 0) {
-        strncpy(units, "meter", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment_sand__volume_fraction") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment__mean_of_deposition_age") == 0) {
-        strncpy(units, "d", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "sea_bottom_sediment_silt__volume_fraction") == 0) {
-        strncpy(units, "", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "channel_exit_water_flow__speed") == 0) {
-        strncpy(units, "m/s", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "channel_exit_x-section__mean_of_width") == 0) {
-        strncpy(units, "m", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "channel_exit_x-section__mean_of_depth") == 0) {
-        strncpy(units, "m", BMI_MAX_UNITS_NAME);
-    } else if (strcmp(name, "channel_exit_water_sediment~suspended__mass_concentration") ==
-        0) {
-        strncpy(units, "kg/m^3", BMI_MAX_UNITS_NAME);
-    } else {
+    const BMI_Var* v = lookup_var(name);
+
+    if (!v) {
         units[0] = '\0';
         return BMI_FAILURE;
     }
 
+    strncpy(units, v->units, BMI_MAX_UNITS_NAME);
+
     return BMI_SUCCESS;
 }
 
@@ -714,98 +544,13 @@ get_var_units(BMI_Model* self, const char* name, char* units)
 static int
 get_var_itemsize(BMI_Model* self, const char* name, int* itemsize)
 {
-    if (strcmp(name, "land-or-seabed_sediment_grain__mean_diameter") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_water__depth") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment__bulk_mass-per-volume_density") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment__bulk_mass-per-volume_density") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_surface__elevation") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment_grain__mean_diameter") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "bedrock_surface__elevation") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment__permeability") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sediment_grain__mean_diameter") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__y_derivative_of_elevation") ==
-        0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment__porosity") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment_silt__volume_fraction") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "channel_water_sediment~bedload__mass_flow_rate") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__elevation") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment_clay__volume_fraction") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment_mud__volume_fraction") == 0) {
-        *itemsize = sizeof(double);
-        // } else if (strcmp(name, "surface_sediment_model_grain_class_0__volume_fraction") == 0) {
-        //     *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment_sand__volume_fraction") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment__mean_of_deposition_age") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sediment__mean_of_deposition_age") == 0) {
-        *itemsize = sizeof(double);
-        // } else if (strcmp(name, "sea_bottom_sediment_model_grain_class_0__volume_fraction") == 0) {
-        //     *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_surface__y_derivative_of_elevation") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment_clay__volume_fraction") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment__porosity") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment__bulk_density") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment_mud__volume_fraction") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "land-or-seabed_sediment_surface__x_derivative_of_elevation") ==
-        0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment__increment_of_thickness") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "bedrock_surface__increment_of_elevation") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "channel_exit_water__volume_flow_rate") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sediment__porosity") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sediment__bulk_mass-per-volume_density") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment__permeability") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sediment__permeability") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_surface__x_derivative_of_elevation") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment_sand__volume_fraction") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment__mean_of_deposition_age") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "sea_bottom_sediment_silt__volume_fraction") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "channel_exit_water_flow__speed") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "channel_exit_x-section__mean_of_width") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "channel_exit_x-section__mean_of_depth") == 0) {
-        *itemsize = sizeof(double);
-    } else if (strcmp(name, "channel_exit_water_sediment~suspended__mass_concentration") ==
-        0) {
-        *itemsize = sizeof(double);
-    } else {
+    if (!lookup_var(name)) {
         *itemsize = 0;
         return BMI_FAILURE;
     }
 
+    *itemsize = sizeof(double);
+
     return BMI_SUCCESS;
 }
 
@@ -841,104 +586,60 @@ get_var_location(BMI_Model* self, const char* name, char* location)
 }
 
 
+/* Surface grids are owned by the sedflux state and are recomputed at most
+ * once per model time, so the pointer is only valid until the next update
+ * or set_value. */
 static int
-get_value(BMI_Model* self, const char* name, void* dest)
+get_value_ptr(BMI_Model* self, const char* name, void** dest)
 {
-    const char* sedflux_name = NULL;
-
-    if (g_str_has_prefix(name, "channel_exit_")) {
-        if (g_str_has_suffix(name, "water_flow__speed")) {
-            *(double*)dest = sedflux_get_channel_velocity((Sedflux_state*)self->data);
-        } else if (g_str_has_suffix(name, "x-section__mean_of_width")) {
-            *(double*)dest = sedflux_get_channel_width((Sedflux_state*)self->data);
-        } else if (g_str_has_suffix(name, "x-section__mean_of_depth")) {
-            *(double*)dest = sedflux_get_channel_depth((Sedflux_state*)self->data);
-        } else if (g_str_has_suffix(name, "water_sediment~suspended__mass_concentration")) {
-            *(double*)dest = sedflux_get_channel_suspended_load((Sedflux_state*)self->data);
-        } else {
-            return BMI_FAILURE;
-        }
+    const BMI_Var* v = lookup_var(name);
 
-        return BMI_SUCCESS;
+    *dest = NULL;
+
+    if (v && v->grid == 0 && v->sedflux_name) {
+        *dest = (void*)sedflux_get_surface_value_ptr((Sedflux_state*)self->data,
+                v->sedflux_name, v->mask_land ? MASK_LAND : 0);
     }
 
-    if (strcmp(name, "sea_water__depth") == 0) {
-        sedflux_name = "DEPTH";
-    } else if (strcmp(name, "bedrock_surface__elevation") == 0) {
-        sedflux_name = "BASEMENT";
-    } else if (g_str_has_suffix(name, "surface__elevation")) {
-        sedflux_name = "ELEVATION";
-    } else if (g_str_has_suffix(name, "surface__x_derivative_of_elevation")) {
-        sedflux_name = "XSLOPE";
-    } else if (g_str_has_suffix(name, "surface__y_derivative_of_elevation")) {
-        sedflux_name = "YSLOPE";
-    } else if (g_str_has_suffix(name, "sediment_grain__mean_diameter")) {
-        sedflux_name = "GRAIN";
-    } else if (g_str_has_suffix(name, "sediment__mean_of_deposition_age")) {
-        sedflux_name = "AGE";
-    } else if (g_str_has_suffix(name, "sediment_sand__volume_fraction")) {
-        sedflux_name = "SAND";
-    } else if (g_str_has_suffix(name, "sediment_silt__volume_fraction")) {
-        sedflux_name = "SILT";
-    } else if (g_str_has_suffix(name, "sediment_clay__volume_fraction")) {
-        sedflux_name = "CLAY";
-    } else if (g_str_has_suffix(name, "sediment_mud__volume_fraction")) {
-        sedflux_name = "MUD";
-    } else if (g_str_has_suffix(name, "sediment__bulk_mass-per-volume_density")) {
-        sedflux_name = "DENSITY";
-    } else if (g_str_has_suffix(name, "sediment__porosity")) {
-        sedflux_name = "POROSITY";
-    } else if (g_str_has_suffix(name, "sediment__permeability")) {
-        sedflux_name = "PERMEABILITY";
+    if (*dest) {
+        return BMI_SUCCESS;
+    } else {
+        return BMI_FAILURE;
     }
-    //     else if (g_str_has_suffix(name, "sediment_model_grain_class_0__volume_fraction"))
-    //         sedflux_name = "";
-    else {
+}
+
+
+static int
+get_value(BMI_Model* self, const char* name, void* dest)
+{
+    const BMI_Var* v = lookup_var(name);
+
+    if (!v) {
         return BMI_FAILURE;
     }
 
-    if (g_str_has_prefix(name, "sediment_")) {
-        if (!sedflux_get_sediment_value((Sedflux_state*)self->data, sedflux_name,
+    if (v->get_scalar) {
+        *(double*)dest = v->get_scalar((Sedflux_state*)self->data);
+    } else if (v->grid == 1 && v->sedflux_name) {
+        if (!sedflux_get_sediment_value((Sedflux_state*)self->data, v->sedflux_name,
                 (double*)dest)) {
             return BMI_FAILURE;
         }
     } else {
-        // NOTE: Need to check for 'land-or-seabed_sediment_'
-        gint mask = 0;
+        void* src = NULL;
+        int nbytes = 0;
 
-        if (g_str_has_prefix(name, "sea_bottom_")) {
-            mask |= MASK_LAND;
-        } else if (g_str_has_prefix(name, "land-or-seabed_")) {
-            mask = 0;
+        if (self->get_value_ptr(self, name, &src) == BMI_FAILURE) {
+            return BMI_FAILURE;
         }
 
-        if (!sedflux_get_surface_value((Sedflux_state*)self->data, sedflux_name, (double*)dest,
-                mask)) {
+        if (self->get_var_nbytes(self, name, &nbytes) == BMI_FAILURE) {
             return BMI_FAILURE;
         }
-    }
 
-    return BMI_SUCCESS;
-}
-
-
-#if 0
-int
-get_value(BMI_Model* self, const char* name, void* dest)
-{
-    void* src = NULL;
-    int nbytes = 0;
-
-    if (get_value_ptr(self, name, &src) == BMI_FAILURE) {
-        return BMI_FAILURE;
-    }
-
-    if (get_var_nbytes(self, name, &nbytes) == BMI_FAILURE) {
-        return BMI_FAILURE;
+        memcpy(dest, src, nbytes);
     }
 
-    memcpy(dest, src, nbytes);
-
     return BMI_SUCCESS;
 }
 
@@ -947,31 +648,38 @@ static int
 get_value_at_indices(BMI_Model* self, const char* name, void* dest,
     int* inds, int len)
 {
-    void* src = NULL;
-    int itemsize = 0;
+    const BMI_Var* v = lookup_var(name);
+    double* to = (double*)dest;
 
-    if (get_value_ptr(self, name, &src) == BMI_FAILURE) {
+    if (!v) {
         return BMI_FAILURE;
     }
 
-    if (get_var_itemsize(self, name, &itemsize) == BMI_FAILURE) {
-        return BMI_FAILURE;
-    }
+    if (v->get_scalar) {
+        const double val = v->get_scalar((Sedflux_state*)self->data);
+        int i;
 
-    {   /* Copy the data */
+        for (i = 0; i < len; i++) {
+            to[i] = val;
+        }
+    } else {
+        void* src = NULL;
+        const double* from;
         int i;
-        int offset;
-        void* ptr;
 
-        for (i = 0, ptr = dest; i < len; i++, ptr += itemsize) {
-            offset = inds[i] * itemsize;
-            memcpy(ptr, src + offset, itemsize);
+        if (self->get_value_ptr(self, name, &src) == BMI_FAILURE) {
+            return BMI_FAILURE;
+        }
+
+        from = (const double*)src;
+
+        for (i = 0; i < len; i++) {
+            to[i] = from[inds[i]];
         }
     }
 
     return BMI_SUCCESS;
 }
-#endif
 
 
 static int
@@ -1065,8 +773,8 @@ register_bmi_sedflux3d(BMI_Model* model)
     model->get_time_step = get_time_step;
 
     model->get_value = get_value;
-    model->get_value_ptr = NULL;
-    model->get_value_at_indices = NULL;
+    model->get_value_ptr = get_value_ptr;
+    model->get_value_at_indices = get_value_at_indices;
 
     model->set_value = set_value;
     // model->set_value_ptr = NULL;
@@ -63,10 +63,19 @@ main(int argc, char* argv[])
     gchar* work_dir = NULL;
     gchar* run_desc = NULL;
     gint dimen = 0;
+    gint n_failed = 0;
 
     g_thread_init(NULL);
     eh_init_glib();
     g_log_set_handler(NULL, G_LOG_LEVEL_MASK, &eh_logger, NULL);
+    eh_log_async_start();
+
+    if (g_getenv("SED_TELEMETRY")) {
+        const gchar* interval = g_getenv("SED_TELEMETRY_INTERVAL");
+
+        sed_telemetry_start(g_getenv("SED_TELEMETRY"),
+            interval ? g_ascii_strtod(interval, NULL) : 0.);
+    }
 
     { /* Initialze sedflux and then run it. */
         Sedflux_state* state = sedflux_initialize(argc, (const char**)argv);
@@ -75,15 +84,26 @@ main(int argc, char* argv[])
             double start = sedflux_get_start_time(state);
             double end = sedflux_get_end_time(state);
 
-            sedflux_run_until(state, end);
+            if (sedflux_is_ensemble(state)) {
+                n_failed = sedflux_run_ensemble(state, end);
+            } else {
+                sedflux_run_until(state, end);
+            }
         }
 
         sedflux_finalize(state);
     }
 
+    sed_telemetry_stop();
+
     // if (g_getenv("SED_MEM_CHECK"))
     //   eh_heap_dump( "heap_dump.txt" );
 
+    if (n_failed > 0) {
+        eh_warning("%d ensemble member(s) failed", n_failed);
+        eh_exit(EXIT_FAILURE);
+    }
+
     eh_exit(EXIT_SUCCESS);
 
     return EXIT_SUCCESS;
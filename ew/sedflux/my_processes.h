@@ -19,6 +19,8 @@ init_bedload(Sed_process, Eh_symbol_table, GError**);
 gboolean
 init_bioturbation(Sed_process, Eh_symbol_table, GError**);
 gboolean
+init_coalesce(Sed_process, Eh_symbol_table, GError**);
+gboolean
 init_compaction(Sed_process, Eh_symbol_table, GError**);
 gboolean
 init_constants(Sed_process, Eh_symbol_table, GError**);
@@ -76,6 +78,8 @@ run_bedload(Sed_process, Sed_cube);
 Sed_process_info
 run_bioturbation(Sed_process, Sed_cube);
 Sed_process_info
+run_coalesce(Sed_process, Sed_cube);
+Sed_process_info
 run_compaction(Sed_process, Sed_cube);
 Sed_process_info
 run_constants(Sed_process, Sed_cube);
@@ -137,6 +141,7 @@ Sed_proc_destroy destroy_avulsion;
 Sed_proc_destroy destroy_bbl;
 Sed_proc_destroy destroy_bedload;
 Sed_proc_destroy destroy_bioturbation;
+Sed_proc_destroy destroy_coalesce;
 Sed_proc_destroy destroy_compaction;
 Sed_proc_destroy destroy_cpr;
 Sed_proc_destroy destroy_constants;
@@ -185,6 +190,23 @@ typedef struct {
 }
 Bioturbation_t;
 
+typedef struct {
+    double* depth;
+    double* thickness;
+    gint    len;
+    double  f_tol;
+    double  age_tol;
+}
+Coalesce_t;
+
+#include <compact.h>
+
+typedef struct {
+    double         load_tol;
+    Compact_cache* cache;
+}
+Compaction_t;
+
 typedef struct {
     Eh_file_list* file_list;
     gchar*        output_dir;
@@ -199,6 +221,8 @@ typedef struct {
     gchar*  output_dir;
     GArray* property;
     int     count;
+    gint    max_in_flight; //< Most snapshot dumps written at once (0 to dump inline)
+    GList*  in_flight; //< Process ids of the snapshot dumps being written
 }
 Data_dump_t;
 
@@ -253,6 +277,8 @@ typedef struct {
     double      last_half_load;
     Eh_dbl_grid last_dw_iso;
     Eh_dbl_grid last_load;
+    Eh_remesh   shrink; //< Weights to remesh the load onto the coarse grid
+    Eh_remesh   expand; //< Weights to remesh the deflection back onto the cube
 }
 Isostasy_t;
 
@@ -264,6 +290,8 @@ typedef struct {
     GArray*         pos;
     gchar*          filename;
     Sed_tripod      met_fp;
+    Sed_measurement* group_parameters;
+    Sed_tripod_group group;
 }
 Met_station_t;
 
@@ -272,7 +300,7 @@ typedef struct {
     double   mean_quake;
     double   var_quake;
     long     rand_seed;
-    GRand*   rand;
+    Eh_rand* rand;
 }
 Quake_t;
 
@@ -308,7 +336,7 @@ typedef struct {
     Eh_input_val max_angle;
     Eh_input_val f_remain;
     gboolean     branching_is_on;
-    GRand*       rand;
+    Eh_rand*     rand;
     guint32      rand_seed;
     gboolean     reset_angle;
     gint         hinge_i;
@@ -382,6 +410,7 @@ typedef struct {
     double        plume_width;
     int           ndx;
     int           ndy;
+    double        x_ratio;
 
     int           deposit_size;
     Sed_cell**    deposit;
@@ -389,6 +418,7 @@ typedef struct {
     double**      plume_deposit;
     Plume_river   last_river_data;
     Plume_data*   plume_data;
+    Eh_dbl_grid*  plume_deposit_grid;
 
     Sed_cell_grid deposit_grid;
     Sed_cell_grid last_deposit_grid;
@@ -436,6 +466,7 @@ typedef struct {
     double    start_year;
     double**  sea_level;
     gint      len;
+    Eh_time_series curve; //< Sea level as a function of time (since start_year)
 }
 Sea_level_t;
 
@@ -452,7 +483,7 @@ typedef struct {
     double       beta;
     double       fraction;
     gboolean     average_non_events;
-    GRand*       rand;
+    Eh_rand*     rand;
     Eh_input_val wave_height;
     guint32      rand_seed;
 }
@@ -462,7 +493,15 @@ typedef struct {
     gchar*       filename;
     double       last_year;
     GArray*      tectonic_curve;
-    Eh_sequence* subsidence_seq;
+    Eh_sequence* subsidence_seq; //< All of the subsidence records (2D only)
+    gint         n_recs; //< Number of subsidence records
+    double*      t; //< Time of each record
+    gint         lower; //< Lower record of the active pair (-1 if none)
+    double*      rate_lo; //< Subsidence rate of each column at the lower record
+    double*      rate_hi; //< Subsidence rate of each column at the upper record
+    double*      slope; //< Change in subsidence rate per year between the pair
+    double*      frame; //< Scratch space for a record read from file (3D only)
+    gint         grid_n_y; //< Number of columns of the grids in the file (3D only)
 }
 Subsidence_t;
 
@@ -28,21 +28,12 @@ Sed_cell**
 construct_deposit_array_3(Sed_cube   p,
     double     fraction,
     Sed_cell** deposit,
-    Sed_riv    r);
+    Sed_riv    r,
+    double     tidal_range);
 int
 rain_3(Sed_cube p, Sed_cell** deposit);
 double
-get_tidal_time_step(double t0,
-    double tidal_range,
-    double tidal_period,
-    double dz);
-double
-get_tidal_time(double dz,
-    double tidal_range,
-    double tidal_period,
-    gboolean waning);
-double
-get_tidal_level(double t, double tidal_range, double tidal_period);
+get_tidal_inundation_fraction(double z, double tidal_range);
 
 gint
 rain_sediment_3(Sed_cube p, int algorithm, Sed_riv this_river)
@@ -59,21 +50,15 @@ rain_sediment_3(Sed_cube p, int algorithm, Sed_riv this_river)
         mouth_pos  = sed_river_mouth(this_river);
 
         if (sed_cube_water_depth(p, mouth_pos.i, mouth_pos.j) >= 0) {
-            const double  v_res         = sed_cube_z_res(p);
-            const double  sea_level     = sed_cube_sea_level(p);
             const double  tidal_range   = sed_cube_tidal_range(p);
             const double  time_step     = sed_cube_time_step_in_days(p);
             Sed_cell      erode_cell    = sed_cell_new_env();
             Sed_cell_grid in_suspension = sed_cube_in_suspension(p, this_river);
             Sed_cell_grid deposit_grid  = sed_cell_grid_new_env(sed_cube_n_x(p), sed_cube_n_y(p));
             Sed_cell**    deposit       = (Sed_cell**)eh_grid_data(deposit_grid);
-            double        time_elapsed  = 0.;
             double        time_left     = time_step;
-            const double  tidal_period  = time_step;
             double fraction;
             double depth;
-            double tidal_dt;
-            double dz;
             double sediment_remaining;
 
             eh_require(erode_cell);
@@ -105,19 +90,10 @@ rain_sediment_3(Sed_cube p, int algorithm, Sed_riv this_river)
 
                 // eh_clamp( fraction , 1e-5 , 1. );
 
-                if (tidal_range > 0) {
-                    tidal_dt = get_tidal_time_step(time_elapsed,
-                            tidal_range,
-                            tidal_period,
-                            v_res);
-
-                    if (tidal_dt < time_left * fraction) {
-                        fraction = tidal_dt / time_left;
-                    }
-                }
-
                 // construct an array of cells to pass to the deposit routine.
-                construct_deposit_array_3(p, fraction, deposit, this_river);
+                // With tides, each column receives sediment only for the part
+                // of the tidal cycle that it is under water.
+                construct_deposit_array_3(p, fraction, deposit, this_river, tidal_range);
 
                 // call the appropriate deposit routine.
                 error = rain_3(p, deposit);
@@ -127,13 +103,8 @@ rain_sediment_3(Sed_cube p, int algorithm, Sed_riv this_river)
 
                 // this is the time required to deposit this sediment.
                 time_left    = time_left * (1. - fraction);
-                time_elapsed = time_step - time_left;
-
-                // get the new sea level.
-                dz = get_tidal_level(time_elapsed, tidal_range, tidal_period);
 
-                // adjust sea level and river mouth.
-                sed_cube_set_sea_level(p, sea_level + dz);
+                // adjust the river mouth.
                 this_river = sed_cube_find_river_mouth(p, this_river);
 
                 eh_require(this_river);
@@ -141,8 +112,6 @@ rain_sediment_3(Sed_cube p, int algorithm, Sed_riv this_river)
                 mouth_pos = sed_river_mouth(this_river);
             }
 
-            sed_cube_set_sea_level(p, sea_level);
-
             sed_cell_destroy(erode_cell);
             sed_cell_grid_destroy(deposit_grid);
         }
@@ -155,7 +124,8 @@ Sed_cell**
 construct_deposit_array_3(Sed_cube   p,
     double     fraction,
     Sed_cell** deposit,
-    Sed_riv    this_river)
+    Sed_riv    this_river,
+    double     tidal_range)
 {
     int i, j;
     double deposit_amount;
@@ -177,11 +147,21 @@ construct_deposit_array_3(Sed_cube   p,
                     sed_cell_grid_val(in_suspension, i - mouth_pos.i, j - mouth_pos.j))
                 * fraction;
 
+            water_depth = sed_cube_water_depth(p, i, j);
+
+            //---
+            // With tides, sediment only settles while the column is flooded and
+            // can fill the column up to high tide.
+            //---
+            if (tidal_range > 0) {
+                deposit_amount *= get_tidal_inundation_fraction(-water_depth, tidal_range);
+                water_depth    += tidal_range;
+            }
+
             //---
             // Any sediment that is deposited above sea level is now added to the
             // river sediment for the next time step.
             //---
-            water_depth = sed_cube_water_depth(p, i, j);
 
             if (deposit_amount > 0
                 && deposit_amount > water_depth - 1e-5) {
@@ -231,87 +211,25 @@ rain_3(Sed_cube p, Sed_cell** deposit)
     return 0;
 }
 
-//---
-// calculate the amount of time that the elevation of the tide will change
-// by an increment dz (m).  the current time is given as t0.
-//---
-double
-get_tidal_time_step(double t0,
-    double tidal_range,
-    double tidal_period,
-    double dz)
-{
-    double z0, t1;
-    gboolean is_waning = FALSE;
-
-    eh_require(t0 <= tidal_period);
-    eh_require(t0 >= 0);
-
-    z0 = get_tidal_level(t0, tidal_range, tidal_period);
-
-    if (t0 > tidal_period / 2.) {
-        dz *= -1;
-        is_waning = TRUE;
-    }
-
-    if (fabs(z0 + dz) > tidal_range) {
-        dz = 0;
-        is_waning = is_waning ? FALSE : TRUE;
-    }
-
-    t1 = get_tidal_time(z0 + dz, tidal_range, tidal_period, is_waning);
+/** Fraction of a tidal cycle that a point is under water.
 
-    if (t1 < t0) {
-        t1 += tidal_period;
-    }
-
-    if (t1 <= t0) {
-        eh_watch_dbl(tidal_period);
-        eh_watch_dbl(tidal_range);
-        eh_watch_dbl(t1);
-        eh_watch_dbl(t0);
-    }
+The tide is taken to be sinusoidal with amplitude \p tidal_range about mean
+sea level.  A point at height \p z above mean sea level is flooded while the
+tide is above it, which is a fraction acos(z/A)/pi of each cycle.
 
-    eh_require(t1 > t0);
+@param z           Height above mean sea level
+@param tidal_range Amplitude of the tide
 
-    return t1 - t0;
-}
-
-//---
-// calculate the time required for the tide to reach a certain elevation, z.
-// given a tidal range (m) and tidal period (s).  in order for there to be a
-// single solution, we specify if the tide is waxing or waning.
-//---
+@return The fraction of a tidal cycle that the point is under water
+*/
 double
-get_tidal_time(double z,
-    double tidal_range,
-    double tidal_period,
-    gboolean waning)
+get_tidal_inundation_fraction(double z, double tidal_range)
 {
-    double dt;
-
-    eh_require(fabs(z) <= tidal_range);
-
-    dt = asin(z / tidal_range) * tidal_period / 2. / M_PI + tidal_period / 4.;
-
-    if (waning) {
-        dt = tidal_period - dt;
+    if (z <= -tidal_range) {
+        return 1.;
+    } else if (z >= tidal_range) {
+        return 0.;
+    } else {
+        return acos(z / tidal_range) / G_PI;
     }
-
-    return dt;
 }
-
-//---
-// calculate tide elevation at some time, t given a tidal range (m) and
-// tidal period (s).
-//---
-double
-get_tidal_level(double t, double tidal_range, double tidal_period)
-{
-    eh_require(t <= tidal_period);
-    eh_require(t >= 0);
-    t -= tidal_period / 4.;
-    return tidal_range * sin(t * 2.*M_PI / tidal_period);
-}
-
-
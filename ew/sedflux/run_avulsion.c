@@ -215,19 +215,19 @@ init_avulsion(Sed_process p, Eh_symbol_table tab, GError** error)
 
     if (eh_symbol_table_require_labels(tab, avulsion_req_labels, &tmp_err)) {
         if (!tmp_err) {
-            data->std_dev   = eh_symbol_table_input_value(tab, AVULSION_KEY_STDDEV, &tmp_err);
+            data->std_dev   = sed_process_input_value(p, tab, AVULSION_KEY_STDDEV, &tmp_err);
         }
 
         if (!tmp_err) {
-            data->f_remain  = eh_symbol_table_input_value(tab, AVULSION_KEY_FRACTION, &tmp_err);
+            data->f_remain  = sed_process_input_value(p, tab, AVULSION_KEY_FRACTION, &tmp_err);
         }
 
         if (!tmp_err) {
-            data->min_angle = eh_symbol_table_input_value(tab, AVULSION_KEY_MIN_ANGLE, &tmp_err);
+            data->min_angle = sed_process_input_value(p, tab, AVULSION_KEY_MIN_ANGLE, &tmp_err);
         }
 
         if (!tmp_err) {
-            data->max_angle = eh_symbol_table_input_value(tab, AVULSION_KEY_MAX_ANGLE, &tmp_err);
+            data->max_angle = sed_process_input_value(p, tab, AVULSION_KEY_MAX_ANGLE, &tmp_err);
         }
 
         data->branching_is_on = eh_symbol_table_bool_value(tab, AVULSION_KEY_BRANCHING);
@@ -281,11 +281,7 @@ init_avulsion_data(Sed_process p, Sed_cube prof)
 
         sed_river_set_avulsion_data(r, avulsion_new(NULL, 0.));
 
-        if (data->rand_seed > 0) {
-            data->rand = g_rand_new_with_seed(data->rand_seed);
-        } else {
-            data->rand = g_rand_new();
-        }
+        data->rand = sed_process_rand_new(data->rand_seed);
 
         data->reset_angle = TRUE;
     }
@@ -301,7 +297,7 @@ destroy_avulsion(Sed_process p)
 
         if (data) {
             if (data->rand) {
-                g_rand_free(data->rand);
+                eh_rand_destroy(data->rand);
             }
 
             eh_input_val_destroy(data->min_angle);
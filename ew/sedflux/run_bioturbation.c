@@ -69,8 +69,8 @@ init_bioturbation(Sed_process p, Eh_symbol_table t, GError** error)
     eh_require(p);
 
     if (eh_symbol_table_require_labels(t, bio_req_labels, &tmp_err)) {
-        data->k     = eh_symbol_table_input_value(t, BIO_KEY_K, &tmp_err);
-        data->depth = eh_symbol_table_input_value(t, BIO_KEY_DEPTH, &tmp_err);
+        data->k     = sed_process_input_value(p, t, BIO_KEY_K, &tmp_err);
+        data->depth = sed_process_input_value(p, t, BIO_KEY_DEPTH, &tmp_err);
     }
 
     if (tmp_err) {
@@ -0,0 +1,137 @@
+//---
+//
+// This file is part of sedflux.
+//
+// sedflux is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// sedflux is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with sedflux; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//---
+
+#define SED_COALESCE_PROC_NAME "coalesce"
+#define EH_LOG_DOMAIN SED_COALESCE_PROC_NAME
+
+#include <stdio.h>
+
+#include <utils/utils.h>
+#include <sed/sed_sedflux.h>
+#include "my_processes.h"
+
+Sed_process_info
+run_coalesce(Sed_process proc, Sed_cube p)
+{
+    Coalesce_t*          data = (Coalesce_t*)sed_process_user_data(proc);
+    Sed_process_info     info = SED_EMPTY_INFO;
+    Sed_coalesce_profile profile;
+    gssize               n_merged;
+
+    profile.depth     = data->depth;
+    profile.thickness = data->thickness;
+    profile.len       = data->len;
+    profile.f_tol     = data->f_tol;
+    profile.age_tol   = data->age_tol;
+
+    n_merged = sed_cube_coalesce(p, &profile);
+
+    eh_message("time             : %f", sed_cube_age_in_years(p));
+    eh_message("cells coalesced  : %d", (gint)n_merged);
+
+    return info;
+}
+
+#define COALESCE_KEY_DEPTH     "depth to start each resolution"
+#define COALESCE_KEY_THICKNESS "thickness of coalesced cells"
+#define COALESCE_KEY_F_TOL     "grain fraction tolerance"
+#define COALESCE_KEY_AGE_TOL   "age tolerance"
+
+static const gchar* coalesce_req_labels[] = {
+    COALESCE_KEY_DEPTH,
+    COALESCE_KEY_THICKNESS,
+    COALESCE_KEY_F_TOL,
+    COALESCE_KEY_AGE_TOL,
+    NULL
+};
+
+gboolean
+init_coalesce(Sed_process p, Eh_symbol_table tab, GError** error)
+{
+    Coalesce_t* data    = sed_process_new_user_data(p, Coalesce_t);
+    GError*     tmp_err = NULL;
+    gchar**     err_s   = NULL;
+    gboolean    is_ok   = TRUE;
+
+    eh_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    data->depth     = NULL;
+    data->thickness = NULL;
+    data->len       = 0;
+
+    if (eh_symbol_table_require_labels(tab, coalesce_req_labels, &tmp_err)) {
+        gint n_depths = 0;
+        gint n_thick  = 0;
+        gint i;
+
+        data->depth     = eh_symbol_table_dbl_array_value(tab, COALESCE_KEY_DEPTH,
+                &n_depths, ",");
+        data->thickness = eh_symbol_table_dbl_array_value(tab, COALESCE_KEY_THICKNESS,
+                &n_thick, ",");
+        data->f_tol     = eh_symbol_table_dbl_value(tab, COALESCE_KEY_F_TOL);
+        data->age_tol   = eh_symbol_table_dbl_value(tab, COALESCE_KEY_AGE_TOL);
+        data->len       = n_depths;
+
+        eh_check_to_s(n_depths > 0, "At least one coalescing depth", &err_s);
+        eh_check_to_s(n_depths == n_thick, "One cell thickness for each depth", &err_s);
+        eh_check_to_s(data->f_tol >= 0., "Grain fraction tolerance positive", &err_s);
+        eh_check_to_s(data->age_tol >= 0., "Age tolerance positive", &err_s);
+
+        for (i = 0 ; i < n_depths ; i++) {
+            eh_check_to_s(data->depth[i] >= 0., "Coalescing depths positive", &err_s);
+
+            if (i > 0) {
+                eh_check_to_s(data->depth[i] > data->depth[i - 1],
+                    "Coalescing depths increasing", &err_s);
+            }
+        }
+
+        for (i = 0 ; i < n_thick ; i++) {
+            eh_check_to_s(data->thickness[i] > 0., "Cell thicknesses positive", &err_s);
+        }
+
+        if (!tmp_err && err_s) {
+            eh_set_error_strv(&tmp_err, SEDFLUX_ERROR, SEDFLUX_ERROR_BAD_PARAM, err_s);
+        }
+    }
+
+    if (tmp_err) {
+        g_propagate_error(error, tmp_err);
+        is_ok = FALSE;
+    }
+
+    return is_ok;
+}
+
+gboolean
+destroy_coalesce(Sed_process p)
+{
+    if (p) {
+        Coalesce_t* data = (Coalesce_t*)sed_process_user_data(p);
+
+        if (data) {
+            eh_free(data->depth);
+            eh_free(data->thickness);
+            eh_free(data);
+        }
+    }
+
+    return TRUE;
+}
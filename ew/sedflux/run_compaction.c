@@ -37,9 +37,14 @@ thread_compact(void* data, void* user_data);
 Sed_process_info
 run_compaction(Sed_process proc, Sed_cube p)
 {
+    Compaction_t*    data = (Compaction_t*)sed_process_user_data(proc);
     Sed_process_info info = SED_EMPTY_INFO;
 
-    compact_cube(p);
+    if (data && data->cache) {
+        compact_cube_incremental(p, data->cache, data->load_tol);
+    } else {
+        compact_cube(p);
+    }
     /*
     #if !defined(WITH_THREADS)
 
@@ -88,6 +93,58 @@ run_compaction(Sed_process proc, Sed_cube p)
     return info;
 }
 
+#define COMPACTION_KEY_LOAD_TOL "load tolerance"
+
+gboolean
+init_compaction(Sed_process p, Eh_symbol_table tab, GError** error)
+{
+    Compaction_t* data    = sed_process_new_user_data(p, Compaction_t);
+    GError*       tmp_err = NULL;
+    gchar**       err_s   = NULL;
+    gboolean      is_ok   = TRUE;
+
+    eh_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    data->load_tol = 0.;
+    data->cache    = NULL;
+
+    // With a load tolerance, only cells whose effective load has changed by
+    // more than it (in Pa) are compacted.
+    if (tab && eh_symbol_table_lookup(tab, COMPACTION_KEY_LOAD_TOL)) {
+        data->load_tol = eh_symbol_table_dbl_value(tab, COMPACTION_KEY_LOAD_TOL);
+
+        eh_check_to_s(data->load_tol >= 0., "Load tolerance positive", &err_s);
+
+        if (!err_s) {
+            data->cache = compact_cache_new();
+        } else {
+            eh_set_error_strv(&tmp_err, SEDFLUX_ERROR, SEDFLUX_ERROR_BAD_PARAM, err_s);
+        }
+    }
+
+    if (tmp_err) {
+        g_propagate_error(error, tmp_err);
+        is_ok = FALSE;
+    }
+
+    return is_ok;
+}
+
+gboolean
+destroy_compaction(Sed_process p)
+{
+    if (p) {
+        Compaction_t* data = (Compaction_t*)sed_process_user_data(p);
+
+        if (data) {
+            compact_cache_destroy(data->cache);
+            eh_free(data);
+        }
+    }
+
+    return TRUE;
+}
+
 #if defined( WITH_THREADS )
 
 int
@@ -83,28 +83,28 @@ init_constants(Sed_process p, Eh_symbol_table tab, GError** error)
     eh_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
     if (!tmp_err) {
-        data->gravity     = eh_symbol_table_input_value(tab, S_KEY_CONST_GRAVITY, &tmp_err);
+        data->gravity     = sed_process_input_value(p, tab, S_KEY_CONST_GRAVITY, &tmp_err);
     }
 
     if (!tmp_err) {
-        data->rho_sea_h2o = eh_symbol_table_input_value(tab, S_KEY_CONST_RHO_SEA_H2O,
+        data->rho_sea_h2o = sed_process_input_value(p, tab, S_KEY_CONST_RHO_SEA_H2O,
                 &tmp_err);
     }
 
     if (!tmp_err) {
-        data->rho_h2o     = eh_symbol_table_input_value(tab, S_KEY_CONST_RHO_H2O, &tmp_err);
+        data->rho_h2o     = sed_process_input_value(p, tab, S_KEY_CONST_RHO_H2O, &tmp_err);
     }
 
     if (!tmp_err) {
-        data->salinity    = eh_symbol_table_input_value(tab, S_KEY_CONST_SALINITY, &tmp_err);
+        data->salinity    = sed_process_input_value(p, tab, S_KEY_CONST_SALINITY, &tmp_err);
     }
 
     if (!tmp_err) {
-        data->rho_quartz  = eh_symbol_table_input_value(tab, S_KEY_CONST_RHO_QUARTZ, &tmp_err);
+        data->rho_quartz  = sed_process_input_value(p, tab, S_KEY_CONST_RHO_QUARTZ, &tmp_err);
     }
 
     if (!tmp_err) {
-        data->rho_mantle  = eh_symbol_table_input_value(tab, S_KEY_CONST_RHO_MANTLE, &tmp_err);
+        data->rho_mantle  = sed_process_input_value(p, tab, S_KEY_CONST_RHO_MANTLE, &tmp_err);
     }
 
     if (tmp_err) {
@@ -21,16 +21,19 @@
 #define SED_DATA_DUMP_PROC_NAME "data dump"
 #define EH_LOG_DOMAIN SED_DATA_DUMP_PROC_NAME
 
+#include <errno.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 #include <utils/utils.h>
 #include <sed/sed_sedflux.h>
 #include "my_processes.h"
 
-Sed_process_info
-run_data_dump(Sed_process proc, Sed_cube prof)
+static void
+_data_dump_write(Data_dump_t* data, Sed_cube prof, int count)
 {
-    Data_dump_t*     data = (Data_dump_t*)sed_process_user_data(proc);
-    Sed_process_info info = SED_EMPTY_INFO;
     int i;
     char str[S_NAMEMAX], *filename;
     gchar* cube_name;
@@ -38,8 +41,7 @@ run_data_dump(Sed_process proc, Sed_cube prof)
     Sed_property_file_attr attr;
     Sed_property property;
 
-    data->count++;
-    sprintf(str, "%04d", data->count);
+    sprintf(str, "%04d", count);
 
     cube_name = sed_cube_name(prof);
 
@@ -82,6 +84,91 @@ run_data_dump(Sed_process proc, Sed_cube prof)
 
     eh_free(cube_name);
 
+    return;
+}
+
+/* Wait for snapshot writers to finish.
+
+Finished writers are always collected.  Then, block until no more than
+max_left writers are still running, oldest first.
+*/
+static void
+_data_dump_reap(Data_dump_t* data, gint max_left)
+{
+    GList* link;
+    GList* next;
+    gint status;
+
+    for (link = data->in_flight ; link ; link = next) {
+        const pid_t pid = GPOINTER_TO_INT(link->data);
+        pid_t done;
+
+        next = link->next;
+
+        do {
+            done = waitpid(pid, &status, WNOHANG);
+        } while (done < 0 && errno == EINTR);
+
+        if (done != 0) {
+            if (done == pid && (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)) {
+                eh_warning("Snapshot dump (pid %d) failed", pid);
+            }
+
+            data->in_flight = g_list_delete_link(data->in_flight, link);
+        }
+    }
+
+    while (g_list_length(data->in_flight) > max_left) {
+        const pid_t pid = GPOINTER_TO_INT(data->in_flight->data);
+        pid_t done;
+
+        do {
+            done = waitpid(pid, &status, 0);
+        } while (done < 0 && errno == EINTR);
+
+        if (done == pid && (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)) {
+            eh_warning("Snapshot dump (pid %d) failed", pid);
+        }
+
+        data->in_flight = g_list_delete_link(data->in_flight, data->in_flight);
+    }
+}
+
+Sed_process_info
+run_data_dump(Sed_process proc, Sed_cube prof)
+{
+    Data_dump_t*     data = (Data_dump_t*)sed_process_user_data(proc);
+    Sed_process_info info = SED_EMPTY_INFO;
+
+    data->count++;
+
+    if (data->max_in_flight > 0) {
+        pid_t pid;
+
+        // The forked child sees a copy-on-write snapshot of the cube as it is
+        // now and writes it while the parent carries on with the next time
+        // step.
+        _data_dump_reap(data, data->max_in_flight - 1);
+
+        fflush(NULL);
+
+        pid = fork();
+
+        if (pid == 0) {
+            _data_dump_write(data, prof, data->count);
+            fflush(NULL);
+            _exit(EXIT_SUCCESS);
+        } else if (pid > 0) {
+            data->in_flight = g_list_append(data->in_flight, GINT_TO_POINTER(pid));
+        } else {
+            eh_warning("Unable to fork a snapshot dump (%s); dumping now",
+                g_strerror(errno));
+            _data_dump_write(data, prof, data->count);
+        }
+    } else {
+        _data_dump_write(data, prof, data->count);
+    }
+
     return info;
 }
 
@@ -91,6 +178,7 @@ run_data_dump(Sed_process proc, Sed_cube prof)
 #define DATA_DUMP_KEY_Y_LIM     "vertical limits"
 #define DATA_DUMP_KEY_X_LIM     "horizontal limits"
 #define DATA_DUMP_KEY_PROPERTY  "property"
+#define DATA_DUMP_KEY_IN_FLIGHT "snapshots in flight"
 
 static const gchar* data_dump_req_labels[] = {
     DATA_DUMP_KEY_DIR,
@@ -111,6 +199,9 @@ init_data_dump(Sed_process p, Eh_symbol_table tab, GError** error)
 
     eh_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
+    data->max_in_flight = 0;
+    data->in_flight     = NULL;
+
     if (eh_symbol_table_require_labels(tab, data_dump_req_labels, &tmp_err)) {
         data->property   = g_array_new(FALSE, FALSE, sizeof(Sed_property));
         data->output_dir = eh_symbol_table_value(tab, DATA_DUMP_KEY_DIR);
@@ -175,6 +266,23 @@ init_data_dump(Sed_process p, Eh_symbol_table tab, GError** error)
             g_strfreev(property);
         }
 
+        // ---
+        // with snapshots in flight, dumps are written by forked processes so
+        // that the run does not wait for them.  no more than this many are
+        // written at once.
+        // ---
+        if (eh_symbol_table_lookup(tab, DATA_DUMP_KEY_IN_FLIGHT)) {
+            gchar** err_s = NULL;
+
+            data->max_in_flight = eh_symbol_table_int_value(tab, DATA_DUMP_KEY_IN_FLIGHT);
+
+            eh_check_to_s(data->max_in_flight >= 0, "Snapshots in flight positive", &err_s);
+
+            if (err_s) {
+                eh_set_error_strv(&tmp_err, SEDFLUX_ERROR, SEDFLUX_ERROR_BAD_PARAM, err_s);
+            }
+        }
+
         //   if ( !try_dir(data->output_dir) )
         if (!tmp_err) {
             eh_open_dir(data->output_dir, &tmp_err);
@@ -196,6 +304,8 @@ destroy_data_dump(Sed_process p)
         Data_dump_t* data = (Data_dump_t*)sed_process_user_data(p);
 
         if (data) {
+            _data_dump_reap(data, 0);
+
             if (data->property) {
                 g_array_free(data->property, TRUE);
             }
@@ -260,6 +370,9 @@ load_data_dump_data(gpointer ptr, FILE* fp)
 
     fread(&(data->count), sizeof(int), 1, fp);
 
+    data->max_in_flight = 0;
+    data->in_flight     = NULL;
+
     return TRUE;
 }
 
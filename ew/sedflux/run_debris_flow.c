@@ -108,7 +108,7 @@ run_debris_flow(Sed_process proc, Sed_cube p)
     c         = sed_cell_new_env();
 
     for (i = 0; i < sed_cube_n_y(fail); i++) {
-        sed_column_top(sed_cube_col(fail, i), sed_cube_thickness(fail, 0, i), c);
+        sed_column_top(sed_cube_peek_col(fail, i), sed_cube_thickness(fail, 0, i), c);
         sed_cell_add(flow_cell, c);
     }
 
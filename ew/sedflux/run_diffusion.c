@@ -114,7 +114,7 @@ init_diffusion(Sed_process p, Eh_symbol_table tab, GError** error)
     eh_symbol_table_require_labels(tab, diffusion_req_labels, &tmp_err);
 
     if (!tmp_err) {
-        data->k_max      = eh_symbol_table_input_value(tab, DIFFUSION_KEY_K_MAX, &tmp_err);
+        data->k_max      = sed_process_input_value(p, tab, DIFFUSION_KEY_K_MAX, &tmp_err);
         data->skin_depth = eh_symbol_table_dbl_value(tab, DIFFUSION_KEY_SKIN_DEPTH);
 
         // eh_check_to_s(data->k_max > 0., "Diffusion coefficient positive", &err_s);
@@ -101,10 +101,24 @@ run_isostasy(Sed_process proc, Sed_cube prof)
         double this_half_load;
         Eh_dbl_grid this_dw_small;
         Eh_dbl_grid this_dw_full;
-        Eh_dbl_grid last_load_small;
         Eh_dbl_grid last_load_full;
-        Eh_dbl_grid this_load_small;
         Eh_dbl_grid this_load_full;
+        Eh_dbl_grid v_0_full;
+        Eh_dbl_grid v_0;
+
+        //---
+        // The weights used to move between the full and the coarse grids only
+        // depend on the grid sizes, so they are calculated once.
+        //---
+        if (!eh_remesh_is_shape(data->shrink, full_n_x, full_n_y, small_n_x, small_n_y)) {
+            eh_remesh_destroy(data->shrink);
+            eh_remesh_destroy(data->expand);
+
+            data->shrink = eh_remesh_new(full_n_x, full_n_y, small_n_x, small_n_y,
+                    EH_REMESH_BILINEAR);
+            data->expand = eh_remesh_new(small_n_x, small_n_y, full_n_x, full_n_y,
+                    EH_REMESH_BILINEAR);
+        }
 
         //---
         // Create a grid to hold the calculated deflections.
@@ -117,6 +131,9 @@ run_isostasy(Sed_process proc, Sed_cube prof)
         }
 
         last_load_full = eh_grid_dup(data->last_load);
+        this_dw_full   = eh_grid_new(double, full_n_x, full_n_y);
+        v_0_full       = eh_grid_new(double, full_n_x, full_n_y);
+        v_0            = eh_grid_new(double, small_n_x, small_n_y);
 
         eh_debug("Subside the basin");
 
@@ -138,16 +155,15 @@ run_isostasy(Sed_process proc, Sed_cube prof)
             this_half_load = sed_cube_water_pressure(prof, 0, sed_cube_n_y(prof) - 1);
 
             //---
-            // Remesh the old and new load grids, to a coarser mesh.  We do this to
-            // improve run-time for 2D simulations.
+            // Remesh the change in load to a coarser mesh.  We do this to
+            // improve run-time for 2D simulations.  The remesh is linear, so
+            // remeshing the difference is the same as differencing the remeshed
+            // old and new loads.
             //---
             eh_debug("Remesh the load grids");
-            last_load_small = eh_dbl_grid_remesh(last_load_full,
-                    small_n_x,
-                    small_n_y);
-            this_load_small = eh_dbl_grid_remesh(this_load_full,
-                    small_n_x,
-                    small_n_y);
+            eh_grid_copy_data(v_0_full, this_load_full);
+            eh_dbl_grid_subtract(v_0_full, last_load_full);
+            eh_remesh_apply(data->shrink, v_0_full, v_0);
 
             //---
             // Calculate the isostatic subsidence for the newly added sediment.
@@ -161,20 +177,15 @@ run_isostasy(Sed_process proc, Sed_cube prof)
             //---
             eh_debug("Calculate deflections");
             {
-                Eh_dbl_grid v_0 = eh_grid_dup(this_load_small);
                 double      eet = data->eet;
                 double      y   = data->youngs_modulus;
 
-                eh_dbl_grid_subtract(v_0, last_load_small);
-
                 subside_grid_load(this_dw_small, v_0, eet, y);
 
                 if (sed_mode_is_2d()) {
                     double half_load = this_half_load - data->last_half_load;
                     subside_half_plane_load(this_dw_small, half_load, eet, y);
                 }
-
-                eh_grid_destroy(v_0, TRUE);
             }
             /*
                      eh_debug( "Calculate the isostatic subsidence" );
@@ -213,9 +224,7 @@ run_isostasy(Sed_process proc, Sed_cube prof)
             // sed_cube can be deflected.
             //---
             eh_debug("Expand the grid to full resolution");
-            this_dw_full = eh_dbl_grid_expand(this_dw_small,
-                    full_n_x,
-                    full_n_y);
+            eh_remesh_apply(data->expand, this_dw_small, this_dw_full);
 
             //---
             // Subside the sed_cube.
@@ -235,9 +244,6 @@ run_isostasy(Sed_process proc, Sed_cube prof)
             //---
             // Free the grids.
             //---
-            eh_grid_destroy(this_dw_full, TRUE);
-            eh_grid_destroy(last_load_small, TRUE);
-            eh_grid_destroy(this_load_small, TRUE);
             eh_grid_destroy(this_load_full, TRUE);
 
             last_dw  = total_dw;
@@ -249,6 +255,9 @@ run_isostasy(Sed_process proc, Sed_cube prof)
         while (fabs(total_dw) > 0 && fabs((total_dw - last_dw) / total_dw) > .01);
 
         eh_grid_destroy(this_dw_small, TRUE);
+        eh_grid_destroy(this_dw_full, TRUE);
+        eh_grid_destroy(v_0_full, TRUE);
+        eh_grid_destroy(v_0, TRUE);
         eh_grid_destroy(last_load_full, TRUE);
 
     }
@@ -321,6 +330,8 @@ init_isostasy(Sed_process p, Eh_symbol_table tab, GError** error)
 
     data->last_dw_iso     = NULL;
     data->last_load       = NULL;
+    data->shrink          = NULL;
+    data->expand          = NULL;
     data->last_half_load  = 0.;
 
     eh_symbol_table_require_labels(tab, isostasy_req_labels, &tmp_err);
@@ -373,6 +384,8 @@ destroy_isostasy(Sed_process p)
         if (data) {
             eh_grid_destroy(data->last_dw_iso, TRUE);
             eh_grid_destroy(data->last_load, TRUE);
+            eh_remesh_destroy(data->shrink);
+            eh_remesh_destroy(data->expand);
 
             eh_free(data);
         }
@@ -400,6 +413,9 @@ load_isostasy_data(gpointer ptr, FILE* fp)
 
     fread(data, sizeof(Isostasy_t), 1, fp);
 
+    data->shrink = NULL;
+    data->expand = NULL;
+
     //   data->old_thickness = eh_new( double , data->len );
     //   data->old_height    = eh_new( double , data->len );
 
@@ -49,7 +49,11 @@ run_met_station(Sed_process proc, Sed_cube prof)
         init_met_station_data(proc, prof, NULL);
     }
 
-    sed_tripod_write(data->met_fp, prof);
+    if (data->group) {
+        sed_tripod_group_write(data->group, prof);
+    } else {
+        sed_tripod_write(data->met_fp, prof);
+    }
 
     return info;
 }
@@ -78,14 +82,47 @@ init_met_station(Sed_process p, Eh_symbol_table tab, GError** error)
     eh_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
     data->met_fp           = NULL;
+    data->group            = NULL;
+    data->group_parameters = NULL;
 
     if (eh_symbol_table_require_labels(tab, measuring_station_req_labels, &tmp_err)) {
+        gchar** names;
+
         data->parameter_str    = eh_symbol_table_value(tab, MET_KEY_PARAMETER);
         data->from_river_mouth = eh_symbol_table_bool_value(tab, MET_KEY_WHENCE);
         data->filename         = eh_symbol_table_value(tab, MET_KEY_FILENAME);
-        data->parameter        = sed_measurement_new(data->parameter_str);
 
-        eh_require(data->parameter);
+        // A list of parameters is measured by a single group of stations
+        // that writes all of them to one binary file.
+        names = g_strsplit(data->parameter_str, ",", -1);
+
+        if (g_strv_length(names) > 1) {
+            gint i;
+
+            data->group_parameters = eh_new(Sed_measurement, g_strv_length(names) + 1);
+
+            for (i = 0 ; !tmp_err && names[i] ; i++) {
+                g_strstrip(names[i]);
+                data->group_parameters[i] = sed_measurement_new(names[i]);
+
+                if (!data->group_parameters[i]) {
+                    g_set_error(&tmp_err, SEDFLUX_ERROR, SEDFLUX_ERROR_BAD_PARAM,
+                        "Unknown measurement: %s", names[i]);
+                }
+            }
+
+            data->group_parameters[i] = NULL;
+
+            if (!tmp_err) {
+                data->parameter = sed_measurement_dup(data->group_parameters[0]);
+            }
+        } else {
+            data->parameter = sed_measurement_new(data->parameter_str);
+        }
+
+        g_strfreev(names);
+
+        eh_require(tmp_err || data->parameter);
 
         pos_s                  = eh_symbol_table_lookup(tab, MET_KEY_POSITION);
 
@@ -125,7 +162,26 @@ init_met_station_data(Sed_process proc, Sed_cube prof, GError** error)
 {
     Met_station_t* data = (Met_station_t*)sed_process_user_data(proc);
 
-    if (data) {
+    if (data && data->group_parameters) {
+        if (data->pos->len <= 0) {
+            data->group = sed_tripod_group_new(data->filename,
+                    data->group_parameters, prof, NULL, 0);
+        } else {
+            // Station positions are distances along the first row of the cube
+            gint     i;
+            Eh_pt_2* pos = eh_new(Eh_pt_2, data->pos->len);
+
+            for (i = 0 ; i < data->pos->len ; i++) {
+                pos[i].x = sed_cube_col_x(prof, 0);
+                pos[i].y = g_array_index(data->pos, double, i);
+            }
+
+            data->group = sed_tripod_group_new(data->filename,
+                    data->group_parameters, prof, pos, data->pos->len);
+
+            eh_free(pos);
+        }
+    } else if (data) {
         data->met_fp = sed_tripod_new(data->filename, data->parameter, NULL);
 
         if (data->pos->len <= 0) {
@@ -149,6 +205,17 @@ destroy_met_station(Sed_process p)
 
         if (data) {
             sed_tripod_destroy(data->met_fp);
+            sed_tripod_group_destroy(data->group);
+
+            if (data->group_parameters) {
+                Sed_measurement* m;
+
+                for (m = data->group_parameters ; *m ; m++) {
+                    sed_measurement_destroy(*m);
+                }
+
+                eh_free(data->group_parameters);
+            }
 
             if (data->pos) {
                 g_array_free(data->pos, FALSE);
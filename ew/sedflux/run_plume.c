@@ -151,35 +151,9 @@ run_plume_hypo(Sed_process proc, Sed_cube prof)
         Sed_riv       this_river;
         Plume_river   river_data;
         Plume_inputs  plume_const;
-        Eh_dbl_grid*  plume_deposit_grid = eh_new(Eh_dbl_grid, n_susp_grains);
+        Eh_dbl_grid*  plume_deposit_grid = data->plume_deposit_grid;
         Sed_cell_grid in_suspension;
 
-        for (n = 0 ; n < n_susp_grains ; n++) {
-            eh_debug("Creating grid for grain type %d", n);
-
-            plume_deposit_grid[n] = eh_grid_new(double,
-                    2 * sed_cube_n_x(prof),
-                    2 * sed_cube_n_y(prof));
-
-            eh_debug("Setting x values");
-
-            if (sed_mode_is_3d())
-                eh_grid_set_x_lin(plume_deposit_grid[n],
-                    - sed_cube_n_x(prof)*sed_cube_x_res(prof)
-                    + sed_cube_x_res(prof)*.5,
-                    sed_cube_x_res(prof));
-            else
-                eh_grid_set_x_lin(plume_deposit_grid[n],
-                    -sed_cube_x_res(prof),
-                    sed_cube_x_res(prof));
-
-            eh_debug("Setting y values");
-            eh_grid_set_y_lin(plume_deposit_grid[n],
-                - sed_cube_n_y(prof)*sed_cube_y_res(prof)
-                + sed_cube_y_res(prof)*.5,
-                sed_cube_y_res(prof));
-        }
-
         this_river = (Sed_riv)sed_process_use(proc, PLUME_HYDRO_DATA);
         hydro_data = sed_river_hydro(this_river);
 
@@ -258,11 +232,10 @@ run_plume_hypo(Sed_process proc, Sed_cube prof)
                 sediment_data,
                 plume_deposit_grid,
                 data->plume_data)) {
-            double*    deposit_rate;
             double**   plume_deposit;
             Sed_cell** deposit = sed_cell_grid_data(data->deposit_grid);
-
-            deposit_rate = eh_new(double, n_grains);
+            // Scratch space from the plume workspace, which plume3d is done with
+            double*    deposit_rate = plume_data_work(data->plume_data, n_grains);
 
             for (i = 0 ; i < eh_grid_n_x(data->deposit_grid) ; i++) {
                 for (j = 0 ; j < eh_grid_n_y(data->deposit_grid) ; j++) {
@@ -280,8 +253,6 @@ run_plume_hypo(Sed_process proc, Sed_cube prof)
                     sed_cell_add_amount(deposit[i][j], deposit_rate);
                 }
             }
-
-            eh_free(deposit_rate);
         } else {
             g_warning("Subroutine PLUME returned an error.");
             sed_cell_grid_clear(data->deposit_grid);
@@ -351,14 +322,6 @@ run_plume_hypo(Sed_process proc, Sed_cube prof)
             }
         }
 
-        eh_debug("Free temporary grids");
-
-        for (n = 0 ; n < n_susp_grains ; n++) {
-            eh_grid_destroy(plume_deposit_grid[n], TRUE);
-        }
-
-        eh_free(plume_deposit_grid);
-
         eh_free(river_data.Cs);
 
         hydro_data = sed_hydro_destroy(hydro_data);
@@ -433,6 +396,9 @@ init_plume_data(Sed_process proc, Sed_cube prof, GError** error)
 #define HYPO_KEY_WIDTH            "maximum plume width"
 #define HYPO_KEY_X_SHORE_NODES    "number of grid nodes in cross-shore"
 #define HYPO_KEY_RIVER_NODES      "number of grid nodes in river mouth"
+// Optional.  Beyond the near field, each row of the plume grid is this many
+// times wider than the last (see docs/running.txt).
+#define HYPO_KEY_X_RATIO          "far-field grid coarsening"
 
 static const gchar* hypo_3d_req_labels[] = {
     HYPO_KEY_CONCENTRATION,
@@ -467,6 +433,7 @@ init_plume_hypo(Sed_process p, Eh_symbol_table tab, GError** error)
     data->plume_deposit      = NULL;
     data->last_river_data.Cs = NULL;
     data->plume_data         = NULL;
+    data->plume_deposit_grid = NULL;
     data->deposit_grid       = NULL;
     data->last_deposit_grid  = NULL;
 
@@ -478,7 +445,7 @@ init_plume_hypo(Sed_process p, Eh_symbol_table tab, GError** error)
 
     if (!tmp_err) {
         if (sed_mode_is_3d()) {
-            data->current_velocity = eh_symbol_table_input_value(tab, HYPO_KEY_CURRENT_VEL,
+            data->current_velocity = sed_process_input_value(p, tab, HYPO_KEY_CURRENT_VEL,
                     &tmp_err);
         } else {
             data->current_velocity = eh_input_val_set("0.0", NULL);
@@ -489,12 +456,20 @@ init_plume_hypo(Sed_process p, Eh_symbol_table tab, GError** error)
         data->ndx                 = eh_symbol_table_int_value(tab, HYPO_KEY_X_SHORE_NODES);
         data->ndy                 = eh_symbol_table_int_value(tab, HYPO_KEY_RIVER_NODES);
 
+        // Optional.  By default the plume grid is uniform.
+        if (eh_symbol_table_lookup(tab, HYPO_KEY_X_RATIO)) {
+            data->x_ratio = eh_symbol_table_dbl_value(tab, HYPO_KEY_X_RATIO);
+        } else {
+            data->x_ratio = 1.;
+        }
+
         data->plume_width *= 1000.;
 
         eh_check_to_s(data->ocean_concentration >= 0., "Ocean concentration positive", &err_s);
         eh_check_to_s(data->plume_width >= 0., "Plume width positive", &err_s);
         eh_check_to_s(data->ndx > 0., "Plume ndx positive integer", &err_s);
         eh_check_to_s(data->ndy > 0., "Plume ndy positive integer", &err_s);
+        eh_check_to_s(data->x_ratio >= 1., "Plume far-field coarsening at least 1", &err_s);
 
         if (err_s) {
             eh_set_error_strv(&tmp_err, SEDFLUX_ERROR, SEDFLUX_ERROR_BAD_PARAM, err_s);
@@ -528,6 +503,41 @@ init_plume_hypo_data(Sed_process proc, Sed_cube prof, GError** error)
 
         data->plume_data = eh_new(Plume_data, 1);
         plume_data_init(data->plume_data);
+
+        data->plume_data->x_ratio = data->x_ratio;
+
+        //---
+        // The plume deposits onto a grid for each suspended grain.  The grids
+        // are kept, along with the plume workspace, for all of the rivers
+        // and all of the time steps.
+        //---
+        {
+            gint n;
+            const gint n_susp_grains = sed_sediment_env_n_types() - 1;
+
+            data->plume_deposit_grid = eh_new(Eh_dbl_grid, n_susp_grains);
+
+            for (n = 0 ; n < n_susp_grains ; n++) {
+                data->plume_deposit_grid[n] = eh_grid_new(double,
+                        2 * sed_cube_n_x(prof),
+                        2 * sed_cube_n_y(prof));
+
+                if (sed_mode_is_3d())
+                    eh_grid_set_x_lin(data->plume_deposit_grid[n],
+                        - sed_cube_n_x(prof)*sed_cube_x_res(prof)
+                        + sed_cube_x_res(prof)*.5,
+                        sed_cube_x_res(prof));
+                else
+                    eh_grid_set_x_lin(data->plume_deposit_grid[n],
+                        -sed_cube_x_res(prof),
+                        sed_cube_x_res(prof));
+
+                eh_grid_set_y_lin(data->plume_deposit_grid[n],
+                    - sed_cube_n_y(prof)*sed_cube_y_res(prof)
+                    + sed_cube_y_res(prof)*.5,
+                    sed_cube_y_res(prof));
+            }
+        }
     }
 
     return TRUE;
@@ -549,6 +559,17 @@ destroy_plume_hypo(Sed_process p)
             eh_free(data->last_river_data.Cs);
             destroy_plume_data(data->plume_data);
 
+            if (data->plume_deposit_grid) {
+                gint n;
+                const gint n_susp_grains = sed_sediment_env_n_types() - 1;
+
+                for (n = 0 ; n < n_susp_grains ; n++) {
+                    eh_grid_destroy(data->plume_deposit_grid[n], TRUE);
+                }
+
+                eh_free(data->plume_deposit_grid);
+            }
+
             eh_input_val_destroy(data->current_velocity);
             eh_free(data);
         }
@@ -44,6 +44,9 @@ run_quake(Sed_process proc, Sed_cube prof)
         init_quake_data(proc, prof, NULL);
     }
 
+    eh_rand_set_stream(data->rand, g_str_hash(sed_process_name(proc)), 0,
+        sed_process_run_count(proc));
+
     a               = exp(-1. / data->mean_quake);
     time_step       = sed_cube_age_in_years(prof) - data->last_time;
     data->last_time = sed_cube_age_in_years(prof);
@@ -118,11 +121,7 @@ init_quake_data(Sed_process proc, Sed_cube prof, GError** error)
     Quake_t* data = (Quake_t*)sed_process_user_data(proc);
 
     if (data) {
-        if (data->rand_seed > 0) {
-            data->rand = g_rand_new_with_seed(data->rand_seed);
-        } else {
-            data->rand = g_rand_new();
-        }
+        data->rand = sed_process_rand_new(data->rand_seed);
 
         data->last_time = sed_cube_age_in_years(prof);
     }
@@ -137,7 +136,7 @@ destroy_quake(Sed_process p)
         Quake_t* data = (Quake_t*)sed_process_user_data(p);
 
         if (data) {
-            g_rand_free(data->rand);
+            eh_rand_destroy(data->rand);
 
             eh_free(data);
         }
@@ -30,8 +30,6 @@
 
 double**
 read_sea_level_curve(char*, gint*);
-double
-get_sea_level(double**, gint, double);
 
 gboolean
 init_sea_level_data(Sed_process proc, Sed_cube prof, GError** error);
@@ -50,7 +48,7 @@ run_sea_level(Sed_process proc, Sed_cube prof)
 
     year = sed_cube_age_in_years(prof) - data->start_year;
 
-    new_sea_level = get_sea_level(data->sea_level, data->len, year);
+    new_sea_level = eh_time_series_eval(data->curve, year);
 
     if (eh_isnan(new_sea_level)) {
         eh_warning("The current time is out of range of the sea level curve.");
@@ -90,6 +88,7 @@ init_sea_level(Sed_process p, Eh_symbol_table tab, GError** error)
 
     eh_message("initializing sea level");
     data->start_year = 0.;
+    data->curve      = NULL;
 
     eh_symbol_table_require_labels(tab, sea_level_req_labels, &tmp_err);
 
@@ -114,6 +113,11 @@ init_sea_level(Sed_process p, Eh_symbol_table tab, GError** error)
                 &tmp_err);
         data->len = len;
 
+        if (!tmp_err) {
+            data->curve = eh_time_series_new(data->sea_level[0], data->sea_level[1],
+                    len, &tmp_err);
+        }
+
         g_free(file);
         g_free(prefix);
     }
@@ -151,6 +155,7 @@ destroy_sea_level(Sed_process p)
 
         if (data) {
             eh_free_2(data->sea_level);
+            eh_time_series_destroy(data->curve);
 
             eh_free(data->filename);
             eh_free(data);
@@ -197,23 +202,9 @@ load_sea_level_data(gpointer ptr, FILE* fp)
     fread(data->sea_level[0], sizeof(double), len, fp);
     fread(data->sea_level[1], sizeof(double), len, fp);
 
-    return TRUE;
-}
-
-double
-get_sea_level(double** sea_level, gint len, double year)
-{
-    double new_sea_level;
-
-    eh_require(sea_level);
-
-    {
-        double* t  = sea_level[0];
-        double* z  = sea_level[1];
-
-        interpolate(t, z, len, &year, &new_sea_level, 1);
-    }
+    data->curve = eh_time_series_new(data->sea_level[0], data->sea_level[1], len,
+            NULL);
 
-    return new_sea_level;
+    return data->curve != NULL;
 }
 
@@ -34,7 +34,8 @@ typedef struct {
 User_storm_data;
 
 GSList*
-get_equivalent_storm(GFunc    get_storm,
+get_equivalent_storm(Eh_rand* rand,
+    GFunc    get_storm,
     gpointer user_data,
     double   n_days,
     double   sig_event_fraction,
@@ -88,6 +89,11 @@ run_storm(Sed_process proc, Sed_cube prof)
     data->last_time = sed_cube_age_in_years(prof);
     n_days          = time_step * S_DAYS_PER_YEAR;
 
+    // Draws for this time step come from their own stream so that they do not
+    // depend on how many numbers were drawn in earlier steps.
+    eh_rand_set_stream(data->rand, g_str_hash(sed_process_name(proc)), 0,
+        sed_process_run_count(proc));
+
     if (time_step > 1e-6) {
         if (TRUE) {
             User_storm_data user_data;
@@ -95,7 +101,8 @@ run_storm(Sed_process proc, Sed_cube prof)
             user_data.h = data->wave_height;
             user_data.t = start_time;
 
-            storm_list = get_equivalent_storm((GFunc)storm_func_user,
+            storm_list = get_equivalent_storm(data->rand,
+                    (GFunc)storm_func_user,
                     &user_data,
                     n_days,
                     data->fraction,
@@ -204,7 +211,7 @@ init_storm(Sed_process p, Eh_symbol_table tab, GError** error)
     eh_symbol_table_require_labels(tab, storm_req_labels, &tmp_err);
 
     if (!tmp_err) {
-        data->wave_height        = eh_symbol_table_input_value(tab, STORM_KEY_WAVE_HEIGHT,
+        data->wave_height        = sed_process_input_value(p, tab, STORM_KEY_WAVE_HEIGHT,
                 &tmp_err);
         data->fraction           = eh_symbol_table_dbl_value(tab, STORM_KEY_FRACTION);
         data->average_non_events = eh_symbol_table_bool_value(tab, STORM_KEY_NON_EVENTS);
@@ -232,11 +239,7 @@ init_storm_data(Sed_process proc, Sed_cube prof, GError** error)
     Storm_t* data = (Storm_t*)sed_process_user_data(proc);
 
     if (data) {
-        if (data->rand_seed > 0) {
-            data->rand = g_rand_new_with_seed(data->rand_seed);
-        } else {
-            data->rand = g_rand_new();
-        }
+        data->rand = sed_process_rand_new(data->rand_seed);
 
         data->last_time = sed_cube_age_in_years(prof);
     }
@@ -251,7 +254,7 @@ destroy_storm(Sed_process p)
         Storm_t* data = (Storm_t*)sed_process_user_data(p);
 
         if (data) {
-            g_rand_free(data->rand);
+            eh_rand_destroy(data->rand);
             eh_input_val_destroy(data->wave_height);
             eh_free(data);
         }
@@ -270,7 +273,7 @@ law pdf that is fixed by the average storm magnitude.  The average storm length
 determines the probability that this storm will be the same as the last
 (yesterday's) storm.
 
-\param rand          A GRand
+\param rand          An Eh_rand
 \param storm_length  The average length of a storm.
 \param average_storm The average magnitude of a storm.
 \param variance      The variance of storm PDF
@@ -279,18 +282,17 @@ determines the probability that this storm will be the same as the last
 \return The magnitude of the next storm.
 */
 double
-storm(GRand* rand, double storm_length, double average_storm, double variance,
+storm(Eh_rand* rand, double storm_length, double average_storm, double variance,
     double last_storm)
 {
     double alpha, f, a;
-    static long seed[1];
 
     alpha = last_storm;
 
     f = 1. - 1. / storm_length;
     a = exp(-1 / average_storm);
 
-    if (eh_ran1(seed) > f) {
+    if (eh_rand_double(rand) > f) {
         alpha = eh_max_log_normal(rand, average_storm, variance, 1. / 365. / 1.);
     }
 
@@ -315,7 +317,7 @@ print_ocean_storm(Sed_ocean_storm this_storm, gpointer user_data);
 struct weibull_storm_data {
     double sigma;
     double mu;
-    GRand* rand;
+    Eh_rand* rand;
 };
 
 void
@@ -323,7 +325,7 @@ storm_func_weibull(double* ans, struct weibull_storm_data* user_data)
 {
     double variance      = user_data->sigma;
     double average_storm = user_data->mu;
-    GRand* rand          = user_data->rand;
+    Eh_rand* rand        = user_data->rand;
 
     *ans = eh_rand_max_weibull(rand,
             average_storm,
@@ -340,7 +342,8 @@ storm_func_user(double* ans, User_storm_data* user_data)
 }
 
 GSList*
-get_equivalent_storm(GFunc get_storm,
+get_equivalent_storm(Eh_rand* rand,
+    GFunc get_storm,
     gpointer user_data,
     double n_days,
     double sig_event_fraction,
@@ -371,7 +374,7 @@ get_equivalent_storm(GFunc get_storm,
         double n_events;
         double fraction = modf(n_days * sig_event_fraction, &n_events);
 
-        if (g_random_double_range(0, 1.) < fraction) {
+        if (eh_rand_double(rand) < fraction) {
             n_sig_events++;
         }
     }
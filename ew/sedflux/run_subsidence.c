@@ -43,19 +43,104 @@ get_tectonics(GArray* rate_array, double year, double* rate_resample, int len);
 gboolean
 init_subsidence_data(Sed_process proc, Sed_cube prof, GError** error);
 
+/* Copy the subsidence rates of record n into a cube-sized array.
+
+In 3D, only this record is read from the subsidence file.  In 2D, the
+records were all read (and resampled to the cube) when the file was scanned.
+*/
+static gboolean
+_subsidence_read_record(Subsidence_t* data, Sed_cube prof, gint n, double* rate,
+    GError** error)
+{
+    const gint n_x = sed_cube_n_x(prof);
+    const gint n_y = sed_cube_n_y(prof);
+    double* src;
+    gint stride;
+    gint i, j;
+
+    if (data->subsidence_seq) {
+        src    = eh_dbl_grid_data_start((Eh_dbl_grid)data->subsidence_seq->data[n]);
+        stride = eh_grid_n_y((Eh_dbl_grid)data->subsidence_seq->data[n]);
+    } else {
+        src    = sed_get_floor_sequence_frame_3(data->filename, n, data->frame, error);
+        stride = data->grid_n_y;
+    }
+
+    if (!src) {
+        return FALSE;
+    }
+
+    for (i = 0 ; i < n_x ; i++)
+        for (j = 0 ; j < n_y ; j++) {
+            rate[i * n_y + j] = src[i * stride + j];
+        }
+
+    return TRUE;
+}
+
+/* Make records n and n+1 the active pair of subsidence records.
+
+The rates of the lower record and the change in rate per year between the
+two are kept for each column.  Moving to the next pair reuses the upper
+record, so each record is read about once in a run.  Past the last record,
+the rate of the last record is used.
+*/
+static void
+_subsidence_set_interval(Subsidence_t* data, Sed_cube prof, gint n)
+{
+    if (n != data->lower) {
+        const gint len = sed_cube_size(prof);
+        GError* err = NULL;
+        gint id;
+
+        if (data->lower >= 0 && n == data->lower + 1 && n < data->n_recs) {
+            double* tmp = data->rate_lo;
+            data->rate_lo = data->rate_hi;
+            data->rate_hi = tmp;
+        } else {
+            _subsidence_read_record(data, prof, n, data->rate_lo, &err);
+        }
+
+        if (!err && n + 1 < data->n_recs) {
+            const double dt = data->t[n + 1] - data->t[n];
+
+            _subsidence_read_record(data, prof, n + 1, data->rate_hi, &err);
+
+            for (id = 0 ; id < len ; id++) {
+                data->slope[id] = (data->rate_hi[id] - data->rate_lo[id]) / dt;
+            }
+        } else {
+            for (id = 0 ; id < len ; id++) {
+                data->slope[id] = 0.;
+            }
+        }
+
+        if (err) {
+            eh_error("%s: Unable to read subsidence record %d: %s",
+                data->filename, n, err->message);
+        }
+
+        data->lower = n;
+    }
+}
+
 Sed_process_info
 run_subsidence(Sed_process proc, Sed_cube prof)
 {
     Subsidence_t*    data = (Subsidence_t*)sed_process_user_data(proc);
     Sed_process_info info = SED_EMPTY_INFO;
-    gsize i, j, n;
+    gint i, j, n;
     double year;
     double start_year, end_year;
     double upper_edge, lower_edge;
     double time_step, total_time = 0., total_subsidence = 0.;
 
-    if (sed_process_run_count(proc) == 0) {
-        init_subsidence_data(proc, prof, NULL);
+    if (!data->rate_lo) {
+        GError* err = NULL;
+
+        if (!init_subsidence_data(proc, prof, &err)) {
+            eh_error("%s", err->message);
+        }
     }
 
     start_year      = data->last_year;
@@ -74,24 +159,36 @@ run_subsidence(Sed_process proc, Sed_cube prof)
     // Note that the time step will be 0 at the beginning of an epoch, in
     // this case, don't do anything.
     //---
-    if (data->subsidence_seq->len == 1 && time_step > 1e-6) {
-        double** sub_grid = eh_dbl_grid_data((Eh_dbl_grid)data->subsidence_seq->data[0]);
+    if (time_step > 1e-6 && data->n_recs > 0) {
+        const gint n_x = sed_cube_n_x(prof);
+        const gint n_y = sed_cube_n_y(prof);
 
-        for (i = 0 ; i < sed_cube_n_x(prof) ; i++)
-            for (j = 0 ; j < sed_cube_n_y(prof) ; j++) {
-                sed_cube_adjust_base_height(prof, i, j, sub_grid[i][j]*time_step);
-            }
-    } else if (time_step > 1e-6) {
-        for (n = 0, total_time = 0 ; n < data->subsidence_seq->len ; n++) {
-            lower_edge = data->subsidence_seq->t[n];
+        // Move the cursor to the record pair that contains the start of the
+        // time step.
+        n = data->lower >= 0 ? data->lower : 0;
+
+        while (n + 1 < data->n_recs && start_year >= data->t[n + 1]) {
+            n++;
+        }
+
+        while (n > 0 && start_year < data->t[n]) {
+            n--;
+        }
+
+        for (total_time = 0 ; n < data->n_recs ; n++) {
+            lower_edge = data->t[n];
 
-            if (n < data->subsidence_seq->len - 1) {
-                upper_edge = data->subsidence_seq->t[n + 1];
+            if (n < data->n_recs - 1) {
+                upper_edge = data->t[n + 1];
             } else {
                 upper_edge = G_MAXDOUBLE;
             }
 
-            if (start_year >= upper_edge) {
+            if (data->n_recs == 1) {
+                time_step = end_year - start_year;
+            } else if (lower_edge >= end_year) {
+                break;
+            } else if (start_year >= upper_edge) {
                 time_step = -1;
             } else if (start_year >= lower_edge && end_year <  upper_edge) {
                 time_step = end_year - start_year;
@@ -106,25 +203,25 @@ run_subsidence(Sed_process proc, Sed_cube prof)
             }
 
             if (time_step > 0) {
+                const double dt_lower = MAX(start_year, lower_edge) - lower_edge;
                 double dz;
-                double** sub_grid_l = eh_dbl_grid_data((Eh_dbl_grid)data->subsidence_seq->data[n]);
-                double** sub_grid_h = eh_dbl_grid_data((Eh_dbl_grid)data->subsidence_seq->data[n + 1]);
+
+                _subsidence_set_interval(data, prof, n);
 
                 total_time += time_step;
 
-                for (i = 0 ; i < sed_cube_n_x(prof) ; i++)
-                    for (j = 0 ; j < sed_cube_n_y(prof) ; j++) {
-                        dz = ((sub_grid_h[i][j] - sub_grid_l[i][j])
-                                / (upper_edge - lower_edge))
-                            * (start_year - lower_edge)
-                            + sub_grid_l[i][j];
+                for (i = 0 ; i < n_x ; i++)
+                    for (j = 0 ; j < n_y ; j++) {
+                        const gint id = i * n_y + j;
+
+                        dz = data->slope[id] * dt_lower + data->rate_lo[id];
                         sed_cube_adjust_base_height(prof, i, j, dz * time_step);
                         total_subsidence += dz * time_step;
                     }
             }
         }
 
-        if (fabs(total_time - (end_year - start_year)) > 1e-5) {
+        if (data->n_recs > 1 && fabs(total_time - (end_year - start_year)) > 1e-5) {
             eh_warning("The current time interval is not completely contained "
                 " within the subsidence curve.");
             eh_warning("Start of this time interval: %f", start_year);
@@ -157,6 +254,13 @@ init_subsidence(Sed_process p, Eh_symbol_table tab, GError** error)
 
     data->last_year      = 0.;
     data->subsidence_seq = NULL;
+    data->n_recs         = 0;
+    data->t              = NULL;
+    data->lower          = -1;
+    data->rate_lo        = NULL;
+    data->rate_hi        = NULL;
+    data->slope          = NULL;
+    data->frame          = NULL;
 
     eh_symbol_table_require_labels(tab, subsidence_req_labels, &tmp_err);
 
@@ -199,22 +303,52 @@ init_subsidence_data(Sed_process proc, Sed_cube prof, GError** error)
     if (data) {
         GError* tmp_err = NULL;
         double* y       = sed_cube_y(prof, NULL);
+        const gint len  = sed_cube_size(prof);
 
         data->last_year = sed_cube_age_in_years(prof);
 
-        if (sed_mode_is_3d())
-            data->subsidence_seq  = sed_get_floor_sequence_3(
-                    data->filename,
-                    sed_cube_x_res(prof),
-                    sed_cube_y_res(prof),
-                    &tmp_err);
-        else
+        //---
+        // In 3D, only the record times are read now.  The grids are read from
+        // the file as they are needed, two at a time.
+        //---
+        if (sed_mode_is_3d()) {
+            gint n_x, n_y;
+
+            data->t = sed_get_floor_sequence_times_3(data->filename, &n_x, &n_y,
+                    &data->n_recs, &tmp_err);
+
+            if (!tmp_err && (n_x < sed_cube_n_x(prof) || n_y < sed_cube_n_y(prof))) {
+                g_set_error(&tmp_err, SEDFLUX_ERROR, SEDFLUX_ERROR_BAD_PARAM,
+                    "%s: Subsidence grid is smaller than the domain (%dx%d)",
+                    data->filename, n_x, n_y);
+            }
+
+            if (!tmp_err) {
+                data->grid_n_y = n_y;
+                data->frame    = eh_new(double, n_x * n_y);
+            }
+        } else {
             data->subsidence_seq  = sed_get_floor_sequence_2(
                     data->filename,
                     y,
                     sed_cube_n_y(prof),
                     &tmp_err);
 
+            if (data->subsidence_seq) {
+                data->n_recs = data->subsidence_seq->len;
+                data->t      = eh_dbl_array_dup(data->subsidence_seq->t, data->n_recs);
+            }
+        }
+
+        if (tmp_err) {
+            data->n_recs = 0;
+        }
+
+        data->lower   = -1;
+        data->rate_lo = eh_new(double, len);
+        data->rate_hi = eh_new(double, len);
+        data->slope   = eh_new(double, len);
+
         eh_free(y);
 
         if (tmp_err) {
@@ -243,6 +377,11 @@ destroy_subsidence(Sed_process p)
                 eh_destroy_sequence(data->subsidence_seq, FALSE);
             }
 
+            eh_free(data->t);
+            eh_free(data->rate_lo);
+            eh_free(data->rate_hi);
+            eh_free(data->slope);
+            eh_free(data->frame);
             eh_free(data->filename);
             eh_free(data);
         }
@@ -447,7 +447,7 @@ run_hyperpycnal(gpointer ptr, Sed_cube p)
         flow = sed_cell_new_env();
 
         for (i = 0 ; i < sed_cube_n_y(fail) ; i++) {
-            sed_column_top(sed_cube_col(fail, i), sed_cube_thickness(fail, 0, i), top);
+            sed_column_top(sed_cube_peek_col(fail, i), sed_cube_thickness(fail, 0, i), top);
             sed_cell_add(flow, top);
         }
 
@@ -212,7 +212,7 @@ init_xshore(Sed_process p, Eh_symbol_table tab, GError** error)
     data->last_time      = 0.;
 
     data->sediment_type  = eh_symbol_table_int_value(tab, S_KEY_ALONG_SHORE_SEDIMENT_NO);
-    data->xshore_current = eh_symbol_table_input_value(tab, S_KEY_XSHORE_VEL, &tmp_err);
+    data->xshore_current = sed_process_input_value(p, tab, S_KEY_XSHORE_VEL, &tmp_err);
 
     if (tmp_err) {
         g_propagate_error(error, tmp_err);
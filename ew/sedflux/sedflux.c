@@ -145,7 +145,7 @@ sedflux_set_val_at(Sed_cube p, const gchar* val_s, gint* here, const double* val
             gint* id = here;
 
             for (; *id != -1; id++) {
-                sed_column_set_base_height(sed_cube_col(p, *id), val[i]);
+                sed_column_set_base_height(sed_cube_peek_col(p, *id), val[i]);
             }
 
         } else {
@@ -153,7 +153,7 @@ sedflux_set_val_at(Sed_cube p, const gchar* val_s, gint* here, const double* val
             gint i;
 
             for (i = 0; i < len; i++) {
-                sed_column_set_base_height(sed_cube_col(p, i), val[i]);
+                sed_column_set_base_height(sed_cube_peek_col(p, i), val[i]);
             }
         }
     }
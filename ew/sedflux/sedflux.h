@@ -22,6 +22,8 @@ typedef struct {
     gboolean verbose;
     gboolean version;
     const char** active_procs;
+    gchar*   ensemble_file;
+    gint     n_jobs;
 }
 Sedflux_param_st;
 
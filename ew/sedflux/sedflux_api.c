@@ -19,8 +19,11 @@
 //---
 
 #include <errno.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 #include <utils/utils.h>
 #include <sed/sed_sedflux.h>
@@ -50,8 +53,27 @@ struct _Sedflux_state {
 
     // Keep track of these variables so that we can take time derivatives
     double* thickness; //< Sediment thickness at the last time state
+
+    GHashTable* surface_cache; //< Surface grids, keyed by name and mask
+    gint64 cache_stamp; //< Bumped whenever the cube is changed
+
+    Sedflux_member* members; //< Ensemble members (NULL for a single run)
+    gint n_members; //< Number of ensemble members
+    gint n_jobs; //< Number of ensemble members to run at once
 };
 
+/** A surface grid that was materialized for the BMI
+
+Surface grids are computed from the cube at most once for each value of the
+state's cache stamp.  The stamp is bumped whenever the model advances in time
+or the cube is changed through one of the sedflux_set_* functions.
+*/
+typedef struct {
+    double* data; //< Surface values for every column of the cube
+    gint64 stamp; //< Cache stamp of the state when data was computed
+}
+Sedflux_surface_grid;
+
 static Sed_process_init_t my_proc_defs[] = {
     { "constants", init_constants, run_constants, destroy_constants },
     { "earthquake", init_quake, run_quake, destroy_quake     },
@@ -72,7 +94,8 @@ static Sed_process_init_t my_proc_defs[] = {
     { "xshore", init_xshore, run_xshore, destroy_xshore      },
     { "squall", init_squall, run_squall, destroy_squall      },
     { "bioturbation", bio_init, bio_run, bio_destroy },
-    { "compaction", NULL, run_compaction, NULL                },
+    { "compaction", init_compaction, run_compaction, destroy_compaction },
+    { "coalesce", init_coalesce, run_coalesce, destroy_coalesce },
     { "flow", init_flow, run_flow, destroy_flow        },
     { "isostasy", init_isostasy, run_isostasy, destroy_isostasy    },
     { "subsidence", init_subsidence, run_subsidence, destroy_subsidence  },
@@ -225,11 +248,33 @@ sedflux_new(void)
         state->is_2d = TRUE;
 
         state->thickness = NULL;
+
+        state->surface_cache = NULL;
+        state->cache_stamp = 0;
+
+        state->members = NULL;
+        state->n_members = 0;
+        state->n_jobs = 0;
     }
 
     return state;
 }
 
+static void
+_sedflux_surface_grid_free(Sedflux_surface_grid* g)
+{
+    if (g) {
+        eh_free(g->data);
+        eh_free(g);
+    }
+}
+
+static void
+_sedflux_invalidate_surface_cache(Sedflux_state* state)
+{
+    state->cache_stamp++;
+}
+
 Sedflux_state*
 sedflux_set_init_file(Sedflux_state* self, gchar* init_file)
 {
@@ -500,6 +545,28 @@ sedflux_initialize(const gint argc, const gchar* argv[])
             sedflux_set_description(state, p->run_desc);
             sedflux_set_dimension(state, p->mode_2d);
 
+            if (p->ensemble_file) {
+                /* Members' output directories are below the working directory
+                   so input paths must not be relative to it. */
+                gchar* cwd = g_get_current_dir();
+                gchar* dir = p->input_dir ? p->input_dir : ".";
+
+                if (!g_path_is_absolute(dir)) {
+                    gchar* path = g_build_filename(cwd, dir, NULL);
+                    sedflux_set_input_dir(state, path);
+                    g_free(path);
+                }
+
+                state->members = sedflux_members_scan(p->ensemble_file,
+                        &state->n_members, &error);
+                eh_exit_on_error(error, "%s: Error reading ensemble file",
+                    p->ensemble_file);
+
+                state->n_jobs = p->n_jobs;
+
+                g_free(cwd);
+            }
+
             /* Setup the signal handling */
             if (p->set_signals) {
                 sed_signal_set_action();
@@ -534,10 +601,17 @@ sedflux_initialize(const gint argc, const gchar* argv[])
                 sedflux_init_file(state));
 
             eh_info("Creating sedflux epoch queue...");
-            state->q = sed_epoch_queue_new_full(sedflux_init_file(state),
-                    sedflux_input_dir(state),
-                    my_proc_defs, my_proc_family,
-                    NULL, &error);
+
+            if (state->members) {
+                /* Each member reads its own process files. */
+                state->q = sed_epoch_queue_new(sedflux_init_file(state),
+                        sedflux_input_dir(state), &error);
+            } else {
+                state->q = sed_epoch_queue_new_full(sedflux_init_file(state),
+                        sedflux_input_dir(state),
+                        my_proc_defs, my_proc_family,
+                        NULL, &error);
+            }
             eh_exit_on_error(error, "%s: Error reading epoch file",
                 sedflux_init_file(state));
         }
@@ -614,6 +688,7 @@ sedflux_run_time_step(Sedflux_state* state)
     eh_require(state->p);
 
     sed_epoch_queue_tic(state->q, state->p);
+    _sedflux_invalidate_surface_cache(state);
     _sedflux_save_time_variables(state);
 
     return;
@@ -627,6 +702,7 @@ sedflux_run(Sedflux_state* state)
     eh_require(state->p);
 
     sed_epoch_queue_run(state->q, state->p);
+    _sedflux_invalidate_surface_cache(state);
     _sedflux_save_time_variables(state);
 
     return;
@@ -640,6 +716,7 @@ sedflux_run_until(Sedflux_state* state, double then)
     eh_require(state->p);
 
     sed_epoch_queue_run_until(state->q, state->p, then);
+    _sedflux_invalidate_surface_cache(state);
     _sedflux_save_time_variables(state);
 
     return;
@@ -996,61 +1073,111 @@ sedflux_get_value(Sedflux_state* state, const char* val_s, int dimen[3])
     return data;
 }
 
-double*
-sedflux_get_surface_value(Sedflux_state* state, const char* val_s, double* dest,
+static void
+_sedflux_compute_surface_value(Sedflux_state* state, Sed_measurement m,
+    double* dest, gint mask)
+{
+    const int len = sed_cube_size(state->p);
+    Eh_ind_2 sub;
+    gint i;
+
+    for (i = 0; i < len; ++i) {
+        sub = sed_cube_sub(state->p, i);
+        dest[i] = sed_measurement_make(m, state->p, sub.i, sub.j);
+    }
+
+    if (mask & MASK_LAND) {
+        for (i = 0; i < len; i++)
+            if (sed_cube_elevation(state->p, 0, i) > .1) {
+                dest[i] = -9999.;
+            }
+    }
+
+    if (mask & MASK_OCEAN) {
+        for (i = 0; i < len; i++)
+            if (sed_cube_elevation(state->p, 0, i) < -.1) {
+                dest[i] = -9999.;
+            }
+    }
+
+    return;
+}
+
+/** Get a read-only view of a surface grid
+
+The returned grid is owned by @p state and is computed at most once for
+each model time.  It remains valid until the model is advanced or the cube
+is changed through one of the sedflux_set_* functions.
+
+@param state A Sedflux_state
+@param val_s Name of a Sed_measurement
+@param mask  Cells to mask out (MASK_LAND, MASK_OCEAN, or both)
+
+@return A pointer to the surface values, or NULL if @p val_s is unknown
+*/
+const double*
+sedflux_get_surface_value_ptr(Sedflux_state* state, const char* val_s,
     gint mask)
 {
-    double* data = NULL;
+    Sedflux_surface_grid* g = NULL;
 
     eh_return_val_if_fail(state, NULL);
+    eh_return_val_if_fail(state->p, NULL);
     eh_return_val_if_fail(val_s, NULL);
-    eh_return_val_if_fail(dest, NULL);
+
+    if (!state->surface_cache)
+        state->surface_cache = g_hash_table_new_full(g_str_hash, g_str_equal,
+                g_free, (GDestroyNotify)_sedflux_surface_grid_free);
 
     {
-        Sed_measurement m = sed_measurement_new(val_s);
+        gchar key[128];
 
-        eh_require(m);
+        g_snprintf(key, sizeof(key), "%s:%d", val_s, mask);
+        g = (Sedflux_surface_grid*)g_hash_table_lookup(state->surface_cache, key);
 
-        { /* Get values at all grid cells */
-            gint i;
-            const int len = sed_cube_size(state->p);
-            Eh_ind_2 sub;
+        if (!g) {
+            g = eh_new(Sedflux_surface_grid, 1);
+            g->data = eh_new(double, sed_cube_size(state->p));
+            g->stamp = state->cache_stamp - 1;
 
-            eh_require(state)
-            eh_require(state->p)
+            g_hash_table_insert(state->surface_cache, g_strdup(key), g);
+        }
+    }
 
-            for (i = 0; i < len; ++i) {
-                sub = sed_cube_sub(state->p, i);
-                dest[i] = sed_measurement_make(m, state->p, sub.i, sub.j);
-            }
+    if (g->stamp != state->cache_stamp) {
+        Sed_measurement m = sed_measurement_new(val_s);
 
-            // fprintf (stderr, "These are my elevations (all %d=%dx%d of them):\n", len, sedflux_get_nx (state), sedflux_get_ny (state));
-            // for (i=0; i<len; ++i)
-            //   fprintf (stderr, "%d, %f\n", i, sed_cube_elevation (state->p, 0, i));
+        if (!m) {
+            return NULL;
         }
 
+        _sedflux_compute_surface_value(state, m, g->data, mask);
+        g->stamp = state->cache_stamp;
+
         sed_measurement_destroy(m);
+    }
 
-        if (mask) {
-            const int len = sed_cube_size(state->p);
-            int i;
+    return g->data;
+}
 
-            if (mask & MASK_LAND) {
-                for (i = 0; i < len; i++)
-                    if (sed_cube_elevation(state->p, 0, i) > .1) {
-                        dest[i] = -9999.;
-                    }
-            }
+double*
+sedflux_get_surface_value(Sedflux_state* state, const char* val_s, double* dest,
+    gint mask)
+{
+    const double* src = NULL;
 
-            if (mask & MASK_OCEAN) {
-                for (i = 0; i < len; i++)
-                    if (sed_cube_elevation(state->p, 0, i) < -.1) {
-                        dest[i] = -9999.;
-                    }
-            }
-        }
+    eh_return_val_if_fail(state, NULL);
+    eh_return_val_if_fail(val_s, NULL);
+    eh_return_val_if_fail(dest, NULL);
+
+    src = sedflux_get_surface_value_ptr(state, val_s, mask);
+
+    if (!src) {
+        return NULL;
     }
 
+    memcpy(dest, src, sizeof(double) * sed_cube_size(state->p));
+
     return dest;
 }
 
@@ -1316,13 +1443,15 @@ sedflux_set_uplift(Sedflux_state* state, const double* val)
     eh_require(state->p);
     eh_require(val);
 
+    _sedflux_invalidate_surface_cache(state);
+
     {
         const gint len = sed_cube_size(state->p);
         gint i;
 
         for (i = 0; i < len; i++) {
             if (val[i] > -999) {
-                sed_column_adjust_base_height(sed_cube_col(state->p, i), val[i]);
+                sed_column_adjust_base_height(sed_cube_peek_col(state->p, i), val[i]);
             }
         }
     }
@@ -1336,12 +1465,14 @@ sedflux_set_basement(Sedflux_state* state, const double* val)
     eh_require(state->p);
     eh_require(val);
 
+    _sedflux_invalidate_surface_cache(state);
+
     {
         const gint len = sed_cube_size(state->p);
         gint i;
 
         for (i = 0; i < len; i++) {
-            sed_column_set_base_height(sed_cube_col(state->p, i), val[i]);
+            sed_column_set_base_height(sed_cube_peek_col(state->p, i), val[i]);
         }
     }
 
@@ -1355,6 +1486,8 @@ sedflux_set_deposition(Sedflux_state* state, const double* val)
     eh_require(state->p);
     eh_require(val);
 
+    _sedflux_invalidate_surface_cache(state);
+
     {
         Sed_cell add_cell = sed_cell_new_bedload(NULL, 1.);
 
@@ -1373,6 +1506,8 @@ sedflux_set_subaerial_deposition(Sedflux_state* state, const double* val)
     eh_require(state->p);
     eh_require(val);
 
+    _sedflux_invalidate_surface_cache(state);
+
     {
         const Sed_cube c = state->p;
         Sed_cell subaqueous_cell = sed_cell_new_env();
@@ -1472,6 +1607,8 @@ sedflux_set_discharge(Sedflux_state* state, const double* val)
     eh_require(state->p);
     eh_require(val);
 
+    _sedflux_invalidate_surface_cache(state);
+
     {
         sed_cube_set_discharge(state->p, val);
     }
@@ -1547,6 +1684,7 @@ void
 sedflux_set_sea_level(Sedflux_state* state, const double* val)
 {
     sed_cube_set_sea_level(state->p, *val);
+    _sedflux_invalidate_surface_cache(state);
 }
 
 
@@ -1582,19 +1720,17 @@ sorted_shore_cells(const Sed_cube c, const double* val, int* len, int** sorted_i
 
     {
         int i;
-        const gint cube_len = sed_cube_size(c);
+        const gint* shore = sed_cube_shore_data(c, NULL);
         GSList* top = NULL;
         Flux_sort_st* data = NULL;
         int list_len = 0;
 
-        for (i = 0; i < cube_len; i++) {
-            if (is_shore_cell_id(c, i)) {
-                data = eh_new(Flux_sort_st, 1);
-                data->val = val[i];
-                data->ind = i;
-                top = g_slist_prepend(top, data);
-                list_len++;
-            }
+        for (i = 0; shore[i] >= 0; i++) {
+            data = eh_new(Flux_sort_st, 1);
+            data->val = val[shore[i]];
+            data->ind = shore[i];
+            top = g_slist_prepend(top, data);
+            list_len++;
         }
 
         //eh_watch_int (list_len);
@@ -1636,6 +1772,8 @@ sedflux_set_bed_load_flux(Sedflux_state* state, const double* val)
     eh_require(state->p);
     eh_require(val);
 
+    _sedflux_invalidate_surface_cache(state);
+
     //  {
     //    sed_cube_set_bed_load_flux (state->p, val);
     //  }
@@ -1890,9 +2028,381 @@ sedflux_finalize(Sedflux_state* state)
 
         sed_cube_destroy(state->p);
 
+        if (state->surface_cache) {
+            g_hash_table_destroy(state->surface_cache);
+        }
+
         sed_sediment_unset_env();
+
+        sedflux_members_free(state->members, state->n_members);
     }
 
     return;
 }
 
+/** Saved state of a sedflux run (see sedflux_snapshot) */
+struct _Sedflux_snapshot {
+    Sed_cube p; //< Snapshot of the cube; it shares unchanged columns with the run
+    double* thickness; //< Sediment thickness at the last time step
+};
+
+/** Take a snapshot of a sedflux run.
+
+The snapshot shares its sediment with the running cube and only the sediment
+of columns that gain or lose some afterwards is copied, so snapshots are
+cheap to take.  Pass the
+snapshot to sedflux_branch to return the run to this state, for instance to
+try several what-if scenarios from a common starting point.
+
+@param state A sedflux state
+
+@return A newly created snapshot.  Destroy it with sedflux_snapshot_destroy.
+*/
+Sedflux_snapshot*
+sedflux_snapshot(Sedflux_state* state)
+{
+    Sedflux_snapshot* snap = NULL;
+
+    eh_require(state);
+
+    if (state) {
+        const gint len = sed_cube_size(state->p);
+
+        snap = eh_new(Sedflux_snapshot, 1);
+
+        snap->p = sed_cube_snapshot(state->p);
+
+        if (state->thickness) {
+            snap->thickness = eh_dbl_array_dup(state->thickness, len);
+        } else {
+            snap->thickness = NULL;
+        }
+    }
+
+    return snap;
+}
+
+/** Return a sedflux run to the state of a snapshot.
+
+The snapshot is left unchanged and can be branched from again.
+
+@param state A sedflux state
+@param snap  A snapshot taken from this run with sedflux_snapshot
+*/
+void
+sedflux_branch(Sedflux_state* state, const Sedflux_snapshot* snap)
+{
+    eh_require(state);
+    eh_require(snap);
+
+    if (state && snap) {
+        sed_cube_branch(state->p, snap->p);
+
+        eh_free(state->thickness);
+
+        if (snap->thickness) {
+            state->thickness = eh_dbl_array_dup(snap->thickness,
+                    sed_cube_size(snap->p));
+        } else {
+            state->thickness = NULL;
+        }
+
+        _sedflux_invalidate_surface_cache(state);
+    }
+}
+
+void
+sedflux_snapshot_destroy(Sedflux_snapshot* snap)
+{
+    if (snap) {
+        sed_cube_destroy(snap->p);
+        eh_free(snap->thickness);
+        eh_free(snap);
+    }
+}
+
+#define SEDFLUX_MEMBER_GROUP      "member"
+#define SEDFLUX_MEMBER_KEY_NAME   "name"
+#define SEDFLUX_MEMBER_KEY_RIVER  "river file"
+#define SEDFLUX_MEMBER_KEY_SEED   "seed"
+#define SEDFLUX_MEMBER_KEY_OVERRIDE "override"
+
+/** Read the members of an ensemble
+
+Each member is described by a "member" group of a key-file.  As with any
+key-file, a group is added to the group of the same name before it unless
+it repeats one of that group's keys, so each member should be given a name.
+A group without a name whose keys are all new is read as part of the member
+before it; one that repeats a key is a member of its own, named
+"member_<n>" where n is its (zero-based) position.  Overrides are separated by semicolons, each of the form
+"process name:key=value".  Since the scanner drops the spaces of values that
+are not quoted, and most keys contain spaces, overrides (and river files
+with spaces) should be put in double quotes.  A relative river file is taken
+to be relative to the current directory.  A member without a seed is given
+its (one-based) position in the file.
+
+\param file      Name of the ensemble file
+\param n_members Location to put the number of members
+\param error     A GError
+
+\return The members, or NULL on error.  Free with sedflux_members_free.
+*/
+Sedflux_member*
+sedflux_members_scan(const gchar* file, gint* n_members, GError** error)
+{
+    Sedflux_member* members = NULL;
+    GError*         tmp_err = NULL;
+    Eh_key_file     key_file;
+
+    eh_return_val_if_fail(error == NULL || *error == NULL, NULL);
+    eh_require(n_members);
+
+    *n_members = 0;
+
+    key_file = eh_key_file_scan(file, &tmp_err);
+
+    if (key_file && !eh_key_file_has_group(key_file, SEDFLUX_MEMBER_GROUP))
+        g_set_error(&tmp_err, SEDFLUX_ERROR, SEDFLUX_ERROR_BAD_PARAM,
+            "No ensemble members found");
+
+    if (!tmp_err) {
+        Eh_symbol_table* tables = eh_key_file_get_symbol_tables(key_file,
+                SEDFLUX_MEMBER_GROUP);
+        const gint len = eh_key_file_group_size(key_file, SEDFLUX_MEMBER_GROUP);
+        gchar* cwd = g_get_current_dir();
+        gint i;
+
+        members = eh_new0(Sedflux_member, len);
+
+        for (i = 0 ; i < len ; i++) {
+            // The key-file keeps the last occurrence of a group first
+            Eh_symbol_table t = tables[len - 1 - i];
+            Sedflux_member* m = members + i;
+
+            if (eh_symbol_table_lookup(t, SEDFLUX_MEMBER_KEY_NAME)) {
+                m->name = eh_symbol_table_value(t, SEDFLUX_MEMBER_KEY_NAME);
+            } else {
+                m->name = g_strdup_printf("member_%d", i);
+            }
+
+            if (eh_symbol_table_lookup(t, SEDFLUX_MEMBER_KEY_RIVER)) {
+                gchar* river = eh_symbol_table_value(t, SEDFLUX_MEMBER_KEY_RIVER);
+
+                if (g_path_is_absolute(river)) {
+                    m->river_file = river;
+                } else {
+                    m->river_file = g_build_filename(cwd, river, NULL);
+                    g_free(river);
+                }
+            }
+
+            if (eh_symbol_table_lookup(t, SEDFLUX_MEMBER_KEY_SEED)) {
+                m->seed = eh_symbol_table_int_value(t, SEDFLUX_MEMBER_KEY_SEED);
+            } else {
+                m->seed = i + 1;
+            }
+
+            if (eh_symbol_table_lookup(t, SEDFLUX_MEMBER_KEY_OVERRIDE)) {
+                m->overrides = g_strsplit(
+                        eh_symbol_table_lookup(t, SEDFLUX_MEMBER_KEY_OVERRIDE), ";", -1);
+            }
+
+            eh_symbol_table_destroy(t);
+        }
+
+        *n_members = len;
+
+        g_free(cwd);
+        eh_free(tables);
+    }
+
+    if (key_file) {
+        eh_key_file_destroy(key_file);
+    }
+
+    if (tmp_err) {
+        g_propagate_error(error, tmp_err);
+    }
+
+    return members;
+}
+
+void
+sedflux_members_free(Sedflux_member* members, gint n_members)
+{
+    if (members) {
+        gint i;
+
+        for (i = 0 ; i < n_members ; i++) {
+            g_free(members[i].name);
+            g_free(members[i].river_file);
+            g_strfreev(members[i].overrides);
+        }
+
+        eh_free(members);
+    }
+}
+
+gboolean
+sedflux_is_ensemble(Sedflux_state* state)
+{
+    eh_require(state);
+    return state->members != NULL;
+}
+
+/* Run one ensemble member until then.  This is called in a forked child so
+   it has its own copy of the cube and epoch queue, and is free to change
+   directory and reseed the random number generators. */
+static gint
+_sedflux_run_member(Sedflux_state* state, const Sedflux_member* m, double then)
+{
+    GError* error = NULL;
+
+    if (g_mkdir_with_parents(m->name, 0755) == -1 || g_chdir(m->name) != 0) {
+        eh_warning("%s: Unable to create member directory (%s)", m->name,
+            g_strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    g_random_set_seed(m->seed);
+    srand(m->seed);
+    sed_process_set_seed_offset(m->seed);
+
+    { /* Apply the member's overrides to the process files as they are read */
+        GPtrArray* overrides = g_ptr_array_new();
+        gchar**    o;
+
+        for (o = m->overrides ; o && *o ; o++) {
+            g_ptr_array_add(overrides, *o);
+        }
+
+        if (m->river_file) {
+            g_ptr_array_add(overrides,
+                g_strconcat("river:river file=", m->river_file, NULL));
+        }
+
+        g_ptr_array_add(overrides, NULL);
+
+        sed_process_set_key_overrides((const gchar**)overrides->pdata);
+
+        if (m->river_file) {
+            g_free(g_ptr_array_index(overrides, overrides->len - 2));
+        }
+
+        g_ptr_array_free(overrides, TRUE);
+    }
+
+    sed_epoch_queue_set_processes(state->q, my_proc_defs, my_proc_family,
+        NULL, &error);
+
+    if (error) {
+        eh_warning("%s: Error reading process files (%s)", m->name,
+            error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    sed_epoch_queue_run_until(state->q, state->p, then);
+
+    /* Close the member's output files */
+    state->q = sed_epoch_queue_destroy(state->q);
+
+    return EXIT_SUCCESS;
+}
+
+/** Run every member of an ensemble
+
+The cube, sediment and epochs are read once, by sedflux_initialize.  Each
+member is then run in a child process of its own that starts with a copy of
+that state, reads its process files with the member's overrides, and writes
+its output to a directory (below the working directory) named for the member.
+Processes keep global state and write to files relative to the current
+directory, so members are kept in separate processes rather than threads.
+
+At most n_jobs members (or one per processor, if not given) run at a time.
+
+\param state A Sedflux_state that was initialized with an ensemble file
+\param then  Time (in years) to run each member until
+
+\return The number of members that failed
+*/
+gint
+sedflux_run_ensemble(Sedflux_state* state, double then)
+{
+    gint n_failed = 0;
+
+    eh_require(state);
+    eh_require(state->members);
+
+    {
+        const gint n_members = state->n_members;
+        gint       n_jobs    = state->n_jobs;
+        gint       n_running = 0;
+        gint       next      = 0;
+        pid_t*     pid       = eh_new0(pid_t, n_members);
+
+        if (n_jobs <= 0) {
+            n_jobs = sysconf(_SC_NPROCESSORS_ONLN);
+        }
+
+        if (n_jobs <= 0) {
+            n_jobs = 1;
+        }
+
+        while (next < n_members || n_running > 0) {
+            if (next < n_members && n_running < n_jobs) {
+                fflush(NULL);
+
+                pid[next] = fork();
+
+                if (pid[next] == 0) {
+                    gint status;
+
+                    sed_telemetry_start_member(state->members[next].name);
+
+                    status = _sedflux_run_member(state, state->members + next, then);
+
+                    sed_telemetry_stop();
+                    fflush(NULL);
+                    _exit(status);
+                } else if (pid[next] < 0) {
+                    eh_warning("%s: Unable to start member (%s)",
+                        state->members[next].name, g_strerror(errno));
+                    n_failed++;
+                } else {
+                    eh_info("%s: Started ensemble member", state->members[next].name);
+                    n_running++;
+                }
+
+                next++;
+            } else {
+                gint  status;
+                pid_t done = waitpid(-1, &status, 0);
+
+                if (done > 0) {
+                    gint n;
+
+                    for (n = 0 ; n < next && pid[n] != done ; n++);
+
+                    n_running--;
+
+                    if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+                        eh_warning("%s: Ensemble member failed",
+                            n < next ? state->members[n].name : "?");
+                        n_failed++;
+                    } else {
+                        eh_info("%s: Finished ensemble member",
+                            n < next ? state->members[n].name : "?");
+                    }
+                } else if (errno != EINTR) {
+                    break;
+                }
+            }
+        }
+
+        eh_free(pid);
+    }
+
+    return n_failed;
+}
+
@@ -9,6 +9,16 @@ extern const gint MASK_LAND;
 extern const gint MASK_OCEAN;
 
 typedef struct _Sedflux_state Sedflux_state;
+typedef struct _Sedflux_snapshot Sedflux_snapshot;
+
+/** One member of an ensemble of sedflux runs */
+typedef struct {
+    gchar*  name;       ///< Name of the member; its output goes to a directory of this name
+    gchar*  river_file; ///< River file that replaces those of the process files (or NULL)
+    guint32 seed;       ///< Seed for the member's random number generators
+    gchar** overrides;  ///< Process key overrides ("process name:key=value")
+}
+Sedflux_member;
 
 //gboolean sedflux (const gchar* init_file, const gchar* prefix, int dimen);
 gboolean
@@ -30,6 +40,15 @@ sedflux_run_until(Sedflux_state* state, double then);
 void
 sedflux_finalize(Sedflux_state* state);
 
+Sedflux_member*
+sedflux_members_scan(const gchar* file, gint* n_members, GError** error);
+void
+sedflux_members_free(Sedflux_member* members, gint n_members);
+gboolean
+sedflux_is_ensemble(Sedflux_state* state);
+gint
+sedflux_run_ensemble(Sedflux_state* state, double then);
+
 gchar**
 sedflux_get_exchange_items(Sedflux_state* state);
 gchar*
@@ -42,6 +61,9 @@ sedflux_get_value_data(Sedflux_state* state, const char* val_s,
 double*
 sedflux_get_surface_value(Sedflux_state* state, const char* val_s, double* dest,
     gint mask);
+const double*
+sedflux_get_surface_value_ptr(Sedflux_state* state, const char* val_s,
+    gint mask);
 double*
 sedflux_get_sediment_value(Sedflux_state* state, const char* val_s, double* dest);
 double*
@@ -124,6 +146,13 @@ sedflux_set_channel_velocity(Sedflux_state* state, const double* val);
 void
 sedflux_set_sea_level(Sedflux_state* state, const double* val);
 
+Sedflux_snapshot*
+sedflux_snapshot(Sedflux_state* state);
+void
+sedflux_branch(Sedflux_state* state, const Sedflux_snapshot* snap);
+void
+sedflux_snapshot_destroy(Sedflux_snapshot* snap);
+
 G_END_DECLS
 
 #endif
@@ -0,0 +1,1439 @@
+//---
+//
+// This file is part of sedflux.
+//
+// sedflux is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// sedflux is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with sedflux; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//---
+
+/** \file sedflux_bench.c
+
+Standard performance benchmarks for sedflux.
+
+There are two kinds of benchmark.  Scenarios run a handful of processes
+together on a synthetic basin (a river plume building a 3D delta that is
+compacted and isostatically loaded, a failure cascade on a steep 2D slope,
+and a season of storms reworking a 2D shelf).  Microbenchmarks time a single
+kernel.  Each benchmark is run a number of times and the fastest run is
+reported, as JSON, in steps and cells per second.  Only a benchmark's run
+function is timed; the data that it works on is created by its setup
+function and destroyed by its teardown function.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include <utime.h>
+#include <glib/gstdio.h>
+#include <utils/utils.h>
+#include <sed/sed_sedflux.h>
+#include <plume_types.h>
+#include <plumeinput.h>
+#include <subside.h>
+#include <compact.h>
+#include <failure.h>
+#include <xshore.h>
+
+gboolean
+plume3d(Plume_inputs* plume_const, Plume_river river,
+    int n_grains, Plume_sediment* sedload,
+    Eh_dbl_grid* deposit, Plume_data* data);
+double
+get_wave_period_from_height(double wave_height_in_meters);
+
+typedef struct {
+    gint n_steps; ///< Number of steps (time steps or kernel calls) taken
+    gint64 n_cells; ///< Number of cells (or grid nodes) processed
+} Bench_count;
+
+typedef struct {
+    const gchar* name;
+    const gchar* kind;
+    gpointer (*setup)(gint size);      ///< Create the data for run (not timed)
+    Bench_count(*run)(gpointer data);  ///< The part of the benchmark that is timed
+    void (*teardown)(gpointer data);   ///< Destroy the data (not timed)
+    gboolean reuse; ///< run leaves the data as it found it, so set up once for all reps
+} Bench;
+
+static gpointer    bench_basin_setup(gint size);
+static Bench_count bench_basin(gpointer data);
+static void        bench_basin_teardown(gpointer data);
+static gpointer    bench_failure_cascade_setup(gint size);
+static Bench_count bench_failure_cascade(gpointer data);
+static void        bench_failure_cascade_teardown(gpointer data);
+static gpointer    bench_storm_season_setup(gint size);
+static Bench_count bench_storm_season(gpointer data);
+static void        bench_storm_season_teardown(gpointer data);
+static gpointer    bench_column_setup(gint size);
+static Bench_count bench_column_add_cell(gpointer data);
+static gpointer    bench_column_extract_top_setup(gint size);
+static Bench_count bench_column_extract_top(gpointer data);
+static void        bench_column_teardown(gpointer data);
+static gpointer    bench_cube_property_subgrid_setup(gint size);
+static Bench_count bench_cube_property_subgrid(gpointer data);
+static void        bench_cube_property_subgrid_teardown(gpointer data);
+static gpointer    bench_subside_grid_load_setup(gint size);
+static Bench_count bench_subside_grid_load(gpointer data);
+static void        bench_subside_grid_load_teardown(gpointer data);
+static gpointer    bench_dbl_grid_setup(gint size);
+static Bench_count bench_dbl_grid_ops(gpointer data);
+static Bench_count bench_dbl_grid_kernels(gpointer data);
+static void        bench_dbl_grid_teardown(gpointer data);
+static gpointer    bench_dlm_read_setup(gint size);
+static Bench_count bench_dlm_read(gpointer data);
+static void        bench_dlm_read_teardown(gpointer data);
+static gpointer    bench_key_file_scan_setup(gint size);
+static gpointer    bench_key_file_scan_cached_setup(gint size);
+static Bench_count bench_key_file_scan(gpointer data);
+static void        bench_key_file_scan_teardown(gpointer data);
+static gpointer    bench_plume3d_setup(gint size);
+static gpointer    bench_plume3d_coarse_setup(gint size);
+static Bench_count bench_plume3d(gpointer data);
+static void        bench_plume3d_teardown(gpointer data);
+static gpointer    bench_wave_number_setup(gint size);
+static Bench_count bench_wave_number_rtsafe(gpointer data);
+static Bench_count bench_wave_number_profile(gpointer data);
+static void        bench_wave_number_teardown(gpointer data);
+
+static Bench all_benchmarks[] = {
+    { "basin", "scenario", &bench_basin_setup, &bench_basin, &bench_basin_teardown, FALSE },
+    { "failure_cascade", "scenario", &bench_failure_cascade_setup, &bench_failure_cascade, &bench_failure_cascade_teardown, FALSE },
+    { "storm_season", "scenario", &bench_storm_season_setup, &bench_storm_season, &bench_storm_season_teardown, FALSE },
+    { "sed_column_add_cell", "micro", &bench_column_setup, &bench_column_add_cell, &bench_column_teardown, FALSE },
+    { "sed_column_extract_top", "micro", &bench_column_extract_top_setup, &bench_column_extract_top, &bench_column_teardown, FALSE },
+    { "sed_cube_property_subgrid", "micro", &bench_cube_property_subgrid_setup, &bench_cube_property_subgrid, &bench_cube_property_subgrid_teardown, TRUE },
+    { "subside_grid_load", "micro", &bench_subside_grid_load_setup, &bench_subside_grid_load, &bench_subside_grid_load_teardown, TRUE },
+    { "dbl_grid_ops", "micro", &bench_dbl_grid_setup, &bench_dbl_grid_ops, &bench_dbl_grid_teardown, FALSE },
+    { "dbl_grid_kernels", "micro", &bench_dbl_grid_setup, &bench_dbl_grid_kernels, &bench_dbl_grid_teardown, FALSE },
+    { "dlm_read", "micro", &bench_dlm_read_setup, &bench_dlm_read, &bench_dlm_read_teardown, TRUE },
+    { "key_file_scan", "micro", &bench_key_file_scan_setup, &bench_key_file_scan, &bench_key_file_scan_teardown, TRUE },
+    { "key_file_scan_cached", "micro", &bench_key_file_scan_cached_setup, &bench_key_file_scan, &bench_key_file_scan_teardown, TRUE },
+    { "plume3d", "micro", &bench_plume3d_setup, &bench_plume3d, &bench_plume3d_teardown, FALSE },
+    { "plume3d_coarse", "micro", &bench_plume3d_coarse_setup, &bench_plume3d, &bench_plume3d_teardown, FALSE },
+    { "wave_number_rtsafe", "micro", &bench_wave_number_setup, &bench_wave_number_rtsafe, &bench_wave_number_teardown, TRUE },
+    { "wave_number_profile", "micro", &bench_wave_number_setup, &bench_wave_number_profile, &bench_wave_number_teardown, TRUE },
+    { NULL }
+};
+
+static gint     n_reps   = 3;
+static gint     size     = 1;
+static gchar*   out_file = NULL;
+static gchar**  names    = NULL;
+static gboolean list     = FALSE;
+
+static GOptionEntry entries[] = {
+    { "reps", 'r', 0, G_OPTION_ARG_INT, &n_reps, "Number of times to run each benchmark", "<n>" },
+    { "size", 's', 0, G_OPTION_ARG_INT, &size, "Problem size multiplier", "<n>" },
+    { "out-file", 'o', 0, G_OPTION_ARG_FILENAME, &out_file, "Write JSON to file", "<file>" },
+    { "bench", 'b', 0, G_OPTION_ARG_STRING_ARRAY, &names, "Run only this benchmark", "<name>" },
+    { "list", 'l', 0, G_OPTION_ARG_NONE, &list, "List the benchmarks", NULL },
+    { NULL }
+};
+
+static gboolean
+bench_setup_sediment(void)
+{
+    GError*      error  = NULL;
+    gchar*       buffer = sed_sediment_default_text();
+    Sed_sediment s      = sed_sediment_scan_text(buffer, &error);
+
+    g_free(buffer);
+
+    eh_print_on_error(error, "sedflux-bench");
+
+    if (s) {
+        sed_sediment_set_env(s);
+    }
+
+    return s ? TRUE : FALSE;
+}
+
+/* A cell of the environment sediment with equal amounts of each grain type. */
+static Sed_cell
+bench_cell_new(double t, double age)
+{
+    const gint n_grains = sed_sediment_env_n_types();
+    double*    f        = eh_new(double, n_grains);
+    Sed_cell   c;
+    gint       n;
+
+    for (n = 0 ; n < n_grains ; n++) {
+        f[n] = 1. / n_grains;
+    }
+
+    c = sed_cell_new_sized(n_grains, t, f);
+    sed_cell_set_age(c, age);
+
+    eh_free(f);
+
+    return c;
+}
+
+/* A cube whose columns are filled to \a fill meters and sit on a basement
+   that dips offshore (in y) with slope \a slope. */
+static Sed_cube
+bench_cube_new(gint n_x, gint n_y, double dx, double dy, double slope,
+    double fill)
+{
+    Sed_cube p = sed_cube_new(n_x, n_y);
+    Sed_cell c = bench_cell_new(.25, 0.);
+    gint     i, j;
+
+    sed_cube_set_x_res(p, dx);
+    sed_cube_set_y_res(p, dy);
+    sed_cube_set_z_res(p, .25);
+    sed_cube_set_sea_level(p, 0.);
+    sed_cube_set_time_step(p, 1.);
+
+    for (i = 0 ; i < n_x ; i++) {
+        for (j = 0 ; j < n_y ; j++) {
+            Sed_column col = sed_cube_col_ij(p, i, j);
+            double     t;
+
+            sed_column_set_base_height(col, 5. - slope * j * dy - fill);
+
+            for (t = 0 ; t < fill ; t += sed_cell_size(c)) {
+                sed_column_add_cell(col, c);
+            }
+        }
+    }
+
+    sed_cell_destroy(c);
+
+    return p;
+}
+
+static Plume_sediment*
+bench_plume_sediment(gint n_susp_grains)
+{
+    Plume_sediment* s          = eh_new(Plume_sediment, n_susp_grains);
+    double*         lambda     = sed_sediment_property(NULL, &sed_type_lambda_in_per_seconds);
+    double*         rho_sat    = sed_sediment_property(NULL, &sed_type_rho_sat);
+    double*         grain_size = sed_sediment_property(NULL, &sed_type_grain_size);
+    double*         diff_coef  = sed_sediment_property(NULL, &sed_type_diff_coef);
+    gint            n;
+
+    for (n = 0 ; n < n_susp_grains ; n++) {
+        s[n].lambda    = lambda    [n + 1];
+        s[n].rho       = rho_sat   [n + 1];
+        s[n].grainsize = grain_size[n + 1];
+        s[n].diff_coef = diff_coef [n + 1];
+    }
+
+    eh_free(lambda);
+    eh_free(rho_sat);
+    eh_free(grain_size);
+    eh_free(diff_coef);
+
+    return s;
+}
+
+static Plume_river
+bench_plume_river(gint n_susp_grains)
+{
+    Plume_river river;
+    gint        n;
+
+    river.Cs = eh_new(double, n_susp_grains);
+
+    for (n = 0 ; n < n_susp_grains ; n++) {
+        river.Cs[n] = .1;
+    }
+
+    river.rdirection = G_PI_2;
+    river.rma        = 0.;
+    river.u0         = 1.06;
+    river.b0         = 263.;
+    river.d0         = 8.3;
+    river.Q          = river.u0 * river.b0 * river.d0;
+
+    return river;
+}
+
+static Plume_inputs
+bench_plume_inputs(void)
+{
+    Plume_inputs plume_const;
+
+    plume_const.current_velocity    = 0.;
+    plume_const.ocean_concentration = 0.;
+    plume_const.plume_width         = 3000.;
+    plume_const.ndx                 = 1;
+    plume_const.ndy                 = 3;
+
+    return plume_const;
+}
+
+static Eh_dbl_grid*
+bench_plume_deposit_new(gint n_susp_grains, gint n_x, gint n_y, double dx,
+    double dy)
+{
+    Eh_dbl_grid* deposit = eh_new(Eh_dbl_grid, n_susp_grains);
+    gint         n;
+
+    for (n = 0 ; n < n_susp_grains ; n++) {
+        deposit[n] = eh_grid_new(double, n_x, n_y);
+
+        eh_grid_set_x_lin(deposit[n], -.5 * n_x * dx, dx);
+        eh_grid_set_y_lin(deposit[n], 0, dy);
+    }
+
+    return deposit;
+}
+
+static void
+bench_plume_deposit_destroy(Eh_dbl_grid* deposit, gint n_susp_grains)
+{
+    gint n;
+
+    for (n = 0 ; n < n_susp_grains ; n++) {
+        eh_grid_destroy(deposit[n], TRUE);
+    }
+
+    eh_free(deposit);
+}
+
+typedef struct {
+    gint            n_x;
+    gint            n_y;
+    double          dx;
+    double          dy;
+    gint            n_susp_grains;
+    Sed_cube        p;
+    Plume_inputs    plume_const;
+    Plume_river     river;
+    Plume_sediment* sedload;
+    Eh_dbl_grid*    deposit;
+    Eh_dbl_grid     last_load;
+    Eh_dbl_grid     dw;
+    double*         amount;
+    Sed_cell        cell;
+    Plume_data      plume_data;
+} Bench_basin;
+
+static gpointer
+bench_basin_setup(gint size)
+{
+    Bench_basin* b = eh_new(Bench_basin, 1);
+
+    b->n_x           = 24 * size;
+    b->n_y           = 48 * size;
+    b->dx            = 500.;
+    b->dy            = 500.;
+    b->n_susp_grains = sed_sediment_env_n_types() - 1;
+    b->p             = bench_cube_new(b->n_x, b->n_y, b->dx, b->dy, .002, 2.);
+    b->plume_const   = bench_plume_inputs();
+    b->river         = bench_plume_river(b->n_susp_grains);
+    b->sedload       = bench_plume_sediment(b->n_susp_grains);
+    b->deposit       = bench_plume_deposit_new(b->n_susp_grains, b->n_x, b->n_y,
+            b->dx, b->dy);
+    b->last_load     = sed_cube_load_grid(b->p, NULL);
+    b->dw            = eh_grid_new(double, b->n_x, b->n_y);
+    b->amount        = eh_new0(double, sed_sediment_env_n_types());
+    b->cell          = sed_cell_new_env();
+
+    plume_data_init(&b->plume_data);
+
+    eh_grid_set_x_lin(b->dw, 0, b->dx);
+    eh_grid_set_y_lin(b->dw, 0, b->dy);
+
+    return b;
+}
+
+/** River, plume, compaction and isostasy on a 3D basin
+
+Each time step, a hypopycnal plume is run from a river at the head of the
+basin and its deposit is added to the cube.  The cube is then compacted and
+the change in load is used to subside the basin.
+*/
+static Bench_count
+bench_basin(gpointer data)
+{
+    Bench_basin* b       = data;
+    Bench_count  count   = { 0, 0 };
+    const gint   n_steps = 10;
+    gint         step;
+
+    for (step = 0 ; step < n_steps ; step++) {
+        gint i, j, n;
+
+        plume3d(&b->plume_const, b->river, b->n_susp_grains, b->sedload,
+            b->deposit, &b->plume_data);
+
+        for (i = 0 ; i < b->n_x ; i++) {
+            for (j = 0 ; j < b->n_y ; j++) {
+                for (n = 0 ; n < b->n_susp_grains ; n++) {
+                    b->amount[n + 1] = eh_dbl_grid_val(b->deposit[n], i, j)
+                        * sed_cube_time_step_in_days(b->p);
+                }
+
+                sed_cell_clear(b->cell);
+                sed_cell_add_amount(b->cell, b->amount);
+                sed_cell_set_age(b->cell, step);
+
+                sed_column_add_cell(sed_cube_col_ij(b->p, i, j), b->cell);
+            }
+        }
+
+        compact_cube(b->p);
+
+        {
+            Eh_dbl_grid this_load = sed_cube_load_grid(b->p, NULL);
+            Eh_dbl_grid v_0       = eh_grid_dup(this_load);
+
+            eh_dbl_grid_subtract(v_0, b->last_load);
+            eh_dbl_grid_scalar_mult(v_0, b->dx * b->dy);
+            eh_dbl_grid_scalar_mult(b->dw, 0.);
+
+            subside_grid_load(b->dw, v_0, 5000., 7e10);
+
+            for (i = 0 ; i < b->n_x ; i++) {
+                for (j = 0 ; j < b->n_y ; j++) {
+                    sed_cube_adjust_base_height(b->p, i, j,
+                        -eh_dbl_grid_val(b->dw, i, j));
+                }
+            }
+
+            eh_grid_destroy(v_0, TRUE);
+            eh_grid_destroy(b->last_load, TRUE);
+            b->last_load = this_load;
+        }
+
+        count.n_steps += 1;
+        count.n_cells += b->n_x * b->n_y;
+    }
+
+    return count;
+}
+
+static void
+bench_basin_teardown(gpointer data)
+{
+    Bench_basin* b = data;
+
+    sed_cell_destroy(b->cell);
+    eh_free(b->amount);
+    eh_grid_destroy(b->dw, TRUE);
+    eh_grid_destroy(b->last_load, TRUE);
+    bench_plume_deposit_destroy(b->deposit, b->n_susp_grains);
+    plume_data_free(&b->plume_data);
+    eh_free(b->sedload);
+    eh_free(b->river.Cs);
+    sed_cube_destroy(b->p);
+    eh_free(b);
+}
+
+typedef struct {
+    gint          n_y;
+    Sed_cube      p;
+    Sed_cell      c;
+    Failure_t     fail_const;
+    Fail_profile* fail_prof;
+} Bench_failure;
+
+static gpointer
+bench_failure_cascade_setup(gint size)
+{
+    Bench_failure* b = eh_new(Bench_failure, 1);
+
+    b->n_y = 200 * size;
+    b->p   = bench_cube_new(1, b->n_y, 1., 100., .05, 10.);
+    b->c   = bench_cell_new(2., 0.);
+
+    b->fail_const.consolidation     = 5e-8;
+    b->fail_const.cohesion          = 0.;
+    b->fail_const.frictionAngle     = 30.;
+    b->fail_const.gravity           = sed_gravity();
+    b->fail_const.density_sea_water = sed_rho_sea_water();
+
+    b->fail_prof = fail_init_fail_profile(b->p, b->fail_const);
+
+    return b;
+}
+
+/** A cascade of failures on a steep 2D slope
+
+Sediment is added to the top of the slope and the profile is searched for
+the weakest failure surface, which is removed and dumped at the foot of the
+slope.  This is repeated until the slope is stable, as in run_failure.
+*/
+static Bench_count
+bench_failure_cascade(gpointer data)
+{
+    Bench_failure* b       = data;
+    Bench_count    count   = { 0, 0 };
+    const gint     n_y     = b->n_y;
+    const gint     n_steps = 5;
+    Sed_cube       p       = b->p;
+    gint           step;
+
+    for (step = 0 ; step < n_steps ; step++) {
+        gint   j, n_fail = 0;
+        double fs_min;
+
+        for (j = 0 ; j < n_y / 4 ; j++) {
+            sed_column_add_cell(sed_cube_col(p, j), b->c);
+        }
+
+        b->fail_prof = fail_reinit_fail_profile(b->fail_prof, p, b->fail_const);
+
+        do {
+            fail_update_fail_profile(b->fail_prof);
+            fail_examine_fail_profile(b->fail_prof);
+
+            fs_min = b->fail_prof->fs_min_val;
+
+            if (fs_min > 0 && fs_min < MIN_FACTOR_OF_SAFETY) {
+                const gint start = b->fail_prof->fs_min_start;
+                const gint len   = b->fail_prof->fs_min_len;
+                Sed_cube   fail  = get_failure_surface(p, start, len);
+
+                if (fail) {
+                    sed_cube_remove(p, fail);
+                    sed_column_add_cell(sed_cube_col(p, n_y - 1),
+                        sed_column_nth_cell(sed_cube_peek_col(fail, 0), 0));
+                    sed_cube_destroy(fail);
+                }
+
+                fail_set_failure_surface_ignore(b->fail_prof, start, len);
+
+                n_fail++;
+            }
+
+            count.n_cells += n_y;
+        } while (fs_min > 0. && fs_min < MIN_FACTOR_OF_SAFETY && n_fail < 100);
+
+        count.n_steps += 1;
+    }
+
+    return count;
+}
+
+static void
+bench_failure_cascade_teardown(gpointer data)
+{
+    Bench_failure* b = data;
+
+    fail_destroy_failure_profile(b->fail_prof);
+    sed_cell_destroy(b->c);
+    sed_cube_destroy(b->p);
+    eh_free(b);
+}
+
+typedef struct {
+    gint            n_y;
+    Sed_cube        p;
+    Sed_cell        along;
+    Eh_rand*        rand;
+    Sed_ocean_storm storm;
+} Bench_storm;
+
+static gpointer
+bench_storm_season_setup(gint size)
+{
+    Bench_storm* b = eh_new(Bench_storm, 1);
+
+    b->n_y   = 300 * size;
+    b->p     = bench_cube_new(1, b->n_y, 1., 100., .002, 5.);
+    b->along = bench_cell_new(0., 0.);
+    b->rand  = eh_rand_new_with_seed(1945);
+    b->storm = sed_ocean_storm_new();
+
+    sed_cube_set_time_step(b->p, 1. / S_DAYS_PER_YEAR);
+
+    return b;
+}
+
+/** A season of daily storms reworking a 2D shelf
+
+Wave heights are drawn from a Weibull distribution and each day's storm is
+passed to the cross-shore transport model.
+*/
+static Bench_count
+bench_storm_season(gpointer data)
+{
+    Bench_storm* b      = data;
+    Bench_count  count  = { 0, 0 };
+    const gint   n_days = 90;
+    gint         day;
+
+    for (day = 0 ; day < n_days ; day++) {
+        const double height = eh_rand_weibull(b->rand, 1.5, 2.);
+        const double freq   = 2.*G_PI / get_wave_period_from_height(height);
+        Sed_wave     wave   = sed_wave_new(height, pow(freq, 2) / sed_gravity(), freq);
+        Xshore_info  info;
+
+        sed_ocean_storm_set_index(b->storm, day);
+        sed_ocean_storm_set_duration(b->storm, 1.);
+        sed_ocean_storm_set_val(b->storm, height);
+        sed_ocean_storm_set_wave(b->storm, wave);
+        sed_wave_destroy(wave);
+
+        info = xshore(b->p, b->along, .1, b->storm);
+
+        sed_cell_destroy(info.added);
+        sed_cell_destroy(info.lost);
+        eh_free(info.dt);
+
+        count.n_steps += 1;
+        count.n_cells += b->n_y;
+    }
+
+    return count;
+}
+
+static void
+bench_storm_season_teardown(gpointer data)
+{
+    Bench_storm* b = data;
+
+    sed_ocean_storm_destroy(b->storm);
+    eh_rand_destroy(b->rand);
+    sed_cell_destroy(b->along);
+    sed_cube_destroy(b->p);
+    eh_free(b);
+}
+
+typedef struct {
+    gint       n_cells;
+    Sed_column col;
+    Sed_cell   c;
+    Sed_cell   top;
+} Bench_column;
+
+static gpointer
+bench_column_setup(gint size)
+{
+    Bench_column* b = eh_new(Bench_column, 1);
+
+    b->n_cells = 100000 * size;
+    b->col     = sed_column_new(1);
+    b->c       = bench_cell_new(.1, 0.);
+    b->top     = sed_cell_new_env();
+
+    return b;
+}
+
+static void
+bench_column_teardown(gpointer data)
+{
+    Bench_column* b = data;
+
+    sed_cell_destroy(b->top);
+    sed_cell_destroy(b->c);
+    sed_column_destroy(b->col);
+    eh_free(b);
+}
+
+static Bench_count
+bench_column_add_cell(gpointer data)
+{
+    Bench_column* b     = data;
+    Bench_count   count = { 0, 0 };
+    gint          i;
+
+    for (i = 0 ; i < b->n_cells ; i++) {
+        sed_cell_set_age(b->c, i);
+        sed_column_add_cell(b->col, b->c);
+    }
+
+    count.n_steps = b->n_cells;
+    count.n_cells = b->n_cells;
+
+    return count;
+}
+
+static gpointer
+bench_column_extract_top_setup(gint size)
+{
+    Bench_column* b = bench_column_setup(size);
+    gint          i;
+
+    for (i = 0 ; i < b->n_cells ; i++) {
+        sed_column_add_cell(b->col, b->c);
+    }
+
+    return b;
+}
+
+static Bench_count
+bench_column_extract_top(gpointer data)
+{
+    Bench_column* b     = data;
+    Bench_count   count = { 0, 0 };
+
+    // Extract less than a cell at a time so that most calls split a cell.
+    while (sed_column_len(b->col) > 0) {
+        sed_column_extract_top(b->col, .15, b->top);
+        count.n_steps += 1;
+    }
+
+    count.n_cells = b->n_cells;
+
+    return count;
+}
+
+typedef struct {
+    gint         n_x;
+    gint         n_y;
+    Sed_cube     p;
+    Sed_property property;
+} Bench_subgrid;
+
+static gpointer
+bench_cube_property_subgrid_setup(gint size)
+{
+    Bench_subgrid* b = eh_new(Bench_subgrid, 1);
+
+    b->n_x      = 20 * size;
+    b->n_y      = 40 * size;
+    b->p        = bench_cube_new(b->n_x, b->n_y, 100., 100., .002, 20.);
+    b->property = sed_property_new("grain");
+
+    return b;
+}
+
+static Bench_count
+bench_cube_property_subgrid(gpointer data)
+{
+    Bench_subgrid* b       = data;
+    Bench_count    count   = { 0, 0 };
+    const gint     n_calls = 5;
+    gint           i;
+
+    for (i = 0 ; i < n_calls ; i++) {
+        double    lower_left[3]  = { -30., 0., 0. };
+        double    upper_right[3] = { 5., b->n_x * 100., b->n_y * 100. };
+        double    resolution[3]  = { .25, 100., 100. };
+        Eh_ndgrid g = sed_cube_property_subgrid(b->p, b->property, lower_left,
+                upper_right, resolution);
+
+        count.n_steps += 1;
+        count.n_cells += eh_ndgrid_n(g, 0) * eh_ndgrid_n(g, 1) * eh_ndgrid_n(g, 2);
+
+        eh_ndgrid_destroy(g, TRUE);
+    }
+
+    return count;
+}
+
+static void
+bench_cube_property_subgrid_teardown(gpointer data)
+{
+    Bench_subgrid* b = data;
+
+    sed_property_destroy(b->property);
+    sed_cube_destroy(b->p);
+    eh_free(b);
+}
+
+typedef struct {
+    Eh_dbl_grid w;
+    Eh_dbl_grid v_0;
+} Bench_subside;
+
+static gpointer
+bench_subside_grid_load_setup(gint size)
+{
+    Bench_subside* b    = eh_new(Bench_subside, 1);
+    const gint     n_x  = 32 * size;
+    const gint     n_y  = 32 * size;
+    Eh_rand*       rand = eh_rand_new_with_seed(1945);
+
+    b->w   = eh_grid_new(double, n_x, n_y);
+    b->v_0 = eh_grid_new(double, n_x, n_y);
+
+    eh_grid_set_x_lin(b->w, 0, 1000.);
+    eh_grid_set_y_lin(b->w, 0, 1000.);
+    eh_grid_set_x_lin(b->v_0, 0, 1000.);
+    eh_grid_set_y_lin(b->v_0, 0, 1000.);
+
+    eh_rand_fill_double(rand, eh_dbl_grid_data_start(b->v_0), n_x * n_y);
+    eh_dbl_grid_scalar_mult(b->v_0, 1e9);
+
+    eh_rand_destroy(rand);
+
+    return b;
+}
+
+static Bench_count
+bench_subside_grid_load(gpointer data)
+{
+    Bench_subside* b       = data;
+    Bench_count    count   = { 0, 0 };
+    const gint     n_calls = 3;
+    gint           i;
+
+    for (i = 0 ; i < n_calls ; i++) {
+        eh_dbl_grid_scalar_mult(b->w, 0.);
+        subside_grid_load(b->w, b->v_0, 5000., 7e10);
+
+        count.n_steps += 1;
+        count.n_cells += eh_grid_n_x(b->w) * eh_grid_n_y(b->w);
+    }
+
+    return count;
+}
+
+static void
+bench_subside_grid_load_teardown(gpointer data)
+{
+    Bench_subside* b = data;
+
+    eh_grid_destroy(b->v_0, TRUE);
+    eh_grid_destroy(b->w, TRUE);
+    eh_free(b);
+}
+
+typedef struct {
+    Eh_dbl_grid x;
+    Eh_dbl_grid y;
+    Eh_dbl_grid mask;
+} Bench_dbl_grid;
+
+static gpointer
+bench_dbl_grid_setup(gint size)
+{
+    Bench_dbl_grid* b    = eh_new(Bench_dbl_grid, 1);
+    const gint      n_x  = 1000 * size;
+    const gint      n_y  = 1000 * size;
+    Eh_rand*        rand = eh_rand_new_with_seed(1945);
+    double*         m;
+    gint            n;
+
+    b->x    = eh_grid_new(double, n_x, n_y);
+    b->y    = eh_grid_new(double, n_x, n_y);
+    b->mask = eh_grid_new(double, n_x, n_y);
+
+    eh_rand_fill_double(rand, eh_dbl_grid_data_start(b->x), n_x * n_y);
+    eh_rand_fill_double(rand, eh_dbl_grid_data_start(b->y), n_x * n_y);
+    eh_rand_fill_double(rand, eh_dbl_grid_data_start(b->mask), n_x * n_y);
+
+    m = eh_dbl_grid_data_start(b->mask);
+
+    for (n = 0 ; n < n_x * n_y ; n++) {
+        m[n] = m[n] > .5 ? 1. : 0.;
+    }
+
+    eh_rand_destroy(rand);
+
+    return b;
+}
+
+static void
+bench_dbl_grid_teardown(gpointer data)
+{
+    Bench_dbl_grid* b = data;
+
+    eh_grid_destroy(b->mask, TRUE);
+    eh_grid_destroy(b->y, TRUE);
+    eh_grid_destroy(b->x, TRUE);
+    eh_free(b);
+}
+
+/** Element-wise arithmetic on a pair of 1000 by 1000 grids
+
+Each step adds a multiple of one grid to another, clamps the result, counts
+the elements above a threshold and sums those within a mask.  If \a fused,
+the fused kernels (eh_dbl_grid_axpy and friends) are used.  Otherwise the
+same work is done with a temporary grid and element accessors.
+*/
+static Bench_count
+_bench_dbl_grid(Bench_dbl_grid* b, gboolean fused)
+{
+    Bench_count       count   = { 0, 0 };
+    const gint        n_x     = eh_grid_n_x(b->x);
+    const gint        n_y     = eh_grid_n_y(b->x);
+    const gint        n_calls = 10;
+    const Eh_dbl_grid x       = b->x;
+    const Eh_dbl_grid y       = b->y;
+    const Eh_dbl_grid mask    = b->mask;
+    double            total   = 0.;
+    gint64            n_above = 0;
+    gint              n;
+
+    for (n = 0 ; n < n_calls ; n++) {
+        if (fused) {
+            eh_dbl_grid_axpy(y, -.5, x);
+            eh_dbl_grid_clamp(y, 0., 1.);
+            n_above += eh_dbl_grid_count_gt(y, .25);
+            total   += eh_dbl_grid_sum_mask(y, mask);
+        } else {
+            Eh_dbl_grid dx = eh_grid_dup(x);
+            gint        i, j;
+
+            eh_dbl_grid_scalar_mult(dx, -.5);
+            eh_dbl_grid_add(y, dx);
+
+            for (i = 0 ; i < n_x ; i++) {
+                for (j = 0 ; j < n_y ; j++) {
+                    double val = eh_dbl_grid_val(y, i, j);
+
+                    eh_dbl_grid_set_val(y, i, j, eh_clamp(val, 0., 1.));
+                }
+            }
+
+            for (i = 0 ; i < n_x ; i++) {
+                for (j = 0 ; j < n_y ; j++) {
+                    if (eh_dbl_grid_val(y, i, j) > .25) {
+                        n_above += 1;
+                    }
+
+                    if (eh_dbl_grid_val(mask, i, j) != 0.) {
+                        total += eh_dbl_grid_val(y, i, j);
+                    }
+                }
+            }
+
+            eh_grid_destroy(dx, TRUE);
+        }
+
+        count.n_steps += 1;
+        count.n_cells += n_x * n_y;
+    }
+
+    eh_debug("%s: %f %" G_GINT64_FORMAT, fused ? "kernels" : "ops", total, n_above);
+
+    return count;
+}
+
+static Bench_count
+bench_dbl_grid_ops(gpointer data)
+{
+    return _bench_dbl_grid(data, FALSE);
+}
+
+static Bench_count
+bench_dbl_grid_kernels(gpointer data)
+{
+    return _bench_dbl_grid(data, TRUE);
+}
+
+/* Write a delimited file of two 50000 by 8 records with comments and blank
+   lines between them.  The name of the file is returned. */
+static gpointer
+bench_dlm_read_setup(gint size)
+{
+    const gint n_rows = 50000 * size;
+    const gint n_cols = 8;
+    Eh_rand*   rand   = eh_rand_new_with_seed(1945);
+    gchar*     file   = NULL;
+    gint       fd;
+
+    fd = g_file_open_tmp("sedflux_bench_XXXXXX.csv", &file, NULL);
+
+    if (fd >= 0) {
+        FILE* fp = fdopen(fd, "w");
+        gint  rec, i, j;
+
+        fprintf(fp, "# Benchmark data\n");
+
+        for (rec = 0 ; rec < 2 ; rec++) {
+            fprintf(fp, "[ Record %d ]\n", rec);
+
+            for (i = 0 ; i < n_rows ; i++) {
+                for (j = 0 ; j < n_cols ; j++) {
+                    const double val = eh_rand_double_range(rand, -1000., 1000.);
+
+                    fprintf(fp, (j % 2 == 0) ? "%.6f" : "%.12g", val);
+                    fprintf(fp, (j < n_cols - 1) ? ", " : "\n");
+                }
+
+                if (i % 1000 == 999) {
+                    fprintf(fp, "\n// %d rows\n\n", i + 1);
+                }
+            }
+        }
+
+        fclose(fp);
+    } else {
+        eh_error("Unable to create a temporary file for dlm_read");
+    }
+
+    eh_rand_destroy(rand);
+
+    return file;
+}
+
+/** Read a 100000 by 8 delimited file
+
+The file is written once by the setup function and then read repeatedly
+with eh_dlm_read_full.
+*/
+static Bench_count
+bench_dlm_read(gpointer data)
+{
+    const gchar* file    = data;
+    Bench_count  count   = { 0, 0 };
+    const gint   n_calls = 5;
+    gint         n;
+
+    for (n = 0 ; n < n_calls ; n++) {
+        gint*     n_x;
+        gint*     n_y;
+        double*** vals;
+        gint      rec;
+
+        vals = eh_dlm_read_full(file, ",", &n_x, &n_y, NULL, -1, NULL);
+
+        for (rec = 0 ; vals && vals[rec] ; rec++) {
+            count.n_cells += n_x[rec] * n_y[rec];
+            eh_free_2(vals[rec]);
+        }
+
+        eh_free(vals);
+        eh_free(n_x);
+        eh_free(n_y);
+
+        count.n_steps += 1;
+    }
+
+    return count;
+}
+
+static void
+bench_dlm_read_teardown(gpointer data)
+{
+    g_remove(data);
+    g_free(data);
+}
+
+typedef struct {
+    gchar* file;      ///< The key-file to scan
+    gchar* cache_dir; ///< Directory of compiled key-files, or NULL
+    gint   n_values;  ///< Number of values in the key-file
+} Bench_key_file;
+
+static gpointer
+_bench_key_file_setup(gint size, gboolean cached)
+{
+    Bench_key_file* b        = eh_new(Bench_key_file, 1);
+    const gint      n_groups = 250 * size;
+    const gint      n_keys   = 16;
+    gint            fd;
+
+    b->file      = NULL;
+    b->cache_dir = NULL;
+    b->n_values  = n_groups * n_keys;
+
+    fd = g_file_open_tmp("sedflux_bench_XXXXXX.kvf", &b->file, NULL);
+
+    if (fd >= 0) {
+        FILE*          fp = fdopen(fd, "w");
+        struct utimbuf t;
+        gint           i, j;
+
+        fprintf(fp, "# Benchmark input file\n");
+
+        for (i = 0 ; i < n_groups ; i++) {
+            fprintf(fp, "\n[ 'process %d' ]\n", i);
+            fprintf(fp, "process name: process %d\n", i);
+            fprintf(fp, "process type: %s\n", (i % 2) ? "plume" : "bedload");
+
+            for (j = 2 ; j < n_keys ; j++) {
+                fprintf(fp, "parameter %d: %.12g\n", j, i + j / 17.);
+            }
+        }
+
+        fclose(fp);
+
+        /* A file modified well before it was compiled is trusted by its
+           time stamp, as an input file would be at the start of a run */
+        t.actime = t.modtime = time(NULL) - 3600;
+        g_utime(b->file, &t);
+    } else {
+        eh_error("Unable to create a temporary file for key_file_scan");
+    }
+
+    if (cached) {
+        b->cache_dir = g_strconcat(b->file, ".cache", NULL);
+        eh_key_file_destroy(eh_key_file_scan_cached(b->file, b->cache_dir, NULL));
+    } else {
+        g_unsetenv("EH_KEY_FILE_CACHE");
+    }
+
+    return b;
+}
+
+static gpointer
+bench_key_file_scan_setup(gint size)
+{
+    return _bench_key_file_setup(size, FALSE);
+}
+
+static gpointer
+bench_key_file_scan_cached_setup(gint size)
+{
+    return _bench_key_file_setup(size, TRUE);
+}
+
+/** Read a 250 group input file
+
+key_file_scan scans the text of the file, as every run does at start up.
+key_file_scan_cached reads the same file from a cache of compiled key-files
+(see eh_key_file_scan_cached) that the setup function has filled.
+*/
+static Bench_count
+bench_key_file_scan(gpointer data)
+{
+    Bench_key_file* b       = data;
+    Bench_count     count   = { 0, 0 };
+    const gint      n_calls = 20;
+    gint            n;
+
+    for (n = 0 ; n < n_calls ; n++) {
+        Eh_key_file f;
+
+        if (b->cache_dir) {
+            f = eh_key_file_scan_cached(b->file, b->cache_dir, NULL);
+        } else {
+            f = eh_key_file_scan(b->file, NULL);
+        }
+
+        eh_require(f);
+        eh_key_file_destroy(f);
+
+        count.n_steps += 1;
+        count.n_cells += b->n_values;
+    }
+
+    return count;
+}
+
+static void
+bench_key_file_scan_teardown(gpointer data)
+{
+    Bench_key_file* b = data;
+
+    if (b->cache_dir) {
+        GDir* dir = g_dir_open(b->cache_dir, 0, NULL);
+
+        if (dir) {
+            const gchar* name;
+
+            while ((name = g_dir_read_name(dir))) {
+                gchar* path = g_build_filename(b->cache_dir, name, NULL);
+                g_remove(path);
+                g_free(path);
+            }
+
+            g_dir_close(dir);
+        }
+
+        g_rmdir(b->cache_dir);
+    }
+
+    g_remove(b->file);
+    g_free(b->cache_dir);
+    g_free(b->file);
+    eh_free(b);
+}
+
+typedef struct {
+    gint            n_x;
+    gint            n_y;
+    gint            n_susp_grains;
+    Plume_inputs    plume_const;
+    Plume_river     river;
+    Plume_sediment* sedload;
+    Eh_dbl_grid*    deposit;
+    Plume_data      plume_data;
+} Bench_plume;
+
+static gpointer
+_bench_plume3d_setup(gint size, double x_ratio)
+{
+    Bench_plume* b = eh_new(Bench_plume, 1);
+
+    b->n_x           = 40 * size;
+    b->n_y           = 80 * size;
+    b->n_susp_grains = sed_sediment_env_n_types() - 1;
+    b->plume_const   = bench_plume_inputs();
+    b->river         = bench_plume_river(b->n_susp_grains);
+    b->sedload       = bench_plume_sediment(b->n_susp_grains);
+    b->deposit       = bench_plume_deposit_new(b->n_susp_grains, b->n_x, b->n_y,
+            250., 250.);
+
+    plume_data_init(&b->plume_data);
+    b->plume_data.x_ratio = x_ratio;
+
+    return b;
+}
+
+static gpointer
+bench_plume3d_setup(gint size)
+{
+    return _bench_plume3d_setup(size, 1.);
+}
+
+/* As plume3d but with the plume grid coarsened in the far field. */
+static gpointer
+bench_plume3d_coarse_setup(gint size)
+{
+    return _bench_plume3d_setup(size, 1.1);
+}
+
+static Bench_count
+bench_plume3d(gpointer data)
+{
+    Bench_plume* b       = data;
+    Bench_count  count   = { 0, 0 };
+    const gint   n_calls = 3;
+    gint         i;
+
+    for (i = 0 ; i < n_calls ; i++) {
+        plume3d(&b->plume_const, b->river, b->n_susp_grains, b->sedload,
+            b->deposit, &b->plume_data);
+
+        count.n_steps += 1;
+        count.n_cells += b->n_x * b->n_y * b->n_susp_grains;
+    }
+
+    return count;
+}
+
+static void
+bench_plume3d_teardown(gpointer data)
+{
+    Bench_plume* b = data;
+
+    plume_data_free(&b->plume_data);
+    bench_plume_deposit_destroy(b->deposit, b->n_susp_grains);
+    eh_free(b->sedload);
+    eh_free(b->river.Cs);
+    eh_free(b);
+}
+
+typedef struct {
+    gint    len;         ///< Number of water depths
+    double* depth;       ///< Water depths of a shelf profile
+    double* wave_number; ///< Wave numbers for each depth
+} Bench_wave_number;
+
+static gpointer
+bench_wave_number_setup(gint size)
+{
+    Bench_wave_number* b = eh_new(Bench_wave_number, 1);
+    gint               i;
+
+    b->len         = 10000 * size;
+    b->depth       = eh_new(double, b->len);
+    b->wave_number = eh_new(double, b->len);
+
+    for (i = 0 ; i < b->len ; i++) {
+        b->depth[i] = .5 + 200. * i / b->len;
+    }
+
+    return b;
+}
+
+/* Wave periods (s) that are solved for over the profile */
+static const double bench_wave_periods[] = { 4., 6., 8., 10., 12., 16. };
+
+/* The dispersion relation as it was solved with rtsafe, before
+   sed_dispersion_relation_wave_number had an explicit solution */
+static void
+_bench_wave_number_helper(double k, double* y, double* dydx, double* data)
+{
+    double g = sed_gravity();
+    double h = data[0];
+    double w = data[1];
+
+    *y    = g * k * tanh(k * h) - w * w;
+    *dydx = g * (k * h * pow(1. / cosh(k * h), 2.) + tanh(k * h));
+}
+
+/** Solve the dispersion relation over a 10000 point shelf profile
+
+wave_number_rtsafe solves it for each depth with rtsafe, to 0.01 1/m, as
+xshore used to.  wave_number_profile solves the same profile with
+sed_dispersion_relation_wave_number_profile, as xshore now does.
+*/
+static Bench_count
+bench_wave_number_rtsafe(gpointer data)
+{
+    Bench_wave_number* b     = data;
+    Bench_count        count = { 0, 0 };
+    gint               n, i;
+
+    for (n = 0 ; n < G_N_ELEMENTS(bench_wave_periods) ; n++) {
+        double args[2];
+
+        args[1] = 2. * G_PI / bench_wave_periods[n];
+
+        for (i = 0 ; i < b->len ; i++) {
+            args[0] = b->depth[i];
+            b->wave_number[i] = rtsafe(&_bench_wave_number_helper, 0, 100, .01,
+                    args);
+        }
+
+        count.n_steps += 1;
+        count.n_cells += b->len;
+    }
+
+    return count;
+}
+
+static Bench_count
+bench_wave_number_profile(gpointer data)
+{
+    Bench_wave_number* b     = data;
+    Bench_count        count = { 0, 0 };
+    gint               n;
+
+    for (n = 0 ; n < G_N_ELEMENTS(bench_wave_periods) ; n++) {
+        sed_dispersion_relation_wave_number_profile(b->depth, b->len,
+            2. * G_PI / bench_wave_periods[n], b->wave_number);
+
+        count.n_steps += 1;
+        count.n_cells += b->len;
+    }
+
+    return count;
+}
+
+static void
+bench_wave_number_teardown(gpointer data)
+{
+    Bench_wave_number* b = data;
+
+    eh_free(b->depth);
+    eh_free(b->wave_number);
+    eh_free(b);
+}
+
+static gboolean
+bench_is_selected(const gchar* name)
+{
+    gchar** s;
+
+    if (!names) {
+        return TRUE;
+    }
+
+    for (s = names ; *s ; s++) {
+        if (strcmp(*s, name) == 0) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+int
+main(int argc, char* argv[])
+{
+    GError*         error   = NULL;
+    GOptionContext* context = g_option_context_new("Run the sedflux benchmarks");
+    FILE*           fp      = stdout;
+    gboolean        first   = TRUE;
+    Bench*          b;
+
+    eh_init_glib();
+
+    g_option_context_add_main_entries(context, entries, NULL);
+
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        eh_error("Error parsing command line arguments: %s", error->message);
+    }
+
+    g_option_context_free(context);
+
+    if (list) {
+        for (b = all_benchmarks ; b->name ; b++) {
+            fprintf(stdout, "%-28s %s\n", b->name, b->kind);
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    eh_require(n_reps > 0);
+    eh_require(size > 0);
+
+    if (!bench_setup_sediment()) {
+        eh_exit(EXIT_FAILURE);
+    }
+
+    if (out_file) {
+        fp = eh_fopen(out_file, "w");
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"program\": \"sedflux-bench\",\n");
+    fprintf(fp, "  \"timestamp\": %ld,\n", (long)time(NULL));
+    fprintf(fp, "  \"size\": %d,\n", size);
+    fprintf(fp, "  \"reps\": %d,\n", n_reps);
+    fprintf(fp, "  \"benchmarks\": [");
+
+    for (b = all_benchmarks ; b->name ; b++) {
+        if (bench_is_selected(b->name)) {
+            GTimer*     timer = g_timer_new();
+            Bench_count count = { 0, 0 };
+            double      best  = G_MAXDOUBLE;
+            gpointer    data  = NULL;
+            gint        rep;
+
+            for (rep = 0 ; rep < n_reps ; rep++) {
+                if (!data) {
+                    data = b->setup(size);
+                }
+
+                g_timer_start(timer);
+                count = b->run(data);
+                g_timer_stop(timer);
+
+                eh_dbl_set_min(best, g_timer_elapsed(timer, NULL));
+
+                if (!b->reuse) {
+                    b->teardown(data);
+                    data = NULL;
+                }
+            }
+
+            if (data) {
+                b->teardown(data);
+            }
+
+            g_timer_destroy(timer);
+
+            eh_dbl_set_max(best, 1e-9);
+
+            fprintf(fp, "%s\n    {\n", first ? "" : ",");
+            fprintf(fp, "      \"name\": \"%s\",\n", b->name);
+            fprintf(fp, "      \"kind\": \"%s\",\n", b->kind);
+            fprintf(fp, "      \"seconds\": %.6g,\n", best);
+            fprintf(fp, "      \"steps\": %d,\n", count.n_steps);
+            fprintf(fp, "      \"cells\": %" G_GINT64_FORMAT ",\n", count.n_cells);
+            fprintf(fp, "      \"steps_per_second\": %.6g,\n", count.n_steps / best);
+            fprintf(fp, "      \"cells_per_second\": %.6g\n", count.n_cells / best);
+            fprintf(fp, "    }");
+
+            first = FALSE;
+        }
+    }
+
+    fprintf(fp, "\n  ]\n}\n");
+
+    if (fp != stdout) {
+        fclose(fp);
+    }
+
+    g_strfreev(names);
+    eh_free(out_file);
+
+    return EXIT_SUCCESS;
+}
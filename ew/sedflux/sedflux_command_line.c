@@ -39,6 +39,8 @@ static gboolean verbose      = FALSE;
 static gboolean silent       = FALSE;
 static gboolean version      = FALSE;
 static const char** active_procs = NULL;
+static gchar*   ensemble_file = NULL;
+static gint     n_jobs       = 0;
 
 /* Define the command line options */
 static GOptionEntry command_line_entries[] = {
@@ -62,6 +64,8 @@ static GOptionEntry command_line_entries[] = {
     { "verbose", 'V', 0, G_OPTION_ARG_NONE, &verbose, "Be verbose", NULL     },
     { "silent", 'S', 0, G_OPTION_ARG_NONE, &silent, "Be silent", NULL     },
     { "version", 'v', 0, G_OPTION_ARG_NONE, &version, "Version number", NULL     },
+    { "ensemble", 'e', 0, G_OPTION_ARG_FILENAME, &ensemble_file, "Run the ensemble members described in a file", "<file>" },
+    { "jobs", 'j', 0, G_OPTION_ARG_INT, &n_jobs, "Number of ensemble members to run at once", "n" },
     { NULL }
 };
 
@@ -181,6 +185,8 @@ sedflux_parse_command_line(const int argc, const char* argv[], GError** error)
             p->verbose      = verbose;
             p->version      = version;
             p->active_procs = active_procs;
+            p->ensemble_file = ensemble_file;
+            p->n_jobs       = n_jobs;
         } else {
             g_propagate_error(error, tmp_err);
         }
@@ -0,0 +1,240 @@
+#include <stdio.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include <utils/utils.h>
+#include <sed/sed_sedflux.h>
+
+#include "sedflux.h"
+#include "sedflux_api.h"
+
+static gchar*
+write_temp_file(const gchar* contents)
+{
+    gchar* name = NULL;
+    FILE*  fp   = eh_open_temp_file(NULL, &name);
+
+    g_assert(fp);
+
+    fprintf(fp, "%s", contents);
+    fclose(fp);
+
+    return name;
+}
+
+void
+test_members_scan(void)
+{
+    gchar* name = write_temp_file(
+            "[ member ]\n"
+            "name: wet\n"
+            "seed: 7\n"
+            "river file: rivers/wet.kvf\n"
+            "override: \"avulsion:seed for random number generator=3; plume:river name=main\"\n"
+            "[ member ]\n"
+            "name: dry\n"
+            "river file: /data/dry.kvf\n"
+            "[ member ]\n"
+            "override: \"plume:river name=dry\"\n"
+            "[ member ]\n"
+            "river file: /data/other.kvf\n");
+    Sedflux_member* members;
+    gint            n_members = 0;
+    GError*         err = NULL;
+
+    members = sedflux_members_scan(name, &n_members, &err);
+
+    g_assert_no_error(err);
+    g_assert(members != NULL);
+    g_assert_cmpint(n_members, ==, 3);
+
+    {
+        gchar* cwd   = g_get_current_dir();
+        gchar* river = g_build_filename(cwd, "rivers/wet.kvf", NULL);
+
+        g_assert_cmpstr(members[0].name, ==, "wet");
+        g_assert_cmpint(members[0].seed, ==, 7);
+        g_assert_cmpstr(members[0].river_file, ==, river);
+
+        g_free(river);
+        g_free(cwd);
+    }
+
+    g_assert(members[0].overrides != NULL);
+    g_assert_cmpint(g_strv_length(members[0].overrides), ==, 2);
+    g_assert_cmpstr(members[0].overrides[0], ==,
+        "avulsion:seed for random number generator=3");
+    g_assert_cmpstr(g_strstrip(members[0].overrides[1]), ==,
+        "plume:river name=main");
+
+    g_assert_cmpstr(members[1].name, ==, "dry");
+    g_assert_cmpint(members[1].seed, ==, 2);
+    g_assert_cmpstr(members[1].river_file, ==, "/data/dry.kvf");
+
+    // A group without a name and with new keys is part of the member before
+    // it, but one that repeats a key is a member of its own
+    g_assert(members[1].overrides != NULL);
+    g_assert_cmpstr(members[1].overrides[0], ==, "plume:river name=dry");
+
+    g_assert_cmpstr(members[2].name, ==, "member_2");
+    g_assert_cmpint(members[2].seed, ==, 3);
+    g_assert_cmpstr(members[2].river_file, ==, "/data/other.kvf");
+    g_assert(members[2].overrides == NULL);
+
+    sedflux_members_free(members, n_members);
+
+    g_remove(name);
+    g_free(name);
+}
+
+void
+test_members_scan_no_members(void)
+{
+    gchar* name = write_temp_file(
+            "[ not a member ]\n"
+            "name: wet\n");
+    Sedflux_member* members;
+    gint            n_members = -1;
+    GError*         err = NULL;
+
+    members = sedflux_members_scan(name, &n_members, &err);
+
+    g_assert(members == NULL);
+    g_assert_cmpint(n_members, ==, 0);
+    g_assert_error(err, SEDFLUX_ERROR, SEDFLUX_ERROR_BAD_PARAM);
+
+    g_clear_error(&err);
+    g_remove(name);
+    g_free(name);
+}
+
+void
+test_key_overrides(void)
+{
+    const gchar* overrides[] = {
+        "avulsion:seed for random number generator=3",
+        " plume : river name = main ",
+        "plume:no such key=1",
+        "no such process:river name=1",
+        NULL
+    };
+    Eh_key_file key_file;
+    GError*     err = NULL;
+
+    key_file = eh_key_file_scan_text(
+            "[ avulsion ]\n"
+            "seed for random number generator: 1973\n"
+            "std dev: 1\n"
+            "[ plume ]\n"
+            "river name: plume\n", &err);
+
+    g_assert_no_error(err);
+    g_assert(key_file != NULL);
+
+    sed_process_set_key_overrides(overrides);
+    sed_process_apply_key_overrides(key_file);
+    sed_process_set_key_overrides(NULL);
+
+    g_assert_cmpint(eh_key_file_get_int_value(key_file, "avulsion",
+            "seed for random number generator"), ==, 3);
+    g_assert_cmpint(eh_key_file_get_int_value(key_file, "avulsion",
+            "std dev"), ==, 1);
+    g_assert_cmpstr(eh_key_file_get_value(key_file, "plume", "river name"), ==,
+        "main");
+    g_assert(!eh_key_file_has_key(key_file, "plume", "no such key"));
+    g_assert(!eh_key_file_has_group(key_file, "no such process"));
+
+    eh_key_file_destroy(key_file);
+}
+
+void
+test_seed_offset(void)
+{
+    Eh_rand* r;
+
+    sed_process_set_seed_offset(0);
+    r = sed_process_rand_new(1973);
+    g_assert_cmpint(eh_rand_seed(r), ==, 1973);
+    eh_rand_destroy(r);
+
+    sed_process_set_seed_offset(7);
+    r = sed_process_rand_new(1973);
+    g_assert_cmpint(eh_rand_seed(r), ==, 1980);
+    eh_rand_destroy(r);
+
+    { /* Unseeded processes draw from glib's generator */
+        Eh_rand* r_0;
+        Eh_rand* r_1;
+
+        g_random_set_seed(7);
+        r_0 = sed_process_rand_new(0);
+
+        g_random_set_seed(7);
+        r_1 = sed_process_rand_new(0);
+
+        g_assert_cmpint(eh_rand_seed(r_0), ==, eh_rand_seed(r_1));
+
+        eh_rand_destroy(r_0);
+        eh_rand_destroy(r_1);
+    }
+
+    sed_process_set_seed_offset(0);
+}
+
+void
+test_input_value_seed(void)
+{
+    Sed_process     p   = sed_process_create("storm", NULL, NULL, NULL);
+    Sed_process     q   = sed_process_create("quake", NULL, NULL, NULL);
+    Eh_symbol_table tab = eh_symbol_table_new();
+    Eh_input_val    a, b, c;
+    double          val;
+
+    eh_symbol_table_insert(tab, "wave height", "uniform=0,10");
+
+    // A run seed makes a process's input values reproducible
+    sed_process_set_seed_offset(7);
+
+    a = sed_process_input_value(p, tab, "wave height", NULL);
+    b = sed_process_input_value(p, tab, "wave height", NULL);
+    c = sed_process_input_value(q, tab, "wave height", NULL);
+
+    val = eh_input_val_eval(a);
+    g_assert_cmpfloat(val, ==, eh_input_val_eval(b));
+
+    // Each process draws from its own stream
+    g_assert_cmpfloat(val, !=, eh_input_val_eval(c));
+
+    eh_input_val_destroy(b);
+
+    // As does each member of an ensemble
+    sed_process_set_seed_offset(8);
+    b = sed_process_input_value(p, tab, "wave height", NULL);
+    g_assert_cmpfloat(val, !=, eh_input_val_eval(b));
+
+    sed_process_set_seed_offset(0);
+
+    eh_input_val_destroy(a);
+    eh_input_val_destroy(b);
+    eh_input_val_destroy(c);
+    eh_symbol_table_destroy(tab);
+    sed_process_destroy(p);
+    sed_process_destroy(q);
+}
+
+int
+main(int argc, char* argv[])
+{
+    eh_init_glib();
+
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/sedflux/ensemble/members_scan", &test_members_scan);
+    g_test_add_func("/sedflux/ensemble/members_scan_no_members",
+        &test_members_scan_no_members);
+    g_test_add_func("/sedflux/ensemble/key_overrides", &test_key_overrides);
+    g_test_add_func("/sedflux/ensemble/seed_offset", &test_seed_offset);
+    g_test_add_func("/sedflux/ensemble/input_value_seed", &test_input_value_seed);
+
+    g_test_run();
+}
@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <glib.h>
+
+#include <utils/utils.h>
+#include <sed/sed_sedflux.h>
+#include <sed/test_sed.h>
+
+Sed_cell**
+construct_deposit_array_3(Sed_cube   p,
+    double     fraction,
+    Sed_cell** deposit,
+    Sed_riv    r,
+    double     tidal_range);
+double
+get_tidal_inundation_fraction(double z, double tidal_range);
+
+void
+test_tidal_inundation_fraction(void)
+{
+    const double a = 2.;
+
+    // Below low tide a point is always flooded, above high tide never
+    g_assert_cmpfloat(get_tidal_inundation_fraction(-a, a), ==, 1.);
+    g_assert_cmpfloat(get_tidal_inundation_fraction(-10. * a, a), ==, 1.);
+    g_assert_cmpfloat(get_tidal_inundation_fraction(a, a), ==, 0.);
+    g_assert_cmpfloat(get_tidal_inundation_fraction(10. * a, a), ==, 0.);
+
+    // Mean sea level is flooded for half of each cycle
+    g_assert(eh_compare_dbl(get_tidal_inundation_fraction(0., a), .5, 1e-12));
+
+    // In between, the fraction falls with height and is continuous at the
+    // limits
+    g_assert(eh_compare_dbl(get_tidal_inundation_fraction(-.5 * a, a), 2. / 3., 1e-12));
+    g_assert(eh_compare_dbl(get_tidal_inundation_fraction(.5 * a, a), 1. / 3., 1e-12));
+    g_assert_cmpfloat(get_tidal_inundation_fraction(-.999999 * a, a), >, .999);
+    g_assert_cmpfloat(get_tidal_inundation_fraction(.999999 * a, a), <, .001);
+
+    {
+        double z;
+        double last = 1.;
+
+        for (z = -a ; z <= a ; z += a / 64.) {
+            const double f = get_tidal_inundation_fraction(z, a);
+
+            g_assert_cmpfloat(f, <=, last);
+            g_assert_cmpfloat(f, >=, 0.);
+            last = f;
+        }
+    }
+}
+
+void
+test_tidal_deposit(void)
+{
+    const double a         = 1.;
+    const double base[5]   = { 2., .5, 0., -2., -2. };
+    const double in_susp[5] = { 1., 3., 1., 1., 4. };
+    Sed_cube      cube    = sed_cube_new(1, 5);
+    Sed_riv       r       = sed_river_new("Trunk");
+    Sed_cell_grid deposit_grid;
+    Sed_cell_grid susp;
+    Sed_cell**    deposit;
+    gint          j;
+
+    sed_cube_set_sea_level(cube, 0.);
+    sed_cube_set_tidal_range(cube, a);
+
+    for (j = 0 ; j < 5 ; j++) {
+        sed_cube_set_base_height(cube, 0, j, base[j]);
+    }
+
+    susp = sed_cube_create_in_suspension(cube);
+    sed_river_attach_susp_grid(r, susp);
+    sed_river_set_mouth(r, 0, 0);
+
+    for (j = 0 ; j < 5 ; j++) {
+        Sed_cell c = sed_cell_new_classed(NULL, in_susp[j], S_SED_TYPE_MUD);
+        sed_cell_copy(sed_cell_grid_val(susp, 0, j), c);
+        sed_cell_destroy(c);
+    }
+
+    deposit_grid = sed_cell_grid_new_env(1, 5);
+    deposit      = (Sed_cell**)eh_grid_data(deposit_grid);
+
+    construct_deposit_array_3(cube, 1., deposit, r, a);
+
+    // Above high tide nothing settles
+    g_assert_cmpfloat(sed_cell_size(deposit[0][0]), ==, 0.);
+
+    // Partly flooded columns receive sediment for the part of the tidal cycle
+    // that they are under water, up to high tide
+    g_assert(eh_compare_dbl(sed_cell_size(deposit[0][1]), .5 + 1e-5, 1e-12));
+    g_assert(eh_compare_dbl(sed_cell_size(deposit[0][2]), .5, 1e-12));
+
+    // Always flooded columns receive all of their sediment, up to high tide
+    // rather than mean sea level
+    g_assert(eh_compare_dbl(sed_cell_size(deposit[0][3]), 1., 1e-12));
+    g_assert(eh_compare_dbl(sed_cell_size(deposit[0][4]), 3. + 1e-5, 1e-12));
+
+    // What doesn't settle stays in suspension
+    for (j = 0 ; j < 5 ; j++) {
+        g_assert(eh_compare_dbl(
+                sed_cell_size(sed_cell_grid_val(susp, 0, j))
+                + sed_cell_size(deposit[0][j]), in_susp[j], 1e-12));
+    }
+
+    sed_cell_grid_destroy(deposit_grid);
+    sed_river_detach_susp_grid(r);
+    sed_river_destroy(r);
+    sed_cube_destroy(cube);
+}
+
+int
+main(int argc, char* argv[])
+{
+    eh_init_glib();
+
+    if (!sed_test_setup_sediment("rain_sediment")) {
+        eh_exit(EXIT_FAILURE);
+    }
+
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/sedflux/rain_sediment/tidal_inundation_fraction",
+        &test_tidal_inundation_fraction);
+    g_test_add_func("/sedflux/rain_sediment/tidal_deposit", &test_tidal_deposit);
+
+    g_test_run();
+}
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include <utils/utils.h>
+#include <sed/sed_sedflux.h>
+#include <sed/test_sed.h>
+
+#include "my_processes.h"
+
+/* The subsidence rate of record k (at time 10k) for column (i,j) */
+static double
+_rate(gint k, gint i, gint j)
+{
+    const double c[3] = { 1., 3., 4. };
+    return c[k] + i + 10 * j;
+}
+
+/* Write a 3D subsidence file of three records, at 0, 10 and 20 years, on a
+   grid that is larger than the domain. */
+static gchar*
+_write_subsidence_file(gint n_x, gint n_y)
+{
+    gchar* name = NULL;
+    FILE*  fp   = eh_open_temp_file(NULL, &name);
+    gint32 dim[2];
+    gint   i, j, k;
+
+    g_assert(fp);
+
+    dim[0] = n_y;
+    dim[1] = n_x;
+    fwrite(dim, sizeof(gint32), 2, fp);
+
+    for (k = 0 ; k < 3 ; k++) {
+        double t = 10. * k;
+
+        fwrite(&t, sizeof(double), 1, fp);
+
+        for (i = 0 ; i < n_x ; i++)
+            for (j = 0 ; j < n_y ; j++) {
+                double rate = _rate(k, i, j);
+                fwrite(&rate, sizeof(double), 1, fp);
+            }
+    }
+
+    fclose(fp);
+
+    return name;
+}
+
+void
+test_subsidence_3d(void)
+{
+    gchar*          file = _write_subsidence_file(4, 5);
+    Sed_cube        cube = sed_cube_new(3, 4);
+    Sed_process     p;
+    Eh_symbol_table tab  = eh_symbol_table_new();
+    GError*         err  = NULL;
+    gint            i, j;
+
+    sed_mode_set(SEDFLUX_MODE_3D);
+    g_assert(sed_mode_is_3d());
+
+    p = sed_process_create("subsidence", &init_subsidence, &run_subsidence,
+            &destroy_subsidence);
+
+    eh_symbol_table_insert(tab, "subsidence file", file);
+    g_assert(init_subsidence(p, tab, &err));
+    g_assert_no_error(err);
+
+    // The first step starts the run, and does not subside
+    sed_cube_set_age(cube, 0.);
+    run_subsidence(p, cube);
+
+    for (i = 0 ; i < 3 ; i++)
+        for (j = 0 ; j < 4 ; j++) {
+            g_assert_cmpfloat(sed_cube_base_height(cube, i, j), ==, 0.);
+        }
+
+    // A step within the first pair of records
+    sed_cube_set_age(cube, 5.);
+    run_subsidence(p, cube);
+
+    for (i = 0 ; i < 3 ; i++)
+        for (j = 0 ; j < 4 ; j++) {
+            g_assert(eh_compare_dbl(sed_cube_base_height(cube, i, j),
+                    5. * _rate(0, i, j), 1e-12));
+        }
+
+    // A step that crosses into the second pair, and one that runs past the
+    // last record, where its rate is held
+    sed_cube_set_age(cube, 15.);
+    run_subsidence(p, cube);
+
+    sed_cube_set_age(cube, 40.);
+    run_subsidence(p, cube);
+
+    for (i = 0 ; i < 3 ; i++)
+        for (j = 0 ; j < 4 ; j++) {
+            const double r_01 = _rate(0, i, j) + .5 * (_rate(1, i, j) - _rate(0, i, j));
+            const double r_12 = _rate(1, i, j) + .5 * (_rate(2, i, j) - _rate(1, i, j));
+            const double z    = 5. * _rate(0, i, j)
+                + 5. * r_01 + 5. * _rate(1, i, j)
+                + 5. * r_12 + 20. * _rate(2, i, j);
+
+            g_assert(eh_compare_dbl(sed_cube_base_height(cube, i, j), z, 1e-12));
+        }
+
+    sed_process_destroy(p);
+    eh_symbol_table_destroy(tab);
+    sed_cube_destroy(cube);
+
+    g_remove(file);
+    g_free(file);
+}
+
+int
+main(int argc, char* argv[])
+{
+    eh_init_glib();
+
+    if (!sed_test_setup_sediment("subsidence")) {
+        eh_exit(EXIT_FAILURE);
+    }
+
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/sedflux/subsidence/3d", &test_subsidence_3d);
+
+    g_test_run();
+}
@@ -1,4 +1,5 @@
 #include <eh_utils.h>
+#include <float.h>
 
 /* Local function declarations */
 gchar*
@@ -158,6 +159,582 @@ eh_dlm_read_swap(const gchar* file,
     return data;
 }
 
+/* The mmap-based reader.
+
+   The file is read in a single pass, straight from its mapping.  Its text is
+   never copied, and values are parsed from their place in the file.  The
+   result is the same as eh_dlm_prepare followed by eh_dlm_split_records and
+   eh_dlm_read_data, which are what the text of the file is viewed through:
+
+   - A '#' or '//' comment runs to the end of its line.
+   - Carriage returns end lines.
+   - Lines that are all white space are skipped (except for the last line
+     of a file that doesn't end with a newline).
+   - If the first non-blank character is a '[', the file is divided into
+     records.  Each begins with a header enclosed by square brackets, and
+     white space is stripped from both ends of its data.
+
+   C-style comments may span lines and join the text on either side of
+   them, so files that contain them are still read with the string
+   functions. */
+
+/* Lines of a mapped file.  Comments and carriage returns are dealt with
+   here, and blank lines are skipped. */
+typedef struct {
+    const gchar* pos; //< Start of the next line
+    const gchar* end; //< End of the file
+    const gchar* eol; //< End of the current line of the file (its '\n')
+    const gchar* cut; //< Start of the comment on the current line of the file
+}
+Dlm_lines;
+
+/* A record as it is being read. */
+typedef struct {
+    guint8   is_delim[256]; //< Non-zero for delimiter characters
+    gboolean strip;         //< Strip white space from the end of the data?
+    GArray*  vals;          //< The values of each row, one after another
+    GArray*  len;           //< The number of values in each row
+    GArray*  keep;          //< Number of values in each row, once it's stripped
+}
+Dlm_record;
+
+static const gchar*
+_dlm_find_comment(const gchar* s, const gchar* e)
+{
+    for (; s < e ; s++) {
+        if (*s == '#' || (*s == '/' && s + 1 < e && s[1] == '/')) {
+            return s;
+        }
+    }
+
+    return e;
+}
+
+static gboolean
+_dlm_is_blank(const gchar* s, const gchar* e)
+{
+    for (; s < e && g_ascii_isspace(*s) ; s++);
+
+    return s == e;
+}
+
+static void
+_dlm_lines_init(Dlm_lines* l, const gchar* buf, gsize len)
+{
+    l->pos = buf;
+    l->end = buf + len;
+    l->eol = memchr(buf, '\n', len);
+
+    if (!l->eol) {
+        l->eol = l->end;
+    }
+
+    l->cut = _dlm_find_comment(buf, l->eol);
+}
+
+/* Find the next line.  Its text is put in [*start,*stop).  Returns FALSE
+   when there are no more lines. */
+static gboolean
+_dlm_lines_next(Dlm_lines* l, const gchar** start, const gchar** stop)
+{
+    while (TRUE) {
+        const gchar* s;
+        const gchar* e;
+
+        if (l->pos > l->cut) {
+            /* Move on to the next line of the file */
+            if (l->eol >= l->end) {
+                return FALSE;
+            }
+
+            l->pos = l->eol + 1;
+            l->eol = memchr(l->pos, '\n', l->end - l->pos);
+
+            if (!l->eol) {
+                l->eol = l->end;
+            }
+
+            l->cut = _dlm_find_comment(l->pos, l->eol);
+        }
+
+        s = l->pos;
+        e = memchr(s, '\r', l->cut - s);
+
+        if (!e) {
+            e = l->cut;
+        }
+
+        l->pos = e + 1;
+
+        if (e == l->cut && l->eol == l->end) {
+            /* The last line of a file without a final newline. */
+            *start = s;
+            *stop  = e;
+            return s < e;
+        } else if (!_dlm_is_blank(s, e)) {
+            *start = s;
+            *stop  = e;
+            return TRUE;
+        }
+    }
+}
+
+static const double _dlm_pow_10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Parse a plain decimal number that fills [s,e) (apart from surrounding
+   white space).  Only numbers whose digits fit in a double and whose
+   exponent is small enough that the power of ten is also exact are
+   handled.  In that case a single multiply or divide is correctly rounded,
+   and so gives the same answer as g_ascii_strtod.  Anything else returns
+   FALSE. */
+static gboolean
+_dlm_parse_dbl(const gchar* s, const gchar* e, double* val)
+{
+#if defined( FLT_EVAL_METHOD ) && FLT_EVAL_METHOD == 0
+    guint64  m        = 0;
+    gint     n_digits = 0;
+    gint     e10      = 0;
+    gboolean neg      = FALSE;
+    gboolean any      = FALSE;
+
+    for (; s < e && g_ascii_isspace(*s) ; s++);
+
+    if (s == e) {
+        *val = 0.;
+        return TRUE;
+    }
+
+    if (*s == '-' || *s == '+') {
+        neg = (*s == '-');
+        s++;
+    }
+
+    for (; s < e && g_ascii_isdigit(*s) ; s++) {
+        any = TRUE;
+
+        if (m || *s != '0') {
+            if (n_digits++ >= 19) {
+                return FALSE;
+            }
+
+            m = m * 10 + (*s - '0');
+        }
+    }
+
+    if (s < e && *s == '.') {
+        for (s++ ; s < e && g_ascii_isdigit(*s) ; s++) {
+            any = TRUE;
+
+            if (m || *s != '0') {
+                if (n_digits++ >= 19) {
+                    return FALSE;
+                }
+
+                m = m * 10 + (*s - '0');
+            }
+
+            e10--;
+        }
+    }
+
+    if (!any) {
+        return FALSE;
+    }
+
+    if (s < e && (*s == 'e' || *s == 'E')) {
+        const gchar* p = s + 1;
+        gboolean     x_neg = FALSE;
+        gint         x = 0;
+
+        if (p < e && (*p == '-' || *p == '+')) {
+            x_neg = (*p == '-');
+            p++;
+        }
+
+        if (p == e || !g_ascii_isdigit(*p)) {
+            return FALSE;
+        }
+
+        for (; p < e && g_ascii_isdigit(*p) ; p++) {
+            if (x > 10000) {
+                return FALSE;
+            }
+
+            x = x * 10 + (*p - '0');
+        }
+
+        e10 += x_neg ? -x : x;
+        s    = p;
+    }
+
+    for (; s < e && g_ascii_isspace(*s) ; s++);
+
+    if (s != e) {
+        return FALSE;
+    }
+
+    if (m == 0) {
+        *val = neg ? -0. : 0.;
+    } else if (m <= (G_GUINT64_CONSTANT(1) << 53) && e10 >= -22 && e10 <= 22) {
+        const double v = (e10 < 0) ? (double)m / _dlm_pow_10[-e10]
+            : (double)m * _dlm_pow_10[e10];
+        *val = neg ? -v : v;
+    } else {
+        return FALSE;
+    }
+
+    return TRUE;
+#else
+    return FALSE;
+#endif
+}
+
+static double
+_dlm_strtod(const gchar* s, const gchar* e)
+{
+    double val;
+
+    if (!_dlm_parse_dbl(s, e, &val)) {
+        gchar* str = g_strndup(s, e - s);
+        val = g_ascii_strtod(str, NULL);
+        g_free(str);
+    }
+
+    return val;
+}
+
+/* Read a row of values from [s,e). */
+static void
+_dlm_record_add_row(Dlm_record* r, const gchar* s, const gchar* e)
+{
+    const gchar* tok  = s;
+    gint         n    = 0;
+    gint         keep = 0;
+    double       val;
+
+    for (; s < e ; s++) {
+        const guchar c = (guchar) * s;
+
+        if (r->is_delim[c]) {
+            val = _dlm_strtod(tok, s);
+            g_array_append_val(r->vals, val);
+
+            tok = s + 1;
+            n  += 1;
+
+            if (!g_ascii_isspace(c)) {
+                keep = n + 1;
+            }
+        } else if (!g_ascii_isspace(c)) {
+            keep = n + 1;
+        }
+    }
+
+    val = _dlm_strtod(tok, e);
+    g_array_append_val(r->vals, val);
+    n += 1;
+
+    g_array_append_val(r->len, n);
+    g_array_append_val(r->keep, keep);
+}
+
+/* Move the values of a record into a new matrix, and clear the record. */
+static double**
+_dlm_record_finish(Dlm_record* r, gint* n_rows, gint* n_cols)
+{
+    double** data;
+    gint     i, n;
+    gint     n_x, n_y;
+    double*  v;
+
+    if (r->len->len == 0) {
+        /* The data are empty.  This is read as a single value of zero. */
+        _dlm_record_add_row(r, "", "");
+    }
+
+    if (r->strip) {
+        /* Remove trailing white space.  This drops blank rows from the end of
+           the record, and values that only follow white space delimiters. */
+        while (r->len->len > 1 && g_array_index(r->keep, gint, r->keep->len - 1) == 0) {
+            g_array_set_size(r->vals, r->vals->len - g_array_index(r->len, gint, r->len->len - 1));
+            g_array_set_size(r->len, r->len->len - 1);
+            g_array_set_size(r->keep, r->keep->len - 1);
+        }
+
+        {
+            gint* len  = &g_array_index(r->len, gint, r->len->len - 1);
+            gint  keep = g_array_index(r->keep, gint, r->keep->len - 1);
+
+            if (keep > 0 && keep < *len) {
+                g_array_set_size(r->vals, r->vals->len - (*len - keep));
+                *len = keep;
+            }
+        }
+    }
+
+    n_x = r->len->len;
+
+    for (i = 0, n_y = 0 ; i < n_x ; i++) {
+        n_y = MAX(n_y, g_array_index(r->len, gint, i));
+    }
+
+    data = eh_new_2(double, n_x, n_y);
+
+    for (i = 0, v = (double*)r->vals->data ; i < n_x ; i++) {
+        n = g_array_index(r->len, gint, i);
+        memcpy(data[i], v, sizeof(double) * n);
+        v += n;
+    }
+
+    *n_rows = n_x;
+    *n_cols = n_y;
+
+    g_array_set_size(r->vals, 0);
+    g_array_set_size(r->len, 0);
+    g_array_set_size(r->keep, 0);
+
+    return data;
+}
+
+typedef enum {
+    DLM_HEADER,
+    DLM_DATA_START,
+    DLM_DATA
+}
+Dlm_state;
+
+/* Read the records of delimited text [buf,buf+len). */
+static double***
+_eh_dlm_read_buffer(const gchar* buf, gsize len, const gchar* delims,
+    gint** n_rows, gint** n_cols, gchar*** rec_data, gint max_records)
+{
+    GPtrArray*   recs   = g_ptr_array_new();
+    GArray*      rows   = g_array_new(FALSE, FALSE, sizeof(gint));
+    GArray*      cols   = g_array_new(FALSE, FALSE, sizeof(gint));
+    GString*     header = g_string_new(NULL);
+    Dlm_record   r;
+    Dlm_lines    lines;
+    Dlm_state    state;
+    const gchar* s;
+    const gchar* e;
+    gboolean     more;
+    gboolean     any_header = FALSE;
+    gboolean     loose      = TRUE;
+    double***    data;
+    gint         n_x, n_y;
+
+    if (!delims) {
+        delims = ";,";
+    }
+
+    memset(r.is_delim, 0, sizeof(r.is_delim));
+
+    for (; *delims ; delims++) {
+        r.is_delim[(guchar) * delims] = 1;
+    }
+
+    r.vals = g_array_new(FALSE, FALSE, sizeof(double));
+    r.len  = g_array_new(FALSE, FALSE, sizeof(gint));
+    r.keep = g_array_new(FALSE, FALSE, sizeof(gint));
+
+    if (rec_data) {
+        *rec_data = NULL;
+    }
+
+    _dlm_lines_init(&lines, buf, len);
+
+    /* Skip to the first non-blank character */
+    for (more = _dlm_lines_next(&lines, &s, &e) ; more ; more = _dlm_lines_next(&lines, &s, &e)) {
+        for (; s < e && g_ascii_isspace(*s) ; s++);
+
+        if (s < e) {
+            break;
+        }
+    }
+
+    if (!more || *s != '[') {
+        /* A single record that runs to the end of the file */
+        r.strip = FALSE;
+
+        if (more) {
+            do {
+                _dlm_record_add_row(&r, s, e);
+            } while (_dlm_lines_next(&lines, &s, &e));
+        }
+
+        g_ptr_array_add(recs, _dlm_record_finish(&r, &n_x, &n_y));
+        g_array_append_val(rows, n_x);
+        g_array_append_val(cols, n_y);
+    } else {
+        gboolean first_line = TRUE;
+
+        /* Text after the first '[' always makes a record but, after that,
+           a header needs at least one character that isn't white space */
+        r.strip = TRUE;
+        state   = DLM_HEADER;
+        s      += 1;
+
+        do {
+            if (!first_line && state == DLM_HEADER) {
+                g_string_append_c(header, '\n');
+                any_header = any_header || loose;
+            }
+
+            first_line = FALSE;
+
+            while (s <= e) {
+                if (state == DLM_HEADER) {
+                    const gchar* end = memchr(s, ']', e - s);
+
+                    g_string_append_len(header, s, (end ? end : e) - s);
+
+                    if (!end) {
+                        any_header = any_header || (loose ? s < e : !_dlm_is_blank(s, e));
+                        break;
+                    }
+
+                    if (rec_data) {
+                        eh_strv_append(rec_data, g_strstrip(g_strdup(header->str)));
+                    }
+
+                    g_string_truncate(header, 0);
+                    state = DLM_DATA_START;
+                    s     = end + 1;
+                } else if (state == DLM_DATA_START) {
+                    for (; s < e && g_ascii_isspace(*s) ; s++);
+
+                    if (s == e) {
+                        break;
+                    }
+
+                    if (*s == '[') {
+                        g_ptr_array_add(recs, _dlm_record_finish(&r, &n_x, &n_y));
+                        g_array_append_val(rows, n_x);
+                        g_array_append_val(cols, n_y);
+
+                        state      = DLM_HEADER;
+                        any_header = FALSE;
+                        loose      = FALSE;
+                        s++;
+                    } else {
+                        state = DLM_DATA;
+                    }
+                } else {
+                    const gchar* end = memchr(s, '[', e - s);
+
+                    _dlm_record_add_row(&r, s, end ? end : e);
+
+                    if (!end) {
+                        break;
+                    }
+
+                    g_ptr_array_add(recs, _dlm_record_finish(&r, &n_x, &n_y));
+                    g_array_append_val(rows, n_x);
+                    g_array_append_val(cols, n_y);
+
+                    state      = DLM_HEADER;
+                    any_header = FALSE;
+                    loose      = FALSE;
+                    s          = end + 1;
+                }
+
+                if (max_records > 0 && recs->len >= max_records) {
+                    break;
+                }
+            }
+        } while ((max_records <= 0 || recs->len < max_records)
+            && _dlm_lines_next(&lines, &s, &e));
+
+        if (max_records <= 0 || recs->len < max_records) {
+            if (state == DLM_HEADER && any_header) {
+                /* A header that isn't closed loses its last character, and
+                   is followed by empty data */
+                if (header->len > 0) {
+                    g_string_truncate(header, header->len - 1);
+                }
+
+                if (rec_data) {
+                    eh_strv_append(rec_data, g_strstrip(g_strdup(header->str)));
+                }
+
+                state = DLM_DATA_START;
+            }
+
+            if (state != DLM_HEADER) {
+                g_ptr_array_add(recs, _dlm_record_finish(&r, &n_x, &n_y));
+                g_array_append_val(rows, n_x);
+                g_array_append_val(cols, n_y);
+            }
+        }
+    }
+
+    data    = eh_new(double**, recs->len + 1);
+    *n_rows = eh_new(gint, recs->len);
+    *n_cols = eh_new(gint, recs->len);
+
+    if (recs->len > 0) {
+        memcpy(data, recs->pdata, sizeof(double**) * recs->len);
+        memcpy(*n_rows, rows->data, sizeof(gint) * recs->len);
+        memcpy(*n_cols, cols->data, sizeof(gint) * recs->len);
+    }
+
+    data[recs->len] = NULL;
+
+    g_ptr_array_free(recs, TRUE);
+    g_array_free(rows, TRUE);
+    g_array_free(cols, TRUE);
+    g_array_free(r.vals, TRUE);
+    g_array_free(r.len, TRUE);
+    g_array_free(r.keep, TRUE);
+    g_string_free(header, TRUE);
+
+    return data;
+}
+
+/* Read the records of a string, with the string functions.  The string
+   is freed. */
+static double***
+_eh_dlm_read_string(gchar* str, const gchar* delims, gint** n_rows,
+    gint** n_cols, gchar*** rec_data, gint max_records)
+{
+    double*** data;
+    gchar**   rec;
+    gint      i, n_recs;
+
+    /* Remove comments and empty lines */
+    eh_str_remove_c_style_comments(str);
+    eh_str_remove_to_eol_comments(str, "#");
+    eh_str_remove_to_eol_comments(str, "//");
+    eh_str_replace(str, '\r', '\n');
+    eh_dlm_remove_empty_lines(str);
+
+    rec    = eh_dlm_split_records(str, "[", "]", rec_data);
+    n_recs = g_strv_length(rec);
+
+    if (max_records > 0) {
+        n_recs = MIN(max_records, n_recs);
+    }
+
+    data    = eh_new(double**, n_recs + 1);
+    *n_rows = eh_new(gint, n_recs);
+    *n_cols = eh_new(gint, n_recs);
+
+    for (i = 0 ; i < n_recs ; i++) {
+        data[i] = eh_dlm_read_data(rec[i], delims, *n_rows + i, *n_cols + i,
+                NULL);
+    }
+
+    data[i] = NULL;
+
+    g_strfreev(rec);
+    eh_free(str);
+
+    return data;
+}
+
 /** Read multiple records from a text delimited file
 
 Similar to eh_dlm_read except that multiple records can be present
@@ -165,6 +742,9 @@ within the text file.  Records begin with a head that is enclosed
 by square brackets.  The data are read with the same format as that used
 by eh_dlm_read.
 
+The file is mapped into memory and read in a single pass.  Only files that
+contain C-style comments are first copied into a string.
+
 \param file        The name of the data file
 \param delims      A string of possible delimeters
 \param n_rows      Location to put the array of number of rows read
@@ -192,42 +772,39 @@ eh_dlm_read_full(const gchar* file,
     eh_return_val_if_fail(err == NULL || *err == NULL, NULL);
 
     if (file) {
-        gchar* str;
-        GError* tmp_error = NULL;
-
-        str = eh_dlm_prepare(file, &tmp_error);
-
-        if (!tmp_error) {
-            gchar** rec;
-            gint i, n_recs;
-            rec = eh_dlm_split_records(str, "[", "]", rec_data);
-
-            n_recs  = g_strv_length(rec);
-
-            if (max_records > 0) {
-                n_recs = MAX(max_records, n_recs);
+        GError*      tmp_error = NULL;
+        GMappedFile* map       = g_mapped_file_new(file, FALSE, &tmp_error);
+
+        if (map) {
+            const gchar* buf = g_mapped_file_get_contents(map);
+            gsize        len = g_mapped_file_get_length(map);
+            const gchar* nul;
+
+            if (!buf) {
+                /* An empty file */
+                buf = "";
+                len = 0;
             }
 
-            data    = eh_new(double**, n_recs + 1);
-            *n_rows = eh_new(gint, n_recs);
-            *n_cols = eh_new(gint, n_recs);
+            /* The text of the file ends at its first NUL */
+            nul = memchr(buf, '\0', len);
 
-            for (i = 0 ; i < n_recs ; i++) {
-                data[i] = eh_dlm_read_data(rec[i],
-                        delims,
-                        *n_rows + i,
-                        *n_cols + i,
-                        NULL);
+            if (nul) {
+                len = nul - buf;
             }
 
-            data[i] = NULL;
+            if (g_strstr_len(buf, len, "/*")) {
+                data = _eh_dlm_read_string(g_strndup(buf, len), delims, n_rows,
+                        n_cols, rec_data, max_records);
+            } else {
+                data = _eh_dlm_read_buffer(buf, len, delims, n_rows, n_cols,
+                        rec_data, max_records);
+            }
 
-            g_strfreev(rec);
+            g_mapped_file_unref(map);
         } else {
             g_propagate_error(err, tmp_error);
         }
-
-        eh_free(str);
     }
 
     return data;
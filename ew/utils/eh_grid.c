@@ -17,6 +17,22 @@ CLASS(Eh_grid)
 //DERIVED_CLASS( Eh_grid , Eh_dbl_grid );
 //DERIVED_CLASS( Eh_grid , Eh_int_grid );
 
+/* The element-wise Eh_dbl_grid operations loop over the contiguous block
+   that starts at eh_grid_data_start so that they can be vectorized (this
+   file is built with -fopenmp-simd where the compiler has it). */
+
+/* Same test as eh_compare_dbl, but visible to the compiler here so that it
+   can be inlined into the summation loop. */
+static inline gboolean
+_eh_dbl_is_close(double a, double b, double eps)
+{
+    const double diff = fabs(a - b);
+    const double d1   = eh_safe_dbl_division(diff, fabs(a));
+    const double d2   = eh_safe_dbl_division(diff, fabs(b));
+
+    return d1 <= eps && d2 <= eps;
+}
+
 Eh_ind_2
 eh_ind_2_create(int i, int j)
 {
@@ -852,6 +868,7 @@ eh_dbl_grid_subtract(Eh_dbl_grid g_1, Eh_dbl_grid g_2)
 
         eh_require(eh_grid_is_compatible(g_1, g_2));
 
+        #pragma omp simd
         for (i = 0 ; i < n_i ; i++) {
             g_1_data[i] -= g_2_data[i];
         }
@@ -883,6 +900,7 @@ eh_dbl_grid_add(Eh_dbl_grid g_1, Eh_dbl_grid g_2)
 
         eh_require(eh_grid_is_compatible(g_1, g_2));
 
+        #pragma omp simd
         for (i = 0 ; i < n_i ; i++) {
             g_1_data[i] += g_2_data[i];
         }
@@ -928,15 +946,16 @@ eh_dbl_grid_sum_bad_val(Eh_dbl_grid g, double bad_val)
         double*       data = (double*)eh_grid_data_start(g);
 
         if (eh_isnan(bad_val)) {
+            #pragma omp simd reduction(+:sum)
+            for (i = 0 ; i < n_i ; i++) {
+                sum += (data[i] == data[i]) ? data[i] : 0.;
+            }
+        } else {
             for (i = 0 ; i < n_i ; i++)
-                if (!eh_isnan(data[i])) {
-                    sum += data[i];
-                }
-        } else
-            for (i = 0 ; i < n_i ; i++)
-                if (!eh_compare_dbl(data[i], bad_val, 1e-12)) {
+                if (!_eh_dbl_is_close(data[i], bad_val, 1e-12)) {
                     sum += data[i];
                 }
+        }
     }
 
     return sum;
@@ -959,6 +978,7 @@ eh_dbl_grid_set(Eh_dbl_grid g, const double val)
         const gint n_i  = eh_grid_n_el(g);
         double*    data = (double*)eh_grid_data_start(g);
 
+        #pragma omp simd
         for (i = 0 ; i < n_i ; i++) {
             data[i] = val;
         }
@@ -1011,6 +1031,7 @@ eh_dbl_grid_scalar_mult(Eh_dbl_grid g, double val)
         const gint n_i  = eh_grid_n_el(g);
         double*    data = (double*)eh_grid_data_start(g);
 
+        #pragma omp simd
         for (i = 0 ; i < n_i ; i++) {
             data[i] *= val;
         }
@@ -1019,6 +1040,134 @@ eh_dbl_grid_scalar_mult(Eh_dbl_grid g, double val)
     return g;
 }
 
+/** Add a multiple of one grid to another
+
+Add \a a times grid \a x to grid \a y, in one pass over the data.  \a x is
+unaltered and the result stored in \a y.
+
+\param   y   A Eh_dbl_grid
+\param   a   The value to multiply \a x by
+\param   x   A Eh_dbl_grid to add
+
+\return The LHS grid
+*/
+Eh_dbl_grid
+eh_dbl_grid_axpy(Eh_dbl_grid y, double a, Eh_dbl_grid x)
+{
+    eh_require(y);
+
+    if (y && x) {
+        gint          i;
+        const gint    n_i    = eh_grid_n_el(y);
+        double*       y_data = (double*)eh_grid_data_start(y);
+        const double* x_data = (double*)eh_grid_data_start(x);
+
+        eh_require(eh_grid_is_compatible(y, x));
+
+        #pragma omp simd
+        for (i = 0 ; i < n_i ; i++) {
+            y_data[i] += a * x_data[i];
+        }
+    }
+
+    return y;
+}
+
+/** Find the sum of a grid over a mask
+
+Sum the elements of \a g for which the corresponding element of \a mask
+is non-zero.  NaN elements of \a g are ignored.
+
+\param   g      A Eh_dbl_grid
+\param   mask   A Eh_dbl_grid the same size as \a g
+
+\return The sum of the masked elements
+*/
+double
+eh_dbl_grid_sum_mask(Eh_dbl_grid g, Eh_dbl_grid mask)
+{
+    double sum = 0;
+
+    eh_require(g);
+    eh_require(mask);
+
+    if (g && mask) {
+        gint          i;
+        const gint    n_i  = eh_grid_n_el(g);
+        const double* data = (double*)eh_grid_data_start(g);
+        const double* m    = (double*)eh_grid_data_start(mask);
+
+        eh_require(eh_grid_is_compatible(g, mask));
+
+        #pragma omp simd reduction(+:sum)
+        for (i = 0 ; i < n_i ; i++) {
+            sum += (m[i] != 0. && data[i] == data[i]) ? data[i] : 0.;
+        }
+    }
+
+    return sum;
+}
+
+/** Clamp the values of a grid
+
+Set elements of \a g that are less than \a low to \a low, and those that
+are greater than \a high to \a high.  NaN elements are left as they are.
+
+\param   g      A Eh_dbl_grid
+\param   low    The smallest allowed value
+\param   high   The largest allowed value
+
+\return The input grid
+*/
+Eh_dbl_grid
+eh_dbl_grid_clamp(Eh_dbl_grid g, double low, double high)
+{
+    eh_require(g);
+    eh_require(low <= high);
+
+    if (g) {
+        gint       i;
+        const gint n_i  = eh_grid_n_el(g);
+        double*    data = (double*)eh_grid_data_start(g);
+
+        #pragma omp simd
+        for (i = 0 ; i < n_i ; i++) {
+            const double v = data[i] < low ? low : data[i];
+            data[i] = data[i] > high ? high : v;
+        }
+    }
+
+    return g;
+}
+
+/** Count the elements of a grid above a threshold
+
+\param   g     A Eh_dbl_grid
+\param   val   The threshold value
+
+\return The number of elements of \a g that are greater than \a val
+*/
+gint64
+eh_dbl_grid_count_gt(Eh_dbl_grid g, double val)
+{
+    gint64 count = 0;
+
+    eh_require(g);
+
+    if (g) {
+        gint          i;
+        const gint    n_i  = eh_grid_n_el(g);
+        const double* data = (double*)eh_grid_data_start(g);
+
+        #pragma omp simd reduction(+:count)
+        for (i = 0 ; i < n_i ; i++) {
+            count += data[i] > val;
+        }
+    }
+
+    return count;
+}
+
 /** Rotate a grid
 
 Rotate the Eh_dbl_grid about one of its elements (\a i_0,\a j_0) by an
@@ -1162,75 +1311,30 @@ eh_dbl_grid_remesh(Eh_dbl_grid g, gint new_n_x, gint new_n_y)
         eh_require(new_grid);
 
         if (new_grid) {
-            double*     x_ind     = eh_new(double, g->n_x);
-            double*     y_ind     = eh_new(double, g->n_y);
-            double*     new_x_ind = eh_new(double, new_grid->n_x);
-            double*     new_y_ind = eh_new(double, new_grid->n_y);
+            Eh_remesh r = eh_remesh_new(g->n_x, g->n_y, new_n_x, new_n_y,
+                    EH_REMESH_BILINEAR);
+            double*   x;
+            double*   y;
+            gint      i, j;
 
             eh_grid_reindex(new_grid, g->low_x, g->low_y);
 
-            { /* Set the x and y positions of the grids */
-                gint        i, j;
-                double      dx = (g->n_x - 1.) / (double)(new_n_x - 1.);
-                double      dy = (g->n_y - 1.) / (double)(new_n_y - 1.);
-
-                for (i = 0 ; i < g->n_x        ; i++) {
-                    x_ind[i]     = i + g->low_x;
-                }
-
-                for (j = 0 ; j < g->n_y        ; j++) {
-                    y_ind[j]     = j + g->low_y;
-                }
-
-                if (g->n_x == 1 && new_n_x == 1) {
-                    dx = 1;
-                }
-
-                if (g->n_y == 1 && new_n_y == 1) {
-                    dy = 1;
-                }
-
-                for (i = 0 ; i < new_grid->n_x ; i++) {
-                    new_x_ind[i] = i * dx + new_grid->low_x;
-                }
-
-                for (j = 0 ; j < new_grid->n_y ; j++) {
-                    new_y_ind[j] = j * dy + new_grid->low_y;
-                }
-
-                if (new_x_ind[i - 1] > x_ind[g->n_x - 1]) {
-                    new_x_ind[i - 1] = x_ind[g->n_x - 1] * (1. - 1e-6);
-                }
+            x = eh_grid_x_start(new_grid);
+            y = eh_grid_y_start(new_grid);
 
-                if (new_y_ind[i - 1] > y_ind[g->n_y - 1]) {
-                    new_y_ind[i - 1] = y_ind[g->n_y - 1] * (1. - 1e-6);
-                }
+            /* The x and y values of the new grid are the (fractional)
+               indices of the original grid */
+            for (i = 0 ; i < new_n_x ; i++) {
+                x[i] = g->low_x + ((new_n_x > 1) ? i * (g->n_x - 1.) / (new_n_x - 1.) : 0.);
             }
 
-            { /* Interpolate the x and y indices */
-                interpolate(x_ind, x_ind, g->n_x,
-                    new_x_ind, eh_grid_x_start(new_grid), new_grid->n_x);
-                interpolate(y_ind, y_ind, g->n_y,
-                    new_y_ind, eh_grid_y_start(new_grid), new_grid->n_y);
+            for (j = 0 ; j < new_n_y ; j++) {
+                y[j] = g->low_y + ((new_n_y > 1) ? j * (g->n_y - 1.) / (new_n_y - 1.) : 0.);
             }
 
-            { /* Interpolate to the new grid */
-                double* orig_x = g->x;
-                double* orig_y = g->y;
-
-                g->x = x_ind;
-                g->y = y_ind;
-
-                interpolate_2(g, new_grid);
+            eh_remesh_apply(r, g, new_grid);
 
-                g->x = orig_x;
-                g->y = orig_y;
-            }
-
-            eh_free(x_ind);
-            eh_free(y_ind);
-            eh_free(new_x_ind);
-            eh_free(new_y_ind);
+            eh_remesh_destroy(r);
         }
     }
 
@@ -1519,6 +1623,51 @@ eh_dbl_grid_rebin_bad_val(Eh_dbl_grid source, Eh_dbl_grid dest, double bad_val)
     eh_require(dest);
 
     if (source && dest) {
+        double* work = eh_new(double, eh_dbl_grid_rebin_work_len(source, dest));
+
+        eh_dbl_grid_rebin_bad_val_work(source, dest, bad_val, work);
+
+        eh_free(work);
+    }
+
+    return dest;
+}
+
+/** Length of the scratch space needed to rebin one grid onto another
+
+\param source The grid to rebin
+\param dest   The grid to rebin onto
+
+\return The number of doubles that eh_dbl_grid_rebin_bad_val_work needs
+*/
+gssize
+eh_dbl_grid_rebin_work_len(Eh_dbl_grid source, Eh_dbl_grid dest)
+{
+    return source->n_x * dest->n_y + source->n_x + dest->n_x
+        + MAX(source->n_x, source->n_y) + 1;
+}
+
+/** Rebin one grid onto another using scratch space from the caller
+
+As eh_dbl_grid_rebin_bad_val but nothing is allocated, so that a caller that
+rebins many grids can keep one block of scratch space for all of them.
+
+\param source  The grid to rebin
+\param dest    The grid to rebin onto
+\param bad_val Value of destination cells that lie outside of source
+\param work    Scratch space of at least eh_dbl_grid_rebin_work_len doubles
+
+\return dest
+*/
+Eh_dbl_grid
+eh_dbl_grid_rebin_bad_val_work(Eh_dbl_grid source, Eh_dbl_grid dest,
+    double bad_val, double* work)
+{
+    eh_require(source);
+    eh_require(dest);
+    eh_require(work);
+
+    if (source && dest && work) {
         gint src_low_x  = source->low_x;
         gint dest_low_x = dest->low_x;
         gint src_low_y  = source->low_y;
@@ -1528,44 +1677,38 @@ eh_dbl_grid_rebin_bad_val(Eh_dbl_grid source, Eh_dbl_grid dest, double bad_val)
         eh_grid_reindex(dest, 0, 0);
 
         {
-            double** temp = eh_new_2(double, source->n_x, dest->n_y);
+            double* temp        = work;
+            double* temp_source = temp + source->n_x * dest->n_y;
+            double* temp_dest   = temp_source + source->n_x;
+            double* x_edge      = temp_dest + dest->n_x;
 
             { /* Rebin the rows of the destination grid */
                 gint i;
 
                 for (i = 0 ; i < source->n_x ; i++)
-                    eh_rebin_dbl_array_bad_val(source->y, (double*)source->data[i],
-                        source->n_y, dest->y, temp[i],
-                        dest->n_y, bad_val);
+                    eh_rebin_dbl_array_bad_val_work(source->y,
+                        (double*)source->data[i], source->n_y, dest->y,
+                        temp + i * dest->n_y, dest->n_y, bad_val, x_edge);
             }
 
-            //   dest_data = dest->data;
-
             {/* Rebin the columns of the destination grid */
-                double*  temp_source = eh_new(double, source->n_x);
-                double*  temp_dest   = eh_new(double, dest->n_x);
-                double** dest_data   = eh_dbl_grid_data(dest);
+                double** dest_data = eh_dbl_grid_data(dest);
                 gint i, j;
 
                 for (j = 0 ; j < dest->n_y ; j++) {
                     for (i = 0 ; i < source->n_x ; i++) {
-                        temp_source[i] = temp[i][j];
+                        temp_source[i] = temp[i * dest->n_y + j];
                     }
 
-                    eh_rebin_dbl_array_bad_val(source->x, temp_source, source->n_x,
-                        dest->x, temp_dest, dest->n_x,
-                        bad_val);
+                    eh_rebin_dbl_array_bad_val_work(source->x, temp_source,
+                        source->n_x, dest->x, temp_dest, dest->n_x, bad_val,
+                        x_edge);
 
                     for (i = 0 ; i < dest->n_x ; i++) {
                         dest_data[i][j] = temp_dest[i];
                     }
                 }
-
-                eh_free(temp_dest);
-                eh_free(temp_source);
             }
-
-            eh_free_2(temp);
         }
 
         eh_grid_reindex(source, src_low_x, src_low_y);
@@ -1583,7 +1726,7 @@ eh_grid_foreach(Eh_grid g, GFunc func, gpointer user_data)
         gssize n_i = g->n_x * g->n_y;
 
         for (i = 0 ; i < n_i ; i++) {
-            (*func)((gchar*)(g->data[0]) + i, user_data);
+            (*func)((gchar*)eh_grid_data_start(g) + i * g->el_size, user_data);
         }
     }
 }
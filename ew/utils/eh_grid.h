@@ -95,6 +95,10 @@ double      eh_dbl_grid_sum_bad_val(Eh_dbl_grid g, double bad_val);
 Eh_dbl_grid eh_dbl_grid_set(Eh_dbl_grid g, double val);
 Eh_dbl_grid eh_dbl_grid_randomize(Eh_dbl_grid g);
 Eh_dbl_grid eh_dbl_grid_scalar_mult(Eh_dbl_grid g, double val);
+Eh_dbl_grid eh_dbl_grid_axpy(Eh_dbl_grid y, double a, Eh_dbl_grid x);
+double      eh_dbl_grid_sum_mask(Eh_dbl_grid g, Eh_dbl_grid mask);
+Eh_dbl_grid eh_dbl_grid_clamp(Eh_dbl_grid g, double low, double high);
+gint64      eh_dbl_grid_count_gt(Eh_dbl_grid g, double val);
 Eh_dbl_grid eh_dbl_grid_rotate(Eh_dbl_grid g, double angle,
     gssize i_0, gssize j_0, double* err);
 Eh_dbl_grid eh_dbl_grid_reduce(Eh_dbl_grid g, gint new_nx, gint new_ny);
@@ -113,6 +117,9 @@ Eh_grid     eh_grid_sub(Eh_grid g, gint i_0, gint j_0, gint n_x, gint n_y);
 Eh_dbl_grid eh_dbl_grid_rebin(Eh_dbl_grid src, Eh_dbl_grid dest);
 Eh_dbl_grid eh_dbl_grid_rebin_bad_val(Eh_dbl_grid src, Eh_dbl_grid dest,
     double val);
+gssize      eh_dbl_grid_rebin_work_len(Eh_dbl_grid src, Eh_dbl_grid dest);
+Eh_dbl_grid eh_dbl_grid_rebin_bad_val_work(Eh_dbl_grid src, Eh_dbl_grid dest,
+    double val, double* work);
 
 Eh_dbl_grid eh_dbl_grid_populate(Eh_dbl_grid g, Populate_func f, gpointer user_data);
 
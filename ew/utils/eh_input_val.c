@@ -13,7 +13,8 @@ CLASS(Eh_input_val)
     double*           x;       //< Array of x-values for a time series or a user-defined CDF
     double*           y;       //< Array of y-values for a time series or a user-defined CDF
     gint              len;     //< Length of \a x and \a y
-    GRand*
+    Eh_time_series    series;  //< Time series built from \a x and \a y, if necessary.  NULL, otherwise.
+    Eh_rand*
     rand;    //< A random number generator, if necessary.  NULL, otherwise.
     double            data[2]; //< Data used to calculate a new value
     double            val;     //< The current value of the Eh_input_val
@@ -44,8 +45,9 @@ eh_input_val_new()
         val->x         = NULL;
         val->y         = NULL;
         val->len       = 0;
+        val->series    = NULL;
         val->val       = G_MINDOUBLE;
-        val->rand      = g_rand_new();
+        val->rand      = eh_rand_new();
     }
 
     return val;
@@ -63,14 +65,41 @@ eh_input_val_destroy(Eh_input_val val)
     if (val) {
         eh_free(val->x);
         eh_free(val->y);
+        eh_time_series_destroy(val->series);
         eh_free(val->file);
-        g_rand_free(val->rand);
+        eh_rand_destroy(val->rand);
         eh_free(val);
     }
 
     return NULL;
 }
 
+/** Seed the random values of an Eh_input_val
+
+Values that are drawn from a distribution are, by default, seeded from
+glib's global random number generator.  Seeding them here instead, and
+giving each value its own stream (see eh_rand_set_stream), makes a run
+reproducible and keeps one value's draws from depending on another's.
+
+\param val     An Eh_input_val
+\param seed    The run seed
+\param process Identifier for the process that owns the value
+\param column  Identifier for the value within its process
+
+\return \a val
+*/
+Eh_input_val
+eh_input_val_set_seed(Eh_input_val val, guint64 seed, guint32 process,
+    guint32 column)
+{
+    eh_require(val);
+
+    eh_rand_init(val->rand, seed);
+    eh_rand_set_stream(val->rand, process, column, 0);
+
+    return val;
+}
+
 /** Create an Eh_input_val with a value
 
 The Eh_input_val can be initialized to be one of:
@@ -170,6 +199,16 @@ eh_input_val_set(const char* input_str, GError** err)
                     val->len = n_cols;
                     val->x = (double*)g_memdup(data[0], sizeof(double) * n_cols);
                     val->y = (double*)g_memdup(data[1], sizeof(double) * n_cols);
+
+                    if (type == EH_INPUT_VAL_FILE) {
+                        val->series = eh_time_series_new(val->x, val->y, val->len,
+                                &tmp_error);
+
+                        if (tmp_error) {
+                            g_prefix_error(&tmp_error, "%s: ", file);
+                            val = eh_input_val_destroy(val);
+                        }
+                    }
                 }
             }
 
@@ -240,20 +279,19 @@ eh_input_val_eval(Eh_input_val val, ...)
     if (val->type == EH_INPUT_VAL_RAND_NORMAL) {
         val->val = eh_rand_normal(val->rand, val->data[0], val->data[1]);
     } else if (val->type == EH_INPUT_VAL_RAND_UNIFORM) {
-        val->val = g_rand_double_range(val->rand, val->data[0], val->data[1]);
+        val->val = eh_rand_double_range(val->rand, val->data[0], val->data[1]);
     } else if (val->type == EH_INPUT_VAL_RAND_WEIBULL) {
         val->val = eh_rand_weibull(val->rand, val->data[0], val->data[1]);
     } else if (val->type == EH_INPUT_VAL_RAND_USER) {
         val->val = eh_rand_user(val->rand, val->x, val->y, val->len);
     } else if (val->type == EH_INPUT_VAL_FILE) {
 
-        eh_require(val->x);
-        eh_require(val->y);
+        eh_require(val->series);
 
         va_start(args, val);
         data = va_arg(args, double);
 
-        interpolate(val->x, val->y, val->len, &data, &(val->val), 1);
+        val->val = eh_time_series_eval(val->series, data);
 
         va_end(args);
     }
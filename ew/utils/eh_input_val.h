@@ -42,6 +42,8 @@ Eh_input_val_type;
 Eh_input_val    eh_input_val_new();
 Eh_input_val    eh_input_val_destroy(Eh_input_val val);
 Eh_input_val    eh_input_val_set(const char* input_str, GError** err);
+Eh_input_val    eh_input_val_set_seed(Eh_input_val val, guint64 seed,
+    guint32 process, guint32 column);
 double          eh_input_val_eval(Eh_input_val val, ...);
 
 #ifdef __cplusplus
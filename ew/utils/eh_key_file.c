@@ -813,18 +813,9 @@ print_keys(gpointer key, gpointer value, gpointer user_data)
     eh_message("KEY = %s", (gchar*)key);
 }
 
-/** Scan a key-file
-
-Scan an entire key-file and construct a new Eh_key_file containing
-the file information.
-
-\param file   The name of the file to scan
-\param error  A GError
-
-\return A new Eh_key_file.  Use eh_key_file_destroy to free.
-*/
-Eh_key_file
-eh_key_file_scan(const char* file, GError** error)
+/* Scan a key-file with a GScanner. */
+static Eh_key_file
+_eh_key_file_scan(const char* file, GError** error)
 {
     Eh_key_file f = NULL;
 
@@ -871,8 +862,316 @@ eh_key_file_scan(const char* file, GError** error)
     return f;
 }
 
+/** Scan a key-file
+
+Scan an entire key-file and construct a new Eh_key_file containing
+the file information.
+
+If the environment variable EH_KEY_FILE_CACHE is set, it names a directory
+of compiled key-files, and the file is read with eh_key_file_scan_cached.
+
+\param file   The name of the file to scan
+\param error  A GError
+
+\return A new Eh_key_file.  Use eh_key_file_destroy to free.
+*/
 Eh_key_file
-eh_key_file_scan_text(const char* buffer, GError** error)
+eh_key_file_scan(const char* file, GError** error)
+{
+    const gchar* cache_dir = g_getenv("EH_KEY_FILE_CACHE");
+
+    eh_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+    if (cache_dir && cache_dir[0] != '\0') {
+        return eh_key_file_scan_cached(file, cache_dir, error);
+    } else {
+        return _eh_key_file_scan(file, error);
+    }
+}
+
+#define EH_KEY_FILE_CACHE_MAGIC      "EHKFC02"
+#define EH_KEY_FILE_CACHE_BYTE_ORDER 0x01020304
+
+/* Nanoseconds within which a source modified before its compiled file was
+   written may have been modified again without its time stamp changing */
+#define EH_KEY_FILE_CACHE_SLACK      G_GINT64_CONSTANT(2000000000)
+
+/* The header of a compiled key-file.  It is followed by the groups of the
+   key-file, in the order that they were added.  Each group is a guint32
+   count of its key-value pairs and its name, followed by the key and value
+   of each pair.  All strings are NUL-terminated. */
+typedef struct {
+    gchar   magic[8];     //< EH_KEY_FILE_CACHE_MAGIC
+    guint32 byte_order;   //< EH_KEY_FILE_CACHE_BYTE_ORDER, as it was written
+    guint32 n_groups;     //< Number of groups, counting repeated groups
+    guint64 n_bytes;      //< Size of the compiled file
+    guint64 src_size;     //< Size of the source file
+    gint64  src_mtime;    //< Modification time of the source file (ns)
+    gint64  written;      //< Time when the compiled file was written (ns)
+    guint8  src_hash[32]; //< SHA-256 digest of the source file
+}
+Eh_key_file_cache_header;
+
+/* The modification time of a file in nanoseconds */
+static gint64
+_eh_key_file_mtime(const struct stat* st)
+{
+#if defined(__APPLE__)
+    return (gint64)st->st_mtimespec.tv_sec * G_GINT64_CONSTANT(1000000000)
+        + st->st_mtimespec.tv_nsec;
+#else
+    return (gint64)st->st_mtim.tv_sec * G_GINT64_CONSTANT(1000000000)
+        + st->st_mtim.tv_nsec;
+#endif
+}
+
+/* The name of the compiled version of a key-file.  It is named for a hash
+   of the absolute path of the key-file. */
+static gchar*
+_eh_key_file_cache_name(const gchar* file, const gchar* cache_dir)
+{
+    gchar* path;
+    gchar* hash;
+    gchar* base;
+    gchar* name;
+
+    if (g_path_is_absolute(file)) {
+        path = g_strdup(file);
+    } else {
+        gchar* cwd = g_get_current_dir();
+        path = g_build_filename(cwd, file, NULL);
+        g_free(cwd);
+    }
+
+    hash = g_compute_checksum_for_string(G_CHECKSUM_SHA256, path, -1);
+    base = g_strconcat(hash, ".ekc", NULL);
+    name = g_build_filename(cache_dir, base, NULL);
+
+    g_free(base);
+    g_free(hash);
+    g_free(path);
+
+    return name;
+}
+
+/* A key-file that is mapped into memory, and hashed, only when it is needed.
+   Its contents are then both compared with a compiled file and scanned, so
+   the two always agree. */
+typedef struct {
+    const gchar* file;
+    GMappedFile* map;
+    guint8       digest[32]; //< SHA-256 digest of the contents of file
+}
+Eh_key_file_source;
+
+/* Map a key-file into memory and calculate the SHA-256 digest of its
+   contents, if that hasn't been done already. */
+static gboolean
+_eh_key_file_source_map(Eh_key_file_source* src, GError** error)
+{
+    if (!src->map) {
+        GMappedFile* map = g_mapped_file_new(src->file, FALSE, error);
+
+        if (map) {
+            GChecksum*   sum = g_checksum_new(G_CHECKSUM_SHA256);
+            const gchar* buf = g_mapped_file_get_contents(map);
+            gsize        len = 32;
+
+            if (buf) {
+                g_checksum_update(sum, (const guchar*)buf, g_mapped_file_get_length(map));
+            }
+
+            g_checksum_get_digest(sum, src->digest, &len);
+            g_checksum_free(sum);
+
+            if (len == 32) {
+                src->map = map;
+            } else {
+                g_mapped_file_unref(map);
+            }
+        }
+    }
+
+    return src->map != NULL;
+}
+
+static void
+_eh_key_file_cache_append_pair(gpointer key, gpointer value, gpointer user_data)
+{
+    GString* buf = (GString*)user_data;
+
+    g_string_append_len(buf, (const gchar*)key, strlen((const gchar*)key) + 1);
+    g_string_append_len(buf, (const gchar*)value, strlen((const gchar*)value) + 1);
+}
+
+/* Write the compiled version of a key-file.  The file is replaced
+   atomically, so that runs sharing a cache never see part of a file. */
+static gboolean
+_eh_key_file_write_cache(Eh_key_file f, const gchar* cache_file,
+    const struct stat* st, const guint8 digest[32])
+{
+    Eh_key_file_cache_header h;
+    GString*                 buf  = g_string_new(NULL);
+    GHashTable*              next = g_hash_table_new(&g_str_hash, &g_str_equal);
+    GList*                   link;
+    gboolean                 ok;
+
+    memset(&h, 0, sizeof(Eh_key_file_cache_header));
+    g_string_append_len(buf, (const gchar*)&h, sizeof(Eh_key_file_cache_header));
+
+    /* The groups of each name are listed most recent first, so walk each
+       list backwards to put them back in the order they were added */
+    for (link = f->l ; link ; link = link->next) {
+        const gchar* name = (const gchar*)link->data;
+        GList*       occ  = (GList*)g_hash_table_lookup(next, name);
+        guint32      n_pairs;
+
+        if (!occ) {
+            occ = g_list_last((GList*)g_hash_table_lookup(f->t, name));
+        }
+
+        eh_require(occ);
+
+        n_pairs = eh_symbol_table_size((Eh_symbol_table)occ->data);
+
+        g_string_append_len(buf, (const gchar*)&n_pairs, sizeof(guint32));
+        g_string_append_len(buf, name, strlen(name) + 1);
+
+        eh_symbol_table_foreach((Eh_symbol_table)occ->data,
+            &_eh_key_file_cache_append_pair, buf);
+
+        g_hash_table_insert(next, (gpointer)name, occ->prev);
+        h.n_groups += 1;
+    }
+
+    memcpy(h.magic, EH_KEY_FILE_CACHE_MAGIC, sizeof(h.magic));
+    memcpy(h.src_hash, digest, sizeof(h.src_hash));
+    h.byte_order = EH_KEY_FILE_CACHE_BYTE_ORDER;
+    h.n_bytes    = buf->len;
+    h.src_size   = st->st_size;
+    h.src_mtime  = _eh_key_file_mtime(st);
+    h.written    = g_get_real_time() * 1000;
+
+    memcpy(buf->str, &h, sizeof(Eh_key_file_cache_header));
+
+    ok = g_file_set_contents(cache_file, buf->str, buf->len, NULL);
+
+    g_hash_table_destroy(next);
+    g_string_free(buf, TRUE);
+
+    return ok;
+}
+
+/* The next NUL-terminated string in [*pos,end), or NULL if there isn't
+   one. */
+static const gchar*
+_eh_key_file_cache_next_str(const gchar** pos, const gchar* end)
+{
+    const gchar* str = *pos;
+    const gchar* nul = memchr(str, '\0', end - str);
+
+    if (nul) {
+        *pos = nul + 1;
+        return str;
+    } else {
+        return NULL;
+    }
+}
+
+/* Read the compiled version of a key-file.  NULL is returned if there is no
+   compiled version, or if it is out of date or damaged.  A compiled file
+   is current if the source has the same size and modification time as
+   when it was compiled or, failing that, the same contents.
+
+   Some file systems keep modification times to the second (or coarser), so
+   a source that was changed shortly before it was compiled can be changed
+   again, to the same size, without its time changing.  The time stamp is
+   only trusted if the source was last modified well before the compiled
+   file was written; otherwise the contents are compared. */
+static Eh_key_file
+_eh_key_file_read_cache(const gchar* cache_file, Eh_key_file_source* src,
+    const struct stat* st)
+{
+    Eh_key_file  f   = NULL;
+    GMappedFile* map = g_mapped_file_new(cache_file, FALSE, NULL);
+
+    if (map) {
+        const gchar*             pos = g_mapped_file_get_contents(map);
+        const gsize              len = g_mapped_file_get_length(map);
+        const gchar*             end = pos + len;
+        Eh_key_file_cache_header h;
+        gboolean                 ok;
+
+        ok = (pos && len >= sizeof(Eh_key_file_cache_header));
+
+        if (ok) {
+            memcpy(&h, pos, sizeof(Eh_key_file_cache_header));
+            pos += sizeof(Eh_key_file_cache_header);
+
+            ok = memcmp(h.magic, EH_KEY_FILE_CACHE_MAGIC, sizeof(h.magic)) == 0
+                && h.byte_order == EH_KEY_FILE_CACHE_BYTE_ORDER
+                && h.n_bytes    == len
+                && h.src_size   == (guint64)st->st_size;
+        }
+
+        if (ok && (h.src_mtime != _eh_key_file_mtime(st)
+                || h.written - h.src_mtime < EH_KEY_FILE_CACHE_SLACK)) {
+            ok = _eh_key_file_source_map(src, NULL)
+                && memcmp(src->digest, h.src_hash, sizeof(h.src_hash)) == 0;
+        }
+
+        if (ok) {
+            guint32 i, j;
+
+            f = eh_key_file_new();
+
+            for (i = 0 ; ok && i < h.n_groups ; i++) {
+                guint32         n_pairs;
+                const gchar*    name;
+                Eh_symbol_table group;
+
+                ok = (end - pos >= (gssize)sizeof(guint32));
+
+                if (ok) {
+                    memcpy(&n_pairs, pos, sizeof(guint32));
+                    pos += sizeof(guint32);
+
+                    name = _eh_key_file_cache_next_str(&pos, end);
+                    ok   = (name != NULL);
+                }
+
+                if (ok) {
+                    group = eh_key_file_add_group(f, name, FALSE);
+
+                    for (j = 0 ; ok && j < n_pairs ; j++) {
+                        const gchar* key   = _eh_key_file_cache_next_str(&pos, end);
+                        const gchar* value = key ? _eh_key_file_cache_next_str(&pos, end) : NULL;
+
+                        if (value) {
+                            eh_symbol_table_insert(group, (gchar*)key, (gchar*)value);
+                        } else {
+                            ok = FALSE;
+                        }
+                    }
+                }
+            }
+
+            if (!ok || pos != end) {
+                f = eh_key_file_destroy(f);
+            }
+        }
+
+        g_mapped_file_unref(map);
+    }
+
+    return f;
+}
+
+/* Scan the first len bytes of buffer, which needn't be NUL-terminated.  name
+   is the name of the buffer in messages from the scanner, or NULL. */
+static Eh_key_file
+_eh_key_file_scan_text_len(const gchar* buffer, gsize len, const gchar* name,
+    GError** error)
 {
     Eh_key_file f = NULL;
 
@@ -880,11 +1179,11 @@ eh_key_file_scan_text(const char* buffer, GError** error)
 
     f = eh_key_file_new();
 
-    if (f) {
+    if (f && len > 0) {
         GError* tmp_err = NULL;
         GScanner* s;
 
-        s = eh_open_scanner_text(buffer, strlen(buffer), &tmp_err);
+        s = eh_open_scanner_text(buffer, len, &tmp_err);
 
         if (s) {
             gboolean        done = FALSE;
@@ -892,6 +1191,10 @@ eh_key_file_scan_text(const char* buffer, GError** error)
             Eh_symbol_table symbol_table;
             gpointer        user_data[2];
 
+            if (name) {
+                s->input_name = name;
+            }
+
             while (!done && !g_scanner_eof(s)) {
                 symbol_table = eh_symbol_table_new();
                 group_name = eh_scan_next_record(s, symbol_table);
@@ -924,6 +1227,71 @@ eh_key_file_scan_text(const char* buffer, GError** error)
     return f;
 }
 
+/** Scan a key-file through a cache of compiled key-files
+
+The first time a key-file is scanned, it is written to \p cache_dir in a
+binary form that can be read back with a single mmap.  After that, the
+compiled file is read in place of the key-file for as long as the key-file
+keeps the same size and modification time (or the same contents).  If the
+compiled file can't be read or written, the key-file is simply scanned.
+
+\param file       The name of the file to scan
+\param cache_dir  The directory that holds the compiled key-files
+\param error      A GError
+
+\return A new Eh_key_file.  Use eh_key_file_destroy to free.
+*/
+Eh_key_file
+eh_key_file_scan_cached(const gchar* file, const gchar* cache_dir,
+    GError** error)
+{
+    Eh_key_file f = NULL;
+    struct stat st;
+
+    eh_return_val_if_fail(error == NULL || *error == NULL, NULL);
+    eh_require(cache_dir);
+
+    if (file && cache_dir && g_stat(file, &st) == 0) {
+        gchar*             cache_file = _eh_key_file_cache_name(file, cache_dir);
+        Eh_key_file_source src        = { file, NULL };
+
+        f = _eh_key_file_read_cache(cache_file, &src, &st);
+
+        /* The file is read once, and the same bytes are scanned and hashed */
+        if (!f && _eh_key_file_source_map(&src, error)) {
+            const gchar* buf = g_mapped_file_get_contents(src.map);
+            const gsize  len = g_mapped_file_get_length(src.map);
+
+            f = _eh_key_file_scan_text_len(buf, len, file, error);
+
+            /* A file that changed since it was stat'ed is not compiled */
+            if (f && len == (gsize)st.st_size
+                && g_mkdir_with_parents(cache_dir, 0755) == 0) {
+                _eh_key_file_write_cache(f, cache_file, &st, src.digest);
+            }
+        }
+
+        if (src.map) {
+            g_mapped_file_unref(src.map);
+        }
+
+        g_free(cache_file);
+    } else {
+        f = _eh_key_file_scan(file, error);
+    }
+
+    return f;
+}
+
+Eh_key_file
+eh_key_file_scan_text(const char* buffer, GError** error)
+{
+    eh_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+    return _eh_key_file_scan_text_len(buffer, buffer ? strlen(buffer) : 0,
+            NULL, error);
+}
+
 gint
 eh_key_file_scan_from_template(const gchar* file,
     const gchar* group_name,
@@ -92,6 +92,9 @@ Eh_symbol_table eh_key_file_get_symbol_table(Eh_key_file f,
 Eh_symbol_table* eh_key_file_get_symbol_tables(Eh_key_file f,
     const gchar* group_name);
 Eh_key_file   eh_key_file_scan(const char* file, GError** error);
+Eh_key_file   eh_key_file_scan_cached(const gchar* file,
+    const gchar* cache_dir,
+    GError** error);
 Eh_key_file   eh_key_file_scan_text(const gchar* buffer, GError** error);
 gint          eh_key_file_scan_from_template(const gchar* file,
     const gchar* group_name,
@@ -21,6 +21,7 @@
 #include <eh_utils.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <pthread.h>
 
 GHashTable* _log_files_;
 long int _log_file_code_;
@@ -145,6 +146,7 @@ eh_close_log(const char* log_name)
     GPtrArray* log_fp_vec;
 
     if (log_name && (log_fp_vec = (GPtrArray*)g_hash_table_lookup(_log_files_, log_name))) {
+        eh_log_async_flush();
         fclose((FILE*)g_ptr_array_index(log_fp_vec, log_fp_vec->len - 1));
         g_ptr_array_free(log_fp_vec, TRUE);
         g_hash_table_remove(_log_files_, log_name);
@@ -188,6 +190,12 @@ eh_set_ignore_log_level(GLogLevelFlags ignore)
     eh_ignore_log_level = (GLogLevelFlags)(eh_ignore_log_level | ignore);
 }
 
+gboolean
+eh_log_level_is_ignored(GLogLevelFlags level)
+{
+    return (eh_ignore_log_level & level) != 0;
+}
+
 GLogLevelFlags
 eh_set_verbosity_level(gint verbosity)
 {
@@ -246,17 +254,350 @@ eh_get_verbosity_level()
     }
 }
 
+/* Asynchronous logging.
+
+   While the drainer is running, eh_logger doesn't write messages itself.
+   Each thread formats its messages into a ring buffer of its own and a
+   drainer thread writes them out.  A ring has one writer (its thread) and
+   one reader (the drainer), and the two only share the head and tail
+   counters, so logging a message takes no locks.  This also makes
+   eh_logger safe to call from OpenMP regions.  If a ring is full, its
+   thread waits for the drainer rather than drop messages.
+
+   A child of fork doesn't have the drainer, so it goes back to writing
+   messages itself (see _eh_log_atfork_child). */
+
+#define EH_LOG_RING_SIZE   (1<<16)
+#define EH_LOG_DRAIN_USECS 1000
+
+typedef struct _Eh_log_ring Eh_log_ring;
+
+struct _Eh_log_ring {
+    gchar         buf[EH_LOG_RING_SIZE]; //< Records, written round the ring
+    volatile gint head;                  //< Number of bytes ever written
+    volatile gint tail;                  //< Number of bytes ever drained
+    volatile gint dead;                  //< Has the thread of the ring exited?
+    Eh_log_ring*  next;                  //< The next ring of the drainer's list
+};
+
+/* A record in a ring.  It is followed by the text of the message. */
+typedef struct {
+    FILE*   fp;  //< File to write the message to
+    guint32 len; //< Length of the message
+}
+Eh_log_record;
+
+static Eh_log_ring* volatile _eh_log_rings   = NULL;
+static volatile gint         _eh_log_running = FALSE;
+static volatile gint         _eh_log_stop    = FALSE;
+static volatile gint         _eh_log_passes  = 0;
+static GThread*              _eh_log_drainer = NULL;
+
+static void
+_eh_log_ring_release(gpointer data)
+{
+    g_atomic_int_set(&((Eh_log_ring*)data)->dead, TRUE);
+}
+
+static GPrivate _eh_log_ring_key = G_PRIVATE_INIT(_eh_log_ring_release);
+
+/* The ring of the calling thread.  It is added to the drainer's list the
+   first time that the thread logs a message. */
+static Eh_log_ring*
+_eh_log_ring_get(void)
+{
+    Eh_log_ring* r = (Eh_log_ring*)g_private_get(&_eh_log_ring_key);
+
+    if (!r) {
+        r = eh_new(Eh_log_ring, 1);
+
+        do {
+            r->next = (Eh_log_ring*)g_atomic_pointer_get(&_eh_log_rings);
+        } while (!g_atomic_pointer_compare_and_exchange(&_eh_log_rings, r->next, r));
+
+        g_private_set(&_eh_log_ring_key, r);
+    }
+
+    return r;
+}
+
+static guint
+_eh_log_ring_put(Eh_log_ring* r, guint pos, const void* src, gsize n)
+{
+    const guint start = pos & (EH_LOG_RING_SIZE - 1);
+    const gsize first = MIN(n, EH_LOG_RING_SIZE - start);
+
+    memcpy(r->buf + start, src, first);
+    memcpy(r->buf, (const gchar*)src + first, n - first);
+
+    return pos + n;
+}
+
+static guint
+_eh_log_ring_take(Eh_log_ring* r, guint pos, void* dest, gsize n)
+{
+    const guint start = pos & (EH_LOG_RING_SIZE - 1);
+    const gsize first = MIN(n, EH_LOG_RING_SIZE - start);
+
+    memcpy(dest, r->buf + start, first);
+    memcpy((gchar*)dest + first, r->buf, n - first);
+
+    return pos + n;
+}
+
+static void
+_eh_log_write(FILE* fp, const gchar* label, const gchar* domain,
+    const gchar* message)
+{
+    if (label) {
+        fprintf(fp, "%s: ", label);
+    }
+
+    if (domain) {
+        fprintf(fp, "%s: ", domain);
+    }
+
+    fprintf(fp, "%s\n", message);
+
+    fflush(fp);
+}
+
+/* Add a message to the ring of the calling thread. */
+static void
+_eh_log_push(FILE* fp, const gchar* label, const gchar* domain,
+    const gchar* message)
+{
+    Eh_log_ring*  r          = _eh_log_ring_get();
+    const gsize   label_len  = label  ? strlen(label)  : 0;
+    const gsize   domain_len = domain ? strlen(domain) : 0;
+    const gsize   len        = strlen(message);
+    Eh_log_record rec;
+    gsize         n_bytes;
+    guint         pos;
+
+    rec.fp  = fp;
+    rec.len = (label ? label_len + 2 : 0) + (domain ? domain_len + 2 : 0) + len + 1;
+    n_bytes = sizeof(Eh_log_record) + rec.len;
+
+    pos = (guint)g_atomic_int_get(&r->head);
+
+    if (n_bytes > EH_LOG_RING_SIZE) {
+        /* Too big for the ring.  Write it once the earlier messages of this
+           thread are out. */
+        while ((guint)g_atomic_int_get(&r->tail) != pos) {
+            g_usleep(EH_LOG_DRAIN_USECS);
+        }
+
+        _eh_log_write(fp, label, domain, message);
+        return;
+    }
+
+    while (EH_LOG_RING_SIZE - (pos - (guint)g_atomic_int_get(&r->tail)) < n_bytes) {
+        g_thread_yield();
+    }
+
+    pos = _eh_log_ring_put(r, pos, &rec, sizeof(Eh_log_record));
+
+    if (label) {
+        pos = _eh_log_ring_put(r, pos, label, label_len);
+        pos = _eh_log_ring_put(r, pos, ": ", 2);
+    }
+
+    if (domain) {
+        pos = _eh_log_ring_put(r, pos, domain, domain_len);
+        pos = _eh_log_ring_put(r, pos, ": ", 2);
+    }
+
+    pos = _eh_log_ring_put(r, pos, message, len);
+    pos = _eh_log_ring_put(r, pos, "\n", 1);
+
+    g_atomic_int_set(&r->head, (gint)pos);
+}
+
+/* Write out everything that is in the rings.  Rings whose threads have
+   exited are freed once they are empty (unless they are at the front of
+   the list, where new rings are added).  Returns the number of messages
+   written. */
+static gint
+_eh_log_drain_rings(gchar* buf)
+{
+    Eh_log_ring* prev = NULL;
+    Eh_log_ring* r    = (Eh_log_ring*)g_atomic_pointer_get(&_eh_log_rings);
+    FILE*        last = NULL;
+    gint         n    = 0;
+
+    while (r) {
+        Eh_log_ring*   next = r->next;
+        const gboolean dead = g_atomic_int_get(&r->dead);
+        const guint    head = (guint)g_atomic_int_get(&r->head);
+        guint          tail = (guint)g_atomic_int_get(&r->tail);
+        Eh_log_record  rec;
+
+        while (tail != head) {
+            tail = _eh_log_ring_take(r, tail, &rec, sizeof(Eh_log_record));
+            tail = _eh_log_ring_take(r, tail, buf, rec.len);
+
+            g_atomic_int_set(&r->tail, (gint)tail);
+
+            if (last && rec.fp != last) {
+                fflush(last);
+            }
+
+            fwrite(buf, 1, rec.len, rec.fp);
+
+            last = rec.fp;
+            n   += 1;
+        }
+
+        if (dead && prev) {
+            prev->next = next;
+            eh_free(r);
+        } else {
+            prev = r;
+        }
+
+        r = next;
+    }
+
+    if (last) {
+        fflush(last);
+    }
+
+    return n;
+}
+
+static gpointer
+_eh_log_drain(gpointer data)
+{
+    gchar*   buf = eh_new(gchar, EH_LOG_RING_SIZE);
+    gboolean stop;
+
+    do {
+        /* Look for the stop flag first so that the last pass sees every
+           message logged before the drainer was stopped */
+        stop = g_atomic_int_get(&_eh_log_stop);
+
+        if (_eh_log_drain_rings(buf) == 0 && !stop) {
+            g_usleep(EH_LOG_DRAIN_USECS);
+        }
+
+        g_atomic_int_inc(&_eh_log_passes);
+    } while (!stop);
+
+    eh_free(buf);
+
+    return data;
+}
+
+/* Before a fork, write out what is queued so that the messages of the
+   parent come out before those of the child. */
+static void
+_eh_log_atfork_prepare(void)
+{
+    eh_log_async_flush();
+}
+
+/* The child of a fork has copies of the rings but not the drainer thread.
+   The messages in the copies are written by the parent, so drop them and
+   have the child write its messages itself. */
+static void
+_eh_log_atfork_child(void)
+{
+    if (_eh_log_running) {
+        Eh_log_ring* r;
+
+        for (r = _eh_log_rings ; r ; r = r->next) {
+            r->tail = r->head;
+        }
+
+        _eh_log_running = FALSE;
+        _eh_log_drainer = NULL;
+    }
+}
+
+/** Write log messages from a background thread
+
+After this is called, messages passed to eh_logger are queued by the
+thread that logs them and written by a drainer thread.  The drainer is
+stopped with eh_log_async_stop, which eh_exit calls, so that no messages
+are lost.  A process that is forked from this one writes its own messages.
+*/
+void
+eh_log_async_start(void)
+{
+    if (!g_atomic_int_get(&_eh_log_running)) {
+        static gboolean is_registered = FALSE;
+
+        g_atomic_int_set(&_eh_log_stop, FALSE);
+
+        _eh_log_drainer = g_thread_new("eh-log-drainer", &_eh_log_drain, NULL);
+
+        g_atomic_int_set(&_eh_log_running, TRUE);
+
+        if (!is_registered) {
+            atexit(&eh_log_async_stop);
+            pthread_atfork(&_eh_log_atfork_prepare, NULL, &_eh_log_atfork_child);
+            is_registered = TRUE;
+        }
+    }
+}
+
+/** Stop writing log messages from a background thread
+
+Any queued messages are written before this returns.  After that,
+eh_logger writes messages as they are logged.  Other threads should have
+stopped logging by the time this is called.
+*/
+void
+eh_log_async_stop(void)
+{
+    if (g_atomic_int_get(&_eh_log_running)) {
+        g_atomic_int_set(&_eh_log_running, FALSE);
+        g_atomic_int_set(&_eh_log_stop, TRUE);
+
+        g_thread_join(_eh_log_drainer);
+        _eh_log_drainer = NULL;
+    }
+}
+
+/** Wait for the queued log messages to be written
+
+This should be called before closing a file that messages are logged to.
+*/
+void
+eh_log_async_flush(void)
+{
+    if (g_atomic_int_get(&_eh_log_running)) {
+        const gint pass = g_atomic_int_get(&_eh_log_passes);
+
+        /* The pass after the current one starts after this call, and so
+           sees every message queued before it */
+        while (g_atomic_int_get(&_eh_log_passes) - pass < 2
+            && g_atomic_int_get(&_eh_log_running)) {
+            g_usleep(EH_LOG_DRAIN_USECS);
+        }
+    }
+}
+
+gboolean
+eh_log_async_is_running(void)
+{
+    return g_atomic_int_get(&_eh_log_running);
+}
+
 void
 eh_logger(const gchar*   log_domain,
     GLogLevelFlags log_level,
     const gchar*   message,
     gpointer       user_data)
 {
-    FILE** fp_list;
+    FILE*        err_list[2] = { stderr, NULL };
+    FILE**       fp_list;
     const gchar* warning_label = "Warning";
     const gchar* error_label = "Error";
     const gchar* log_label = NULL;
     gboolean is_fatal = (log_level & G_LOG_FLAG_FATAL) != 0;
+    gboolean is_async = eh_log_async_is_running();
     int i;
 
     if (eh_ignore_log_level & log_level) {
@@ -270,9 +611,7 @@ eh_logger(const gchar*   log_domain,
     if (user_data && !(log_level & G_LOG_LEVEL_DEBUG)) {
         fp_list = (FILE**)user_data;
     } else {
-        fp_list = eh_new(FILE*, 2);
-        fp_list[0] = stderr;
-        fp_list[1] = NULL;
+        fp_list = err_list;
     }
 
     if (log_level & G_LOG_LEVEL_WARNING) {
@@ -281,27 +620,19 @@ eh_logger(const gchar*   log_domain,
         log_label = error_label;
     }
 
-    for (i = 0 ; fp_list[i] != NULL ; i++) {
-        if (log_label) {
-            fprintf(fp_list[i], "%s: ", log_label);
-        }
+    if (log_level & EH_LOG_LEVEL_DATA) {
+        log_domain = NULL;
+    }
 
-        if (log_domain && !(log_level & EH_LOG_LEVEL_DATA)) {
-            fprintf(fp_list[i], "%s: ", log_domain);
+    for (i = 0 ; fp_list[i] != NULL ; i++) {
+        if (is_async) {
+            _eh_log_push(fp_list[i], log_label, log_domain, message);
+        } else {
+            _eh_log_write(fp_list[i], log_label, log_domain, message);
         }
-
-        fprintf(fp_list[i], "%s\n", message);
-
-        fflush(fp_list[i]);
     }
 
     if (is_fatal) {
         eh_exit(EXIT_FAILURE);
     }
-
-    if (!(user_data && !(log_level & G_LOG_LEVEL_DEBUG))) {
-        eh_free(fp_list);
-    }
 }
-
-
@@ -70,7 +70,25 @@ void eh_redirect_log(const char* log_file1, const char* log_file2);
 # define EH_LOG_DOMAIN ((gchar*)0)
 #endif
 
+// start writing log messages from a background thread.
+// return value : nothing.
+void eh_log_async_start(void);
+
+// stop writing log messages from a background thread.  queued messages
+// are written first.
+// return value : nothing.
+void eh_log_async_stop(void);
+
+// wait until the queued log messages have been written.
+// return value : nothing.
+void eh_log_async_flush(void);
+
+// are log messages being written from a background thread?
+// return value : TRUE if they are.
+gboolean eh_log_async_is_running(void);
+
 void eh_set_ignore_log_level(GLogLevelFlags ignore);
+gboolean eh_log_level_is_ignored(GLogLevelFlags level);
 gint eh_get_verbosity_level();
 GLogLevelFlags eh_set_verbosity_level(gint verbosity);
 void eh_logger(const gchar* log_domain,
@@ -78,65 +96,61 @@ void eh_logger(const gchar* log_domain,
     const gchar* message,
     gpointer user_data);
 #ifdef G_HAVE_ISO_VARARGS
-#define eh_message(...)  g_log( EH_LOG_DOMAIN ,       \
-    G_LOG_LEVEL_MESSAGE , \
-    __VA_ARGS__ )
-#define eh_info(...)     g_log( EH_LOG_DOMAIN ,    \
-    G_LOG_LEVEL_INFO , \
-    __VA_ARGS__ )
-#define eh_warning(...)  g_log( EH_LOG_DOMAIN ,       \
-    G_LOG_LEVEL_WARNING , \
-    __VA_ARGS__ )
+#define eh_message(...)  ( eh_log_level_is_ignored( G_LOG_LEVEL_MESSAGE ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , G_LOG_LEVEL_MESSAGE , __VA_ARGS__ ) )
+#define eh_info(...)     ( eh_log_level_is_ignored( G_LOG_LEVEL_INFO ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , G_LOG_LEVEL_INFO , __VA_ARGS__ ) )
+#define eh_warning(...)  ( eh_log_level_is_ignored( G_LOG_LEVEL_WARNING ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , G_LOG_LEVEL_WARNING , __VA_ARGS__ ) )
 #define eh_error(...)    g_log( EH_LOG_DOMAIN ,     \
     G_LOG_LEVEL_ERROR , \
     __VA_ARGS__ )
-#define eh_debug(...)    g_log( EH_LOG_DOMAIN ,     \
-    G_LOG_LEVEL_DEBUG , \
-    __VA_ARGS__ )
-#define eh_data(...)     g_log( EH_LOG_DOMAIN ,     \
-    EH_LOG_LEVEL_DATA , \
-    __VA_ARGS__ )
+#define eh_debug(...)    ( eh_log_level_is_ignored( G_LOG_LEVEL_DEBUG ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , G_LOG_LEVEL_DEBUG , __VA_ARGS__ ) )
+#define eh_data(...)     ( eh_log_level_is_ignored( EH_LOG_LEVEL_DATA ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , EH_LOG_LEVEL_DATA , __VA_ARGS__ ) )
 #elif defined(G_HAVE_GNUC_VARARGS)
-#define eh_message(format...)  g_log( EH_LOG_DOMAIN ,       \
-    G_LOG_LEVEL_MESSAGE , \
-    format )
-#define eh_info(format...)     g_log( EH_LOG_DOMAIN ,    \
-    G_LOG_LEVEL_INFO , \
-    format )
-#define eh_warning(format...)  g_log( EH_LOG_DOMAIN ,       \
-    G_LOG_LEVEL_WARNING , \
-    format )
+#define eh_message(format...)  ( eh_log_level_is_ignored( G_LOG_LEVEL_MESSAGE ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , G_LOG_LEVEL_MESSAGE , format ) )
+#define eh_info(format...)     ( eh_log_level_is_ignored( G_LOG_LEVEL_INFO ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , G_LOG_LEVEL_INFO , format ) )
+#define eh_warning(format...)  ( eh_log_level_is_ignored( G_LOG_LEVEL_WARNING ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , G_LOG_LEVEL_WARNING , format ) )
 #define eh_error(format...)    g_log( EH_LOG_DOMAIN ,     \
     G_LOG_LEVEL_ERROR , \
     format )
-#define eh_debug(format...)    g_log( EH_LOG_DOMAIN ,     \
-    G_LOG_LEVEL_DEBUG , \
-    format )
-#define eh_data(format...)     g_log( EH_LOG_DOMAIN ,     \
-    EH_LOG_LEVEL_DATA , \
-    format )
+#define eh_debug(format...)    ( eh_log_level_is_ignored( G_LOG_LEVEL_DEBUG ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , G_LOG_LEVEL_DEBUG , format ) )
+#define eh_data(format...)     ( eh_log_level_is_ignored( EH_LOG_LEVEL_DATA ) ? (void)0 : \
+    g_log( EH_LOG_DOMAIN , EH_LOG_LEVEL_DATA , format ) )
 #else
 static void eh_message(const char* format, ...)
 {
-    va_list args;
-    va_start(args, format);
-    g_logv(EH_LOG_DOMAIN, G_LOG_LEVEL_MESSAGE, format, args);
-    va_end(args);
+    if (!eh_log_level_is_ignored(G_LOG_LEVEL_MESSAGE)) {
+        va_list args;
+        va_start(args, format);
+        g_logv(EH_LOG_DOMAIN, G_LOG_LEVEL_MESSAGE, format, args);
+        va_end(args);
+    }
 }
 static void eh_info(const char* format, ...)
 {
-    va_list args;
-    va_start(args, format);
-    g_logv(EH_LOG_DOMAIN, G_LOG_LEVEL_INFO, format, args);
-    va_end(args);
+    if (!eh_log_level_is_ignored(G_LOG_LEVEL_INFO)) {
+        va_list args;
+        va_start(args, format);
+        g_logv(EH_LOG_DOMAIN, G_LOG_LEVEL_INFO, format, args);
+        va_end(args);
+    }
 }
 
 static void eh_warning(const char* format, ...)
 {
-    va_list args;
-    va_start(args, format);
-    g_logv(EH_LOG_DOMAIN, G_LOG_LEVEL_WARNING, format, args);
-    va_end(args);
+    if (!eh_log_level_is_ignored(G_LOG_LEVEL_WARNING)) {
+        va_list args;
+        va_start(args, format);
+        g_logv(EH_LOG_DOMAIN, G_LOG_LEVEL_WARNING, format, args);
+        va_end(args);
+    }
 }
 
 static void eh_error(const char* format, ...)
@@ -149,18 +163,22 @@ static void eh_error(const char* format, ...)
 
 static void eh_debug(const char* format, ...)
 {
-    va_list args;
-    va_start(args, format);
-    g_logv(EH_LOG_DOMAIN, G_LOG_LEVEL_DEBUG, format, args);
-    va_end(args);
+    if (!eh_log_level_is_ignored(G_LOG_LEVEL_DEBUG)) {
+        va_list args;
+        va_start(args, format);
+        g_logv(EH_LOG_DOMAIN, G_LOG_LEVEL_DEBUG, format, args);
+        va_end(args);
+    }
 }
 
 static void eh_data(const char* format, ...)
 {
-    va_list args;
-    va_start(args, format);
-    g_logv(EH_LOG_DOMAIN, EH_LOG_LEVEL_DATA, format, args);
-    va_end(args);
+    if (!eh_log_level_is_ignored(EH_LOG_LEVEL_DATA)) {
+        va_list args;
+        va_start(args, format);
+        g_logv(EH_LOG_DOMAIN, EH_LOG_LEVEL_DATA, format, args);
+        va_end(args);
+    }
 }
 #endif
 
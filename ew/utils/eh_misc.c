@@ -44,6 +44,8 @@ eh_init_glib(void)
 void
 eh_exit(int code)
 {
+    eh_log_async_stop();
+
     fprintf(stderr, "Exiting program.  ");
 
     //   fprintf( stderr , "Looking for memory leaks...\n" );
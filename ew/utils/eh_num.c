@@ -3290,11 +3290,27 @@ void
 eh_rebin_dbl_array_bad_val(double* x, double* y, gssize len,
     double* x_bin, double* y_bin, gssize len_bin,
     double bad_val)
+{
+    double* x_edge = eh_new(double, len + 1);
+
+    eh_rebin_dbl_array_bad_val_work(x, y, len, x_bin, y_bin, len_bin, bad_val,
+        x_edge);
+
+    eh_free(x_edge);
+}
+
+/* As eh_rebin_dbl_array_bad_val but with scratch space, x_edge, of at least
+   len+1 doubles supplied by the caller. */
+void
+eh_rebin_dbl_array_bad_val_work(double* x, double* y, gssize len,
+    double* x_bin, double* y_bin, gssize len_bin,
+    double bad_val, double* x_edge)
 {
     eh_require(x);
     eh_require(y);
     eh_require(x_bin);
     eh_require(y_bin);
+    eh_require(x_edge);
     //eh_require( len>2 );
     //eh_require( len_bin>2 );
 
@@ -3303,7 +3319,6 @@ eh_rebin_dbl_array_bad_val(double* x, double* y, gssize len,
         gint top_i, top_j, lower_j, upper_j;
         double left_bin, right_bin, lower, upper, upper_bin, lower_bin;
         double sum;
-        double* x_edge;
 
         eh_require(eh_dbl_array_is_monotonic_up(x, len));
         eh_require(eh_dbl_array_is_monotonic_up(x_bin, len_bin));
@@ -3320,7 +3335,6 @@ eh_rebin_dbl_array_bad_val(double* x, double* y, gssize len,
         upper     = x[top_j]     + (x[top_j]     - x[top_j - 1]) * .5;
 
         { /* Define the edges of the data */
-            x_edge      = eh_new(double, len + 1);
             x_edge[0]   = x[0] - (x[1] - x[0]) * .5;
             x_edge[len] = x[top_j] + (x[top_j] - x[top_j - 1]) * .5;
 
@@ -3398,7 +3412,6 @@ eh_rebin_dbl_array_bad_val(double* x, double* y, gssize len,
             y_bin[i] = sum;
         }
 
-        eh_free(x_edge);
     }
 
     return;
@@ -198,6 +198,9 @@ void eh_rebin_dbl_array(double* x, double* y, gssize len,
 void eh_rebin_dbl_array_bad_val(double* x, double* y, gssize len,
     double* x_bin, double* y_bin, gssize len_bin,
     double bad_val);
+void eh_rebin_dbl_array_bad_val_work(double* x, double* y, gssize len,
+    double* x_bin, double* y_bin, gssize len_bin,
+    double bad_val, double* x_edge);
 
 typedef enum {
     EH_NUM_IMPLICIT,
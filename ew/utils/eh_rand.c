@@ -445,6 +445,308 @@ eh_maxpowdev(double a, double n, long* idum)
     return log(1 - pow(dum, 1. / n)) / log(a);
 }
 
+/** \defgroup rand_stream_group Counter-based random number streams
+@{
+*/
+
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+
+/* Philox-4x32-10 of Salmon et al. (2011).  Encrypt the counter, \a ctr, with
+   \a key and put the resulting four words into \a out. */
+static inline void
+_eh_philox_4x32_10(const guint32 ctr[4], const guint32 key[2], guint32 out[4])
+{
+    guint32 c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    guint32 k0 = key[0], k1 = key[1];
+    gint r;
+
+    for (r = 0 ; r < 10 ; r++) {
+        const guint64 p0 = (guint64)PHILOX_M0 * c0;
+        const guint64 p1 = (guint64)PHILOX_M1 * c2;
+
+        c0 = (guint32)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (guint32)p1;
+        c2 = (guint32)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (guint32)p0;
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+#undef PHILOX_M0
+#undef PHILOX_M1
+#undef PHILOX_W0
+#undef PHILOX_W1
+
+/* A double in [0,1) with 53 random bits. */
+static inline double
+_eh_rand_words_to_double(guint32 hi, guint32 lo)
+{
+    return ((hi >> 5) * 67108864. + (lo >> 6)) * (1. / 9007199254740992.);
+}
+
+static inline guint32
+_eh_rand_next_word(Eh_rand* rand)
+{
+    if (rand->n_buf == 0) {
+        _eh_philox_4x32_10(rand->ctr, rand->key, rand->buf);
+        rand->ctr[0] += 1;
+        rand->n_buf   = 4;
+    }
+
+    return rand->buf[4 - (rand->n_buf--)];
+}
+
+/* The distributions below accept a NULL stream, in which case they fall
+   back to the global GLib generator (as they always have). */
+static inline double
+_eh_rand_uniform(Eh_rand* rand)
+{
+    return rand ? eh_rand_double(rand) : g_random_double();
+}
+
+/** Create a random number stream seeded from the system
+
+\return A new Eh_rand.  Use eh_rand_destroy to free.
+*/
+Eh_rand*
+eh_rand_new(void)
+{
+    guint64 seed = ((guint64)g_random_int() << 32) | g_random_int();
+    return eh_rand_new_with_seed(seed);
+}
+
+/** Create a random number stream for a run seed
+
+\param seed  The run seed
+
+\return A new Eh_rand.  Use eh_rand_destroy to free.
+*/
+Eh_rand*
+eh_rand_new_with_seed(guint64 seed)
+{
+    return eh_rand_init(eh_new(Eh_rand, 1), seed);
+}
+
+/** Initialize a random number stream
+
+The stream is positioned at the start of process 0, column 0, step 0.
+
+\param rand  An (uninitialized) Eh_rand
+\param seed  The run seed
+
+\return \a rand
+*/
+Eh_rand*
+eh_rand_init(Eh_rand* rand, guint64 seed)
+{
+    eh_require(rand);
+
+    rand->key[0] = (guint32)(seed & G_MAXUINT32);
+    rand->key[1] = (guint32)(seed >> 32);
+
+    return eh_rand_set_stream(rand, 0, 0, 0);
+}
+
+/** Copy a random number stream
+
+The copy will produce the same sequence of numbers as the original.
+
+\param rand  An Eh_rand
+
+\return A new Eh_rand
+*/
+Eh_rand*
+eh_rand_copy(const Eh_rand* rand)
+{
+    Eh_rand* dup = NULL;
+
+    if (rand) {
+        dup = eh_new(Eh_rand, 1);
+        memcpy(dup, rand, sizeof(Eh_rand));
+    }
+
+    return dup;
+}
+
+Eh_rand*
+eh_rand_destroy(Eh_rand* rand)
+{
+    eh_free(rand);
+    return NULL;
+}
+
+/** Move to the start of a new stream
+
+Every (process, column, step) triple names its own stream of
+2<sup>34</sup> words.  Positioning a generator with this function before
+drawing makes the numbers independent of the order that streams are visited.
+
+\param rand     An Eh_rand
+\param process  Identifier for the process that is drawing numbers
+\param column   Identifier for the column (or any other sub-stream)
+\param step     The time step
+
+\return \a rand
+*/
+Eh_rand*
+eh_rand_set_stream(Eh_rand* rand, guint32 process, guint32 column,
+    guint32 step)
+{
+    eh_require(rand);
+
+    rand->ctr[0]     = 0;
+    rand->ctr[1]     = step;
+    rand->ctr[2]     = column;
+    rand->ctr[3]     = process;
+    rand->n_buf      = 0;
+    rand->has_normal = FALSE;
+    rand->normal     = 0.;
+
+    return rand;
+}
+
+guint64
+eh_rand_seed(const Eh_rand* rand)
+{
+    eh_require(rand);
+    return ((guint64)rand->key[1] << 32) | rand->key[0];
+}
+
+/** A random integer uniformly distributed over [0,2<sup>32</sup>)
+*/
+guint32
+eh_rand_int(Eh_rand* rand)
+{
+    return _eh_rand_next_word(rand);
+}
+
+/** A random integer uniformly distributed over [\a begin, \a end)
+*/
+gint32
+eh_rand_int_range(Eh_rand* rand, gint32 begin, gint32 end)
+{
+    const guint64 len = (guint64)((gint64)end - begin);
+
+    eh_require(end > begin);
+
+    return begin + (gint32)((len * _eh_rand_next_word(rand)) >> 32);
+}
+
+gboolean
+eh_rand_boolean(Eh_rand* rand)
+{
+    return (_eh_rand_next_word(rand) & 1) ? TRUE : FALSE;
+}
+
+/** A random number uniformly distributed over [0,1)
+*/
+double
+eh_rand_double(Eh_rand* rand)
+{
+    const guint32 hi = _eh_rand_next_word(rand);
+    const guint32 lo = _eh_rand_next_word(rand);
+
+    return _eh_rand_words_to_double(hi, lo);
+}
+
+/** A random number uniformly distributed over [\a begin, \a end)
+*/
+double
+eh_rand_double_range(Eh_rand* rand, double begin, double end)
+{
+    return begin + (end - begin) * eh_rand_double(rand);
+}
+
+/** Fill an array with uniform random numbers
+
+The numbers are identical to those of \a n calls to eh_rand_double but
+whole blocks are generated directly into \a x.  Each block only depends on
+its own counter so the main loop carries no state from one iteration to the
+next.
+
+\param rand  An Eh_rand
+\param x     Array to fill
+\param n     Length of \a x
+
+\return \a x
+*/
+double*
+eh_rand_fill_double(Eh_rand* rand, double* x, gsize n)
+{
+    gsize i = 0;
+
+    eh_require(rand);
+    eh_require(x || n == 0);
+
+    // Use up what is left of the current block.
+    for (; i < n && rand->n_buf > 0 ; i++) {
+        x[i] = eh_rand_double(rand);
+    }
+
+    if (i + 1 < n) {
+        const gsize   n_blocks = (n - i) / 2;
+        const guint32 first    = rand->ctr[0];
+        gsize         k;
+
+        for (k = 0 ; k < n_blocks ; k++) {
+            guint32 ctr[4] = { first + (guint32)k, rand->ctr[1], rand->ctr[2], rand->ctr[3] };
+            guint32 b[4];
+
+            _eh_philox_4x32_10(ctr, rand->key, b);
+
+            x[i + 2 * k]     = _eh_rand_words_to_double(b[0], b[1]);
+            x[i + 2 * k + 1] = _eh_rand_words_to_double(b[2], b[3]);
+        }
+
+        rand->ctr[0] = first + (guint32)n_blocks;
+        i += 2 * n_blocks;
+    }
+
+    for (; i < n ; i++) {
+        x[i] = eh_rand_double(rand);
+    }
+
+    return x;
+}
+
+/** Fill an array with normally distributed random numbers
+
+\param rand   An Eh_rand
+\param x      Array to fill
+\param n      Length of \a x
+\param mu     Mean of normal distribution
+\param sigma  Standard deviation of normal distribution
+
+\return \a x
+*/
+double*
+eh_rand_fill_normal(Eh_rand* rand, double* x, gsize n, double mu,
+    double sigma)
+{
+    gsize i;
+
+    eh_require(rand);
+    eh_require(x || n == 0);
+
+    for (i = 0 ; i < n ; i++) {
+        x[i] = eh_rand_normal(rand, mu, sigma);
+    }
+
+    return x;
+}
+
+/* @} */
+
 /** \defgroup rand_group Random number distributions
 @{
 */
@@ -457,18 +759,18 @@ Pick a random number from an exponential distribution with mean, \a mu.
    f(x) = {1\over \mu}e^{-{x\over\mu}}
 \f]
 
-\param rand  A GRand
+\param rand  An Eh_rand
 \param mu    The scale parameter of the distribution
 
 \return A random number
 */
 double
-eh_rand_exponential(GRand* rand, double mu)
+eh_rand_exponential(Eh_rand* rand, double mu)
 {
     double dum;
 
     do {
-        dum = g_rand_double(rand);
+        dum = _eh_rand_uniform(rand);
     } while (dum == 0.);
 
     return - mu * log(dum);
@@ -478,19 +780,19 @@ eh_rand_exponential(GRand* rand, double mu)
 
 The maximum of a series of numbers drawn from an exponential distribution
 
-\param rand A GRand
+\param rand An Eh_rand
 \param mu   Mean of the distribution
 \param n    The number of numbers picked
 
 \return A random number
 */
 double
-eh_rand_max_exponential(GRand* rand, double mu, double n)
+eh_rand_max_exponential(Eh_rand* rand, double mu, double n)
 {
     double dum;
 
     do {
-        dum = g_rand_double(rand);
+        dum = _eh_rand_uniform(rand);
     } while (pow(dum, 1. / n) == 1.);
 
 
@@ -506,14 +808,14 @@ Pick a random number from a log-normal distribution with mean, \a mu and standar
    f(x) = {1 \over \sigma \sqrt{2 \pi} } e^{ \left(\log\left( x-\mu \right)\right)^2 \over 2 \sigma^2 }
 \f]
 
-\param rand  A GRand
+\param rand  An Eh_rand
 \param mu    The scale parameter of the distribution
 \param sigma The shape parameter of the distribution
 
 \return A random number
 */
 double
-eh_log_normal(GRand* rand, double mu, double sigma)
+eh_log_normal(Eh_rand* rand, double mu, double sigma)
 {
     return exp(eh_rand_normal(rand, mu, sigma));
 }
@@ -522,7 +824,7 @@ eh_log_normal(GRand* rand, double mu, double sigma)
 
 The maximum of a series of numbers drawn from a log-normal distribution
 
-\param rand  A GRand
+\param rand  An Eh_rand
 \param mu    The scale parameter
 \param sigma The shape parameter
 \param n     The number of numbers picked
@@ -530,14 +832,14 @@ The maximum of a series of numbers drawn from a log-normal distribution
 \return A random number
 */
 double
-eh_max_log_normal(GRand* rand, double mu, double sigma, double n)
+eh_max_log_normal(Eh_rand* rand, double mu, double sigma, double n)
 {
     double eh_ran2(long * idum);
     double dum;
 
     do {
         //      dum=eh_ran2(idum);
-        dum = g_rand_double(rand);
+        dum = _eh_rand_uniform(rand);
         //      dum = ((double)random())/((double)G_MAXINT);
     } while (fabs(2 * (pow(dum, 1. / n) - .5)) >= 1. - 1e-12);
 
@@ -554,19 +856,19 @@ scale parameter \a eta.
           e^{-\left( {x \over \eta} \right)^\beta }
 \f]
 
-\param rand A GRand
+\param rand An Eh_rand
 \param eta  Scale parameter
 \param beta Shape parameter
 
 \return A random number
 */
 double
-eh_rand_weibull(GRand* rand, double eta, double beta)
+eh_rand_weibull(Eh_rand* rand, double eta, double beta)
 {
     double dum;
 
     do {
-        dum = g_rand_double(rand);
+        dum = _eh_rand_uniform(rand);
     } while (dum == 0);
 
     return eta * pow(-log(dum), 1. / beta);
@@ -576,7 +878,7 @@ eh_rand_weibull(GRand* rand, double eta, double beta)
 
 The maximum of a series of numbers drawn from a Weibull distribution.
 
-\param rand A GRand
+\param rand An Eh_rand
 \param beta Shape parameter
 \param eta  Scale parameter
 \param n    The number of numbers picked
@@ -584,14 +886,14 @@ The maximum of a series of numbers drawn from a Weibull distribution.
 \return A random number
 */
 double
-eh_rand_max_weibull(GRand* rand, double eta, double beta, double n)
+eh_rand_max_weibull(Eh_rand* rand, double eta, double beta, double n)
 {
     double dum;
     double z;
     double ans;
 
     do {
-        dum = g_rand_double(rand);
+        dum = _eh_rand_uniform(rand);
         z = pow(dum, 1. / n);
     } while (dum == 1.);
 
@@ -612,7 +914,7 @@ eh_rand_max_weibull(GRand* rand, double eta, double beta, double n)
 
 Pick a random number from a user defined distribution function.
 
-\param rand A GRand
+\param rand An Eh_rand
 \param x    x-values of the user-defined CDF
 \param F    F-values of the user-defined CDF
 \param len  Length of \a x and \a y
@@ -620,9 +922,9 @@ Pick a random number from a user defined distribution function.
 \return A random number
 */
 double
-eh_rand_user(GRand* rand, double* x, double* F, gssize len)
+eh_rand_user(Eh_rand* rand, double* x, double* F, gssize len)
 {
-    double ans, u = g_rand_double(rand);
+    double ans, u = _eh_rand_uniform(rand);
     interpolate(F, x, len,  &u, &ans, 1);
     return ans;
 }
@@ -636,42 +938,39 @@ Pick a random number from a normal distribution with mean \a mu, and standard de
    f(x) = {1 \over \sigma \sqrt{2 \pi} } e^{ \left( x-\mu \right)^2 \over 2 \sigma^2 }
 \f]
 
-\param rand  A GRand
+\param rand  An Eh_rand
 \param mu    Mean of normal distribution
 \param sigma Standard deviation of normal distribution
 
 \return A random number
 */
 double
-eh_rand_normal(GRand* rand, double mu, double sigma)
+eh_rand_normal(Eh_rand* rand, double mu, double sigma)
 {
-    static gboolean iset = FALSE;
-    static double gset;
     double fac, rsq, v1, v2;
 
     eh_require(sigma > 0);
 
-    if (iset == 0) {
-        do {
-            if (rand) {
-                v1 = 2.0 * g_rand_double(rand) - 1.;
-                v2 = 2.0 * g_rand_double(rand) - 1.;
-            } else {
-                v1 = 2.0 * g_random_double() - 1.;
-                v2 = 2.0 * g_random_double() - 1.;
-            }
+    if (rand && rand->has_normal) {
+        rand->has_normal = FALSE;
+        return rand->normal * sigma + mu;
+    }
 
-            rsq = v1 * v1 + v2 * v2;
-        } while (rsq >= 1.0 || rsq == 0.0);
+    do {
+        v1 = 2.0 * _eh_rand_uniform(rand) - 1.;
+        v2 = 2.0 * _eh_rand_uniform(rand) - 1.;
 
-        fac = sqrt(-2.0 * log(rsq) / rsq);
-        gset = v1 * fac;
-        iset = TRUE;
-        return v2 * fac * sigma + mu;
-    } else {
-        iset = FALSE;
-        return gset * sigma + mu;
+        rsq = v1 * v1 + v2 * v2;
+    } while (rsq >= 1.0 || rsq == 0.0);
+
+    fac = sqrt(-2.0 * log(rsq) / rsq);
+
+    if (rand) {
+        rand->normal     = v1 * fac;
+        rand->has_normal = TRUE;
     }
+
+    return v2 * fac * sigma + mu;
 }
 
 double
@@ -52,14 +52,52 @@ double eh_maxpowdev(double, double, long*);
 double eh_gasdev(long*);
 double eh_reject(double (*)(double), double (*)(double), double (*)(double));
 
-double eh_rand_exponential(GRand* rand, double);
-double eh_rand_max_exponential(GRand* rand, double mean, double n);
-double eh_log_normal(GRand* rand, double mean, double std);
-double eh_max_log_normal(GRand* rand, double mean, double std, double n);
-double eh_rand_weibull(GRand* rand, double eta, double beta);
-double eh_rand_max_weibull(GRand* rand, double eta, double beta, double n);
-double eh_rand_normal(GRand* rand, double mu, double sigma);
-double eh_rand_user(GRand* rand, double* x, double* F, gssize len);
+/** A counter-based random number stream.
+
+Numbers are generated a block of four 32-bit words at a time by applying the
+Philox-4x32-10 bijection to the counter (block, step, column, process) under
+a key made from the run seed.  A draw depends only on these coordinates and
+not on how many numbers other streams have drawn, so columns and processes
+can be visited in any order (or in parallel) and still see the same numbers.
+
+An Eh_rand is small enough to live on the stack; use eh_rand_init to set one
+up without allocating.
+*/
+typedef struct {
+    guint32  key[2];    ///< Run seed
+    guint32  ctr[4];    ///< Block, step, column and process
+    guint32  buf[4];    ///< The current block of random words
+    gint     n_buf;     ///< Number of unused words left in \a buf
+    gboolean has_normal;///< A second normal deviate is waiting in \a normal
+    double   normal;
+} Eh_rand;
+
+Eh_rand* eh_rand_new(void);
+Eh_rand* eh_rand_new_with_seed(guint64 seed);
+Eh_rand* eh_rand_init(Eh_rand* rand, guint64 seed);
+Eh_rand* eh_rand_copy(const Eh_rand* rand);
+Eh_rand* eh_rand_destroy(Eh_rand* rand);
+Eh_rand* eh_rand_set_stream(Eh_rand* rand, guint32 process, guint32 column,
+    guint32 step);
+guint64  eh_rand_seed(const Eh_rand* rand);
+
+guint32  eh_rand_int(Eh_rand* rand);
+gint32   eh_rand_int_range(Eh_rand* rand, gint32 begin, gint32 end);
+gboolean eh_rand_boolean(Eh_rand* rand);
+double   eh_rand_double(Eh_rand* rand);
+double   eh_rand_double_range(Eh_rand* rand, double begin, double end);
+double*  eh_rand_fill_double(Eh_rand* rand, double* x, gsize n);
+double*  eh_rand_fill_normal(Eh_rand* rand, double* x, gsize n, double mu,
+    double sigma);
+
+double eh_rand_exponential(Eh_rand* rand, double);
+double eh_rand_max_exponential(Eh_rand* rand, double mean, double n);
+double eh_log_normal(Eh_rand* rand, double mean, double std);
+double eh_max_log_normal(Eh_rand* rand, double mean, double std, double n);
+double eh_rand_weibull(Eh_rand* rand, double eta, double beta);
+double eh_rand_max_weibull(Eh_rand* rand, double eta, double beta, double n);
+double eh_rand_normal(Eh_rand* rand, double mu, double sigma);
+double eh_rand_user(Eh_rand* rand, double* x, double* F, gssize len);
 
 double    eh_get_fuzzy_dbl(double min, double max);
 double    eh_get_fuzzy_dbl_norm(double mean, double std);
@@ -0,0 +1,286 @@
+#include <eh_utils.h>
+
+/* Interpolation weights along one axis of a grid.  Destination element k
+   is the sum over p = ptr[k], ..., ptr[k+1]-1 of w[p] times source element
+   ind[p]. */
+typedef struct {
+    gint*   ptr;
+    gint*   ind;
+    double* w;
+}
+Eh_remesh_axis;
+
+/** Separable interpolation from one grid shape to another
+
+The weights along each axis are calculated once, when the Eh_remesh is
+created.  A source grid is then remeshed in two passes.  The first
+interpolates each source row onto the destination columns.  The second
+builds each destination row from a weighted sum of those rows.  Both passes
+run over contiguous memory and nothing is allocated while they run.
+
+The intermediate rows are kept with the Eh_remesh.  Because of that, an
+Eh_remesh must not be applied from more than one thread at a time.
+*/
+CLASS(Eh_remesh)
+{
+    Eh_remesh_mode mode;     //< Bilinear or conservative interpolation
+    gint           src_n_x;  //< Number of rows of the source grid
+    gint           src_n_y;  //< Number of columns of the source grid
+    gint           dest_n_x; //< Number of rows of the destination grid
+    gint           dest_n_y; //< Number of columns of the destination grid
+    Eh_remesh_axis x;        //< Weights for the rows
+    Eh_remesh_axis y;        //< Weights for the columns
+    double*        temp;     //< Source rows interpolated onto the destination columns
+};
+
+/* Linear interpolation weights.  The end points of the two axes line up,
+   and the destination points are evenly spaced between them. */
+static void
+_eh_remesh_axis_bilinear(Eh_remesh_axis* a, gint n, gint m)
+{
+    gint k, p = 0;
+
+    a->ptr = eh_new(gint, m + 1);
+    a->ind = eh_new(gint, 2 * m);
+    a->w   = eh_new(double, 2 * m);
+
+    for (k = 0 ; k < m ; k++) {
+        const double pos = (m > 1) ? k * (n - 1.) / (m - 1.) : 0.;
+        gint         lo  = (gint)floor(pos);
+        double       f;
+
+        lo = eh_min(lo, n - 2);
+        lo = eh_max(lo, 0);
+        f  = (n > 1) ? pos - lo : 0.;
+
+        a->ptr[k] = p;
+
+        if (f < 1.) {
+            a->ind[p] = lo;
+            a->w[p]   = 1. - f;
+            p++;
+        }
+
+        if (f > 0.) {
+            a->ind[p] = lo + 1;
+            a->w[p]   = f;
+            p++;
+        }
+    }
+
+    a->ptr[m] = p;
+}
+
+/* Area weights.  Each destination cell is the average of the source cells
+   that it overlaps, so that the sum of the cells times their width is the
+   same for both axes. */
+static void
+_eh_remesh_axis_conservative(Eh_remesh_axis* a, gint n, gint m)
+{
+    const double width = n / (double)m;
+    const gint   max_p = n + m;
+    gint         k, p = 0;
+
+    a->ptr = eh_new(gint, m + 1);
+    a->ind = eh_new(gint, max_p);
+    a->w   = eh_new(double, max_p);
+
+    for (k = 0 ; k < m ; k++) {
+        const double lo = k * width;
+        const double hi = (k + 1 == m) ? n : (k + 1) * width;
+        gint         j;
+
+        a->ptr[k] = p;
+
+        for (j = (gint)floor(lo) ; j < n && j < hi ; j++) {
+            const double overlap = eh_min(hi, j + 1.) - eh_max(lo, (double)j);
+
+            if (overlap > 0. && p < max_p) {
+                a->ind[p] = j;
+                a->w[p]   = overlap / (hi - lo);
+                p++;
+            }
+        }
+    }
+
+    a->ptr[m] = p;
+}
+
+static void
+_eh_remesh_axis_free(Eh_remesh_axis* a)
+{
+    eh_free(a->ptr);
+    eh_free(a->ind);
+    eh_free(a->w);
+}
+
+/** Create an Eh_remesh
+
+\param src_n_x   Number of rows of the source grid
+\param src_n_y   Number of columns of the source grid
+\param dest_n_x  Number of rows of the destination grid
+\param dest_n_y  Number of columns of the destination grid
+\param mode      EH_REMESH_BILINEAR to interpolate linearly between source
+                 elements, or EH_REMESH_CONSERVATIVE to average the source
+                 cells that each destination cell overlaps (which preserves
+                 the integral of the grid)
+
+\return A new Eh_remesh.  Should be destroyed with eh_remesh_destroy.
+*/
+Eh_remesh
+eh_remesh_new(gint src_n_x, gint src_n_y, gint dest_n_x, gint dest_n_y,
+    Eh_remesh_mode mode)
+{
+    Eh_remesh r;
+
+    eh_return_val_if_fail(src_n_x > 0 && src_n_y > 0, NULL);
+    eh_return_val_if_fail(dest_n_x > 0 && dest_n_y > 0, NULL);
+
+    NEW_OBJECT(Eh_remesh, r);
+
+    r->mode     = mode;
+    r->src_n_x  = src_n_x;
+    r->src_n_y  = src_n_y;
+    r->dest_n_x = dest_n_x;
+    r->dest_n_y = dest_n_y;
+    r->temp     = eh_new(double, src_n_x * dest_n_y);
+
+    if (mode == EH_REMESH_CONSERVATIVE) {
+        _eh_remesh_axis_conservative(&r->x, src_n_x, dest_n_x);
+        _eh_remesh_axis_conservative(&r->y, src_n_y, dest_n_y);
+    } else {
+        _eh_remesh_axis_bilinear(&r->x, src_n_x, dest_n_x);
+        _eh_remesh_axis_bilinear(&r->y, src_n_y, dest_n_y);
+    }
+
+    return r;
+}
+
+Eh_remesh
+eh_remesh_destroy(Eh_remesh r)
+{
+    if (r) {
+        _eh_remesh_axis_free(&r->x);
+        _eh_remesh_axis_free(&r->y);
+        eh_free(r->temp);
+        eh_free(r);
+    }
+
+    return NULL;
+}
+
+/** Does an Eh_remesh map between grids of the given shapes?
+
+\return TRUE if \a r remeshes a \a src_n_x by \a src_n_y grid onto a
+        \a dest_n_x by \a dest_n_y grid
+*/
+gboolean
+eh_remesh_is_shape(Eh_remesh r, gint src_n_x, gint src_n_y, gint dest_n_x,
+    gint dest_n_y)
+{
+    return r
+        && r->src_n_x  == src_n_x  && r->src_n_y  == src_n_y
+        && r->dest_n_x == dest_n_x && r->dest_n_y == dest_n_y;
+}
+
+/** Remesh an array of grid data
+
+\param r     An Eh_remesh
+\param src   Source data, listed row by row
+\param dest  Location to put the remeshed data, listed row by row
+
+\return \a dest
+*/
+double*
+eh_remesh_apply_data(Eh_remesh r, const double* src, double* dest)
+{
+    eh_require(r);
+    eh_require(src);
+    eh_require(dest);
+
+    if (r && src && dest) {
+        const gint     n_x = r->src_n_x;
+        const gint     n_y = r->dest_n_y;
+        const gint*    ptr;
+        const gint*    ind;
+        const double*  w;
+        gint           i, k, p;
+
+        { /* Interpolate each source row onto the destination columns */
+            ptr = r->y.ptr;
+            ind = r->y.ind;
+            w   = r->y.w;
+
+            for (i = 0 ; i < n_x ; i++) {
+                const double* row = src + i * r->src_n_y;
+                double*       t   = r->temp + i * n_y;
+
+                for (k = 0 ; k < n_y ; k++) {
+                    double sum = 0.;
+
+                    for (p = ptr[k] ; p < ptr[k + 1] ; p++) {
+                        sum += w[p] * row[ind[p]];
+                    }
+
+                    t[k] = sum;
+                }
+            }
+        }
+
+        { /* Combine the interpolated rows into the destination rows */
+            ptr = r->x.ptr;
+            ind = r->x.ind;
+            w   = r->x.w;
+
+            for (k = 0 ; k < r->dest_n_x ; k++) {
+                double* row = dest + k * n_y;
+                gint    j;
+
+                memset(row, 0, sizeof(double) * n_y);
+
+                for (p = ptr[k] ; p < ptr[k + 1] ; p++) {
+                    const double  a = w[p];
+                    const double* t = r->temp + ind[p] * n_y;
+
+                    #pragma omp simd
+                    for (j = 0 ; j < n_y ; j++) {
+                        row[j] += a * t[j];
+                    }
+                }
+            }
+        }
+    }
+
+    return dest;
+}
+
+/** Remesh a grid
+
+Remesh the data of \a src onto \a dest.  The x and y values of \a dest are
+left as they are.
+
+\param r     An Eh_remesh
+\param src   An Eh_dbl_grid with the source shape of \a r
+\param dest  An Eh_dbl_grid with the destination shape of \a r
+
+\return \a dest
+*/
+Eh_dbl_grid
+eh_remesh_apply(Eh_remesh r, Eh_dbl_grid src, Eh_dbl_grid dest)
+{
+    eh_require(r);
+    eh_require(src);
+    eh_require(dest);
+
+    if (r && src && dest) {
+        eh_require(eh_grid_n_x(src)  == r->src_n_x);
+        eh_require(eh_grid_n_y(src)  == r->src_n_y);
+        eh_require(eh_grid_n_x(dest) == r->dest_n_x);
+        eh_require(eh_grid_n_y(dest) == r->dest_n_y);
+
+        eh_remesh_apply_data(r, eh_dbl_grid_data_start(src),
+            eh_dbl_grid_data_start(dest));
+    }
+
+    return dest;
+}
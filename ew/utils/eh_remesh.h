@@ -0,0 +1,31 @@
+#ifndef __EH_REMESH_H__
+#define __EH_REMESH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <glib.h>
+#include <utils/eh_types.h>
+#include <utils/eh_grid.h>
+
+new_handle(Eh_remesh);
+
+typedef enum {
+    EH_REMESH_BILINEAR,
+    EH_REMESH_CONSERVATIVE
+}
+Eh_remesh_mode;
+
+Eh_remesh   eh_remesh_new(gint src_n_x, gint src_n_y, gint dest_n_x,
+                          gint dest_n_y, Eh_remesh_mode mode);
+Eh_remesh   eh_remesh_destroy(Eh_remesh r);
+gboolean    eh_remesh_is_shape(Eh_remesh r, gint src_n_x, gint src_n_y,
+                               gint dest_n_x, gint dest_n_y);
+double*     eh_remesh_apply_data(Eh_remesh r, const double* src, double* dest);
+Eh_dbl_grid eh_remesh_apply(Eh_remesh r, Eh_dbl_grid src, Eh_dbl_grid dest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+#include <eh_utils.h>
+
+/** A piecewise-linear curve that is sampled at increasing times
+
+The x-values are checked once, when the curve is created.  Each evaluation
+starts its search from the segment that was used last, so a curve that is
+sampled at steadily increasing (or repeated) times costs O(1) per sample.
+Any other sample falls back to a binary search.
+
+Because of the cursor, an Eh_time_series must not be evaluated from more
+than one thread at a time.
+*/
+CLASS(Eh_time_series)
+{
+    double* x;      //< Monotonically increasing x-values
+    double* y;      //< y-values at each x-value
+    double* m;      //< Slope of each segment
+    gint    len;    //< Length of \a x and \a y
+    gint    cursor; //< Segment that was used for the last evaluation
+};
+
+GQuark
+eh_time_series_error_quark(void)
+{
+    return g_quark_from_static_string("eh-time-series-error-quark");
+}
+
+/** Create an Eh_time_series
+
+The data are copied.
+
+\param x   Monotonically increasing x-values
+\param y   y-values at each x-value
+\param len Length of \a x and \a y
+\param err Location of a GError to indicate and error (or NULL)
+
+\return A new Eh_time_series, or NULL if an error occured.  Should be
+        destroyed with eh_time_series_destroy.
+*/
+Eh_time_series
+eh_time_series_new(const double* x, const double* y, gint len, GError** err)
+{
+    Eh_time_series ts = NULL;
+
+    eh_return_val_if_fail(err == NULL || *err == NULL, NULL);
+
+    if (len < 1 || !x || !y) {
+        g_set_error(err, EH_TIME_SERIES_ERROR, EH_TIME_SERIES_ERROR_EMPTY,
+            "A time series needs at least one point");
+    } else if (!eh_dbl_array_is_monotonic_up((double*)x, len)) {
+        g_set_error(err, EH_TIME_SERIES_ERROR, EH_TIME_SERIES_ERROR_X_NOT_MONOTONIC,
+            "x values must be monotonically increasing");
+    } else {
+        gint i;
+
+        NEW_OBJECT(Eh_time_series, ts);
+
+        ts->len    = len;
+        ts->cursor = 0;
+        ts->x      = eh_new(double, len);
+        ts->y      = eh_new(double, len);
+        ts->m      = eh_new(double, len);
+
+        memcpy(ts->x, x, sizeof(double) * len);
+        memcpy(ts->y, y, sizeof(double) * len);
+
+        for (i = 0 ; i < len - 1 ; i++) {
+            ts->m[i] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+        }
+
+        ts->m[len - 1] = 0.;
+    }
+
+    return ts;
+}
+
+Eh_time_series
+eh_time_series_destroy(Eh_time_series ts)
+{
+    if (ts) {
+        eh_free(ts->x);
+        eh_free(ts->y);
+        eh_free(ts->m);
+        eh_free(ts);
+    }
+
+    return NULL;
+}
+
+/* Is x_new within segment i?  Like interpolate, a point that lies on the
+   boundary between two segments belongs to the lower one. */
+static gboolean
+_eh_time_series_in_segment(Eh_time_series ts, gint i, double x_new)
+{
+    return i >= 0 && i < ts->len - 1
+        && (i == 0 || x_new > ts->x[i])
+        && x_new <= ts->x[i + 1];
+}
+
+/** Evaluate an Eh_time_series
+
+Values are linearly interpolated.  The result is the same as that of
+interpolate_bad_val with a single point.
+
+\param ts      An Eh_time_series
+\param x_new   The x-value to evaluate the curve at
+\param bad_val Value to return if \a x_new is outside of the curve
+
+\return The value of the curve at \a x_new
+*/
+double
+eh_time_series_eval_bad_val(Eh_time_series ts, double x_new, double bad_val)
+{
+    const double* x = ts->x;
+    const gint    len = ts->len;
+    gint          i;
+
+    if (!(x_new >= x[0] && x_new <= x[len - 1])) {
+        return bad_val;
+    }
+
+    if (len == 1) {
+        return ts->y[0];
+    }
+
+    i = ts->cursor;
+
+    if (!_eh_time_series_in_segment(ts, i, x_new)) {
+        if (_eh_time_series_in_segment(ts, i + 1, x_new)) {
+            i += 1;
+        } else {
+            gint lo = 0;
+            gint hi = len - 2;
+
+            // Find the first segment whose upper end is at or above x_new.
+            while (lo < hi) {
+                const gint mid = (lo + hi) / 2;
+
+                if (x_new <= x[mid + 1]) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+
+            i = lo;
+        }
+
+        ts->cursor = i;
+    }
+
+    return ts->m[i] * (x_new - x[i]) + ts->y[i];
+}
+
+/** Evaluate an Eh_time_series
+
+\param ts    An Eh_time_series
+\param x_new The x-value to evaluate the curve at
+
+\return The value of the curve at \a x_new, or NaN if \a x_new is outside
+        of the curve.
+
+\see eh_time_series_eval_bad_val
+*/
+double
+eh_time_series_eval(Eh_time_series ts, double x_new)
+{
+    return eh_time_series_eval_bad_val(ts, x_new, eh_nan());
+}
+
+gint
+eh_time_series_len(Eh_time_series ts)
+{
+    return ts->len;
+}
+
+const double*
+eh_time_series_x(Eh_time_series ts)
+{
+    return ts->x;
+}
+
+const double*
+eh_time_series_y(Eh_time_series ts)
+{
+    return ts->y;
+}
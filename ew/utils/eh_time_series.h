@@ -0,0 +1,35 @@
+#ifndef __EH_TIME_SERIES_H__
+#define __EH_TIME_SERIES_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <glib.h>
+#include <utils/eh_types.h>
+
+new_handle(Eh_time_series);
+
+typedef enum {
+    EH_TIME_SERIES_ERROR_EMPTY,
+    EH_TIME_SERIES_ERROR_X_NOT_MONOTONIC
+}
+Eh_time_series_error;
+
+#define EH_TIME_SERIES_ERROR eh_time_series_error_quark()
+
+GQuark         eh_time_series_error_quark(void);
+Eh_time_series eh_time_series_new(const double* x, const double* y, gint len,
+                                  GError** err);
+Eh_time_series eh_time_series_destroy(Eh_time_series ts);
+double         eh_time_series_eval(Eh_time_series ts, double x);
+double         eh_time_series_eval_bad_val(Eh_time_series ts, double x,
+                                           double bad_val);
+gint           eh_time_series_len(Eh_time_series ts);
+const double*  eh_time_series_x(Eh_time_series ts);
+const double*  eh_time_series_y(Eh_time_series ts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
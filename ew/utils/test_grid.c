@@ -266,6 +266,58 @@ test_scalar_mult_grid(void)
     g = eh_grid_destroy(g, TRUE);
 }
 
+void
+test_kernels_grid(void)
+{
+    const int nx = g_test_rand_int_range(100, 500);
+    const int ny = g_test_rand_int_range(10, 100);
+    Eh_dbl_grid x    = eh_grid_new(double, nx, ny);
+    Eh_dbl_grid y    = eh_grid_new(double, nx, ny);
+    Eh_dbl_grid mask = eh_grid_new(double, nx, ny);
+    Eh_dbl_grid y_0;
+    double total = 0;
+    gint64 n_above = 0;
+    int i, j;
+
+    eh_dbl_grid_randomize(x);
+    eh_dbl_grid_randomize(y);
+
+    for (i = 0 ; i < nx ; i++)
+        for (j = 0 ; j < ny ; j++) {
+            eh_dbl_grid_set_val(mask, i, j, g_random_boolean() ? 1. : 0.);
+        }
+
+    y_0 = eh_grid_dup(y);
+
+    eh_dbl_grid_axpy(y, -2., x);
+    eh_dbl_grid_clamp(y, -.5, .5);
+
+    for (i = 0 ; i < nx ; i++)
+        for (j = 0 ; j < ny ; j++) {
+            double val = eh_dbl_grid_val(y_0, i, j) - 2. * eh_dbl_grid_val(x, i, j);
+
+            eh_clamp(val, -.5, .5);
+
+            g_assert_cmpfloat(eh_dbl_grid_val(y, i, j), ==, val);
+
+            if (val > .25) {
+                n_above++;
+            }
+
+            if (eh_dbl_grid_val(mask, i, j) != 0.) {
+                total += val;
+            }
+        }
+
+    g_assert_cmpint(eh_dbl_grid_count_gt(y, .25), ==, n_above);
+    g_assert(fabs(eh_dbl_grid_sum_mask(y, mask) - total) < 1e-9);
+
+    x    = eh_grid_destroy(x, TRUE);
+    y    = eh_grid_destroy(y, TRUE);
+    y_0  = eh_grid_destroy(y_0, TRUE);
+    mask = eh_grid_destroy(mask, TRUE);
+}
+
 
 void
 test_reindex_grid(void)
@@ -339,6 +391,54 @@ test_reduce_grid(void)
 }
 
 
+void
+test_remesh_grid(void)
+{
+    const int nx = g_test_rand_int_range(10, 50);
+    const int ny = g_test_rand_int_range(50, 100);
+    const int new_nx = g_test_rand_int_range(2, 100);
+    const int new_ny = g_test_rand_int_range(2, 100);
+    Eh_dbl_grid g = eh_grid_new(double, nx, ny);
+    Eh_dbl_grid new_g = eh_grid_new(double, new_nx, new_ny);
+    Eh_remesh r;
+    int i, j;
+
+    for (i = 0 ; i < nx ; i++)
+        for (j = 0 ; j < ny ; j++) {
+            eh_dbl_grid_set_val(g, i, j, 2.*i - 3.*j);
+        }
+
+    r = eh_remesh_new(nx, ny, new_nx, new_ny, EH_REMESH_BILINEAR);
+
+    g_assert(eh_remesh_is_shape(r, nx, ny, new_nx, new_ny));
+
+    eh_remesh_apply(r, g, new_g);
+
+    for (i = 0 ; i < new_nx ; i++)
+        for (j = 0 ; j < new_ny ; j++) {
+            double x = i * (nx - 1.) / (new_nx - 1.);
+            double y = j * (ny - 1.) / (new_ny - 1.);
+
+            g_assert(fabs(eh_dbl_grid_val(new_g, i, j) - (2.*x - 3.*y)) < 1e-9);
+        }
+
+    r = eh_remesh_destroy(r);
+
+    eh_dbl_grid_randomize(g);
+
+    r = eh_remesh_new(nx, ny, new_nx, new_ny, EH_REMESH_CONSERVATIVE);
+    eh_remesh_apply(r, g, new_g);
+
+    g_assert(eh_compare_dbl(eh_dbl_grid_sum(g),
+            eh_dbl_grid_sum(new_g) * nx * ny / (double)(new_nx * new_ny),
+            1e-12));
+
+    r     = eh_remesh_destroy(r);
+    g     = eh_grid_destroy(g, TRUE);
+    new_g = eh_grid_destroy(new_g, TRUE);
+}
+
+
 void
 test_rebin_grid(void)
 {
@@ -385,6 +485,85 @@ test_rebin_grid(void)
 }
 
 
+void
+test_rebin_grid_work(void)
+{
+    Eh_dbl_grid x = eh_grid_new(double, 31, 47);
+    Eh_dbl_grid dest[2];
+    Eh_dbl_grid expected[2];
+    double* work;
+    gssize len = 0;
+    gssize i, j, n;
+
+    eh_grid_set_x_lin(x, 0., 33.);
+    eh_grid_set_y_lin(x, 0., 300.);
+
+    for (i = 0 ; i < eh_grid_n_x(x) ; i++)
+        for (j = 0 ; j < eh_grid_n_y(x) ; j++) {
+            eh_dbl_grid_set_val(x, i, j, i + .1 * j);
+        }
+
+    dest[0] = eh_grid_new(double, 5, 120);
+    dest[1] = eh_grid_new(double, 64, 9);
+
+    eh_grid_set_x_lin(dest[0], 0., 200.);
+    eh_grid_set_y_lin(dest[0], 0., 125.);
+    eh_grid_set_x_lin(dest[1], 0., 16.);
+    eh_grid_set_y_lin(dest[1], 0., 1600.);
+
+    for (n = 0 ; n < 2 ; n++) {
+        expected[n] = eh_grid_dup(dest[n]);
+        eh_dbl_grid_rebin_bad_val(x, expected[n], 0.);
+        len = MAX(len, eh_dbl_grid_rebin_work_len(x, dest[n]));
+    }
+
+    // One block of scratch space, whatever it holds, does for every grid
+    work = eh_new(double, len);
+    eh_dbl_array_set(work, len, eh_nan());
+
+    for (n = 0 ; n < 2 ; n++) {
+        g_assert(eh_dbl_grid_rebin_bad_val_work(x, dest[n], 0., work) == dest[n]);
+
+        for (i = 0 ; i < eh_grid_n_x(dest[n]) ; i++)
+            for (j = 0 ; j < eh_grid_n_y(dest[n]) ; j++)
+                g_assert_cmpfloat(eh_dbl_grid_val(dest[n], i, j), ==,
+                    eh_dbl_grid_val(expected[n], i, j));
+
+        eh_grid_destroy(dest[n], TRUE);
+        eh_grid_destroy(expected[n], TRUE);
+    }
+
+    eh_free(work);
+    eh_grid_destroy(x, TRUE);
+}
+
+static void
+_sum_dbl(gpointer data, gpointer sum)
+{
+    *(double*)sum += *(double*)data;
+}
+
+void
+test_foreach_grid(void)
+{
+    Eh_dbl_grid g = eh_grid_new(double, 5, 7);
+    double      sum = 0.;
+    gint        i, j;
+
+    for (i = 0 ; i < eh_grid_n_x(g) ; i++)
+        for (j = 0 ; j < eh_grid_n_y(g) ; j++) {
+            eh_dbl_grid_set_val(g, i, j, i * eh_grid_n_y(g) + j);
+        }
+
+    eh_grid_reindex(g, -2, 3);
+
+    eh_grid_foreach(g, &_sum_dbl, &sum);
+
+    g_assert_cmpfloat(sum, ==, 35. * 34. / 2.);
+
+    eh_grid_destroy(g, TRUE);
+}
+
 void
 test_line_path(void)
 {
@@ -477,11 +656,15 @@ main(int argc, char* argv[])
     g_test_add_func("/utils/grid/sum", &test_sum_grid);
     g_test_add_func("/utils/grid/sum_bad", &test_bad_sum_grid);
     g_test_add_func("/utils/grid/mult", &test_scalar_mult_grid);
+    g_test_add_func("/utils/grid/kernels", &test_kernels_grid);
     g_test_add_func("/utils/grid/cmp_same", &test_cmp_grid);
     g_test_add_func("/utils/grid/cmp_unequal", &test_cmp_unequal_grid);
     g_test_add_func("/utils/grid/reindex", &test_reindex_grid);
     g_test_add_func("/utils/grid/reduce", &test_reduce_grid);
+    g_test_add_func("/utils/grid/remesh", &test_remesh_grid);
     g_test_add_func("/utils/grid/rebin", &test_rebin_grid);
+    g_test_add_func("/utils/grid/rebin_work", &test_rebin_grid_work);
+    g_test_add_func("/utils/grid/foreach", &test_foreach_grid);
 
     g_test_run();
 }
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 #include "utils/utils.h"
 #include <eh_utils.h>
 
@@ -68,6 +69,87 @@ test_set_input_val(void)
     }
 }
 
+void
+test_set_input_val_seed(void)
+{
+    const gint   n_evals = 100;
+    Eh_input_val a       = eh_input_val_set("uniform=-1,1", NULL);
+    Eh_input_val b       = eh_input_val_set("uniform=-1,1", NULL);
+    Eh_input_val c       = eh_input_val_set("uniform=-1,1", NULL);
+    gint         i, n_same;
+
+    eh_input_val_set_seed(a, 1973, 1, 2);
+    eh_input_val_set_seed(b, 1973, 1, 2);
+    eh_input_val_set_seed(c, 1973, 1, 3);
+
+    // Values with the same seed and stream draw the same numbers, while
+    // another stream draws its own
+    for (i = 0, n_same = 0; i < n_evals; i++) {
+        const double val = eh_input_val_eval(a);
+
+        g_assert_cmpfloat(val, >=, -1.);
+        g_assert_cmpfloat(val, <, 1.);
+        g_assert_cmpfloat(val, ==, eh_input_val_eval(b));
+
+        if (val == eh_input_val_eval(c)) {
+            n_same++;
+        }
+    }
+
+    g_assert_cmpint(n_same, <, n_evals);
+
+    // Reseeding starts the stream over
+    {
+        const double first = eh_input_val_eval(eh_input_val_set_seed(a, 1973, 1, 2));
+
+        eh_input_val_set_seed(b, 1973, 1, 2);
+        g_assert_cmpfloat(first, ==, eh_input_val_eval(b));
+    }
+
+    eh_input_val_destroy(a);
+    eh_input_val_destroy(b);
+    eh_input_val_destroy(c);
+}
+
+void
+test_set_input_val_file(void)
+{
+    gchar*       name = NULL;
+    FILE*        fp   = eh_open_temp_file(NULL, &name);
+    Eh_input_val v;
+    gchar*       str;
+    GError*      err = NULL;
+
+    g_assert(fp);
+
+    fprintf(fp, "0, 0\n1, 10\n2, 30\n");
+    fclose(fp);
+
+    str = g_strconcat("FILE=", name, NULL);
+    v = eh_input_val_set(str, &err);
+
+    g_assert_no_error(err);
+    g_assert(v != NULL);
+    g_assert(eh_compare_dbl(eh_input_val_eval(v, .5), 5., 1e-12));
+    g_assert(eh_compare_dbl(eh_input_val_eval(v, 1.5), 20., 1e-12));
+
+    v = eh_input_val_destroy(v);
+
+    fp = fopen(name, "w");
+    fprintf(fp, "0, 0\n2, 10\n1, 30\n");
+    fclose(fp);
+
+    v = eh_input_val_set(str, &err);
+
+    g_assert(v == NULL);
+    g_assert_error(err, EH_INPUT_VAL_ERROR, EH_INPUT_VAL_ERROR_X_NOT_MONOTONIC);
+
+    g_clear_error(&err);
+    g_remove(name);
+    g_free(name);
+    g_free(str);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -77,6 +159,8 @@ main(int argc, char* argv[])
 
     g_test_add_func("/utils/input_val/create", &test_create_input_val);
     g_test_add_func("/utils/input_val/set", &test_set_input_val);
+    g_test_add_func("/utils/input_val/set_file", &test_set_input_val_file);
+    g_test_add_func("/utils/input_val/set_seed", &test_set_input_val_seed);
 
     g_test_run();
 }
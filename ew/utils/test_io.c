@@ -1,5 +1,10 @@
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/wait.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 #include "utils/utils.h"
 #include <eh_utils.h>
 
@@ -203,6 +208,349 @@ test_getline_realloc(void)
     g_assert_true(strlen(line_str) == n);
 }
 
+void
+test_dlm_read_records(void)
+{
+    gchar*    name = NULL;
+    FILE*     fp   = eh_open_temp_file(NULL, &name);
+    gint*     n_rows;
+    gint*     n_cols;
+    gchar**   headers = NULL;
+    double*** data;
+    GError*   err = NULL;
+
+    g_assert_true(fp);
+
+    fprintf(fp, "# header comment\r\n");
+    fprintf(fp, "[ first ]\r\n");
+    fprintf(fp, "1, 2 ,3\r\n");
+    fprintf(fp, "\r\n");
+    fprintf(fp, "4;5 // trailing\r\n");
+    fprintf(fp, "[second]\n");
+    fprintf(fp, "  -1.5e2,0.25\n");
+    fprintf(fp, "\n");
+    fprintf(fp, "6\n");
+    fclose(fp);
+
+    data = eh_dlm_read_full(name, NULL, &n_rows, &n_cols, &headers, -1, &err);
+
+    g_assert_no_error(err);
+    g_assert_true(data);
+    g_assert_true(data[0] && data[1] && !data[2]);
+
+    g_assert_cmpstr(headers[0], ==, "first");
+    g_assert_cmpstr(headers[1], ==, "second");
+
+    g_assert_cmpint(n_rows[0], ==, 2);
+    g_assert_cmpint(n_cols[0], ==, 3);
+    g_assert_cmpfloat(data[0][0][2], ==, 3.);
+    g_assert_cmpfloat(data[0][1][1], ==, 5.);
+    g_assert_cmpfloat(data[0][1][2], ==, 0.);
+
+    g_assert_cmpint(n_rows[1], ==, 2);
+    g_assert_cmpint(n_cols[1], ==, 2);
+    g_assert_cmpfloat(data[1][0][0], ==, -150.);
+    g_assert_cmpfloat(data[1][0][1], ==, .25);
+    g_assert_cmpfloat(data[1][1][0], ==, 6.);
+
+    eh_free_2(data[0]);
+    eh_free_2(data[1]);
+    eh_free(data);
+    eh_free(n_rows);
+    eh_free(n_cols);
+    g_strfreev(headers);
+
+    data = eh_dlm_read_full(name, NULL, &n_rows, &n_cols, NULL, 1, &err);
+
+    g_assert_no_error(err);
+    g_assert_true(data[0] && !data[1]);
+    g_assert_cmpint(n_rows[0], ==, 2);
+    g_assert_cmpint(n_cols[0], ==, 3);
+
+    eh_free_2(data[0]);
+    eh_free(data);
+    eh_free(n_rows);
+    eh_free(n_cols);
+
+    g_remove(name);
+}
+
+/* Append a random number, in one of the forms that may be found in a
+   delimited file, to a string. */
+static void
+_dlm_append_random_value(GString* str)
+{
+    const double x = g_test_rand_double_range(-1e4, 1e4);
+
+    switch (g_test_rand_int_range(0, 12)) {
+        case 0:
+            g_string_append_printf(str, "%d", g_test_rand_int_range(-1000, 1000));
+            break;
+
+        case 1:
+            g_string_append_printf(str, "%.*f", g_test_rand_int_range(0, 20), x);
+            break;
+
+        case 2:
+            g_string_append_printf(str, "%.*g", g_test_rand_int_range(1, 18), x);
+            break;
+
+        case 3:
+            g_string_append_printf(str, "%.*e", g_test_rand_int_range(0, 17),
+                x * pow(10., g_test_rand_int_range(-320, 300)));
+            break;
+
+        case 4:
+            g_string_append_printf(str, "%+.3E", x);
+            break;
+
+        case 5:
+            g_string_append_printf(str, ".%d", g_test_rand_int_range(0, 100000));
+            break;
+
+        case 6:
+            g_string_append_printf(str, "%d.", g_test_rand_int_range(0, 100000));
+            break;
+
+        case 7:
+            g_string_append_printf(str, "%.17g", x);
+            break;
+
+        case 8:
+            g_string_append(str, g_test_rand_int_range(0, 2) ? "-0" : "1e400");
+            break;
+
+        case 9:
+            g_string_append(str, g_test_rand_int_range(0, 2) ? "nan" : "-inf");
+            break;
+
+        case 10:
+            g_string_append_printf(str, "%.0f%.0f", fabs(x), fabs(x));
+            break;
+
+        default:
+            /* An empty field */
+            break;
+    }
+}
+
+/* Write a random delimited file whose records are read the same way
+   by the string and the mapped readers. */
+static gchar*
+_dlm_random_text(void)
+{
+    const gchar* delims[] = { ",", ";", ", ", " ,", "\t,", " ; " };
+    const gchar* eols[]   = { "\n", "\r\n", "\r" };
+    const gint   n_lines  = g_test_rand_int_range(0, 30);
+    const gint   n_vals   = g_test_rand_int_range(1, 6);
+    GString*     str      = g_string_new(NULL);
+    gint         i, j;
+
+    for (i = 0 ; i < n_lines ; i++) {
+        const gchar* eol = eols[g_test_rand_int_range(0, 3)];
+
+        switch (g_test_rand_int_range(0, 10)) {
+            case 0:
+                g_string_append(str, g_test_rand_int_range(0, 2) ? "# comment" : "// comment");
+                break;
+
+            case 1:
+                g_string_append(str, g_test_rand_int_range(0, 2) ? "" : "  \t ");
+                break;
+
+            case 2:
+                g_string_append_printf(str, "[%s record %d ]",
+                    g_test_rand_int_range(0, 2) ? " " : "", i);
+                break;
+
+            default: {
+                /* Most rows have the same number of values */
+                const gint len = g_test_rand_int_range(0, 4) ? n_vals
+                    : g_test_rand_int_range(1, 8);
+
+                if (g_test_rand_int_range(0, 4) == 0) {
+                    g_string_append(str, "  ");
+                }
+
+                for (j = 0 ; j < len ; j++) {
+                    if (j > 0) {
+                        g_string_append(str, delims[g_test_rand_int_range(0, 6)]);
+                    }
+
+                    _dlm_append_random_value(str);
+                }
+
+                if (g_test_rand_int_range(0, 5) == 0) {
+                    g_string_append(str, g_test_rand_int_range(0, 2) ? " # comment" : "// comment");
+                }
+            }
+        }
+
+        if (i < n_lines - 1 || g_test_rand_int_range(0, 2)) {
+            g_string_append(str, eol);
+        }
+    }
+
+    return g_string_free(str, FALSE);
+}
+
+static gchar*
+_dlm_write_temp_file(const gchar* prefix, const gchar* text)
+{
+    gchar* name = NULL;
+    FILE*  fp   = eh_open_temp_file(NULL, &name);
+
+    g_assert_true(fp);
+
+    fprintf(fp, "%s%s", prefix, text);
+    fclose(fp);
+
+    return name;
+}
+
+static void
+_dlm_free(double*** data, gint* n_rows, gint* n_cols, gchar** headers)
+{
+    gint i;
+
+    for (i = 0 ; data[i] ; i++) {
+        eh_free_2(data[i]);
+    }
+
+    eh_free(data);
+    eh_free(n_rows);
+    eh_free(n_cols);
+    g_strfreev(headers);
+}
+
+/* A file that contains a C-style comment is read through the string
+   functions, and one that doesn't is read straight from its memory map.
+   Random files are read both ways, the first by starting it with an empty
+   comment, and the records, values and headers must match to the bit. */
+void
+test_dlm_read_string_vs_map(void)
+{
+    const gint n_files = g_test_quick() ? 500 : 5000;
+    gint       n;
+
+    for (n = 0 ; n < n_files ; n++) {
+        gchar*       text   = _dlm_random_text();
+        gchar*       name_0 = _dlm_write_temp_file("/**/\n", text);
+        gchar*       name_1 = _dlm_write_temp_file("", text);
+        const gchar* delims = g_test_rand_int_range(0, 2) ? NULL : ",;";
+        gint*        n_rows[2];
+        gint*        n_cols[2];
+        gchar**      headers[2] = { NULL, NULL };
+        double***    data[2];
+        GError*      err = NULL;
+        gint         i, row;
+
+        data[0] = eh_dlm_read_full(name_0, delims, &n_rows[0], &n_cols[0],
+                &headers[0], -1, &err);
+        g_assert_no_error(err);
+
+        data[1] = eh_dlm_read_full(name_1, delims, &n_rows[1], &n_cols[1],
+                &headers[1], -1, &err);
+        g_assert_no_error(err);
+
+        g_assert_true(data[0] && data[1]);
+
+        for (i = 0 ; data[0][i] || data[1][i] ; i++) {
+            g_assert_true(data[0][i] && data[1][i]);
+            g_assert_cmpint(n_rows[0][i], ==, n_rows[1][i]);
+            g_assert_cmpint(n_cols[0][i], ==, n_cols[1][i]);
+
+            for (row = 0 ; row < n_rows[0][i] ; row++) {
+                g_assert_true(memcmp(data[0][i][row], data[1][i][row],
+                        sizeof(double) * n_cols[0][i]) == 0);
+            }
+        }
+
+        if (headers[0] || headers[1]) {
+            g_assert_true(headers[0] && headers[1]);
+            g_assert_cmpint(g_strv_length(headers[0]), ==, g_strv_length(headers[1]));
+
+            for (i = 0 ; headers[0][i] ; i++) {
+                g_assert_cmpstr(headers[0][i], ==, headers[1][i]);
+            }
+        }
+
+        _dlm_free(data[0], n_rows[0], n_cols[0], headers[0]);
+        _dlm_free(data[1], n_rows[1], n_cols[1], headers[1]);
+
+        g_remove(name_0);
+        g_remove(name_1);
+        g_free(name_0);
+        g_free(name_1);
+        g_free(text);
+    }
+}
+
+void
+test_log_async_fork(void)
+{
+    gchar* name = NULL;
+    FILE*  fp   = eh_open_temp_file(NULL, &name);
+    pid_t  pid;
+    gint   status;
+
+    g_assert_true(fp);
+    fclose(fp);
+
+    eh_log_async_start();
+
+    pid = fork();
+    g_assert_cmpint(pid, >=, 0);
+
+    if (pid == 0) {
+        FILE* fp_list[2] = { NULL, NULL };
+        gchar line[101];
+        gint  i;
+
+        /* A child that hangs is killed rather than hang the test */
+        alarm(10);
+
+        if (eh_log_async_is_running()) {
+            _exit(1);
+        }
+
+        fp_list[0] = fopen(name, "w");
+
+        memset(line, 'x', 100);
+        line[100] = '\0';
+
+        /* Log about twice the size of a ring */
+        for (i = 0 ; i < 1000 ; i++) {
+            eh_logger(NULL, G_LOG_LEVEL_MESSAGE, line, fp_list);
+        }
+
+        eh_log_async_flush();
+        fclose(fp_list[0]);
+
+        _exit(0);
+    }
+
+    g_assert_cmpint(waitpid(pid, &status, 0), ==, pid);
+    g_assert_true(WIFEXITED(status));
+    g_assert_cmpint(WEXITSTATUS(status), ==, 0);
+
+    g_assert_true(eh_log_async_is_running());
+    eh_log_async_stop();
+
+    {
+        gchar* contents = NULL;
+        gsize  len      = 0;
+
+        g_assert_true(g_file_get_contents(name, &contents, &len, NULL));
+        g_assert_cmpint(len, ==, 1000 * 101);
+        g_assert_cmpint(contents[len - 1], ==, '\n');
+
+        g_free(contents);
+    }
+
+    g_remove(name);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -217,6 +565,10 @@ main(int argc, char* argv[])
     g_test_add_func("/utils/io/getline_multi_line", &test_getline_multi_line);
     g_test_add_func("/utils/io/getline_alloc", &test_getline_alloc);
     g_test_add_func("/utils/io/getline_realloc", &test_getline_realloc);
+    g_test_add_func("/utils/io/dlm_read_records", &test_dlm_read_records);
+    g_test_add_func("/utils/io/dlm_read_string_vs_map",
+        &test_dlm_read_string_vs_map);
+    g_test_add_func("/utils/io/log_async_fork", &test_log_async_fork);
 
     g_test_run();
 }
@@ -1,6 +1,9 @@
 #define _GNU_SOURCE
 #include <stdio.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 #include "utils/utils.h"
 
 char* key_file_0[] = {
@@ -44,6 +47,112 @@ test_key_file_scan_stream(void)
         eh_key_file_get_int_value(f, "first group", "key 1"), ==, 1);
 }
 
+void
+test_key_file_scan_cached(void)
+{
+    gchar*      name      = NULL;
+    FILE*       fp        = eh_open_temp_file(NULL, &name);
+    gchar*      buffer    = g_strjoinv("\n", key_file_0);
+    gchar*      cache_dir = NULL;
+    GDir*       cached;
+    GError*     error     = NULL;
+    Eh_key_file f;
+    gint        i;
+
+    g_assert(fp);
+
+    fprintf(fp, "%s\n", buffer);
+    fclose(fp);
+
+    cache_dir = g_strconcat(name, ".cache", NULL);
+
+    /* The first scan compiles the file, and the second reads it back */
+    for (i = 0 ; i < 2 ; i++) {
+        f = eh_key_file_scan_cached(name, cache_dir, &error);
+
+        g_assert_no_error(error);
+        g_assert(f);
+
+        g_assert_cmpint(eh_key_file_size(f), ==, 2);
+        g_assert(eh_key_file_has_group(f, "first group"));
+        g_assert(eh_key_file_has_group(f, "second group"));
+        g_assert(eh_key_file_has_key(f, "first group", "KEY 1"));
+
+        g_assert_cmpint(
+            eh_key_file_get_int_value(f, "first group", "key 1"), ==, 1);
+        g_assert_cmpint(
+            eh_key_file_get_int_value(f, "second group", "key 0"), ==, 0);
+
+        eh_key_file_destroy(f);
+
+        cached = g_dir_open(cache_dir, 0, NULL);
+        g_assert(cached);
+        g_assert(g_dir_read_name(cached));
+        g_dir_close(cached);
+    }
+
+    /* A file that has changed is scanned again */
+    fp = fopen(name, "w");
+    fprintf(fp, "[ 'first group' ]\nkey 1: 11\n");
+    fclose(fp);
+
+    f = eh_key_file_scan_cached(name, cache_dir, &error);
+
+    g_assert_no_error(error);
+    g_assert_cmpint(eh_key_file_size(f), ==, 1);
+    g_assert_cmpint(
+        eh_key_file_get_int_value(f, "first group", "key 1"), ==, 11);
+
+    eh_key_file_destroy(f);
+
+    { /* A change of the same size that leaves the time stamp as it was, as
+         happens with coarse time stamps, is still noticed */
+        struct stat     st;
+        struct timespec times[2];
+
+        g_assert_cmpint(g_stat(name, &st), ==, 0);
+
+        fp = fopen(name, "w");
+        fprintf(fp, "[ 'first group' ]\nkey 1: 22\n");
+        fclose(fp);
+
+        times[0] = st.st_atim;
+        times[1] = st.st_mtim;
+        g_assert_cmpint(utimensat(AT_FDCWD, name, times, 0), ==, 0);
+
+        f = eh_key_file_scan_cached(name, cache_dir, &error);
+
+        g_assert_no_error(error);
+        g_assert_cmpint(
+            eh_key_file_get_int_value(f, "first group", "key 1"), ==, 22);
+
+        eh_key_file_destroy(f);
+    }
+
+    {
+        const gchar* base;
+
+        cached = g_dir_open(cache_dir, 0, NULL);
+        g_assert(cached);
+
+        while ((base = g_dir_read_name(cached))) {
+            gchar* file = g_build_filename(cache_dir, base, NULL);
+            g_remove(file);
+            g_free(file);
+        }
+
+        g_dir_close(cached);
+
+        g_assert_cmpint(g_rmdir(cache_dir), ==, 0);
+    }
+
+    g_remove(name);
+
+    g_free(name);
+    g_free(cache_dir);
+    g_free(buffer);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -52,6 +161,7 @@ main(int argc, char* argv[])
     g_test_init(&argc, &argv, NULL);
 
     g_test_add_func("/utils/key_file/scan", &test_key_file_scan_stream);
+    g_test_add_func("/utils/key_file/scan_cached", &test_key_file_scan_cached);
 
     g_test_run();
 }
@@ -51,6 +51,57 @@ test_interpolate(void)
 }
 
 
+void
+test_time_series(void)
+{
+    double x[5] = {1, 2, 3, 4, 5},  y[5] = {.1, .2, .3, .4, .5};
+    Eh_time_series ts = eh_time_series_new(x, y, 5, NULL);
+
+    g_assert(ts);
+    g_assert_cmpint(eh_time_series_len(ts), ==, 5);
+
+    g_assert(eh_isnan(eh_time_series_eval(ts, -1)));
+    g_assert(eh_isnan(eh_time_series_eval(ts, 6)));
+    g_assert(eh_isnan(eh_time_series_eval(ts, eh_nan())));
+    g_assert_cmpfloat(eh_time_series_eval_bad_val(ts, 6, -99.), ==, -99.);
+
+    { /* Advancing, repeating, and jumping back give the same values as interpolate */
+        double xi[] = {1., 1.25, 1.25, 2., 2.5, 3.75, 5., 1.5, 4.5, 3., 2.};
+        const gint len = sizeof(xi) / sizeof(double);
+        double yi;
+        gint i;
+
+        for (i = 0 ; i < len ; i++) {
+            interpolate(x, y, 5, &xi[i], &yi, 1);
+            g_assert_cmpfloat(eh_time_series_eval(ts, xi[i]), ==, yi);
+        }
+    }
+
+    eh_time_series_destroy(ts);
+
+    ts = eh_time_series_new(x, y, 1, NULL);
+
+    g_assert(eh_compare_dbl(eh_time_series_eval(ts, 1.), .1, 1e-12));
+    g_assert(eh_isnan(eh_time_series_eval(ts, .5)));
+    g_assert(eh_isnan(eh_time_series_eval(ts, 1.5)));
+
+    eh_time_series_destroy(ts);
+
+    {
+        GError* err = NULL;
+
+        x[2] = x[1];
+
+        ts = eh_time_series_new(x, y, 5, &err);
+
+        g_assert(ts == NULL);
+        g_assert_error(err, EH_TIME_SERIES_ERROR, EH_TIME_SERIES_ERROR_X_NOT_MONOTONIC);
+
+        g_error_free(err);
+    }
+}
+
+
 void
 test_poly_interpolate(void)
 {
@@ -852,6 +903,83 @@ test_convolve(void)
     //   eh_dbl_array_fprint( stdout , z , len_x );
 }
 
+void
+test_rand_philox(void)
+{
+    Eh_rand r;
+
+    // Known-answer vector for Philox-4x32-10 with a zero key and counter.
+    eh_rand_init(&r, 0);
+
+    g_assert_cmpuint(eh_rand_int(&r), ==, 0x6627e8d5);
+    g_assert_cmpuint(eh_rand_int(&r), ==, 0xe169c58d);
+    g_assert_cmpuint(eh_rand_int(&r), ==, 0xbc57ac4c);
+    g_assert_cmpuint(eh_rand_int(&r), ==, 0x9b00dbd8);
+}
+
+void
+test_rand_fill(void)
+{
+    const gsize len = 1001;
+    double* x = eh_new(double, len);
+    double* y = eh_new(double, len);
+    Eh_rand* r = eh_rand_new_with_seed(1945);
+    gsize i;
+
+    eh_rand_int(r);
+    for (i = 0 ; i < len ; i++) {
+        x[i] = eh_rand_double(r);
+    }
+
+    eh_rand_set_stream(r, 0, 0, 0);
+    eh_rand_int(r);
+    eh_rand_fill_double(r, y, len);
+
+    for (i = 0 ; i < len ; i++) {
+        g_assert(x[i] == y[i]);
+        g_assert(y[i] >= 0. && y[i] < 1.);
+    }
+
+    eh_rand_destroy(r);
+    eh_free(y);
+    eh_free(x);
+}
+
+void
+test_rand_streams(void)
+{
+    const gint n_cols = 16;
+    double* forward  = eh_new(double, n_cols);
+    double* backward = eh_new(double, n_cols);
+    Eh_rand r;
+    gint i;
+
+    eh_rand_init(&r, 42);
+
+    for (i = 0 ; i < n_cols ; i++) {
+        eh_rand_set_stream(&r, 7, i, 3);
+        forward[i] = eh_rand_normal(&r, 0., 1.);
+    }
+
+    for (i = n_cols - 1 ; i >= 0 ; i--) {
+        eh_rand_set_stream(&r, 7, i, 3);
+        eh_rand_double(&r);
+        eh_rand_set_stream(&r, 7, i, 3);
+        backward[i] = eh_rand_normal(&r, 0., 1.);
+    }
+
+    for (i = 0 ; i < n_cols ; i++) {
+        g_assert(forward[i] == backward[i]);
+    }
+
+    for (i = 1 ; i < n_cols ; i++) {
+        g_assert(forward[i] != forward[i - 1]);
+    }
+
+    eh_free(backward);
+    eh_free(forward);
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -861,6 +989,7 @@ main(int argc, char* argv[])
 
     g_test_add_func("/utils/num/core/nan", &test_nan);
     g_test_add_func("/utils/num/core/interpolate", &test_interpolate);
+    g_test_add_func("/utils/num/core/time_series", &test_time_series);
     g_test_add_func("/utils/num/core/interpolate_poly", &test_poly_interpolate);
     g_test_add_func("/utils/num/core/trapazoid", &test_trapazoid);
     g_test_add_func("/utils/num/core/integrate", &test_integrate);
@@ -885,6 +1014,10 @@ main(int argc, char* argv[])
     g_test_add_func("/utils/num/fit/poly", &test_poly_fit);
     g_test_add_func("/utils/num/fit/r_squared", &test_r_squared);
 
+    g_test_add_func("/utils/num/rand/philox", &test_rand_philox);
+    g_test_add_func("/utils/num/rand/fill", &test_rand_fill);
+    g_test_add_func("/utils/num/rand/streams", &test_rand_streams);
+
     g_test_run();
 }
 
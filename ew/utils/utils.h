@@ -21,6 +21,8 @@ extern "C" {
 #include "utils/eh_symbol_table.h"
 #include "utils/eh_data_record.h"
 #include "utils/eh_input_val.h"
+#include "utils/eh_time_series.h"
+#include "utils/eh_remesh.h"
 #include "utils/eh_types.h"
 #include "utils/eh_dlm_file.h"
 #include "utils/eh_str.h"
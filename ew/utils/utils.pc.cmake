@@ -1,7 +1,7 @@
 Name: LibUtils
 Description: My utility library
 Version: ${SEDFLUX_VERSION}
-Requires: glib-2.0 >= 2.25
+Requires: glib-2.0 >= 2.32
 Libs: -L${CMAKE_INSTALL_PREFIX}/lib -lutils -lm
 Cflags: -I${CMAKE_INSTALL_PREFIX}/include
 
@@ -1135,6 +1135,8 @@ get_sediment_flux(Sed_cube p, Sed_wave deep_wave, double u_0, Bruun_data* data,
         double*            z = (double*)eh_grid_data_start(z_grid);
         double*        dz_dy = (double*)eh_grid_data_start(dz_dy_grid);
         double depth, y_b, y, *k_b;
+        double* depth_i = eh_new(double, sed_cube_n_y(p));
+        double* k_i     = eh_new(double, sed_cube_n_y(p));
         double* gz  = sed_sediment_property(NULL, &sed_type_grain_size_in_meters);
         double* w_s = sed_sediment_property(NULL, &sed_type_settling_velocity);
 
@@ -1147,18 +1149,27 @@ get_sediment_flux(Sed_cube p, Sed_wave deep_wave, double u_0, Bruun_data* data,
         y_b = data->x_b - data->x_0;
         k_b = data->k;
 
+        // Solve the dispersion relation for the whole profile at once.
         for (i = 0 ; i < sed_cube_n_y(p) ; i++) {
             if (i != sed_cube_n_y(p) - 1) {
-                depth = (z[i] + z[i + 1]) * .5;
+                depth_i[i] = (z[i] + z[i + 1]) * .5;
             } else {
-                depth = z[i];
+                depth_i[i] = z[i];
             }
+        }
+
+        sed_dispersion_relation_wave_number_profile(depth_i, sed_cube_n_y(p),
+            sed_wave_frequency(deep_wave), k_i);
+
+        for (i = 0 ; i < sed_cube_n_y(p) ; i++) {
+            depth = depth_i[i];
 
             y = sed_cube_col_y(p, i) - data->x_0;
 
             if (depth > .01) {
 
-                this_wave = sed_gravity_wave_new(deep_wave, depth, this_wave);
+                this_wave = sed_gravity_wave_new_with_number(deep_wave, depth, k_i[i],
+                        this_wave);
 
                 eh_require(!sed_wave_is_bad(this_wave));
 
@@ -1195,6 +1206,8 @@ get_sediment_flux(Sed_cube p, Sed_wave deep_wave, double u_0, Bruun_data* data,
 
         }
 
+        eh_free(depth_i);
+        eh_free(k_i);
         eh_free(gz);
         eh_free(w_s);
         eh_grid_destroy(dz_dy_grid, TRUE);
@@ -1363,7 +1376,7 @@ move_sediment(Sed_cube p,
             add_index    = (du_tot > 0) ? (i + 1) : (i);
 
             if (fabs(du_tot) > 0) {
-                double m_0 = sed_column_mass(sed_cube_col(p, remove_index));
+                double m_0 = sed_column_mass(sed_cube_peek_col(p, remove_index));
                 double m_1, dm;
 
                 if (fabs(du_tot) > dh_max[i]) {
@@ -1378,13 +1391,13 @@ move_sediment(Sed_cube p,
                     du[i],
                     fill_cell,
                     add_cell);
-                m_1 = sed_column_mass(sed_cube_col(p, remove_index));
+                m_1 = sed_column_mass(sed_cube_peek_col(p, remove_index));
                 dm  = sed_cell_mass(add_cell);
 
                 if (fabs(m_1 + dm - m_0) > 1e-6) {
                     eh_watch_int(i);
                     eh_watch_int(remove_index);
-                    eh_watch_dbl(sed_column_thickness(sed_cube_col(p, remove_index)));
+                    eh_watch_dbl(sed_column_thickness(sed_cube_peek_col(p, remove_index)));
                     eh_watch_dbl(du_tot);
                     eh_watch_dbl(m_0);
                     eh_watch_dbl(m_1);